@@ -0,0 +1,63 @@
+/*
+ * Copyright 2023-2024 The Gestalt Project Authors. All Rights Reserved.
+ *
+ * Licensed under the MIT License. See the file LICENSE for the full text.
+ */
+
+/*
+ * bench_aes_batch.cpp
+ *
+ * This file contains the multi-buffer AES-CBC benchmark. It encrypts many short records, each under
+ * its own key, once with one encryptAESCBC call per record and once with a single encryptAESCBCBatch
+ * call, and reports the throughput of both.
+ *
+ * Usage: bench_aes_batch [payload size in MB, default 16] [record size in bytes, default 256]
+ */
+
+#include <cstdlib>
+#include <vector>
+
+#include <gestalt/aes.h>
+#include "bench_utils.h"
+
+int main(int argc, char* argv[]) {
+    size_t megabytes = payloadMegabytes(argc, argv, 16);
+    size_t recordSize = argc > 2 ? std::strtoul(argv[2], nullptr, 10) : 256;
+    recordSize = recordSize > 0 ? recordSize : 1;
+
+    const size_t numRecords = megabytes * 1024 * 1024 / recordSize;
+    const size_t stride = aesPaddedLength(recordSize);
+
+    std::vector<uint8_t> keys(numRecords * 32);
+    std::vector<uint8_t> ivs(numRecords * AES_BLOCK_SIZE, 0x0f);
+    std::vector<uint8_t> records(numRecords * recordSize, 0x5a);
+    std::vector<uint8_t> output(numRecords * stride);
+    for (size_t i = 0; i < keys.size(); i++) {
+        keys[i] = static_cast<uint8_t>(i * 31);
+    }
+
+    std::printf("AES-256-CBC, %zu records of %zu bytes, one key per record\n\n", numRecords, recordSize);
+
+    report("encryptAESCBC per record", numRecords * recordSize, secondsFor([&]() {
+        for (size_t i = 0; i < numRecords; i++) {
+            encryptAESCBC(
+                records.data() + i * recordSize, recordSize, ivs.data() + i * AES_BLOCK_SIZE, keys.data() + i * 32, 32,
+                output.data() + i * stride
+            );
+        }
+    }));
+
+    std::vector<AESBatchItem> items(numRecords);
+    for (size_t i = 0; i < numRecords; i++) {
+        items[i].key = keys.data() + i * 32;
+        items[i].keyLen = 32;
+        items[i].iv = ivs.data() + i * AES_BLOCK_SIZE;
+        items[i].in = records.data() + i * recordSize;
+        items[i].inLen = recordSize;
+        items[i].out = output.data() + i * stride;
+    }
+    report("encryptAESCBCBatch", numRecords * recordSize,
+           secondsFor([&]() { encryptAESCBCBatch(items.data(), items.size()); }));
+
+    return 0;
+}
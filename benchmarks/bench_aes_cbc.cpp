@@ -0,0 +1,85 @@
+/*
+ * Copyright 2023-2024 The Gestalt Project Authors. All Rights Reserved.
+ *
+ * Licensed under the MIT License. See the file LICENSE for the full text.
+ */
+
+/*
+ * bench_aes_cbc.cpp
+ *
+ * This file contains the AES-CBC throughput benchmark. It compares the previous chaining loop, which
+ * round-tripped the chaining value through hex on every block, against the binary CBC engine for
+ * every supported backend, and reports the end-to-end cost of the hex and binary public APIs.
+ *
+ * Usage: bench_aes_cbc [payload size in MB, default 16]
+ */
+
+#include <string>
+#include <vector>
+
+#include <gestalt/aes.h>
+#include "aes/aesCore.h"
+#include "utils.h"
+#include "bench_utils.h"
+
+static const char* KEY = "000102030405060708090a0b0c0d0e0f101112131415161718191a1b1c1d1e1f";
+static const char* IV = "0f0e0d0c0b0a09080706050403020100";
+
+// The chaining loop used before the CBC engine kept the chaining value in binary form
+static void legacyEncryptCBC(AES& cipher, unsigned char* data, size_t length, std::string iv) {
+    for (size_t blockIndex = 0; blockIndex < length; blockIndex += AES_BLOCK_SIZE) {
+        xorBlock(data, iv, blockIndex);
+        cipher.encryptBlock(data + blockIndex);
+        iv.assign(reinterpret_cast<char*>(data + blockIndex), AES_BLOCK_SIZE);
+        iv = convertToHex(iv);
+    }
+}
+
+int main(int argc, char* argv[]) {
+    size_t megabytes = payloadMegabytes(argc, argv, 16);
+    const size_t length = megabytes * 1024 * 1024;
+
+    std::vector<unsigned char> key = hexStringToBytesVec(KEY);
+    std::vector<unsigned char> iv = hexStringToBytesVec(IV);
+    std::vector<unsigned char> data(length, 0x5a);
+
+    std::printf("AES-256-CBC, %zu MB payload\n\n", megabytes);
+
+    const AESBackend backends[] = { AESBackend::Reference, AESBackend::TTable, AESBackend::AESNI, AESBackend::Bitsliced };
+    for (AESBackend backend : backends) {
+        if (!isAESBackendSupported(backend)) {
+            continue;
+        }
+        AES cipher(key.data(), key.size(), backend);
+        std::string label = backendName(backend);
+
+        report((label + " legacy hex chaining").c_str(), length,
+               secondsFor([&]() { legacyEncryptCBC(cipher, data.data(), length, IV); }));
+
+        unsigned char chain[AES_BLOCK_SIZE];
+        std::copy(iv.begin(), iv.end(), chain);
+        report((label + " encryptBlocksCBC").c_str(), length,
+               secondsFor([&]() { cipher.encryptBlocksCBC(data.data(), length / AES_BLOCK_SIZE, chain); }));
+
+        std::copy(iv.begin(), iv.end(), chain);
+        report((label + " decryptBlocksCBC").c_str(), length,
+               secondsFor([&]() { cipher.decryptBlocksCBC(data.data(), length / AES_BLOCK_SIZE, chain); }));
+        std::printf("\n");
+    }
+
+    std::vector<unsigned char> output(aesPaddedLength(length));
+    size_t ciphertextLen = 0;
+    report("encryptAESCBC (binary)", length, secondsFor([&]() {
+        ciphertextLen = encryptAESCBC(data.data(), length, iv.data(), key.data(), key.size(), output.data());
+    }));
+    report("decryptAESCBC (binary, in place)", length, secondsFor([&]() {
+        decryptAESCBC(output.data(), ciphertextLen, iv.data(), key.data(), key.size(), output.data());
+    }));
+
+    std::string msg(data.begin(), data.end());
+    std::string hexCiphertext;
+    report("encryptAESCBC (hex)", length, secondsFor([&]() { hexCiphertext = encryptAESCBC(msg, IV, KEY); }));
+    report("decryptAESCBC (hex)", length, secondsFor([&]() { decryptAESCBC(hexCiphertext, IV, KEY); }));
+
+    return 0;
+}
@@ -0,0 +1,55 @@
+/*
+ * Copyright 2023-2024 The Gestalt Project Authors. All Rights Reserved.
+ *
+ * Licensed under the MIT License. See the file LICENSE for the full text.
+ */
+
+/*
+ * bench_aes_ctr.cpp
+ *
+ * This file contains the AES-CTR throughput benchmark. It measures the single threaded keystream
+ * engine for every supported backend and the public API, which splits large buffers across threads.
+ *
+ * Usage: bench_aes_ctr [payload size in MB, default 64]
+ */
+
+#include <string>
+#include <vector>
+
+#include <gestalt/aes.h>
+#include "aes/aesCore.h"
+#include "utils.h"
+#include "bench_utils.h"
+
+static const char* KEY = "000102030405060708090a0b0c0d0e0f101112131415161718191a1b1c1d1e1f";
+static const char* COUNTER = "f0f1f2f3f4f5f6f7f8f9fafbfcfdfeff";
+
+int main(int argc, char* argv[]) {
+    size_t megabytes = payloadMegabytes(argc, argv, 64);
+    const size_t length = megabytes * 1024 * 1024;
+
+    std::vector<unsigned char> key = hexStringToBytesVec(KEY);
+    std::vector<unsigned char> counter = hexStringToBytesVec(COUNTER);
+    std::vector<unsigned char> data(length, 0x5a);
+
+    std::printf("AES-256-CTR, %zu MB payload\n\n", megabytes);
+
+    const AESBackend backends[] = { AESBackend::Reference, AESBackend::TTable, AESBackend::AESNI, AESBackend::Bitsliced };
+    for (AESBackend backend : backends) {
+        if (!isAESBackendSupported(backend)) {
+            continue;
+        }
+        AES cipher(key.data(), key.size(), backend);
+        std::string label = std::string(backendName(backend)) + " applyCTR";
+
+        report(label.c_str(), length,
+               secondsFor([&]() { cipher.applyCTR(data.data(), data.data(), length, counter.data()); }));
+    }
+
+    std::printf("\n");
+    report("encryptAESCTR (in place)", length, secondsFor([&]() {
+        encryptAESCTR(data.data(), length, counter.data(), key.data(), key.size(), data.data());
+    }));
+
+    return 0;
+}
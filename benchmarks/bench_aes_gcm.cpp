@@ -0,0 +1,63 @@
+/*
+ * Copyright 2023-2024 The Gestalt Project Authors. All Rights Reserved.
+ *
+ * Licensed under the MIT License. See the file LICENSE for the full text.
+ */
+
+/*
+ * bench_aes_gcm.cpp
+ *
+ * This file contains the AES-GCM throughput benchmark. It measures single pass GCM with each supported
+ * GHASH engine against the two pass AES-CBC plus HMAC-SHA256 construction it replaces.
+ *
+ * Usage: bench_aes_gcm [payload size in MB, default 16]
+ */
+
+#include <string>
+#include <vector>
+
+#include <gestalt/aes.h>
+#include <gestalt/hmac_sha2.h>
+#include "aes/aesGCM.h"
+#include "utils.h"
+#include "bench_utils.h"
+
+static const char* KEY = "000102030405060708090a0b0c0d0e0f101112131415161718191a1b1c1d1e1f";
+static const char* IV = "cafebabefacedbaddecaf888";
+static const char* CBC_IV = "0f0e0d0c0b0a09080706050403020100";
+
+int main(int argc, char* argv[]) {
+    size_t megabytes = payloadMegabytes(argc, argv, 16);
+    const size_t length = megabytes * 1024 * 1024;
+
+    std::vector<unsigned char> key = hexStringToBytesVec(KEY);
+    std::vector<unsigned char> iv = hexStringToBytesVec(IV);
+    std::vector<unsigned char> data(length, 0x5a);
+    unsigned char tag[GCM_TAG_SIZE];
+
+    std::printf("AES-256-GCM, %zu MB payload\n\n", megabytes);
+
+    const GHASHBackend backends[] = { GHASHBackend::Table, GHASHBackend::CLMUL };
+    for (GHASHBackend backend : backends) {
+        if (!isGHASHBackendSupported(backend)) {
+            continue;
+        }
+        GCM gcm(key.data(), key.size(), AESBackend::Auto, backend);
+        std::string label = backend == GHASHBackend::CLMUL ? "GCM encrypt (CLMUL)" : "GCM encrypt (Table)";
+
+        report(label.c_str(), length, secondsFor([&]() {
+            gcm.start(iv.data(), iv.size());
+            gcm.encryptUpdate(data.data(), data.data(), length);
+            gcm.finish(tag);
+        }));
+    }
+
+    std::vector<unsigned char> cbcIV = hexStringToBytesVec(CBC_IV);
+    std::vector<unsigned char> output(aesPaddedLength(length));
+    report("AES-CBC + HMAC-SHA256", length, secondsFor([&]() {
+        size_t ciphertextLen = encryptAESCBC(data.data(), length, cbcIV.data(), key.data(), key.size(), output.data());
+        hmacSHA256(KEY, std::string(output.begin(), output.begin() + ciphertextLen));
+    }));
+
+    return 0;
+}
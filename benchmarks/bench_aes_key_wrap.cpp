@@ -0,0 +1,84 @@
+/*
+ * Copyright 2023-2024 The Gestalt Project Authors. All Rights Reserved.
+ *
+ * Licensed under the MIT License. See the file LICENSE for the full text.
+ */
+
+/*
+ * bench_aes_key_wrap.cpp
+ *
+ * This file contains the key unwrap benchmark. It loads many wrapped 256-bit data keys under one KEK,
+ * once through per-key unwrapKey calls and once through the batch API, with each supported engine. A
+ * second batch alternates 128-bit and 256-bit keys, as a key store holding both would.
+ *
+ * Usage: bench_aes_key_wrap [number of keys in thousands, default 64]
+ */
+
+#include <string>
+#include <vector>
+
+#include <gestalt/aes.h>
+#include "utils.h"
+#include "bench_utils.h"
+
+static const char* KEK = "000102030405060708090a0b0c0d0e0f101112131415161718191a1b1c1d1e1f";
+static const size_t KEY_SIZE = 32;
+static const size_t WRAPPED_SIZE = KEY_SIZE + 8;
+
+int main(int argc, char* argv[]) {
+    const size_t count = payloadMegabytes(argc, argv, 64) * 1000;
+
+    std::vector<unsigned char> kekBytes = hexStringToBytesVec(KEK);
+    std::vector<unsigned char> wrapped(count * WRAPPED_SIZE);
+    std::vector<unsigned char> keys(count * KEY_SIZE, 0x5a);
+    AES kek(kekBytes.data(), kekBytes.size());
+    for (size_t i = 0; i < count; i++) {
+        kek.wrapKey(keys.data() + i * KEY_SIZE, KEY_SIZE, wrapped.data() + i * WRAPPED_SIZE);
+    }
+
+    std::vector<AESKeyWrapItem> items(count);
+    for (size_t i = 0; i < count; i++) {
+        items[i] = { wrapped.data() + i * WRAPPED_SIZE, WRAPPED_SIZE, keys.data() + i * KEY_SIZE, 0, AESBatchStatus::Ok };
+    }
+
+    // Alternating 24- and 40-byte wrapped keys
+    std::vector<unsigned char> mixedWrapped(count * WRAPPED_SIZE);
+    std::vector<AESKeyWrapItem> mixedItems(count);
+    size_t mixedBytes = 0;
+    for (size_t i = 0; i < count; i++) {
+        size_t keySize = i % 2 == 0 ? KEY_SIZE / 2 : KEY_SIZE;
+        unsigned char* slot = mixedWrapped.data() + i * WRAPPED_SIZE;
+        size_t wrappedSize = kek.wrapKey(keys.data() + i * KEY_SIZE, keySize, slot);
+        mixedItems[i] = { slot, wrappedSize, keys.data() + i * KEY_SIZE, 0, AESBatchStatus::Ok };
+        mixedBytes += wrappedSize;
+    }
+
+    std::printf("AES-256 KW unwrap, %zu keys of %zu bytes\n\n", count, KEY_SIZE);
+
+    const AESBackend backends[] = { AESBackend::TTable, AESBackend::AESNI, AESBackend::Bitsliced };
+    for (AESBackend backend : backends) {
+        if (!isAESBackendSupported(backend)) {
+            continue;
+        }
+        AES cipher(kekBytes.data(), kekBytes.size(), backend);
+
+        std::string label = std::string("Single unwrap (") + backendName(backend) + ")";
+        report(label.c_str(), count * WRAPPED_SIZE, secondsFor([&]() {
+            for (size_t i = 0; i < count; i++) {
+                cipher.unwrapKey(wrapped.data() + i * WRAPPED_SIZE, WRAPPED_SIZE, keys.data() + i * KEY_SIZE);
+            }
+        }));
+
+        label = std::string("Batch unwrap (") + backendName(backend) + ")";
+        report(label.c_str(), count * WRAPPED_SIZE, secondsFor([&]() {
+            unwrapAESKeyBatch(cipher, items.data(), items.size());
+        }));
+
+        label = std::string("Mixed batch unwrap (") + backendName(backend) + ")";
+        report(label.c_str(), mixedBytes, secondsFor([&]() {
+            unwrapAESKeyBatch(cipher, mixedItems.data(), mixedItems.size());
+        }));
+    }
+
+    return 0;
+}
@@ -0,0 +1,73 @@
+/*
+ * Copyright 2023-2024 The Gestalt Project Authors. All Rights Reserved.
+ *
+ * Licensed under the MIT License. See the file LICENSE for the full text.
+ */
+
+/*
+ * bench_aes_mac.cpp
+ *
+ * This file contains the message authentication benchmark. It measures AES-CMAC with each supported
+ * AES engine and GMAC on many small messages under one key, against HMAC-SHA256.
+ *
+ * Usage: bench_aes_mac [payload size in MB, default 16]
+ */
+
+#include <string>
+#include <vector>
+
+#include <gestalt/aes.h>
+#include <gestalt/hmac_sha2.h>
+#include "utils.h"
+#include "bench_utils.h"
+
+static const char* KEY = "000102030405060708090a0b0c0d0e0f";
+static const char* IV = "cafebabefacedbaddecaf888";
+static const size_t MESSAGE_SIZE = 64;
+
+int main(int argc, char* argv[]) {
+    size_t megabytes = payloadMegabytes(argc, argv, 16);
+    const size_t count = megabytes * 1024 * 1024 / MESSAGE_SIZE;
+    const size_t length = count * MESSAGE_SIZE;
+
+    std::vector<unsigned char> key = hexStringToBytesVec(KEY);
+    std::vector<unsigned char> iv = hexStringToBytesVec(IV);
+    std::vector<unsigned char> data(length, 0x5a);
+    unsigned char tag[AES_BLOCK_SIZE];
+
+    std::printf("AES-128 MACs, %zu byte messages, %zu MB payload\n\n", MESSAGE_SIZE, megabytes);
+
+    const AESBackend backends[] = { AESBackend::Reference, AESBackend::TTable, AESBackend::AESNI, AESBackend::Bitsliced };
+    for (AESBackend backend : backends) {
+        if (!isAESBackendSupported(backend)) {
+            continue;
+        }
+        AESCMAC cmac(key.data(), key.size(), backend);
+        std::string label = std::string("CMAC (") + backendName(backend) + ")";
+
+        report(label.c_str(), length, secondsFor([&]() {
+            for (size_t i = 0; i < count; i++) {
+                cmac.update(data.data() + i * MESSAGE_SIZE, MESSAGE_SIZE);
+                cmac.finish(tag);
+            }
+        }));
+    }
+
+    AESGMAC gmac(key.data(), key.size());
+    report("GMAC", length, secondsFor([&]() {
+        for (size_t i = 0; i < count; i++) {
+            gmac.start(iv.data(), iv.size());
+            gmac.update(data.data() + i * MESSAGE_SIZE, MESSAGE_SIZE);
+            gmac.finish(tag);
+        }
+    }));
+
+    std::string message(MESSAGE_SIZE, 0x5a);
+    report("HMAC-SHA256", length, secondsFor([&]() {
+        for (size_t i = 0; i < count; i++) {
+            hmacSHA256(KEY, message);
+        }
+    }));
+
+    return 0;
+}
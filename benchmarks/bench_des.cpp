@@ -0,0 +1,111 @@
+/*
+ * Copyright 2023-2024 The Gestalt Project Authors. All Rights Reserved.
+ *
+ * Licensed under the MIT License. See the file LICENSE for the full text.
+ */
+
+/*
+ * bench_des.cpp
+ *
+ * This file contains the DES and 3DES throughput benchmark. It measures the block engine directly, so
+ * the figures exclude the hex and padding conversions of the string API.
+ *
+ * Usage: bench_des [payload size in MB, default 4]
+ */
+
+#include <string>
+#include <vector>
+
+#include <gestalt/des.h>
+#include "des/desCore.h"
+#include "des/desBitsliced.h"
+#include "bench_utils.h"
+
+static const char* KEY1 = "133457799BBCDFF1";
+static const char* KEY2 = "0E329232EA6D0D73";
+static const char* KEY3 = "752878397493CB70";
+
+int main(int argc, char* argv[]) {
+    size_t megabytes = payloadMegabytes(argc, argv, 4);
+    const size_t numBlocks = megabytes * 1024 * 1024 / 8;
+    const size_t length = numBlocks * 8;
+
+    std::vector<uint64_t> blocks(numBlocks, 0x0123456789abcdefULL);
+    DES des1(KEY1);
+    DES des2(KEY2);
+    DES des3(KEY3);
+
+    std::printf("DES block engine, %zu MB payload\n\n", megabytes);
+
+    report("DES encrypt", length, secondsFor([&]() {
+        for (uint64_t& block : blocks) {
+            block = des1.encryptBlock(block);
+        }
+    }));
+
+    report("DES decrypt", length, secondsFor([&]() {
+        for (uint64_t& block : blocks) {
+            block = des1.decryptBlock(block);
+        }
+    }));
+
+    report("3DES encrypt (EDE)", length, secondsFor([&]() {
+        for (uint64_t& block : blocks) {
+            block = des3.encryptBlock(des2.decryptBlock(des1.encryptBlock(block)));
+        }
+    }));
+
+    TripleDES tdes(des1, des2, des3);
+    report("3DES encrypt (fused EDE)", length, secondsFor([&]() {
+        for (uint64_t& block : blocks) {
+            block = tdes.encryptBlock(block);
+        }
+    }));
+
+    DESBitsliced bitsliced1(des1);
+    DESBitsliced bitsliced2(des2);
+    DESBitsliced bitsliced3(des3);
+    std::string bitslicedName = std::string("bitsliced, ")
+        + (desBitslicedAVX2Supported() ? "AVX2" : "64-bit");
+
+    report(("DES encrypt (" + bitslicedName + ")").c_str(), length, secondsFor([&]() {
+        bitsliced1.encryptBlocks(blocks.data(), blocks.size());
+    }));
+
+    report(("3DES encrypt (" + bitslicedName + ")").c_str(), length, secondsFor([&]() {
+        DESBitsliced::encryptBlocksEDE(bitsliced1, bitsliced2, bitsliced3, blocks.data(), blocks.size());
+    }));
+
+    // The mode functions on byte buffers, including padding and the block conversions
+    std::vector<uint8_t> message(length, 0x61);
+    std::vector<uint8_t> output(desPaddedLength(length));
+    std::vector<uint8_t> decrypted(output.size());
+    const uint8_t key1[8] = { 0x13, 0x34, 0x57, 0x79, 0x9B, 0xBC, 0xDF, 0xF1 };
+    const uint8_t key2[8] = { 0x0E, 0x32, 0x92, 0x32, 0xEA, 0x6D, 0x0D, 0x73 };
+    const uint8_t iv[8] = { 0x01, 0x02, 0x03, 0x04, 0x05, 0x06, 0x07, 0x08 };
+
+    report("3DES-ECB encrypt (binary API)", length, secondsFor([&]() {
+        encrypt3DESECB(message.data(), length, key1, key2, key1, output.data());
+    }));
+
+    report("3DES-CBC encrypt (binary API)", length, secondsFor([&]() {
+        encrypt3DESCBC(message.data(), length, iv, key1, key2, key1, output.data());
+    }));
+
+    report("3DES-CBC decrypt (binary API)", length, secondsFor([&]() {
+        decrypt3DESCBC(output.data(), output.size(), iv, key1, key2, key1, decrypted.data());
+    }));
+
+    // Key setup, as paid on every 3DES rekey
+    const size_t numKeys = 100000;
+    uint64_t checksum = 0;
+    double seconds = secondsFor([&]() {
+        for (size_t i = 0; i < numKeys; i++) {
+            DES des(static_cast<uint64_t>(0x133457799BBCDFF1ULL + i));
+            checksum ^= des.encryptBlock(i);
+        }
+    });
+    std::printf("%-34s %10.1f keys/ms\n", "DES key setup", static_cast<double>(numKeys) / seconds / 1000.0);
+
+    return (blocks[0] ^ checksum) == 0 ? 1 : 0;
+}
@@ -0,0 +1,146 @@
+/*
+ * Copyright 2023-2024 The Gestalt Project Authors. All Rights Reserved.
+ *
+ * Licensed under the MIT License. See the file LICENSE for the full text.
+ */
+
+/*
+ * bench_sha2.cpp
+ *
+ * This file contains the SHA-2 throughput benchmark, hashing one large message through the streaming
+ * contexts in pieces of 64 KB, followed by the SHA-1 and SHA-256 compression backends on the same data,
+ * the multi-buffer lane backends, and batches of 64 byte messages hashed one by one and with the batch
+ * functions.
+ *
+ * Usage: bench_sha2 [payload size in MB, default 16]
+ */
+
+#include <vector>
+
+#include <gestalt/sha2.h>
+#include "sha1/sha1Core.h"
+#include "sha2/sha2Core.h"
+#include "bench_utils.h"
+
+static const size_t PIECE_SIZE = 64 * 1024;
+
+template <typename Context>
+static void benchmark(const char* name, const std::vector<uint8_t>& message, uint8_t* digest) {
+    report(name, message.size(), secondsFor([&]() {
+        Context context;
+        for (size_t i = 0; i < message.size(); i += PIECE_SIZE) {
+            size_t length = message.size() - i < PIECE_SIZE ? message.size() - i : PIECE_SIZE;
+            context.update(message.data() + i, length);
+        }
+        context.final(digest);
+    }));
+}
+
+template <size_t StateWords>
+static void benchmarkCompress(const char* name, void (*compress)(uint32_t*, const uint8_t*, size_t),
+                              const std::vector<uint8_t>& message, uint8_t* digest) {
+    uint32_t state[StateWords] = {};
+    report(name, message.size(), secondsFor([&]() {
+        compress(state, message.data(), message.size() / 64);
+    }));
+    digest[0] ^= static_cast<uint8_t>(state[0]);
+}
+
+static const char* laneBackendName(SHA2LaneBackend backend) {
+    switch (backend) {
+    case SHA2LaneBackend::SSE41: return "SSE4.1";
+    case SHA2LaneBackend::AVX2: return "AVX2";
+    case SHA2LaneBackend::AVX512: return "AVX-512";
+    default: return "scalar";
+    }
+}
+
+/*
+ * Splits the message into as many equal streams as the backend has lanes and compresses them together.
+ */
+template <typename Word>
+static void benchmarkLanes(const char* algorithm, SHA2LaneBackend backend, size_t numLanes,
+                           void (*compressLanes)(SHA2LaneBackend, Word* const*, const uint8_t* const*, size_t, size_t),
+                           const std::vector<uint8_t>& message, uint8_t* digest) {
+    const size_t blockSize = 16 * sizeof(Word);
+    const size_t blocksPerLane = message.size() / blockSize / numLanes;
+
+    Word states[SHA2_MAX_LANES][8] = {};
+    Word* statePointers[SHA2_MAX_LANES];
+    const uint8_t* blocks[SHA2_MAX_LANES];
+    for (size_t lane = 0; lane < numLanes; lane++) {
+        statePointers[lane] = states[lane];
+        blocks[lane] = message.data() + lane * blocksPerLane * blockSize;
+    }
+
+    char name[64];
+    std::snprintf(name, sizeof(name), "%s %s x%zu", algorithm, laneBackendName(backend), numLanes);
+    report(name, blocksPerLane * numLanes * blockSize, secondsFor([&]() {
+        compressLanes(backend, statePointers, blocks, numLanes, blocksPerLane);
+    }));
+    digest[0] ^= static_cast<uint8_t>(states[0][0]);
+}
+
+template <typename Context>
+static void benchmarkSmallMessages(const char* name, void (*hashBatch)(const SHA2BatchItem*, size_t),
+                                   const std::vector<uint8_t>& message, std::vector<uint8_t>& digests) {
+    const size_t messageSize = 64;
+    const size_t numMessages = message.size() / messageSize;
+    char label[64];
+
+    std::snprintf(label, sizeof(label), "%s one by one", name);
+    report(label, numMessages * messageSize, secondsFor([&]() {
+        Context context;
+        for (size_t i = 0; i < numMessages; i++) {
+            context.update(message.data() + i * messageSize, messageSize);
+            context.final(digests.data() + i * Context::DIGEST_SIZE);
+        }
+    }));
+
+    std::vector<SHA2BatchItem> items(numMessages);
+    for (size_t i = 0; i < numMessages; i++) {
+        items[i] = { message.data() + i * messageSize, messageSize, digests.data() + i * Context::DIGEST_SIZE };
+    }
+    std::snprintf(label, sizeof(label), "%s batch", name);
+    report(label, numMessages * messageSize, secondsFor([&]() {
+        hashBatch(items.data(), items.size());
+    }));
+}
+
+int main(int argc, char* argv[]) {
+    size_t megabytes = payloadMegabytes(argc, argv, 16);
+    std::vector<uint8_t> message(megabytes * 1024 * 1024, 0x61);
+    uint8_t digest[64];
+
+    std::printf("SHA-2, %zu MB payload\n\n", megabytes);
+
+    benchmark<SHA256>("SHA-256", message, digest);
+    benchmark<SHA512>("SHA-512", message, digest);
+
+    std::printf("\nCompression backends\n\n");
+
+    benchmarkCompress<5>("SHA-1 scalar", sha1CompressScalar, message, digest);
+    if (sha1NISupported())
+        benchmarkCompress<5>("SHA-1 SHA-NI", sha1CompressNI, message, digest);
+    benchmarkCompress<8>("SHA-256 scalar", sha256CompressScalar, message, digest);
+    if (sha256NISupported())
+        benchmarkCompress<8>("SHA-256 SHA-NI", sha256CompressNI, message, digest);
+
+    std::printf("\nMulti-buffer lanes\n\n");
+
+    for (SHA2LaneBackend backend : { SHA2LaneBackend::SSE41, SHA2LaneBackend::AVX2, SHA2LaneBackend::AVX512 }) {
+        if (!isSHA2LaneBackendSupported(backend))
+            continue;
+        benchmarkLanes<uint32_t>("SHA-256", backend, sha256LaneCount(backend), sha256CompressLanes, message, digest);
+        benchmarkLanes<uint64_t>("SHA-512", backend, sha512LaneCount(backend), sha512CompressLanes, message, digest);
+    }
+
+    std::printf("\n64 byte messages\n\n");
+
+    std::vector<uint8_t> digests(message.size());
+    benchmarkSmallMessages<SHA256>("SHA-256", hashSHA256Batch, message, digests);
+    benchmarkSmallMessages<SHA512>("SHA-512", hashSHA512Batch, message, digests);
+    digest[0] ^= digests[0];
+
+    return digest[0] == 0 && digest[1] == 0 ? 1 : 0;
+}
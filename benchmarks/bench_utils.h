@@ -0,0 +1,49 @@
+/*
+ * Copyright 2023-2024 The Gestalt Project Authors. All Rights Reserved.
+ *
+ * Licensed under the MIT License. See the file LICENSE for the full text.
+ */
+
+/*
+ * bench_utils.h
+ *
+ * This file contains the timing and reporting helpers shared by the benchmarks.
+ */
+
+#pragma once
+
+#include <chrono>
+#include <cstdio>
+#include <cstdlib>
+
+#include "aes/aesCore.h"
+
+template <typename Function>
+double secondsFor(Function function) {
+    std::chrono::steady_clock::time_point start = std::chrono::steady_clock::now();
+    function();
+    std::chrono::duration<double> elapsed = std::chrono::steady_clock::now() - start;
+    return elapsed.count();
+}
+
+inline void report(const char* name, size_t bytes, double seconds) {
+    std::printf("%-34s %10.1f MB/s\n", name, static_cast<double>(bytes) / (1024.0 * 1024.0) / seconds);
+}
+
+/*
+ * Reads the payload size in MB from the first command line argument.
+ */
+inline size_t payloadMegabytes(int argc, char* argv[], size_t defaultMegabytes) {
+    size_t megabytes = argc > 1 ? std::strtoul(argv[1], nullptr, 10) : defaultMegabytes;
+    return megabytes > 0 ? megabytes : 1;
+}
+
+inline const char* backendName(AESBackend backend) {
+    switch (backend) {
+    case AESBackend::Reference: return "Reference";
+    case AESBackend::TTable: return "TTable";
+    case AESBackend::AESNI: return "AESNI";
+    case AESBackend::Bitsliced: return "Bitsliced";
+    default: return "Auto";
+    }
+}
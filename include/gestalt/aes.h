@@ -12,8 +12,489 @@
 
 #pragma once
 
+#include <string>
+#include <vector>
+#include <cstdint>
+#include <cstddef>
+#include <memory>
+
 std::string encryptAESECB(const std::string& msg, std::string key);
 std::string decryptAESECB(const std::string& hexMsg, std::string key);
 
 std::string encryptAESCBC(const std::string& msg, std::string iv, std::string key);
-std::string decryptAESCBC(const std::string& hexMsg, std::string iv, std::string key);
\ No newline at end of file
+std::string decryptAESCBC(const std::string& hexMsg, std::string iv, std::string key);
+
+/*
+ * Binary interface
+ *
+ * These overloads take raw key, IV and message bytes and produce raw bytes, so no hex encoding or
+ * decoding is performed. The pointer variants write into a caller-provided buffer and allocate nothing:
+ * encryption needs aesPaddedLength(msgLen) bytes of output space, decryption needs ciphertextLen bytes.
+ * The output buffer may alias the input buffer for in-place operation.
+ */
+inline size_t aesPaddedLength(size_t msgLen) { return msgLen + 16 - (msgLen % 16); }
+
+size_t encryptAESECB(const uint8_t* msg, size_t msgLen, const uint8_t* key, size_t keyLen, uint8_t* out);
+size_t decryptAESECB(const uint8_t* ciphertext, size_t ciphertextLen, const uint8_t* key, size_t keyLen, uint8_t* out);
+
+size_t encryptAESCBC(
+    const uint8_t* msg, size_t msgLen, const uint8_t iv[16], const uint8_t* key, size_t keyLen, uint8_t* out
+);
+size_t decryptAESCBC(
+    const uint8_t* ciphertext, size_t ciphertextLen, const uint8_t iv[16], const uint8_t* key, size_t keyLen, uint8_t* out
+);
+
+std::vector<uint8_t> encryptAESECB(const std::vector<uint8_t>& msg, const std::vector<uint8_t>& key);
+std::vector<uint8_t> decryptAESECB(const std::vector<uint8_t>& ciphertext, const std::vector<uint8_t>& key);
+
+std::vector<uint8_t> encryptAESCBC(
+    const std::vector<uint8_t>& msg, const std::vector<uint8_t>& iv, const std::vector<uint8_t>& key
+);
+std::vector<uint8_t> decryptAESCBC(
+    const std::vector<uint8_t>& ciphertext, const std::vector<uint8_t>& iv, const std::vector<uint8_t>& key
+);
+
+/*
+ * AES-CTR (NIST SP 800-38A)
+ *
+ * Encryption and decryption are the same operation and need no padding, so the output is always
+ * length bytes and may alias the input. The 16 byte counter block is incremented as a 128-bit
+ * big-endian integer. offset is the keystream byte position of the first input byte, which allows
+ * decrypting any part of a CTR ciphertext without processing the bytes before it.
+ */
+void encryptAESCTR(
+    const uint8_t* in, size_t length, const uint8_t counter[16], const uint8_t* key, size_t keyLen, uint8_t* out,
+    uint64_t offset = 0
+);
+void decryptAESCTR(
+    const uint8_t* in, size_t length, const uint8_t counter[16], const uint8_t* key, size_t keyLen, uint8_t* out,
+    uint64_t offset = 0
+);
+
+std::vector<uint8_t> encryptAESCTR(
+    const std::vector<uint8_t>& msg, const std::vector<uint8_t>& counter, const std::vector<uint8_t>& key
+);
+std::vector<uint8_t> decryptAESCTR(
+    const std::vector<uint8_t>& ciphertext, const std::vector<uint8_t>& counter, const std::vector<uint8_t>& key
+);
+
+/*
+ * AES-GCM (NIST SP 800-38D)
+ *
+ * Authenticated encryption: the ciphertext has the length of the plaintext and the tag authenticates
+ * both the ciphertext and the additional authenticated data (AAD). A 12 byte IV is recommended, and an
+ * IV must never be reused under the same key. Tags may be 4, 8, or 12 to 16 bytes, 16 by default.
+ * The output buffer may alias the input buffer.
+ *
+ * decryptAESGCM checks the tag and throws std::runtime_error on a mismatch, after clearing the output.
+ */
+void encryptAESGCM(
+    const uint8_t* msg, size_t msgLen, const uint8_t* aad, size_t aadLen, const uint8_t* iv, size_t ivLen,
+    const uint8_t* key, size_t keyLen, uint8_t* out, uint8_t* tag, size_t tagLen = 16
+);
+void decryptAESGCM(
+    const uint8_t* ciphertext, size_t ciphertextLen, const uint8_t* aad, size_t aadLen, const uint8_t* iv, size_t ivLen,
+    const uint8_t* key, size_t keyLen, const uint8_t* tag, size_t tagLen, uint8_t* out
+);
+
+// The vector overloads append a 16 byte tag to the ciphertext
+std::vector<uint8_t> encryptAESGCM(
+    const std::vector<uint8_t>& msg, const std::vector<uint8_t>& iv, const std::vector<uint8_t>& key,
+    const std::vector<uint8_t>& aad = std::vector<uint8_t>()
+);
+std::vector<uint8_t> decryptAESGCM(
+    const std::vector<uint8_t>& ciphertext, const std::vector<uint8_t>& iv, const std::vector<uint8_t>& key,
+    const std::vector<uint8_t>& aad = std::vector<uint8_t>()
+);
+
+class GCM;
+
+/*
+ * Streaming AES-GCM.
+ *
+ * The key is expanded once, after which any number of messages can be processed, each as start(iv),
+ * any number of updateAAD calls, any number of encryptUpdate (or decryptUpdate) calls of any length,
+ * and finally finish (or verify). Decrypted data must not be used until verify returns true.
+ */
+class AESGCM {
+private:
+    std::unique_ptr<GCM> gcm;
+
+public:
+    AESGCM(const uint8_t* key, size_t keyLen);
+    ~AESGCM();
+
+    AESGCM(const AESGCM&) = delete;
+    AESGCM& operator=(const AESGCM&) = delete;
+
+    void start(const uint8_t* iv, size_t ivLen);
+    void updateAAD(const uint8_t* aad, size_t aadLen);
+    void encryptUpdate(const uint8_t* in, size_t length, uint8_t* out);
+    void decryptUpdate(const uint8_t* in, size_t length, uint8_t* out);
+    void finish(uint8_t* tag, size_t tagLen = 16);
+    bool verify(const uint8_t* tag, size_t tagLen = 16);
+};
+
+const size_t AES_BLOCK_SIZE = 16;
+const size_t AES_MAX_ROUNDS = 14;
+const size_t AES_MULTI_BUFFER_LANES = 8; // Independent streams interleaved by the multi-buffer engine
+
+/*
+ * Selects the round engine used by an AES instance.
+ *
+ * Auto:      Picks the fastest engine the executing CPU supports (AESNI, otherwise TTable), unless the
+ *            library was configured with GESTALT_AES_BACKEND to force a specific engine.
+ * Reference: The byte-oriented FIPS 197 implementation, one pass per round step.
+ * TTable:    Merges SubBytes, ShiftRows, MixColumns and AddRoundKey into 32-bit T-table lookups.
+ *            The lookups depend on the key and the data and are exposed to cache-timing attacks.
+ * AESNI:     Uses the x86 AES-NI instructions (AESENC/AESDEC/AESKEYGENASSIST).
+ * Bitsliced: Evaluates the cipher as a boolean circuit on 8 blocks at once, with no table lookups or
+ *            data dependent branches, so its timing does not depend on the key or the data. The
+ *            constant-time choice for hosts without AES instructions, selected explicitly or with
+ *            GESTALT_AES_BACKEND=Bitsliced. Only ECB, CTR and CBC decryption fill its eight lanes;
+ *            single-block and chained work (CBC encryption, CMAC, key wrap) runs no faster than
+ *            on the byte engine.
+ */
+enum class AESBackend {
+    Auto,
+    Reference,
+    TTable,
+    AESNI,
+    Bitsliced
+};
+
+bool isAESBackendSupported(AESBackend backend);
+
+/*
+ * Keyed AES context.
+ *
+ * Construction expands the key once into the encryption schedule and, for the table and AES-NI
+ * engines, the equivalent inverse cipher schedule used for decryption. Both are held inline, so an
+ * instance owns no heap memory and copying it is a plain copy of the schedules. A context can be
+ * kept per key and reused for any number of messages; the const operations do not modify it and may
+ * be called from several threads at once.
+ *
+ * The mode operations take the same arguments as the free functions above without the key. The
+ * block level operations work in place on whole blocks and leave padding to the caller.
+ */
+class AES {
+private:
+    unsigned int Nw = 0; // Number of words in a state
+    unsigned int Nr = 0; // Number of rounds
+
+    AESBackend backend;
+
+    unsigned char roundKey[AES_BLOCK_SIZE * (AES_MAX_ROUNDS + 1)]; // Expanded Key
+
+    uint32_t encRoundKeyWords[4 * (AES_MAX_ROUNDS + 1)]; // Expanded key as big-endian column words
+    uint32_t decRoundKeyWords[4 * (AES_MAX_ROUNDS + 1)]; // Equivalent inverse cipher key schedule
+
+    unsigned char decRoundKey[AES_BLOCK_SIZE * (AES_MAX_ROUNDS + 1)]; // AES-NI decryption key schedule
+
+    uint64_t bitslicedRoundKey[8 * (AES_MAX_ROUNDS + 1)]; // Bitsliced key schedule, eight words per round
+
+    void subByte(unsigned char* state) const;
+    void shiftRows(unsigned char* state) const;
+    void mixColumns(unsigned char* state) const;
+    void addRoundKey(unsigned char* state, const unsigned char* roundKey) const;
+
+    void invSubByte(unsigned char* state) const;
+    void invShiftRows(unsigned char* state) const;
+    void invMixColumns(unsigned char* state) const;
+
+    void setKeySize(size_t keyBits);
+    void initializeKeySchedule(const unsigned char* key);
+
+    void keyExpansion(const std::string& key, unsigned char* roundKey);
+    void keyExpansion(const unsigned char* key, unsigned char* roundKey);
+    void rotWord(unsigned char temp[4]);
+    void subWord(unsigned char temp[4]);
+    void rcon(unsigned char temp[4], int round);
+
+    void expandRoundKeyWords();
+    void keyExpansionAESNI(const unsigned char* key);
+    void keyExpansionBitsliced(const unsigned char* key);
+
+    void encryptBlockReference(unsigned char* state) const;
+    void decryptBlockReference(unsigned char* state) const;
+    void encryptBlockTTable(unsigned char* state) const;
+    void decryptBlockTTable(unsigned char* state) const;
+    void encryptBlocksAESNI(unsigned char* data, size_t numBlocks) const;
+    void decryptBlocksAESNI(unsigned char* data, size_t numBlocks) const;
+    void encryptCBCAESNI(unsigned char* data, size_t numBlocks, unsigned char iv[AES_BLOCK_SIZE]) const;
+    void decryptCBCAESNI(unsigned char* data, size_t numBlocks, unsigned char iv[AES_BLOCK_SIZE]) const;
+    void encryptCTRAESNI(const unsigned char* in, unsigned char* out, size_t numBlocks, uint64_t& high, uint64_t& low) const;
+    void encryptBlocksBitsliced(unsigned char* data, size_t numBlocks) const;
+    void decryptBlocksBitsliced(unsigned char* data, size_t numBlocks) const;
+    static void encryptCBCLanesAESNI(
+        const AES* const* ciphers, unsigned char* const* data, unsigned char* const* ivs, size_t numLanes, size_t numBlocks
+    );
+
+    void generateKeystream(unsigned char* keystream, size_t numBlocks, uint64_t& high, uint64_t& low) const;
+
+    friend class AES_Functions;
+public:
+    explicit AES(const std::string& key, AESBackend backend = AESBackend::Auto);
+    AES(const unsigned char* key, size_t keyLen, AESBackend backend = AESBackend::Auto);
+
+    // Mode operations
+    size_t encryptECB(const uint8_t* msg, size_t msgLen, uint8_t* out) const;
+    size_t decryptECB(const uint8_t* ciphertext, size_t ciphertextLen, uint8_t* out) const;
+
+    size_t encryptCBC(const uint8_t* msg, size_t msgLen, const uint8_t iv[16], uint8_t* out) const;
+    size_t decryptCBC(const uint8_t* ciphertext, size_t ciphertextLen, const uint8_t iv[16], uint8_t* out) const;
+
+    void encryptCTR(const uint8_t* in, size_t length, const uint8_t counter[16], uint8_t* out, uint64_t offset = 0) const;
+    void decryptCTR(const uint8_t* in, size_t length, const uint8_t counter[16], uint8_t* out, uint64_t offset = 0) const;
+
+    void encryptGCM(
+        const uint8_t* msg, size_t msgLen, const uint8_t* aad, size_t aadLen, const uint8_t* iv, size_t ivLen,
+        uint8_t* out, uint8_t* tag, size_t tagLen = 16
+    ) const;
+    void decryptGCM(
+        const uint8_t* ciphertext, size_t ciphertextLen, const uint8_t* aad, size_t aadLen, const uint8_t* iv, size_t ivLen,
+        const uint8_t* tag, size_t tagLen, uint8_t* out
+    ) const;
+
+    size_t wrapKey(const uint8_t* key, size_t keyLen, uint8_t* out) const;
+    size_t unwrapKey(const uint8_t* wrapped, size_t wrappedLen, uint8_t* out) const;
+    size_t wrapKeyPadded(const uint8_t* key, size_t keyLen, uint8_t* out) const;
+    size_t unwrapKeyPadded(const uint8_t* wrapped, size_t wrappedLen, uint8_t* out) const;
+
+    // Block level operations
+    void encryptBlock(unsigned char* state) const;
+    void decryptBlock(unsigned char* state) const;
+
+    void encryptBlocks(unsigned char* data, size_t numBlocks) const;
+    void decryptBlocks(unsigned char* data, size_t numBlocks) const;
+
+    void encryptBlocksCBC(unsigned char* data, size_t numBlocks, unsigned char iv[AES_BLOCK_SIZE]) const;
+    void decryptBlocksCBC(unsigned char* data, size_t numBlocks, unsigned char iv[AES_BLOCK_SIZE]) const;
+
+    void applyCTR(
+        const unsigned char* in, unsigned char* out, size_t length, const unsigned char counter[AES_BLOCK_SIZE], uint64_t offset = 0
+    ) const;
+
+    static void encryptBlocksCBCLanes(
+        const AES* const* ciphers, unsigned char* const* data, unsigned char* const* ivs, size_t numLanes, size_t numBlocks
+    );
+
+    AESBackend getBackend() const { return backend; }
+};
+
+/*
+ * Multi-buffer AES-CBC
+ *
+ * Encrypts or decrypts many independent messages, each under its own key and IV, in one call. CBC
+ * encryption is serial within a message, so the batch keeps up to AES_MULTI_BUFFER_LANES messages in
+ * flight and interleaves their rounds, which fills the AES-NI pipeline the way a single stream cannot.
+ *
+ * Every item is processed independently: a bad item gets an error status and the rest of the batch
+ * still runs. Buffers follow the single-message rules: encryption needs aesPaddedLength(inLen) bytes
+ * of output, decryption needs inLen bytes, and out may alias in.
+ */
+enum class AESBatchStatus {
+    Ok,
+    InvalidKeySize,      // The key is not 16, 24, or 32 bytes
+    InvalidLength,       // The ciphertext or wrapped key has a length the mode does not allow
+    InvalidPadding,      // The decrypted padding is malformed
+    IntegrityCheckFailed // An unwrapped key does not carry the expected integrity check value
+};
+
+struct AESBatchItem {
+    const uint8_t* key;
+    size_t keyLen;
+    const uint8_t* iv; // 16 bytes
+    const uint8_t* in;
+    size_t inLen;
+    uint8_t* out;
+    size_t outLen;         // Set by the batch call: bytes written, or plaintext length after unpadding
+    AESBatchStatus status; // Set by the batch call
+};
+
+size_t encryptAESCBCBatch(AESBatchItem* items, size_t count);
+size_t decryptAESCBCBatch(AESBatchItem* items, size_t count);
+
+/*
+ * XTS-AES (IEEE 1619, NIST SP 800-38E)
+ *
+ * Length-preserving encryption for block storage. The key is two AES keys of equal size, the data key
+ * followed by the tweak key: 32 bytes for XTS-AES-128, 64 bytes for XTS-AES-256. Every data unit (a
+ * sector or page) is encrypted independently under its data unit number, so one unit can be read or
+ * rewritten without touching the others. A data unit must be at least 16 bytes; units that are not a
+ * multiple of 16 bytes use ciphertext stealing. The output buffer may alias the input buffer.
+ */
+class AESXTS {
+private:
+    AES dataCipher;
+    AES tweakCipher;
+
+    void processDataUnit(const uint8_t* in, size_t length, uint64_t dataUnit, uint8_t* out, bool encrypting) const;
+    void processDataUnits(
+        const uint8_t* in, size_t length, size_t dataUnitSize, uint64_t firstDataUnit, uint8_t* out, bool encrypting
+    ) const;
+
+public:
+    AESXTS(const uint8_t* key, size_t keyLen);
+
+    void encryptDataUnit(const uint8_t* in, size_t length, uint64_t dataUnit, uint8_t* out) const;
+    void decryptDataUnit(const uint8_t* in, size_t length, uint64_t dataUnit, uint8_t* out) const;
+
+    // Consecutive units of dataUnitSize bytes numbered from firstDataUnit, processed on several threads
+    void encryptDataUnits(const uint8_t* in, size_t length, size_t dataUnitSize, uint64_t firstDataUnit, uint8_t* out) const;
+    void decryptDataUnits(const uint8_t* in, size_t length, size_t dataUnitSize, uint64_t firstDataUnit, uint8_t* out) const;
+};
+
+void encryptAESXTS(
+    const uint8_t* in, size_t length, const uint8_t* key, size_t keyLen, size_t dataUnitSize, uint64_t firstDataUnit,
+    uint8_t* out
+);
+void decryptAESXTS(
+    const uint8_t* in, size_t length, const uint8_t* key, size_t keyLen, size_t dataUnitSize, uint64_t firstDataUnit,
+    uint8_t* out
+);
+
+/*
+ * Streaming AES-CBC
+ *
+ * Encrypts or decrypts a message of any length delivered in pieces, using constant memory: only the
+ * chaining block and an incomplete trailing block are kept between calls. update accepts any number
+ * of bytes and writes the blocks that are complete, so it needs room for length + 15 bytes of output
+ * and returns the number of bytes written. finalize writes the rest. PKCS7 padding is only added or
+ * removed by finalize, which is why the decryptor holds back the last complete block until then.
+ * The output of a call must not overlap its input. After finalize, reset starts the next message
+ * under the same key.
+ */
+class AESCBCEncryptor {
+private:
+    AES cipher;
+    uint8_t chain[AES_BLOCK_SIZE];
+    uint8_t pending[AES_BLOCK_SIZE];
+    size_t pendingLen = 0;
+    bool finalized = false;
+
+public:
+    AESCBCEncryptor(const uint8_t* key, size_t keyLen, const uint8_t iv[16], AESBackend backend = AESBackend::Auto);
+    AESCBCEncryptor(const AES& cipher, const uint8_t iv[16]);
+
+    void reset(const uint8_t iv[16]);
+    size_t update(const uint8_t* in, size_t length, uint8_t* out);
+    size_t finalize(uint8_t* out); // Writes the final padded block, always 16 bytes
+};
+
+class AESCBCDecryptor {
+private:
+    AES cipher;
+    uint8_t chain[AES_BLOCK_SIZE];
+    uint8_t pending[AES_BLOCK_SIZE]; // Incomplete block, or the held back last complete block
+    size_t pendingLen = 0;
+    bool finalized = false;
+
+public:
+    AESCBCDecryptor(const uint8_t* key, size_t keyLen, const uint8_t iv[16], AESBackend backend = AESBackend::Auto);
+    AESCBCDecryptor(const AES& cipher, const uint8_t iv[16]);
+
+    void reset(const uint8_t iv[16]);
+    size_t update(const uint8_t* in, size_t length, uint8_t* out);
+    size_t finalize(uint8_t* out); // Writes the unpadded rest of the message, at most 15 bytes
+};
+
+/*
+ * AES-CMAC (NIST SP 800-38B, RFC 4493)
+ *
+ * A message authentication code computed with the block cipher alone, for data that is already
+ * protected with AES. The key schedule and the two CMAC subkeys are derived once at construction, after
+ * which any number of messages can be authenticated, each as any number of update calls followed by
+ * finish (or verify), which also prepare the object for the next message. Tags may be truncated to
+ * between 8 and 16 bytes.
+ */
+class AESCMAC {
+private:
+    AES cipher;
+    uint8_t k1[AES_BLOCK_SIZE]; // Subkey for a final complete block
+    uint8_t k2[AES_BLOCK_SIZE]; // Subkey for a final padded block
+    uint8_t state[AES_BLOCK_SIZE];
+    uint8_t pending[AES_BLOCK_SIZE]; // Incomplete block, or the held back last complete block
+    size_t pendingLen = 0;
+
+    void deriveSubkeys();
+
+public:
+    AESCMAC(const uint8_t* key, size_t keyLen, AESBackend backend = AESBackend::Auto);
+    explicit AESCMAC(const AES& cipher);
+
+    void reset();
+    void update(const uint8_t* data, size_t length);
+    void finish(uint8_t* tag, size_t tagLen = 16);
+    bool verify(const uint8_t* tag, size_t tagLen = 16);
+};
+
+void cmacAES(const uint8_t* msg, size_t msgLen, const uint8_t* key, size_t keyLen, uint8_t* tag, size_t tagLen = 16);
+bool verifyCMACAES(const uint8_t* msg, size_t msgLen, const uint8_t* key, size_t keyLen, const uint8_t* tag, size_t tagLen = 16);
+
+/*
+ * GMAC (NIST SP 800-38D)
+ *
+ * GCM authentication without encryption: the tag over data passed as additional authenticated data
+ * only. Every message needs a unique IV under a key, as with GCM. A message is processed as start(iv),
+ * any number of update calls and finally finish (or verify). Tags may be 4, 8, or 12 to 16 bytes.
+ */
+class AESGMAC {
+private:
+    std::unique_ptr<GCM> gcm;
+
+public:
+    AESGMAC(const uint8_t* key, size_t keyLen);
+    explicit AESGMAC(const AES& cipher);
+    ~AESGMAC();
+
+    AESGMAC(const AESGMAC&) = delete;
+    AESGMAC& operator=(const AESGMAC&) = delete;
+
+    void start(const uint8_t* iv, size_t ivLen);
+    void update(const uint8_t* data, size_t length);
+    void finish(uint8_t* tag, size_t tagLen = 16);
+    bool verify(const uint8_t* tag, size_t tagLen = 16);
+};
+
+void gmacAES(
+    const uint8_t* msg, size_t msgLen, const uint8_t* iv, size_t ivLen, const uint8_t* key, size_t keyLen,
+    uint8_t* tag, size_t tagLen = 16
+);
+bool verifyGMACAES(
+    const uint8_t* msg, size_t msgLen, const uint8_t* iv, size_t ivLen, const uint8_t* key, size_t keyLen,
+    const uint8_t* tag, size_t tagLen = 16
+);
+
+/*
+ * AES key wrap (RFC 3394, NIST SP 800-38F KW) and key wrap with padding (RFC 5649, KWP)
+ *
+ * Wraps key material under a key encryption key (KEK), the AES context. KW wraps keys that are a
+ * multiple of 8 bytes and at least 16 bytes long into keyLen + 8 bytes; KWP wraps keys of any
+ * non-zero length into aesKeyWrapPaddedLength(keyLen) bytes. Unwrapping needs wrappedLen - 8 bytes of
+ * output, checks the integrity value and throws std::runtime_error, with the output cleared, when it
+ * does not match.
+ *
+ * The batch functions unwrap many keys under one KEK, expanded once. Up to AES_MULTI_BUFFER_LANES
+ * wrapped keys of equal length, wherever they sit in the batch, are unwrapped in lockstep, so the AES
+ * engine always has a full set of independent blocks to work on. A bad item gets an error status and the rest of the batch still runs.
+ */
+inline size_t aesKeyWrapPaddedLength(size_t keyLen) {
+    return 8 + ((keyLen + 7) / 8) * 8;
+}
+
+struct AESKeyWrapItem {
+    const uint8_t* in; // Wrapped key
+    size_t inLen;
+    uint8_t* out;          // inLen - 8 bytes, may alias in
+    size_t outLen;         // Set by the batch call: length of the unwrapped key
+    AESBatchStatus status; // Set by the batch call
+};
+
+size_t unwrapAESKeyBatch(const AES& kek, AESKeyWrapItem* items, size_t count);
+size_t unwrapAESKeyPaddedBatch(const AES& kek, AESKeyWrapItem* items, size_t count);
+
+size_t wrapAESKey(const uint8_t* key, size_t keyLen, const uint8_t* kek, size_t kekLen, uint8_t* out);
+size_t unwrapAESKey(const uint8_t* wrapped, size_t wrappedLen, const uint8_t* kek, size_t kekLen, uint8_t* out);
+size_t wrapAESKeyPadded(const uint8_t* key, size_t keyLen, const uint8_t* kek, size_t kekLen, uint8_t* out);
+size_t unwrapAESKeyPadded(const uint8_t* wrapped, size_t wrappedLen, const uint8_t* kek, size_t kekLen, uint8_t* out);
@@ -12,6 +12,11 @@
 
 #pragma once
 
+#include <string>
+#include <vector>
+#include <cstdint>
+#include <cstddef>
+
 std::string encryptDESECB(const std::string& plaintext, const std::string& key);
 std::string decryptDESECB(const std::string& ciphertext, const std::string& key);
 std::string encrypt3DESECB(
@@ -42,4 +47,75 @@ std::string decrypt3DESCBC(
     const std::string& key1, 
     const std::string& key2, 
     const std::string& key3
-);
\ No newline at end of file
+);
+
+/*
+ * Binary interface
+ *
+ * These overloads take raw key, IV and message bytes and produce raw bytes, so no hex encoding or
+ * decoding is performed. Keys and IVs are 8 bytes. The pointer variants write into a caller-provided
+ * buffer and allocate nothing: encryption needs desPaddedLength(msgLen) bytes of output space,
+ * decryption needs ciphertextLen bytes. The output buffer may alias the input buffer for in-place
+ * operation.
+ */
+inline size_t desPaddedLength(size_t msgLen) { return msgLen + 8 - (msgLen % 8); }
+
+size_t encryptDESECB(const uint8_t* msg, size_t msgLen, const uint8_t key[8], uint8_t* out);
+size_t decryptDESECB(const uint8_t* ciphertext, size_t ciphertextLen, const uint8_t key[8], uint8_t* out);
+size_t encrypt3DESECB(
+    const uint8_t* msg, size_t msgLen, const uint8_t key1[8], const uint8_t key2[8], const uint8_t key3[8],
+    uint8_t* out
+);
+size_t decrypt3DESECB(
+    const uint8_t* ciphertext, size_t ciphertextLen, const uint8_t key1[8], const uint8_t key2[8],
+    const uint8_t key3[8], uint8_t* out
+);
+
+size_t encryptDESCBC(const uint8_t* msg, size_t msgLen, const uint8_t iv[8], const uint8_t key[8], uint8_t* out);
+size_t decryptDESCBC(
+    const uint8_t* ciphertext, size_t ciphertextLen, const uint8_t iv[8], const uint8_t key[8], uint8_t* out
+);
+size_t encrypt3DESCBC(
+    const uint8_t* msg, size_t msgLen, const uint8_t iv[8], const uint8_t key1[8], const uint8_t key2[8],
+    const uint8_t key3[8], uint8_t* out
+);
+size_t decrypt3DESCBC(
+    const uint8_t* ciphertext, size_t ciphertextLen, const uint8_t iv[8], const uint8_t key1[8],
+    const uint8_t key2[8], const uint8_t key3[8], uint8_t* out
+);
+
+std::vector<uint8_t> encryptDESECB(const std::vector<uint8_t>& msg, const std::vector<uint8_t>& key);
+std::vector<uint8_t> decryptDESECB(const std::vector<uint8_t>& ciphertext, const std::vector<uint8_t>& key);
+std::vector<uint8_t> encrypt3DESECB(
+    const std::vector<uint8_t>& msg,
+    const std::vector<uint8_t>& key1,
+    const std::vector<uint8_t>& key2,
+    const std::vector<uint8_t>& key3
+);
+std::vector<uint8_t> decrypt3DESECB(
+    const std::vector<uint8_t>& ciphertext,
+    const std::vector<uint8_t>& key1,
+    const std::vector<uint8_t>& key2,
+    const std::vector<uint8_t>& key3
+);
+
+std::vector<uint8_t> encryptDESCBC(
+    const std::vector<uint8_t>& msg, const std::vector<uint8_t>& iv, const std::vector<uint8_t>& key
+);
+std::vector<uint8_t> decryptDESCBC(
+    const std::vector<uint8_t>& ciphertext, const std::vector<uint8_t>& iv, const std::vector<uint8_t>& key
+);
+std::vector<uint8_t> encrypt3DESCBC(
+    const std::vector<uint8_t>& msg,
+    const std::vector<uint8_t>& iv,
+    const std::vector<uint8_t>& key1,
+    const std::vector<uint8_t>& key2,
+    const std::vector<uint8_t>& key3
+);
+std::vector<uint8_t> decrypt3DESCBC(
+    const std::vector<uint8_t>& ciphertext,
+    const std::vector<uint8_t>& iv,
+    const std::vector<uint8_t>& key1,
+    const std::vector<uint8_t>& key2,
+    const std::vector<uint8_t>& key3
+);
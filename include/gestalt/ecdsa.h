@@ -33,6 +33,8 @@ class ECDSA : public ECC {
 private:
 
     void prepareMessage(const std::string& messageHash, mpz_t& result);
+    void prepareDigest(const uint8_t* digest, size_t length, mpz_t& result);
+    void hashMessage(const std::string& message, HashAlgorithm hashAlg, mpz_t& result);
     bool isInvalidSignature(Signature S);
 
     Signature generateSignature(const mpz_t& e, mpz_t& k);
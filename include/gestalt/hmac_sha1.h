@@ -16,5 +16,5 @@
 #include "hmac/hmac.h"
 
 inline std::string hmacSHA1(const std::string& key, const std::string& input) {
-    return HMAC(SHA1).keyedHash(key, input, hashSHA1);
+    return HMAC(HASH_ALGORITHM::SHA1).keyedHash(key, input, digestSHA1);
 }
\ No newline at end of file
@@ -16,25 +16,25 @@
 #include "hmac/hmac.h"
 
 inline std::string hmacSHA224(const std::string& key, const std::string& input) {
-    return HMAC(SHA224).keyedHash(key, input, hashSHA224);
+    return HMAC(HASH_ALGORITHM::SHA224).keyedHash(key, input, digestSHA224);
 }
 
 inline std::string hmacSHA256(const std::string& key, const std::string& input) {
-    return HMAC(SHA256).keyedHash(key, input, hashSHA256);
+    return HMAC(HASH_ALGORITHM::SHA256).keyedHash(key, input, digestSHA256);
 }
 
 inline std::string hmacSHA384(const std::string& key, const std::string& input) {
-    return HMAC(SHA384).keyedHash(key, input, hashSHA384);
+    return HMAC(HASH_ALGORITHM::SHA384).keyedHash(key, input, digestSHA384);
 }
 
 inline std::string hmacSHA512(const std::string& key, const std::string& input) {
-    return HMAC(SHA512).keyedHash(key, input, hashSHA512);
+    return HMAC(HASH_ALGORITHM::SHA512).keyedHash(key, input, digestSHA512);
 }
 
 inline std::string hmacSHA512_224(const std::string& key, const std::string& input) {
-    return HMAC(SHA512_224).keyedHash(key, input, hashSHA512_224);
+    return HMAC(HASH_ALGORITHM::SHA512_224).keyedHash(key, input, digestSHA512_224);
 }
 
 inline std::string hmacSHA512_256(const std::string& key, const std::string& input) {
-    return HMAC(SHA512_256).keyedHash(key, input, hashSHA512_256);
+    return HMAC(HASH_ALGORITHM::SHA512_256).keyedHash(key, input, digestSHA512_256);
 }
\ No newline at end of file
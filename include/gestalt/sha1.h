@@ -13,5 +13,47 @@
 #pragma once
 
 #include <string>
+#include <cstdint>
+#include <cstddef>
 
-std::string hashSHA1(const std::string& in);
\ No newline at end of file
+/*
+ * hashSHA1 returns the digest in lowercase hex. digestSHA1 writes the raw SHA1::DIGEST_SIZE bytes
+ * to digest instead, for callers that go on to use the digest as bytes.
+ */
+std::string hashSHA1(const std::string& in);
+void digestSHA1(const void* in, size_t inLen, uint8_t* digest);
+
+/*
+ * Streaming SHA-1 (FIPS 180-4)
+ *
+ * Hashes a message delivered in any number of update calls, in constant memory: only an incomplete
+ * block is buffered between calls and whole blocks are compressed straight from the caller's data.
+ * final writes the DIGEST_SIZE byte digest and resets the context for the next message, e.g.
+ *
+ *     SHA1 sha;
+ *     while (size_t n = read(file, chunk, sizeof(chunk)))
+ *         sha.update(chunk, n);
+ *     sha.final(digest);
+ */
+class SHA1 {
+private:
+    static const size_t BLOCK_SIZE = 64;
+
+    uint32_t state[5];
+    uint8_t buffer[BLOCK_SIZE]; // Incomplete block
+    size_t bufferLen = 0;
+    uint64_t totalLen = 0;      // Message bytes so far
+public:
+    static const size_t DIGEST_SIZE = 20;
+
+    SHA1();
+
+    void reset();
+    void update(const void* data, size_t length);
+    void update(const std::string& data) { update(data.data(), data.size()); }
+    void final(uint8_t* out);
+
+    size_t digestLength() const { return DIGEST_SIZE; }
+
+    std::string hash(const std::string& in);
+};
@@ -13,10 +13,125 @@
 #pragma once
 
 #include <string>
+#include <cstdint>
+#include <cstddef>
 
+/*
+ * The hashSHA functions return the digest in lowercase hex. The digestSHA functions write the raw
+ * digest, DIGEST_SIZE bytes of the matching class below, for callers that use the digest as bytes.
+ */
 std::string hashSHA224(const std::string& in);
 std::string hashSHA256(const std::string& in);
 std::string hashSHA384(const std::string& in);
 std::string hashSHA512(const std::string& in);
 std::string hashSHA512_224(const std::string& in);
-std::string hashSHA512_256(const std::string& in);
\ No newline at end of file
+std::string hashSHA512_256(const std::string& in);
+
+void digestSHA224(const void* in, size_t inLen, uint8_t* digest);
+void digestSHA256(const void* in, size_t inLen, uint8_t* digest);
+void digestSHA384(const void* in, size_t inLen, uint8_t* digest);
+void digestSHA512(const void* in, size_t inLen, uint8_t* digest);
+void digestSHA512_224(const void* in, size_t inLen, uint8_t* digest);
+void digestSHA512_256(const void* in, size_t inLen, uint8_t* digest);
+
+/*
+ * Streaming SHA-2 (FIPS 180-4)
+ *
+ * Hashes a message delivered in any number of update calls, in constant memory: only an incomplete
+ * block is buffered between calls and whole blocks are compressed straight from the caller's data.
+ * final writes the digest (digestLength() bytes) and resets the context for the next message.
+ *
+ * SHA2Context is the common implementation; use one of the algorithm classes below, e.g.
+ *
+ *     SHA256 sha;
+ *     sha.update(header, headerLen);
+ *     sha.update(body, bodyLen);
+ *     sha.final(digest);
+ */
+template <typename Word>
+class SHA2Context {
+private:
+    static const size_t BLOCK_SIZE = 16 * sizeof(Word);
+
+    Word state[8];
+    uint8_t buffer[BLOCK_SIZE]; // Incomplete block
+    size_t bufferLen = 0;
+    uint64_t totalLen = 0;      // Message bytes so far
+    const Word* initialState;
+    size_t digestSize;
+
+    void compress(const uint8_t* blocks, size_t numBlocks);
+
+protected:
+    SHA2Context(const Word* initialState, size_t digestSize);
+
+public:
+    void reset();
+    void update(const void* data, size_t length);
+    void update(const std::string& data) { update(data.data(), data.size()); }
+    void final(uint8_t* out);
+
+    size_t digestLength() const { return digestSize; }
+};
+
+extern template class SHA2Context<uint32_t>;
+extern template class SHA2Context<uint64_t>;
+
+class SHA224 : public SHA2Context<uint32_t> {
+public:
+    static const size_t DIGEST_SIZE = 28;
+    SHA224();
+};
+
+class SHA256 : public SHA2Context<uint32_t> {
+public:
+    static const size_t DIGEST_SIZE = 32;
+    SHA256();
+};
+
+class SHA384 : public SHA2Context<uint64_t> {
+public:
+    static const size_t DIGEST_SIZE = 48;
+    SHA384();
+};
+
+class SHA512 : public SHA2Context<uint64_t> {
+public:
+    static const size_t DIGEST_SIZE = 64;
+    SHA512();
+};
+
+class SHA512_224 : public SHA2Context<uint64_t> {
+public:
+    static const size_t DIGEST_SIZE = 28;
+    SHA512_224();
+};
+
+class SHA512_256 : public SHA2Context<uint64_t> {
+public:
+    static const size_t DIGEST_SIZE = 32;
+    SHA512_256();
+};
+
+/*
+ * Multi-buffer SHA-2
+ *
+ * Hashes many independent messages in one call. Messages are compressed side by side, one per vector
+ * lane (up to 16 SHA-256 or 8 SHA-512 messages with AVX-512), so short messages such as per-record
+ * digests or MGF1 counter blocks use the full vector width a single message cannot. Messages may have
+ * different lengths: a finished message frees its lane for the next item.
+ *
+ * Each item's digest buffer must hold the algorithm's DIGEST_SIZE bytes.
+ */
+struct SHA2BatchItem {
+    const uint8_t* in;
+    size_t inLen;
+    uint8_t* digest;
+};
+
+void hashSHA224Batch(const SHA2BatchItem* items, size_t count);
+void hashSHA256Batch(const SHA2BatchItem* items, size_t count);
+void hashSHA384Batch(const SHA2BatchItem* items, size_t count);
+void hashSHA512Batch(const SHA2BatchItem* items, size_t count);
+void hashSHA512_224Batch(const SHA2BatchItem* items, size_t count);
+void hashSHA512_256Batch(const SHA2BatchItem* items, size_t count);
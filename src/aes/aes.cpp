@@ -13,10 +13,89 @@
 #include <string>
 #include <cstring>
 #include <iostream>
+#include <vector>
+#include <stdexcept>
 
 #include <gestalt/aes.h>
 #include "aesCore.h"
+#include "aesGCM.h"
 #include "utils.h"
+#include "parallel/parallel.h"
+
+/*
+ * Copies the message into out and appends PKCS7 padding.
+ *
+ * @param msg The message bytes.
+ * @param msgLen The length of the message in bytes.
+ * @param out Output buffer of at least aesPaddedLength(msgLen) bytes, may alias msg.
+ * @result The padded length in bytes.
+ */
+static size_t padPKCS7(const uint8_t* msg, size_t msgLen, uint8_t* out) {
+    size_t paddedLen = aesPaddedLength(msgLen);
+    if (out != msg) {
+        memmove(out, msg, msgLen);
+    }
+    memset(out + msgLen, static_cast<int>(paddedLen - msgLen), paddedLen - msgLen);
+    return paddedLen;
+}
+
+/*
+ * Validates the PKCS7 padding at the end of a decrypted buffer.
+ *
+ * @param data The decrypted bytes.
+ * @param len The length of the decrypted data in bytes.
+ * @result The length of the data without padding.
+ * @throws std::runtime_error if the padding is invalid.
+ */
+static size_t unpadPKCS7(const uint8_t* data, size_t len) {
+    if (len == 0) {
+        throw std::runtime_error("Data is empty, cannot remove padding.");
+    }
+    size_t paddingLength = data[len - 1];
+    if (paddingLength == 0 || paddingLength > len || paddingLength > AES_BLOCK_SIZE) {
+        throw std::runtime_error("Invalid padding length.");
+    }
+    return len - paddingLength;
+}
+
+static void validateCiphertextLength(size_t ciphertextLen) {
+    if (ciphertextLen % AES_BLOCK_SIZE != 0) {
+        throw std::invalid_argument("Invalid ciphertext length. Expected a multiple of the AES block size.");
+    }
+}
+
+/*
+ * Encrypts a binary message with AES_ECB under this context's key.
+ *
+ * @param msg The message bytes.
+ * @param msgLen The length of the message in bytes.
+ * @param out Output buffer of at least aesPaddedLength(msgLen) bytes, may alias msg.
+ * @result The number of ciphertext bytes written.
+ */
+size_t AES::encryptECB(const uint8_t* msg, size_t msgLen, uint8_t* out) const {
+    size_t paddedLen = padPKCS7(msg, msgLen, out);
+    encryptBlocks(out, paddedLen / AES_BLOCK_SIZE);
+    return paddedLen;
+}
+
+/*
+ * Decrypts a binary AES_ECB ciphertext under this context's key.
+ *
+ * @param ciphertext The ciphertext bytes.
+ * @param ciphertextLen The length of the ciphertext in bytes.
+ * @param out Output buffer of at least ciphertextLen bytes, may alias ciphertext.
+ * @result The number of plaintext bytes after the padding is removed.
+ * @throws std::invalid_argument if the ciphertext size is invalid.
+ * @throws std::runtime_error if the padding is invalid.
+ */
+size_t AES::decryptECB(const uint8_t* ciphertext, size_t ciphertextLen, uint8_t* out) const {
+    validateCiphertextLength(ciphertextLen);
+    if (out != ciphertext) {
+        memmove(out, ciphertext, ciphertextLen);
+    }
+    decryptBlocks(out, ciphertextLen / AES_BLOCK_SIZE);
+    return unpadPKCS7(out, ciphertextLen);
+}
 
 /*
  * Encrypts and arbitrarily input with AES_ECB.
@@ -29,20 +108,10 @@
 std::string encryptAESECB(const std::string& msg, std::string key) {
     AES cipher(key);
 
-    std::string paddedMsg = applyPKCS7Padding(msg);
-    size_t paddedMsgLen = paddedMsg.length();
-
-    unsigned char* input = new unsigned char[paddedMsgLen];
-    memcpy(input, paddedMsg.c_str(), paddedMsgLen);
+    std::vector<uint8_t> output(aesPaddedLength(msg.length()));
+    size_t outputLen = cipher.encryptECB(reinterpret_cast<const uint8_t*>(msg.data()), msg.length(), output.data());
 
-    for (size_t blockIndex = 0; blockIndex < paddedMsgLen; blockIndex += AES_BLOCK_SIZE) {
-        cipher.encryptBlock(input + blockIndex);
-    }
-
-    std::string hexResult = toHex(reinterpret_cast<const unsigned char*>(input), paddedMsgLen);
-
-    delete[] input;
-    return hexResult;
+    return toHex(output.data(), outputLen);
 }
 
 /*
@@ -57,19 +126,115 @@ std::string decryptAESECB(const std::string& hexMsg, std::string key) {
     AES cipher(key);
 
     std::string msg = fromHex(hexMsg);
-	size_t msgLen = msg.length();
+    uint8_t* data = reinterpret_cast<uint8_t*>(&msg[0]);
+    msg.resize(cipher.decryptECB(data, msg.length(), data));
+
+    return msg;
+}
+
+/*
+ * Encrypts a binary message with AES_ECB into a caller-provided buffer.
+ *
+ * @param msg The message bytes.
+ * @param msgLen The length of the message in bytes.
+ * @param key The 16, 24, or 32 byte key.
+ * @param keyLen The length of the key in bytes.
+ * @param out Output buffer of at least aesPaddedLength(msgLen) bytes, may alias msg.
+ * @result The number of ciphertext bytes written.
+ * @throws std::invalid_argument if the key size is not 128, 192, or 256 bits.
+ */
+size_t encryptAESECB(const uint8_t* msg, size_t msgLen, const uint8_t* key, size_t keyLen, uint8_t* out) {
+    AES cipher(key, keyLen);
+    return cipher.encryptECB(msg, msgLen, out);
+}
+
+/*
+ * Decrypts a binary AES_ECB ciphertext into a caller-provided buffer.
+ *
+ * @param ciphertext The ciphertext bytes.
+ * @param ciphertextLen The length of the ciphertext in bytes.
+ * @param key The 16, 24, or 32 byte key.
+ * @param keyLen The length of the key in bytes.
+ * @param out Output buffer of at least ciphertextLen bytes, may alias ciphertext.
+ * @result The number of plaintext bytes after the padding is removed.
+ * @throws std::invalid_argument if the key or ciphertext size is invalid.
+ * @throws std::runtime_error if the padding is invalid.
+ */
+size_t decryptAESECB(const uint8_t* ciphertext, size_t ciphertextLen, const uint8_t* key, size_t keyLen, uint8_t* out) {
+    AES cipher(key, keyLen);
+    return cipher.decryptECB(ciphertext, ciphertextLen, out);
+}
 
-	unsigned char* input = new unsigned char[msgLen];
-	memcpy(input, msg.c_str(), msgLen);
+std::vector<uint8_t> encryptAESECB(const std::vector<uint8_t>& msg, const std::vector<uint8_t>& key) {
+    std::vector<uint8_t> output(aesPaddedLength(msg.size()));
+    encryptAESECB(msg.data(), msg.size(), key.data(), key.size(), output.data());
+    return output;
+}
+
+std::vector<uint8_t> decryptAESECB(const std::vector<uint8_t>& ciphertext, const std::vector<uint8_t>& key) {
+    std::vector<uint8_t> output(ciphertext.size());
+    output.resize(decryptAESECB(ciphertext.data(), ciphertext.size(), key.data(), key.size(), output.data()));
+    return output;
+}
+
+/*
+ * Encrypts a binary message with AES_CBC under this context's key.
+ *
+ * @param msg The message bytes.
+ * @param msgLen The length of the message in bytes.
+ * @param iv The 16 byte initialization vector.
+ * @param out Output buffer of at least aesPaddedLength(msgLen) bytes, may alias msg.
+ * @result The number of ciphertext bytes written.
+ */
+size_t AES::encryptCBC(const uint8_t* msg, size_t msgLen, const uint8_t iv[16], uint8_t* out) const {
+    size_t paddedLen = padPKCS7(msg, msgLen, out);
+
+    uint8_t chain[AES_BLOCK_SIZE];
+    memcpy(chain, iv, AES_BLOCK_SIZE);
+    encryptBlocksCBC(out, paddedLen / AES_BLOCK_SIZE, chain);
+
+    return paddedLen;
+}
+
+/*
+ * Decrypts a binary AES_CBC ciphertext under this context's key. Block decryptions in CBC are
+ * independent of each other, so large inputs are split into ranges that are decrypted on separate threads.
+ *
+ * @param ciphertext The ciphertext bytes.
+ * @param ciphertextLen The length of the ciphertext in bytes.
+ * @param iv The 16 byte initialization vector.
+ * @param out Output buffer of at least ciphertextLen bytes, may alias ciphertext.
+ * @result The number of plaintext bytes after the padding is removed.
+ * @throws std::invalid_argument if the ciphertext size is invalid.
+ * @throws std::runtime_error if the padding is invalid.
+ */
+size_t AES::decryptCBC(const uint8_t* ciphertext, size_t ciphertextLen, const uint8_t iv[16], uint8_t* out) const {
+    validateCiphertextLength(ciphertextLen);
+    if (out != ciphertext) {
+        memmove(out, ciphertext, ciphertextLen);
+    }
 
-	for (size_t blockIndex = 0; blockIndex < msgLen; blockIndex += AES_BLOCK_SIZE) {
-		cipher.decryptBlock(input + blockIndex);
-	}
+    // Each range is seeded with the ciphertext block before it, captured before any range is decrypted in place
+    std::vector<BlockRange> ranges = splitBlockRange(ciphertextLen / AES_BLOCK_SIZE, AES_BLOCK_SIZE);
+    std::vector<uint8_t> seeds(ranges.size() * AES_BLOCK_SIZE);
+    memcpy(seeds.data(), iv, AES_BLOCK_SIZE);
+    for (size_t i = 1; i < ranges.size(); i++) {
+        memcpy(seeds.data() + i * AES_BLOCK_SIZE, out + (ranges[i].first - 1) * AES_BLOCK_SIZE, AES_BLOCK_SIZE);
+    }
 
-    msg.assign(reinterpret_cast<char*>(input), msgLen);
+    parallelFor(ranges.size(), [&](size_t i) {
+        decryptBlocksCBC(out + ranges[i].first * AES_BLOCK_SIZE, ranges[i].count, seeds.data() + i * AES_BLOCK_SIZE);
+    });
 
-	delete[] input;
-    return removePKCS7Padding(msg);
+    return unpadPKCS7(out, ciphertextLen);
+}
+
+static void parseHexIV(const std::string& iv, uint8_t out[AES_BLOCK_SIZE]) {
+    std::string bytes = fromHex(iv);
+    if (bytes.length() != AES_BLOCK_SIZE) {
+        throw std::invalid_argument("Invalid IV size. Expected 128 bits.");
+    }
+    memcpy(out, bytes.data(), AES_BLOCK_SIZE);
 }
 
 /*
@@ -84,23 +249,13 @@ std::string decryptAESECB(const std::string& hexMsg, std::string key) {
 std::string encryptAESCBC(const std::string& msg, std::string iv, std::string key) {
     AES cipher(key);
 
-    std::string paddedMsg = applyPKCS7Padding(msg);
-    size_t paddedMsgLen = paddedMsg.length();
-
-    unsigned char* input = new unsigned char[paddedMsgLen];
-    memcpy(input, paddedMsg.c_str(), paddedMsgLen);
-	
-	for (size_t blockIndex = 0; blockIndex < paddedMsgLen; blockIndex += AES_BLOCK_SIZE) {
-		xorBlock(input, iv, blockIndex);
-		cipher.encryptBlock(input + blockIndex);
-		iv.assign(reinterpret_cast<char*>(input + blockIndex), AES_BLOCK_SIZE);
-		iv = convertToHex(iv);
-	}
+    uint8_t chain[AES_BLOCK_SIZE];
+    parseHexIV(iv, chain);
 
-	std::string hexResult = toHex(reinterpret_cast<const unsigned char*>(input), paddedMsgLen);
+    std::vector<uint8_t> output(aesPaddedLength(msg.length()));
+    size_t outputLen = cipher.encryptCBC(reinterpret_cast<const uint8_t*>(msg.data()), msg.length(), chain, output.data());
 
-	delete[] input;
-	return hexResult;
+    return toHex(output.data(), outputLen);
 }
 
 /*
@@ -115,24 +270,443 @@ std::string encryptAESCBC(const std::string& msg, std::string iv, std::string ke
 std::string decryptAESCBC(const std::string& hexMsg, std::string iv, std::string key) {
     AES cipher(key);
 
+    uint8_t chain[AES_BLOCK_SIZE];
+    parseHexIV(iv, chain);
+
     std::string msg = fromHex(hexMsg);
-	size_t msgLen = msg.length();
+    uint8_t* data = reinterpret_cast<uint8_t*>(&msg[0]);
+    msg.resize(cipher.decryptCBC(data, msg.length(), chain, data));
+
+    return msg;
+}
+
+/*
+ * Encrypts a binary message with AES_CBC into a caller-provided buffer.
+ *
+ * @param msg The message bytes.
+ * @param msgLen The length of the message in bytes.
+ * @param iv The 16 byte initialization vector.
+ * @param key The 16, 24, or 32 byte key.
+ * @param keyLen The length of the key in bytes.
+ * @param out Output buffer of at least aesPaddedLength(msgLen) bytes, may alias msg.
+ * @result The number of ciphertext bytes written.
+ * @throws std::invalid_argument if the key size is not 128, 192, or 256 bits.
+ */
+size_t encryptAESCBC(
+    const uint8_t* msg, size_t msgLen, const uint8_t iv[16], const uint8_t* key, size_t keyLen, uint8_t* out
+) {
+    AES cipher(key, keyLen);
+    return cipher.encryptCBC(msg, msgLen, iv, out);
+}
+
+/*
+ * Decrypts a binary AES_CBC ciphertext into a caller-provided buffer.
+ *
+ * @param ciphertext The ciphertext bytes.
+ * @param ciphertextLen The length of the ciphertext in bytes.
+ * @param iv The 16 byte initialization vector.
+ * @param key The 16, 24, or 32 byte key.
+ * @param keyLen The length of the key in bytes.
+ * @param out Output buffer of at least ciphertextLen bytes, may alias ciphertext.
+ * @result The number of plaintext bytes after the padding is removed.
+ * @throws std::invalid_argument if the key or ciphertext size is invalid.
+ * @throws std::runtime_error if the padding is invalid.
+ */
+size_t decryptAESCBC(
+    const uint8_t* ciphertext, size_t ciphertextLen, const uint8_t iv[16], const uint8_t* key, size_t keyLen, uint8_t* out
+) {
+    AES cipher(key, keyLen);
+    return cipher.decryptCBC(ciphertext, ciphertextLen, iv, out);
+}
+
+static void validateIV(const std::vector<uint8_t>& iv) {
+    if (iv.size() != AES_BLOCK_SIZE) {
+        throw std::invalid_argument("Invalid IV size. Expected 128 bits.");
+    }
+}
+
+std::vector<uint8_t> encryptAESCBC(
+    const std::vector<uint8_t>& msg, const std::vector<uint8_t>& iv, const std::vector<uint8_t>& key
+) {
+    validateIV(iv);
+    std::vector<uint8_t> output(aesPaddedLength(msg.size()));
+    encryptAESCBC(msg.data(), msg.size(), iv.data(), key.data(), key.size(), output.data());
+    return output;
+}
+
+std::vector<uint8_t> decryptAESCBC(
+    const std::vector<uint8_t>& ciphertext, const std::vector<uint8_t>& iv, const std::vector<uint8_t>& key
+) {
+    validateIV(iv);
+    std::vector<uint8_t> output(ciphertext.size());
+    output.resize(decryptAESCBC(ciphertext.data(), ciphertext.size(), iv.data(), key.data(), key.size(), output.data()));
+    return output;
+}
+
+static bool isValidKeySize(size_t keyLen) {
+    return keyLen == 16 || keyLen == 24 || keyLen == 32;
+}
+
+/*
+ * A message in flight in the multi-buffer CBC encryptor.
+ */
+struct CBCLane {
+    AES cipher;
+    AESBatchItem* item;
+    size_t nextBlock;
+    uint8_t chain[AES_BLOCK_SIZE];
+
+    explicit CBCLane(AESBatchItem* item) : cipher(item->key, item->keyLen), item(item), nextBlock(0) {
+        memcpy(chain, item->iv, AES_BLOCK_SIZE);
+    }
+
+    size_t remainingBlocks() const { return item->outLen / AES_BLOCK_SIZE - nextBlock; }
+};
+
+/*
+ * Encrypts a batch of independent messages with AES_CBC, each under its own key and IV.
+ *
+ * Up to AES_MULTI_BUFFER_LANES messages are in flight at once. Every step advances all of them by the
+ * number of blocks left in the shortest one, with their rounds interleaved, and a message that finishes
+ * frees its lane for the next item, so messages of different lengths keep the lanes full.
+ *
+ * @param items The messages. outLen and status are set for every item.
+ * @param count The number of items.
+ * @result The number of items encrypted successfully.
+ */
+size_t encryptAESCBCBatch(AESBatchItem* items, size_t count) {
+    std::vector<CBCLane> lanes;
+    lanes.reserve(AES_MULTI_BUFFER_LANES);
+    size_t next = 0;
+    size_t succeeded = 0;
+
+    for (;;) {
+        while (lanes.size() < AES_MULTI_BUFFER_LANES && next < count) {
+            AESBatchItem* item = &items[next++];
+            item->outLen = 0;
+            if (!isValidKeySize(item->keyLen)) {
+                item->status = AESBatchStatus::InvalidKeySize;
+                continue;
+            }
+            item->status = AESBatchStatus::Ok;
+            item->outLen = padPKCS7(item->in, item->inLen, item->out);
+            lanes.emplace_back(item);
+        }
+        if (lanes.empty()) {
+            break;
+        }
+
+        size_t step = lanes[0].remainingBlocks();
+        for (size_t lane = 1; lane < lanes.size(); lane++) {
+            step = lanes[lane].remainingBlocks() < step ? lanes[lane].remainingBlocks() : step;
+        }
+
+        const AES* ciphers[AES_MULTI_BUFFER_LANES];
+        unsigned char* data[AES_MULTI_BUFFER_LANES];
+        unsigned char* chains[AES_MULTI_BUFFER_LANES];
+        for (size_t lane = 0; lane < lanes.size(); lane++) {
+            ciphers[lane] = &lanes[lane].cipher;
+            data[lane] = lanes[lane].item->out + lanes[lane].nextBlock * AES_BLOCK_SIZE;
+            chains[lane] = lanes[lane].chain;
+        }
+        AES::encryptBlocksCBCLanes(ciphers, data, chains, lanes.size(), step);
+
+        // Retire finished messages, back to front so the remaining indices stay valid
+        for (size_t lane = lanes.size(); lane-- > 0;) {
+            lanes[lane].nextBlock += step;
+            if (lanes[lane].remainingBlocks() == 0) {
+                lanes.erase(lanes.begin() + lane);
+                succeeded++;
+            }
+        }
+    }
+
+    return succeeded;
+}
+
+/*
+ * Decrypts a batch of independent AES_CBC ciphertexts, each under its own key and IV.
+ *
+ * CBC decryption is not serial within a message, so each message already fills the pipeline through
+ * decryptCBC and the items are simply processed in order.
+ *
+ * @param items The ciphertexts. outLen and status are set for every item.
+ * @param count The number of items.
+ * @result The number of items decrypted successfully.
+ */
+size_t decryptAESCBCBatch(AESBatchItem* items, size_t count) {
+    size_t succeeded = 0;
+
+    for (size_t i = 0; i < count; i++) {
+        AESBatchItem& item = items[i];
+        item.outLen = 0;
+        if (!isValidKeySize(item.keyLen)) {
+            item.status = AESBatchStatus::InvalidKeySize;
+            continue;
+        }
+        if (item.inLen == 0 || item.inLen % AES_BLOCK_SIZE != 0) {
+            item.status = AESBatchStatus::InvalidLength;
+            continue;
+        }
+
+        AES cipher(item.key, item.keyLen);
+        try {
+            item.outLen = cipher.decryptCBC(item.in, item.inLen, item.iv, item.out);
+            item.status = AESBatchStatus::Ok;
+            succeeded++;
+        } catch (const std::runtime_error&) {
+            item.status = AESBatchStatus::InvalidPadding;
+        }
+    }
+
+    return succeeded;
+}
+
+/*
+ * Encrypts a binary message with AES_CTR under this context's key. Large buffers are split into ranges
+ * that each seek directly to their keystream position and run on separate threads.
+ *
+ * @param in The message bytes.
+ * @param length The length of the message in bytes.
+ * @param counter The 16 byte initial counter block.
+ * @param out Output buffer of at least length bytes, may alias in.
+ * @param offset The keystream byte position of in[0].
+ */
+void AES::encryptCTR(const uint8_t* in, size_t length, const uint8_t counter[16], uint8_t* out, uint64_t offset) const {
+    size_t numBlocks = (length + AES_BLOCK_SIZE - 1) / AES_BLOCK_SIZE;
+    std::vector<BlockRange> ranges = splitBlockRange(numBlocks, AES_BLOCK_SIZE);
+
+    parallelFor(ranges.size(), [&](size_t i) {
+        size_t begin = ranges[i].first * AES_BLOCK_SIZE;
+        size_t end = (ranges[i].first + ranges[i].count) * AES_BLOCK_SIZE;
+        if (end > length) {
+            end = length;
+        }
+        applyCTR(in + begin, out + begin, end - begin, counter, offset + begin);
+    });
+}
+
+/*
+ * Decrypts a binary AES_CTR ciphertext under this context's key; the same operation as encryptCTR.
+ */
+void AES::decryptCTR(const uint8_t* in, size_t length, const uint8_t counter[16], uint8_t* out, uint64_t offset) const {
+    encryptCTR(in, length, counter, out, offset);
+}
+
+/*
+ * Encrypts a binary message with AES_CTR into a caller-provided buffer.
+ *
+ * @param in The message bytes.
+ * @param length The length of the message in bytes.
+ * @param counter The 16 byte initial counter block.
+ * @param key The 16, 24, or 32 byte key.
+ * @param keyLen The length of the key in bytes.
+ * @param out Output buffer of at least length bytes, may alias in.
+ * @param offset The keystream byte position of in[0].
+ * @throws std::invalid_argument if the key size is not 128, 192, or 256 bits.
+ */
+void encryptAESCTR(
+    const uint8_t* in, size_t length, const uint8_t counter[16], const uint8_t* key, size_t keyLen, uint8_t* out,
+    uint64_t offset
+) {
+    AES cipher(key, keyLen);
+    cipher.encryptCTR(in, length, counter, out, offset);
+}
+
+/*
+ * Decrypts a binary AES_CTR ciphertext into a caller-provided buffer.
+ *
+ * @param in The ciphertext bytes.
+ * @param length The length of the ciphertext in bytes.
+ * @param counter The 16 byte initial counter block.
+ * @param key The 16, 24, or 32 byte key.
+ * @param keyLen The length of the key in bytes.
+ * @param out Output buffer of at least length bytes, may alias in.
+ * @param offset The keystream byte position of in[0].
+ * @throws std::invalid_argument if the key size is not 128, 192, or 256 bits.
+ */
+void decryptAESCTR(
+    const uint8_t* in, size_t length, const uint8_t counter[16], const uint8_t* key, size_t keyLen, uint8_t* out,
+    uint64_t offset
+) {
+    AES cipher(key, keyLen);
+    cipher.encryptCTR(in, length, counter, out, offset);
+}
+
+std::vector<uint8_t> encryptAESCTR(
+    const std::vector<uint8_t>& msg, const std::vector<uint8_t>& counter, const std::vector<uint8_t>& key
+) {
+    validateIV(counter);
+    std::vector<uint8_t> output(msg.size());
+    encryptAESCTR(msg.data(), msg.size(), counter.data(), key.data(), key.size(), output.data());
+    return output;
+}
+
+std::vector<uint8_t> decryptAESCTR(
+    const std::vector<uint8_t>& ciphertext, const std::vector<uint8_t>& counter, const std::vector<uint8_t>& key
+) {
+    validateIV(counter);
+    std::vector<uint8_t> output(ciphertext.size());
+    decryptAESCTR(ciphertext.data(), ciphertext.size(), counter.data(), key.data(), key.size(), output.data());
+    return output;
+}
+
+/*
+ * Encrypts and authenticates a binary message with AES_GCM.
+ *
+ * @param msg The message bytes.
+ * @param msgLen The length of the message in bytes.
+ * @param aad The additional authenticated data, may be null when aadLen is 0.
+ * @param aadLen The length of the additional authenticated data in bytes.
+ * @param iv The initialization vector, 12 bytes recommended.
+ * @param ivLen The length of the IV in bytes.
+ * @param key The 16, 24, or 32 byte key.
+ * @param keyLen The length of the key in bytes.
+ * @param out Output buffer of at least msgLen bytes, may alias msg.
+ * @param tag Output buffer for the tag.
+ * @param tagLen The tag length in bytes: 4, 8, or 12 to 16.
+ * @throws std::invalid_argument if the key, IV or tag size is invalid.
+ */
+void encryptAESGCM(
+    const uint8_t* msg, size_t msgLen, const uint8_t* aad, size_t aadLen, const uint8_t* iv, size_t ivLen,
+    const uint8_t* key, size_t keyLen, uint8_t* out, uint8_t* tag, size_t tagLen
+) {
+    AES cipher(key, keyLen);
+    cipher.encryptGCM(msg, msgLen, aad, aadLen, iv, ivLen, out, tag, tagLen);
+}
+
+/*
+ * Verifies and decrypts a binary AES_GCM ciphertext.
+ *
+ * @param ciphertext The ciphertext bytes.
+ * @param ciphertextLen The length of the ciphertext in bytes.
+ * @param aad The additional authenticated data, may be null when aadLen is 0.
+ * @param aadLen The length of the additional authenticated data in bytes.
+ * @param iv The initialization vector used for encryption.
+ * @param ivLen The length of the IV in bytes.
+ * @param key The 16, 24, or 32 byte key.
+ * @param keyLen The length of the key in bytes.
+ * @param tag The received tag.
+ * @param tagLen The tag length in bytes: 4, 8, or 12 to 16.
+ * @param out Output buffer of at least ciphertextLen bytes, may alias ciphertext.
+ * @throws std::invalid_argument if the key, IV or tag size is invalid.
+ * @throws std::runtime_error if the tag does not match; the output is cleared.
+ */
+void decryptAESGCM(
+    const uint8_t* ciphertext, size_t ciphertextLen, const uint8_t* aad, size_t aadLen, const uint8_t* iv, size_t ivLen,
+    const uint8_t* key, size_t keyLen, const uint8_t* tag, size_t tagLen, uint8_t* out
+) {
+    AES cipher(key, keyLen);
+    cipher.decryptGCM(ciphertext, ciphertextLen, aad, aadLen, iv, ivLen, tag, tagLen, out);
+}
+
+std::vector<uint8_t> encryptAESGCM(
+    const std::vector<uint8_t>& msg, const std::vector<uint8_t>& iv, const std::vector<uint8_t>& key,
+    const std::vector<uint8_t>& aad
+) {
+    std::vector<uint8_t> output(msg.size() + GCM_TAG_SIZE);
+    encryptAESGCM(
+        msg.data(), msg.size(), aad.data(), aad.size(), iv.data(), iv.size(), key.data(), key.size(),
+        output.data(), output.data() + msg.size(), GCM_TAG_SIZE
+    );
+    return output;
+}
+
+std::vector<uint8_t> decryptAESGCM(
+    const std::vector<uint8_t>& ciphertext, const std::vector<uint8_t>& iv, const std::vector<uint8_t>& key,
+    const std::vector<uint8_t>& aad
+) {
+    if (ciphertext.size() < GCM_TAG_SIZE) {
+        throw std::invalid_argument("Invalid ciphertext length. Expected at least the 16 byte tag.");
+    }
+    size_t textLen = ciphertext.size() - GCM_TAG_SIZE;
+    std::vector<uint8_t> output(textLen);
+    decryptAESGCM(
+        ciphertext.data(), textLen, aad.data(), aad.size(), iv.data(), iv.size(), key.data(), key.size(),
+        ciphertext.data() + textLen, GCM_TAG_SIZE, output.data()
+    );
+    return output;
+}
+
+/*
+ * Encrypts and authenticates a binary message with AES_GCM under this context's key. Only the hash
+ * subkey is derived per call; the AES key schedule is reused.
+ *
+ * @param msg The message bytes.
+ * @param msgLen The length of the message in bytes.
+ * @param aad The additional authenticated data, may be null when aadLen is 0.
+ * @param aadLen The length of the additional authenticated data in bytes.
+ * @param iv The initialization vector, 12 bytes recommended.
+ * @param ivLen The length of the IV in bytes.
+ * @param out Output buffer of at least msgLen bytes, may alias msg.
+ * @param tag Output buffer for the tag.
+ * @param tagLen The tag length in bytes: 4, 8, or 12 to 16.
+ * @throws std::invalid_argument if the IV or tag size is invalid.
+ */
+void AES::encryptGCM(
+    const uint8_t* msg, size_t msgLen, const uint8_t* aad, size_t aadLen, const uint8_t* iv, size_t ivLen,
+    uint8_t* out, uint8_t* tag, size_t tagLen
+) const {
+    GCM gcm(*this);
+    gcm.start(iv, ivLen);
+    gcm.updateAAD(aad, aadLen);
+    gcm.encryptUpdate(msg, out, msgLen);
+    gcm.finish(tag, tagLen);
+}
+
+/*
+ * Verifies and decrypts a binary AES_GCM ciphertext under this context's key.
+ *
+ * @param ciphertext The ciphertext bytes.
+ * @param ciphertextLen The length of the ciphertext in bytes.
+ * @param aad The additional authenticated data, may be null when aadLen is 0.
+ * @param aadLen The length of the additional authenticated data in bytes.
+ * @param iv The initialization vector used for encryption.
+ * @param ivLen The length of the IV in bytes.
+ * @param tag The received tag.
+ * @param tagLen The tag length in bytes: 4, 8, or 12 to 16.
+ * @param out Output buffer of at least ciphertextLen bytes, may alias ciphertext.
+ * @throws std::invalid_argument if the IV or tag size is invalid.
+ * @throws std::runtime_error if the tag does not match; the output is cleared.
+ */
+void AES::decryptGCM(
+    const uint8_t* ciphertext, size_t ciphertextLen, const uint8_t* aad, size_t aadLen, const uint8_t* iv, size_t ivLen,
+    const uint8_t* tag, size_t tagLen, uint8_t* out
+) const {
+    GCM gcm(*this);
+    gcm.start(iv, ivLen);
+    gcm.updateAAD(aad, aadLen);
+    gcm.decryptUpdate(ciphertext, out, ciphertextLen);
+    if (!gcm.verify(tag, tagLen)) {
+        memset(out, 0, ciphertextLen);
+        throw std::runtime_error("AES-GCM authentication failed.");
+    }
+}
+
+AESGCM::AESGCM(const uint8_t* key, size_t keyLen) : gcm(new GCM(key, keyLen)) {}
 
-	unsigned char* input = new unsigned char[msgLen];
-	memcpy(input, msg.c_str(), msgLen);
+AESGCM::~AESGCM() = default;
 
-	std::string tmp = "";
+void AESGCM::start(const uint8_t* iv, size_t ivLen) {
+    gcm->start(iv, ivLen);
+}
 
-	for (size_t blockIndex = 0; blockIndex < msgLen; blockIndex += AES_BLOCK_SIZE) {
-		tmp.assign(reinterpret_cast<char*>(input + blockIndex), AES_BLOCK_SIZE);
-		tmp = convertToHex(tmp);
-		cipher.decryptBlock(input + blockIndex);
-		xorBlock(input, iv, blockIndex);
-		iv = tmp;
-	}
+void AESGCM::updateAAD(const uint8_t* aad, size_t aadLen) {
+    gcm->updateAAD(aad, aadLen);
+}
 
-	msg.assign(reinterpret_cast<char*>(input), msgLen);
+void AESGCM::encryptUpdate(const uint8_t* in, size_t length, uint8_t* out) {
+    gcm->encryptUpdate(in, out, length);
+}
 
-	delete[] input;
-    return removePKCS7Padding(msg);   
-}
\ No newline at end of file
+void AESGCM::decryptUpdate(const uint8_t* in, size_t length, uint8_t* out) {
+    gcm->decryptUpdate(in, out, length);
+}
+
+void AESGCM::finish(uint8_t* tag, size_t tagLen) {
+    gcm->finish(tag, tagLen);
+}
+
+bool AESGCM::verify(const uint8_t* tag, size_t tagLen) {
+    return gcm->verify(tag, tagLen);
+}
@@ -0,0 +1,555 @@
+/*
+ * Copyright 2023-2024 The Gestalt Project Authors. All Rights Reserved.
+ *
+ * Licensed under the MIT License. See the file LICENSE for the full text.
+ */
+
+/*
+ * aesBitsliced.cpp
+ *
+ * This file contains the constant-time bitsliced round engine for the AES class.
+ *
+ * References:
+ * - "Faster and Timing-Attack Resistant AES-GCM" by Emilia Käsper and Peter Schwabe
+ * - "A new combinational logic minimization technique with applications to cryptology" by Joan Boyar
+ *   and René Peralta, which gives the 113 gate S-box circuit used here
+ * - The BearSSL aes_ct64 implementation by Thomas Pornin, whose state layout this engine follows
+ *
+ * Four blocks are held in eight 64-bit words. Word i holds bit i of all 64 bytes, grouped by row so
+ * that bits 16r .. 16r + 15 belong to row r of the state, four bits (one per block) per column.
+ * SubBytes is then evaluated as a boolean circuit on the eight words, ShiftRows is a fixed bit
+ * permutation inside each word, and MixColumns combines rotations of the words. No operation indexes
+ * memory or branches on secret data, so the running time does not depend on the key or the data.
+ *
+ * The engine works on AES_BITSLICED_BLOCKS blocks per pass as two four-block groups stepped together,
+ * so the two circuits overlap in the pipeline. It is the fastest table-free engine for hosts without
+ * AES instructions, for the modes that have independent blocks: ECB, CTR and CBC decryption.
+ */
+
+#include <cstring>
+
+#include "aesCore.h"
+
+static const size_t AES_BITSLICED_GROUPS = AES_BITSLICED_BLOCKS / 4;
+
+static inline uint32_t loadLittleEndian32(const unsigned char* in) {
+    return static_cast<uint32_t>(in[0]) | (static_cast<uint32_t>(in[1]) << 8) |
+           (static_cast<uint32_t>(in[2]) << 16) | (static_cast<uint32_t>(in[3]) << 24);
+}
+
+static inline void storeLittleEndian32(unsigned char* out, uint32_t word) {
+    out[0] = static_cast<unsigned char>(word);
+    out[1] = static_cast<unsigned char>(word >> 8);
+    out[2] = static_cast<unsigned char>(word >> 16);
+    out[3] = static_cast<unsigned char>(word >> 24);
+}
+
+/*
+ * Swaps the bits selected by the masks between two words, which transposes 2x2 blocks of bits.
+ */
+static inline void swapBits(uint64_t& x, uint64_t& y, uint64_t lowMask, uint64_t highMask, int shift) {
+    uint64_t a = x;
+    uint64_t b = y;
+    x = (a & lowMask) | ((b & lowMask) << shift);
+    y = ((a & highMask) >> shift) | (b & highMask);
+}
+
+/*
+ * Converts between the byte-interleaved and the bitsliced representations. The transform is an
+ * 8x8 bit matrix transpose and therefore its own inverse.
+ */
+static void orthogonalize(uint64_t q[8]) {
+    swapBits(q[0], q[1], 0x5555555555555555ULL, 0xAAAAAAAAAAAAAAAAULL, 1);
+    swapBits(q[2], q[3], 0x5555555555555555ULL, 0xAAAAAAAAAAAAAAAAULL, 1);
+    swapBits(q[4], q[5], 0x5555555555555555ULL, 0xAAAAAAAAAAAAAAAAULL, 1);
+    swapBits(q[6], q[7], 0x5555555555555555ULL, 0xAAAAAAAAAAAAAAAAULL, 1);
+
+    swapBits(q[0], q[2], 0x3333333333333333ULL, 0xCCCCCCCCCCCCCCCCULL, 2);
+    swapBits(q[1], q[3], 0x3333333333333333ULL, 0xCCCCCCCCCCCCCCCCULL, 2);
+    swapBits(q[4], q[6], 0x3333333333333333ULL, 0xCCCCCCCCCCCCCCCCULL, 2);
+    swapBits(q[5], q[7], 0x3333333333333333ULL, 0xCCCCCCCCCCCCCCCCULL, 2);
+
+    swapBits(q[0], q[4], 0x0F0F0F0F0F0F0F0FULL, 0xF0F0F0F0F0F0F0F0ULL, 4);
+    swapBits(q[1], q[5], 0x0F0F0F0F0F0F0F0FULL, 0xF0F0F0F0F0F0F0F0ULL, 4);
+    swapBits(q[2], q[6], 0x0F0F0F0F0F0F0F0FULL, 0xF0F0F0F0F0F0F0F0ULL, 4);
+    swapBits(q[3], q[7], 0x0F0F0F0F0F0F0F0FULL, 0xF0F0F0F0F0F0F0F0ULL, 4);
+}
+
+/*
+ * Spreads the four little-endian words of one block over two words, 16 bits of each column at a time,
+ * ready for orthogonalize.
+ */
+static void interleaveIn(uint64_t& q0, uint64_t& q1, const uint32_t w[4]) {
+    uint64_t x0 = w[0];
+    uint64_t x1 = w[1];
+    uint64_t x2 = w[2];
+    uint64_t x3 = w[3];
+
+    x0 = (x0 | (x0 << 16)) & 0x0000FFFF0000FFFFULL;
+    x1 = (x1 | (x1 << 16)) & 0x0000FFFF0000FFFFULL;
+    x2 = (x2 | (x2 << 16)) & 0x0000FFFF0000FFFFULL;
+    x3 = (x3 | (x3 << 16)) & 0x0000FFFF0000FFFFULL;
+
+    x0 = (x0 | (x0 << 8)) & 0x00FF00FF00FF00FFULL;
+    x1 = (x1 | (x1 << 8)) & 0x00FF00FF00FF00FFULL;
+    x2 = (x2 | (x2 << 8)) & 0x00FF00FF00FF00FFULL;
+    x3 = (x3 | (x3 << 8)) & 0x00FF00FF00FF00FFULL;
+
+    q0 = x0 | (x2 << 8);
+    q1 = x1 | (x3 << 8);
+}
+
+static void interleaveOut(uint32_t w[4], uint64_t q0, uint64_t q1) {
+    uint64_t x0 = q0 & 0x00FF00FF00FF00FFULL;
+    uint64_t x1 = q1 & 0x00FF00FF00FF00FFULL;
+    uint64_t x2 = (q0 >> 8) & 0x00FF00FF00FF00FFULL;
+    uint64_t x3 = (q1 >> 8) & 0x00FF00FF00FF00FFULL;
+
+    x0 = (x0 | (x0 >> 8)) & 0x0000FFFF0000FFFFULL;
+    x1 = (x1 | (x1 >> 8)) & 0x0000FFFF0000FFFFULL;
+    x2 = (x2 | (x2 >> 8)) & 0x0000FFFF0000FFFFULL;
+    x3 = (x3 | (x3 >> 8)) & 0x0000FFFF0000FFFFULL;
+
+    w[0] = static_cast<uint32_t>(x0) | static_cast<uint32_t>(x0 >> 16);
+    w[1] = static_cast<uint32_t>(x1) | static_cast<uint32_t>(x1 >> 16);
+    w[2] = static_cast<uint32_t>(x2) | static_cast<uint32_t>(x2 >> 16);
+    w[3] = static_cast<uint32_t>(x3) | static_cast<uint32_t>(x3 >> 16);
+}
+
+/*
+ * Evaluates the AES S-box on all 64 bytes of a bitsliced group with the Boyar-Peralta circuit: a
+ * linear top layer, a shared GF(2^4) inversion and a linear bottom layer that also applies the affine
+ * constant. The circuit variables number bits from the most significant, so x0 is q[7].
+ */
+static void subBytesBitsliced(uint64_t q[8]) {
+    uint64_t x0 = q[7], x1 = q[6], x2 = q[5], x3 = q[4];
+    uint64_t x4 = q[3], x5 = q[2], x6 = q[1], x7 = q[0];
+
+    // Top linear transformation
+    uint64_t y14 = x3 ^ x5;
+    uint64_t y13 = x0 ^ x6;
+    uint64_t y9 = x0 ^ x3;
+    uint64_t y8 = x0 ^ x5;
+    uint64_t t0 = x1 ^ x2;
+    uint64_t y1 = t0 ^ x7;
+    uint64_t y4 = y1 ^ x3;
+    uint64_t y12 = y13 ^ y14;
+    uint64_t y2 = y1 ^ x0;
+    uint64_t y5 = y1 ^ x6;
+    uint64_t y3 = y5 ^ y8;
+    uint64_t t1 = x4 ^ y12;
+    uint64_t y15 = t1 ^ x5;
+    uint64_t y20 = t1 ^ x1;
+    uint64_t y6 = y15 ^ x7;
+    uint64_t y10 = y15 ^ t0;
+    uint64_t y11 = y20 ^ y9;
+    uint64_t y7 = x7 ^ y11;
+    uint64_t y17 = y10 ^ y11;
+    uint64_t y19 = y10 ^ y8;
+    uint64_t y16 = t0 ^ y11;
+    uint64_t y21 = y13 ^ y16;
+    uint64_t y18 = x0 ^ y16;
+
+    // Non-linear section
+    uint64_t t2 = y12 & y15;
+    uint64_t t3 = y3 & y6;
+    uint64_t t4 = t3 ^ t2;
+    uint64_t t5 = y4 & x7;
+    uint64_t t6 = t5 ^ t2;
+    uint64_t t7 = y13 & y16;
+    uint64_t t8 = y5 & y1;
+    uint64_t t9 = t8 ^ t7;
+    uint64_t t10 = y2 & y7;
+    uint64_t t11 = t10 ^ t7;
+    uint64_t t12 = y9 & y11;
+    uint64_t t13 = y14 & y17;
+    uint64_t t14 = t13 ^ t12;
+    uint64_t t15 = y8 & y10;
+    uint64_t t16 = t15 ^ t12;
+    uint64_t t17 = t4 ^ t14;
+    uint64_t t18 = t6 ^ t16;
+    uint64_t t19 = t9 ^ t14;
+    uint64_t t20 = t11 ^ t16;
+    uint64_t t21 = t17 ^ y20;
+    uint64_t t22 = t18 ^ y19;
+    uint64_t t23 = t19 ^ y21;
+    uint64_t t24 = t20 ^ y18;
+
+    uint64_t t25 = t21 ^ t22;
+    uint64_t t26 = t21 & t23;
+    uint64_t t27 = t24 ^ t26;
+    uint64_t t28 = t25 & t27;
+    uint64_t t29 = t28 ^ t22;
+    uint64_t t30 = t23 ^ t24;
+    uint64_t t31 = t22 ^ t26;
+    uint64_t t32 = t31 & t30;
+    uint64_t t33 = t32 ^ t24;
+    uint64_t t34 = t23 ^ t33;
+    uint64_t t35 = t27 ^ t33;
+    uint64_t t36 = t24 & t35;
+    uint64_t t37 = t36 ^ t34;
+    uint64_t t38 = t27 ^ t36;
+    uint64_t t39 = t29 & t38;
+    uint64_t t40 = t25 ^ t39;
+
+    uint64_t t41 = t40 ^ t37;
+    uint64_t t42 = t29 ^ t33;
+    uint64_t t43 = t29 ^ t40;
+    uint64_t t44 = t33 ^ t37;
+    uint64_t t45 = t42 ^ t41;
+    uint64_t z0 = t44 & y15;
+    uint64_t z1 = t37 & y6;
+    uint64_t z2 = t33 & x7;
+    uint64_t z3 = t43 & y16;
+    uint64_t z4 = t40 & y1;
+    uint64_t z5 = t29 & y7;
+    uint64_t z6 = t42 & y11;
+    uint64_t z7 = t45 & y17;
+    uint64_t z8 = t41 & y10;
+    uint64_t z9 = t44 & y12;
+    uint64_t z10 = t37 & y3;
+    uint64_t z11 = t33 & y4;
+    uint64_t z12 = t43 & y13;
+    uint64_t z13 = t40 & y5;
+    uint64_t z14 = t29 & y2;
+    uint64_t z15 = t42 & y9;
+    uint64_t z16 = t45 & y14;
+    uint64_t z17 = t41 & y8;
+
+    // Bottom linear transformation
+    uint64_t t46 = z15 ^ z16;
+    uint64_t t47 = z10 ^ z11;
+    uint64_t t48 = z5 ^ z13;
+    uint64_t t49 = z9 ^ z10;
+    uint64_t t50 = z2 ^ z12;
+    uint64_t t51 = z2 ^ z5;
+    uint64_t t52 = z7 ^ z8;
+    uint64_t t53 = z0 ^ z3;
+    uint64_t t54 = z6 ^ z7;
+    uint64_t t55 = z16 ^ z17;
+    uint64_t t56 = z12 ^ t48;
+    uint64_t t57 = t50 ^ t53;
+    uint64_t t58 = z4 ^ t46;
+    uint64_t t59 = z3 ^ t54;
+    uint64_t t60 = t46 ^ t57;
+    uint64_t t61 = z14 ^ t57;
+    uint64_t t62 = t52 ^ t58;
+    uint64_t t63 = t49 ^ t58;
+    uint64_t t64 = z4 ^ t59;
+    uint64_t t65 = t61 ^ t62;
+    uint64_t t66 = z1 ^ t63;
+    uint64_t s0 = t59 ^ t63;
+    uint64_t s6 = t56 ^ ~t62;
+    uint64_t s7 = t48 ^ ~t60;
+    uint64_t t67 = t64 ^ t65;
+    uint64_t s3 = t53 ^ t66;
+    uint64_t s4 = t51 ^ t66;
+    uint64_t s5 = t47 ^ t65;
+    uint64_t s1 = t64 ^ ~s3;
+    uint64_t s2 = t55 ^ ~t67;
+
+    q[7] = s0;
+    q[6] = s1;
+    q[5] = s2;
+    q[4] = s3;
+    q[3] = s4;
+    q[2] = s5;
+    q[1] = s6;
+    q[0] = s7;
+}
+
+/*
+ * Applies the inverse of the S-box affine transformation, including its 0x63 constant.
+ */
+static void invAffineBitsliced(uint64_t q[8]) {
+    uint64_t q0 = ~q[0], q1 = ~q[1], q2 = q[2], q3 = q[3];
+    uint64_t q4 = q[4], q5 = ~q[5], q6 = ~q[6], q7 = q[7];
+
+    q[7] = q1 ^ q4 ^ q6;
+    q[6] = q0 ^ q3 ^ q5;
+    q[5] = q7 ^ q2 ^ q4;
+    q[4] = q6 ^ q1 ^ q3;
+    q[3] = q5 ^ q0 ^ q2;
+    q[2] = q4 ^ q7 ^ q1;
+    q[1] = q3 ^ q6 ^ q0;
+    q[0] = q2 ^ q5 ^ q7;
+}
+
+/*
+ * The inverse S-box is the inversion wrapped in the inverse affine transformation on both sides,
+ * which reuses the forward circuit: InvSBox(y) = A^-1(SBox(A^-1(y))).
+ */
+static void invSubBytesBitsliced(uint64_t q[8]) {
+    invAffineBitsliced(q);
+    subBytesBitsliced(q);
+    invAffineBitsliced(q);
+}
+
+static void shiftRowsBitsliced(uint64_t q[8]) {
+    for (int i = 0; i < 8; i++) {
+        uint64_t x = q[i];
+        q[i] = (x & 0x000000000000FFFFULL)
+            | ((x & 0x00000000FFF00000ULL) >> 4)
+            | ((x & 0x00000000000F0000ULL) << 12)
+            | ((x & 0x0000FF0000000000ULL) >> 8)
+            | ((x & 0x000000FF00000000ULL) << 8)
+            | ((x & 0xF000000000000000ULL) >> 12)
+            | ((x & 0x0FFF000000000000ULL) << 4);
+    }
+}
+
+static void invShiftRowsBitsliced(uint64_t q[8]) {
+    for (int i = 0; i < 8; i++) {
+        uint64_t x = q[i];
+        q[i] = (x & 0x000000000000FFFFULL)
+            | ((x & 0x000000000FFF0000ULL) << 4)
+            | ((x & 0x00000000F0000000ULL) >> 12)
+            | ((x & 0x000000FF00000000ULL) << 8)
+            | ((x & 0x0000FF0000000000ULL) >> 8)
+            | ((x & 0x000F000000000000ULL) << 12)
+            | ((x & 0xFFF0000000000000ULL) >> 4);
+    }
+}
+
+// Rotating a word by 16 bits moves every row up by one, by 32 bits moves it up by two
+static inline uint64_t rotateRow(uint64_t x) {
+    return (x >> 16) | (x << 48);
+}
+
+static inline uint64_t rotateTwoRows(uint64_t x) {
+    return (x << 32) | (x >> 32);
+}
+
+/*
+ * MixColumns computes b[r] = 2 * (a[r] ^ a[r + 1]) ^ a[r + 1] ^ a[r + 2] ^ a[r + 3] for every row r,
+ * where the multiplication by 2 moves each bit plane up by one and folds bit 7 back in as 0x1b.
+ */
+static void mixColumnsBitsliced(uint64_t q[8]) {
+    uint64_t q0 = q[0], q1 = q[1], q2 = q[2], q3 = q[3];
+    uint64_t q4 = q[4], q5 = q[5], q6 = q[6], q7 = q[7];
+    uint64_t r0 = rotateRow(q0), r1 = rotateRow(q1), r2 = rotateRow(q2), r3 = rotateRow(q3);
+    uint64_t r4 = rotateRow(q4), r5 = rotateRow(q5), r6 = rotateRow(q6), r7 = rotateRow(q7);
+
+    q[0] = q7 ^ r7 ^ r0 ^ rotateTwoRows(q0 ^ r0);
+    q[1] = q0 ^ r0 ^ q7 ^ r7 ^ r1 ^ rotateTwoRows(q1 ^ r1);
+    q[2] = q1 ^ r1 ^ r2 ^ rotateTwoRows(q2 ^ r2);
+    q[3] = q2 ^ r2 ^ q7 ^ r7 ^ r3 ^ rotateTwoRows(q3 ^ r3);
+    q[4] = q3 ^ r3 ^ q7 ^ r7 ^ r4 ^ rotateTwoRows(q4 ^ r4);
+    q[5] = q4 ^ r4 ^ r5 ^ rotateTwoRows(q5 ^ r5);
+    q[6] = q5 ^ r5 ^ r6 ^ rotateTwoRows(q6 ^ r6);
+    q[7] = q6 ^ r6 ^ r7 ^ rotateTwoRows(q7 ^ r7);
+}
+
+/*
+ * InvMixColumns factors into MixColumns after multiplying each column by 4x^2 + 5, that is
+ * a[r] ^= 4 * (a[r] ^ a[r + 2]), which keeps the inverse as cheap as the forward transformation.
+ */
+static void invMixColumnsBitsliced(uint64_t q[8]) {
+    uint64_t t[8];
+    for (int i = 0; i < 8; i++) {
+        t[i] = q[i] ^ rotateTwoRows(q[i]);
+    }
+    for (int n = 0; n < 2; n++) {
+        uint64_t top = t[7];
+        t[7] = t[6];
+        t[6] = t[5];
+        t[5] = t[4];
+        t[4] = t[3] ^ top;
+        t[3] = t[2] ^ top;
+        t[2] = t[1];
+        t[1] = t[0] ^ top;
+        t[0] = top;
+    }
+    for (int i = 0; i < 8; i++) {
+        q[i] ^= t[i];
+    }
+    mixColumnsBitsliced(q);
+}
+
+static inline void addRoundKeyBitsliced(uint64_t q[8], const uint64_t* roundKey) {
+    for (int i = 0; i < 8; i++) {
+        q[i] ^= roundKey[i];
+    }
+}
+
+/*
+ * Expands the compressed round keys (two words per round) into eight words per round. Each bit of
+ * a compressed word stands for the same key bit in all four blocks of a group.
+ */
+static void expandBitslicedKeys(uint64_t* roundKeys, const uint64_t* compressed, unsigned int rounds) {
+    for (unsigned int i = 0; i < 2 * (rounds + 1); i++) {
+        uint64_t x0 = compressed[i] & 0x1111111111111111ULL;
+        uint64_t x1 = (compressed[i] & 0x2222222222222222ULL) >> 1;
+        uint64_t x2 = (compressed[i] & 0x4444444444444444ULL) >> 2;
+        uint64_t x3 = (compressed[i] & 0x8888888888888888ULL) >> 3;
+        roundKeys[4 * i + 0] = (x0 << 4) - x0;
+        roundKeys[4 * i + 1] = (x1 << 4) - x1;
+        roundKeys[4 * i + 2] = (x2 << 4) - x2;
+        roundKeys[4 * i + 3] = (x3 << 4) - x3;
+    }
+}
+
+/*
+ * Loads up to AES_BITSLICED_BLOCKS blocks into the groups that hold them; missing blocks of the last
+ * group are zero.
+ */
+static void loadGroups(uint64_t q[AES_BITSLICED_GROUPS][8], const unsigned char* data, size_t numBlocks, size_t numGroups) {
+    uint32_t w[4 * AES_BITSLICED_BLOCKS] = { 0 };
+    for (size_t i = 0; i < 4 * numBlocks; i++) {
+        w[i] = loadLittleEndian32(data + 4 * i);
+    }
+    for (size_t g = 0; g < numGroups; g++) {
+        for (size_t i = 0; i < 4; i++) {
+            interleaveIn(q[g][i], q[g][i + 4], w + 16 * g + 4 * i);
+        }
+        orthogonalize(q[g]);
+    }
+}
+
+static void storeGroups(unsigned char* data, size_t numBlocks, size_t numGroups, uint64_t q[AES_BITSLICED_GROUPS][8]) {
+    uint32_t w[4 * AES_BITSLICED_BLOCKS];
+    for (size_t g = 0; g < numGroups; g++) {
+        orthogonalize(q[g]);
+        for (size_t i = 0; i < 4; i++) {
+            interleaveOut(w + 16 * g + 4 * i, q[g][i], q[g][i + 4]);
+        }
+    }
+    for (size_t i = 0; i < 4 * numBlocks; i++) {
+        storeLittleEndian32(data + 4 * i, w[i]);
+    }
+}
+
+/*
+ * Applies the S-box to each byte of a word in constant time, for the key schedule.
+ */
+static uint32_t subWordBitsliced(uint32_t x) {
+    uint64_t q[8] = { x, 0, 0, 0, 0, 0, 0, 0 };
+    orthogonalize(q);
+    subBytesBitsliced(q);
+    orthogonalize(q);
+    return static_cast<uint32_t>(q[0]);
+}
+
+/*
+ * Expands the key without table lookups and stores the round keys in bitsliced form, ready to be
+ * XORed into a group. The byte schedule in roundKey is filled as well so the instance looks like any
+ * other.
+ *
+ * @param key The 16, 24, or 32 byte cipher key, as selected by Nw.
+ */
+void AES::keyExpansionBitsliced(const unsigned char* key) {
+    static const uint32_t roundConstants[10] = { 0x01, 0x02, 0x04, 0x08, 0x10, 0x20, 0x40, 0x80, 0x1B, 0x36 };
+    const unsigned int numWords = 4 * (Nr + 1);
+    uint32_t words[4 * (AES_MAX_ROUNDS + 1)];
+
+    for (unsigned int i = 0; i < Nw; i++) {
+        words[i] = loadLittleEndian32(key + 4 * i);
+    }
+
+    // Words are little-endian, so RotWord is a right rotation and Rcon goes into the low byte
+    uint32_t temp = words[Nw - 1];
+    for (unsigned int i = Nw; i < numWords; i++) {
+        if (i % Nw == 0) {
+            temp = subWordBitsliced((temp >> 8) | (temp << 24)) ^ roundConstants[i / Nw - 1];
+        } else if (Nw > 6 && i % Nw == 4) {
+            temp = subWordBitsliced(temp);
+        }
+        temp ^= words[i - Nw];
+        words[i] = temp;
+    }
+
+    for (unsigned int i = 0; i < numWords; i++) {
+        storeLittleEndian32(roundKey + 4 * i, words[i]);
+    }
+
+    // Bitslice each round key as if it were four identical blocks, then keep one bit in four
+    uint64_t compressed[2 * (AES_MAX_ROUNDS + 1)];
+    for (unsigned int round = 0; round <= Nr; round++) {
+        uint64_t q[8];
+        interleaveIn(q[0], q[4], words + 4 * round);
+        q[1] = q[2] = q[3] = q[0];
+        q[5] = q[6] = q[7] = q[4];
+        orthogonalize(q);
+
+        compressed[2 * round] = (q[0] & 0x1111111111111111ULL) | (q[1] & 0x2222222222222222ULL)
+            | (q[2] & 0x4444444444444444ULL) | (q[3] & 0x8888888888888888ULL);
+        compressed[2 * round + 1] = (q[4] & 0x1111111111111111ULL) | (q[5] & 0x2222222222222222ULL)
+            | (q[6] & 0x4444444444444444ULL) | (q[7] & 0x8888888888888888ULL);
+    }
+    expandBitslicedKeys(bitslicedRoundKey, compressed, Nr);
+}
+
+/*
+ * Encrypts consecutive blocks in place, AES_BITSLICED_BLOCKS blocks per pass. A final partial pass
+ * only runs the groups that hold blocks.
+ *
+ * @param data A pointer to numBlocks * AES_BLOCK_SIZE bytes to be encrypted.
+ * @param numBlocks The number of blocks to encrypt.
+ */
+void AES::encryptBlocksBitsliced(unsigned char* data, size_t numBlocks) const {
+    const uint64_t* rk = bitslicedRoundKey;
+
+    for (size_t i = 0; i < numBlocks; i += AES_BITSLICED_BLOCKS) {
+        size_t batch = numBlocks - i < AES_BITSLICED_BLOCKS ? numBlocks - i : AES_BITSLICED_BLOCKS;
+        unsigned char* blocks = data + i * AES_BLOCK_SIZE;
+        size_t numGroups = (batch + 3) / 4;
+        uint64_t q[AES_BITSLICED_GROUPS][8];
+
+        loadGroups(q, blocks, batch, numGroups);
+        for (size_t g = 0; g < numGroups; g++) {
+            addRoundKeyBitsliced(q[g], rk);
+        }
+        for (unsigned int round = 1; round < Nr; round++) {
+            for (size_t g = 0; g < numGroups; g++) {
+                subBytesBitsliced(q[g]);
+                shiftRowsBitsliced(q[g]);
+                mixColumnsBitsliced(q[g]);
+                addRoundKeyBitsliced(q[g], rk + 8 * round);
+            }
+        }
+        for (size_t g = 0; g < numGroups; g++) {
+            subBytesBitsliced(q[g]);
+            shiftRowsBitsliced(q[g]);
+            addRoundKeyBitsliced(q[g], rk + 8 * Nr);
+        }
+        storeGroups(blocks, batch, numGroups, q);
+    }
+}
+
+/*
+ * Decrypts consecutive blocks in place with the inverse cipher, AES_BITSLICED_BLOCKS blocks per pass,
+ * running only the groups that hold blocks in a final partial pass. The inverse transformations are
+ * cheap in bitsliced form, so the encryption round keys are used directly in reverse order.
+ *
+ * @param data A pointer to numBlocks * AES_BLOCK_SIZE bytes to be decrypted.
+ * @param numBlocks The number of blocks to decrypt.
+ */
+void AES::decryptBlocksBitsliced(unsigned char* data, size_t numBlocks) const {
+    const uint64_t* rk = bitslicedRoundKey;
+
+    for (size_t i = 0; i < numBlocks; i += AES_BITSLICED_BLOCKS) {
+        size_t batch = numBlocks - i < AES_BITSLICED_BLOCKS ? numBlocks - i : AES_BITSLICED_BLOCKS;
+        unsigned char* blocks = data + i * AES_BLOCK_SIZE;
+        size_t numGroups = (batch + 3) / 4;
+        uint64_t q[AES_BITSLICED_GROUPS][8];
+
+        loadGroups(q, blocks, batch, numGroups);
+        for (size_t g = 0; g < numGroups; g++) {
+            addRoundKeyBitsliced(q[g], rk + 8 * Nr);
+        }
+        for (unsigned int round = Nr - 1; round > 0; round--) {
+            for (size_t g = 0; g < numGroups; g++) {
+                invShiftRowsBitsliced(q[g]);
+                invSubBytesBitsliced(q[g]);
+                addRoundKeyBitsliced(q[g], rk + 8 * round);
+                invMixColumnsBitsliced(q[g]);
+            }
+        }
+        for (size_t g = 0; g < numGroups; g++) {
+            invShiftRowsBitsliced(q[g]);
+            invSubBytesBitsliced(q[g]);
+            addRoundKeyBitsliced(q[g], rk);
+        }
+        storeGroups(blocks, batch, numGroups, q);
+    }
+}
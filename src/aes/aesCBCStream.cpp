@@ -0,0 +1,218 @@
+/*
+ * Copyright 2023-2024 The Gestalt Project Authors. All Rights Reserved.
+ *
+ * Licensed under the MIT License. See the file LICENSE for the full text.
+ */
+
+/*
+ * aesCBCStream.cpp
+ *
+ * This file contains the streaming AES-CBC encryptor and decryptor.
+ *
+ * Both objects carry the chaining block and at most one block of input between calls. Each update
+ * first completes the carried block from the new input, then copies the remaining whole blocks to the
+ * output and runs them through the multi-block CBC engine, so the data is never buffered internally
+ * and memory use does not depend on the message size.
+ */
+
+#include <cstring>
+#include <stdexcept>
+
+#include <gestalt/aes.h>
+#include "aesCore.h"
+
+static void checkNotFinalized(bool finalized) {
+    if (finalized) {
+        throw std::runtime_error("CBC stream is finalized, reset must be called before processing more data.");
+    }
+}
+
+/*
+ * Creates an encryptor for one message.
+ *
+ * @param key The key bytes.
+ * @param keyLen The key length in bytes: 16, 24, or 32.
+ * @param iv The 16 byte initialization vector.
+ * @param backend The AES engine to use.
+ * @throws std::invalid_argument if the key size is not 128, 192, or 256 bits.
+ */
+AESCBCEncryptor::AESCBCEncryptor(const uint8_t* key, size_t keyLen, const uint8_t iv[16], AESBackend backend)
+    : cipher(key, keyLen, backend) {
+    reset(iv);
+}
+
+AESCBCEncryptor::AESCBCEncryptor(const AES& cipher, const uint8_t iv[16]) : cipher(cipher) {
+    reset(iv);
+}
+
+/*
+ * Discards any buffered input and starts a new message.
+ *
+ * @param iv The 16 byte initialization vector of the new message.
+ */
+void AESCBCEncryptor::reset(const uint8_t iv[16]) {
+    memcpy(chain, iv, AES_BLOCK_SIZE);
+    pendingLen = 0;
+    finalized = false;
+}
+
+/*
+ * Encrypts the next piece of the message.
+ *
+ * @param in The message bytes.
+ * @param length The number of bytes, may be zero.
+ * @param out Output buffer of at least length + 15 bytes, must not overlap in.
+ * @result The number of ciphertext bytes written, a multiple of 16.
+ * @throws std::runtime_error if called after finalize.
+ */
+size_t AESCBCEncryptor::update(const uint8_t* in, size_t length, uint8_t* out) {
+    checkNotFinalized(finalized);
+
+    size_t numBlocks = (pendingLen + length) / AES_BLOCK_SIZE;
+    if (numBlocks == 0) {
+        memcpy(pending + pendingLen, in, length);
+        pendingLen += length;
+        return 0;
+    }
+
+    size_t consumed = 0;
+    size_t written = 0;
+    if (pendingLen > 0) {
+        consumed = AES_BLOCK_SIZE - pendingLen;
+        memcpy(out, pending, pendingLen);
+        memcpy(out + pendingLen, in, consumed);
+        written = AES_BLOCK_SIZE;
+    }
+
+    size_t rest = numBlocks * AES_BLOCK_SIZE - written;
+    memcpy(out + written, in + consumed, rest);
+    consumed += rest;
+    cipher.encryptBlocksCBC(out, numBlocks, chain);
+
+    pendingLen = length - consumed;
+    memcpy(pending, in + consumed, pendingLen);
+    return numBlocks * AES_BLOCK_SIZE;
+}
+
+/*
+ * Pads and encrypts the buffered tail of the message.
+ *
+ * @param out Output buffer of at least 16 bytes.
+ * @result The number of ciphertext bytes written, always 16.
+ * @throws std::runtime_error if the message is already finalized.
+ */
+size_t AESCBCEncryptor::finalize(uint8_t* out) {
+    checkNotFinalized(finalized);
+
+    memcpy(out, pending, pendingLen);
+    memset(out + pendingLen, static_cast<int>(AES_BLOCK_SIZE - pendingLen), AES_BLOCK_SIZE - pendingLen);
+    cipher.encryptBlocksCBC(out, 1, chain);
+
+    pendingLen = 0;
+    finalized = true;
+    return AES_BLOCK_SIZE;
+}
+
+/*
+ * Creates a decryptor for one message.
+ *
+ * @param key The key bytes.
+ * @param keyLen The key length in bytes: 16, 24, or 32.
+ * @param iv The 16 byte initialization vector.
+ * @param backend The AES engine to use.
+ * @throws std::invalid_argument if the key size is not 128, 192, or 256 bits.
+ */
+AESCBCDecryptor::AESCBCDecryptor(const uint8_t* key, size_t keyLen, const uint8_t iv[16], AESBackend backend)
+    : cipher(key, keyLen, backend) {
+    reset(iv);
+}
+
+AESCBCDecryptor::AESCBCDecryptor(const AES& cipher, const uint8_t iv[16]) : cipher(cipher) {
+    reset(iv);
+}
+
+/*
+ * Discards any buffered input and starts a new message.
+ *
+ * @param iv The 16 byte initialization vector of the new message.
+ */
+void AESCBCDecryptor::reset(const uint8_t iv[16]) {
+    memcpy(chain, iv, AES_BLOCK_SIZE);
+    pendingLen = 0;
+    finalized = false;
+}
+
+/*
+ * Decrypts the next piece of the ciphertext. The last complete block seen so far may hold the
+ * padding, so it is kept back until more input arrives or finalize is called.
+ *
+ * @param in The ciphertext bytes.
+ * @param length The number of bytes, may be zero.
+ * @param out Output buffer of at least length + 15 bytes, must not overlap in.
+ * @result The number of plaintext bytes written, a multiple of 16.
+ * @throws std::runtime_error if called after finalize.
+ */
+size_t AESCBCDecryptor::update(const uint8_t* in, size_t length, uint8_t* out) {
+    checkNotFinalized(finalized);
+
+    size_t total = pendingLen + length;
+    if (total <= AES_BLOCK_SIZE) {
+        memcpy(pending + pendingLen, in, length);
+        pendingLen = total;
+        return 0;
+    }
+
+    // Every complete block except one that could be the last is released
+    size_t numBlocks = (total - 1) / AES_BLOCK_SIZE;
+
+    size_t consumed = 0;
+    size_t written = 0;
+    if (pendingLen > 0) {
+        consumed = AES_BLOCK_SIZE - pendingLen;
+        memcpy(out, pending, pendingLen);
+        memcpy(out + pendingLen, in, consumed);
+        written = AES_BLOCK_SIZE;
+    }
+
+    size_t rest = numBlocks * AES_BLOCK_SIZE - written;
+    memcpy(out + written, in + consumed, rest);
+    consumed += rest;
+    cipher.decryptBlocksCBC(out, numBlocks, chain);
+
+    pendingLen = length - consumed;
+    memcpy(pending, in + consumed, pendingLen);
+    return numBlocks * AES_BLOCK_SIZE;
+}
+
+/*
+ * Decrypts the held back last block and removes the PKCS7 padding. The message is finished even if
+ * the padding turns out to be invalid; reset starts the next one.
+ *
+ * @param out Output buffer of at least 15 bytes.
+ * @result The number of plaintext bytes written, 0 to 15.
+ * @throws std::invalid_argument if the ciphertext was empty or not a multiple of the block size.
+ * @throws std::runtime_error if the padding is invalid or the message is already finalized.
+ */
+size_t AESCBCDecryptor::finalize(uint8_t* out) {
+    checkNotFinalized(finalized);
+    if (pendingLen != AES_BLOCK_SIZE) {
+        throw std::invalid_argument("Invalid ciphertext length. Expected a multiple of the AES block size.");
+    }
+
+    uint8_t block[AES_BLOCK_SIZE];
+    memcpy(block, pending, AES_BLOCK_SIZE);
+    cipher.decryptBlocksCBC(block, 1, chain);
+
+    // The chaining value has moved past the last block, so there is no way back into this message
+    pendingLen = 0;
+    finalized = true;
+
+    size_t paddingLength = block[AES_BLOCK_SIZE - 1];
+    if (paddingLength == 0 || paddingLength > AES_BLOCK_SIZE) {
+        throw std::runtime_error("Invalid padding length.");
+    }
+
+    size_t outLen = AES_BLOCK_SIZE - paddingLength;
+    memcpy(out, block, outLen);
+    return outLen;
+}
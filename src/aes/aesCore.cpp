@@ -43,11 +43,13 @@
  * defined in the AES standard.
  */
 
-#include <sstream>
 #include <cstring>
+#include <stdexcept>
 
 #include "aesCore.h"
 #include "aesConstants.h"
+#include "cpu_features/cpu_features.h"
+#include "utils.h"
 
 enum class AESKeySize : int {
     AES_128 = 128,
@@ -55,6 +57,66 @@ enum class AESKeySize : int {
     AES_256 = 256
 };
 
+/*
+ * Reports whether the given backend can run on the executing CPU.
+ *
+ * @param backend The backend to check.
+ * @return True if an AES instance may be constructed with this backend.
+ */
+bool isAESBackendSupported(AESBackend backend) {
+    switch (backend) {
+    case AESBackend::AESNI:
+        return getCPUFeatures().aesni;
+    default:
+        return true;
+    }
+}
+
+/*
+ * Resolves AESBackend::Auto to a concrete backend and validates explicit requests.
+ *
+ * Auto selects AES-NI when the CPU supports it and falls back to the T-table engine otherwise. The
+ * bitsliced engine is not chosen by default: it only pays off on eight independent blocks, and
+ * single-block and chained work (CBC encryption, CMAC, key wrap, GCM and XTS setup) would run no
+ * faster than on the byte engine and far below the T-tables. Configuring the library with GESTALT_AES_BACKEND forces the
+ * backend chosen for Auto instead, e.g. Bitsliced where constant time matters more than speed.
+ *
+ * @param requested The backend passed to the AES constructor.
+ * @throws std::runtime_error if the requested backend is not supported on this CPU.
+ */
+static AESBackend resolveBackend(AESBackend requested) {
+    if (requested == AESBackend::Auto) {
+#if defined(GESTALT_AES_FORCE_BACKEND)
+        requested = AESBackend::GESTALT_AES_FORCE_BACKEND;
+#else
+        return isAESBackendSupported(AESBackend::AESNI) ? AESBackend::AESNI : AESBackend::TTable;
+#endif
+    }
+
+    if (!isAESBackendSupported(requested)) {
+        throw std::runtime_error("Requested AES backend is not supported on this CPU.");
+    }
+    return requested;
+}
+
+/*
+ * Decodes a hex key into raw bytes.
+ *
+ * @param key The key in hexadecimal format.
+ * @param keyBytes Output buffer of key.size() / 2 bytes.
+ * @throws std::invalid_argument if the key contains a non-hexadecimal character.
+ */
+static void parseHexKey(const std::string& key, unsigned char* keyBytes) {
+    for (size_t i = 0; i < key.size() / 2; i++) {
+        int high = hexDigitValue(key[2 * i]);
+        int low = hexDigitValue(key[2 * i + 1]);
+        if (high < 0 || low < 0) {
+            throw std::invalid_argument("Invalid key. Expected hexadecimal digits.");
+        }
+        keyBytes[i] = static_cast<unsigned char>((high << 4) | low);
+    }
+}
+
 /*
  * AES Constructor
  *
@@ -63,11 +125,40 @@ enum class AESKeySize : int {
  * Performs key expansion to generate the round keys.
  *
  * @param key A string representing the encryption key in hexadecimal format.
+ * @param backend The round engine used by encryptBlock and decryptBlock.
+ * @throws std::invalid_argument if the key size is not 128, 192, or 256 bits or the key is not hex.
+ */
+AES::AES(const std::string& key, AESBackend backend) : backend(resolveBackend(backend)) {
+    setKeySize(key.size() * 4);
+
+    unsigned char keyBytes[32];
+    parseHexKey(key, keyBytes);
+    initializeKeySchedule(keyBytes);
+}
+
+/*
+ * AES Constructor
+ *
+ * Initializes the AES instance with a raw binary key, without any hex decoding.
+ *
+ * @param key A pointer to the 16, 24, or 32 byte encryption key.
+ * @param keyLen The length of the key in bytes.
+ * @param backend The round engine used by encryptBlock and decryptBlock.
  * @throws std::invalid_argument if the key size is not 128, 192, or 256 bits.
  */
-AES::AES(const std::string& key) {
-    // // Determine key size and set Nw (number of words in key) and Nr (number of rounds)
-    switch (key.size() * 4) {
+AES::AES(const unsigned char* key, size_t keyLen, AESBackend backend) : backend(resolveBackend(backend)) {
+    setKeySize(keyLen * 8);
+    initializeKeySchedule(key);
+}
+
+/*
+ * Sets the number of words in the key (Nw) and the number of rounds (Nr) from the key size.
+ *
+ * @param keyBits The key size in bits.
+ * @throws std::invalid_argument if the key size is not 128, 192, or 256 bits.
+ */
+void AES::setKeySize(size_t keyBits) {
+    switch (keyBits) {
     case static_cast<int>(AESKeySize::AES_128):
         Nw = 4;
         Nr = 10;
@@ -83,43 +174,346 @@ AES::AES(const std::string& key) {
     default:
         throw std::invalid_argument("Invalid key size. Expected 128, 192, or 256 bits.");
     }
+}
+
+/*
+ * Expands the key into the schedules used by the selected backend. The decryption schedules are
+ * derived here once, so no per-message or per-block key work is left for decryption.
+ *
+ * @param key The raw key of 4 * Nw bytes.
+ */
+void AES::initializeKeySchedule(const unsigned char* key) {
+    // Each backend only builds the schedules it uses
+    switch (backend) {
+    case AESBackend::AESNI:
+        keyExpansionAESNI(key);
+        break;
+    case AESBackend::TTable:
+        keyExpansion(key, roundKey);
+        expandRoundKeyWords();
+        break;
+    case AESBackend::Bitsliced:
+        keyExpansionBitsliced(key);
+        break;
+    default:
+        keyExpansion(key, roundKey);
+        break;
+    }
+}
+
+/*
+ * Encrypts a single AES block (16 bytes) in place using the backend selected at construction.
+ *
+ * @param state A pointer to the input block to be encrypted.
+ */
+void AES::encryptBlock(unsigned char* state) const {
+    switch (backend) {
+    case AESBackend::Reference:
+        encryptBlockReference(state);
+        break;
+    case AESBackend::AESNI:
+        encryptBlocksAESNI(state, 1);
+        break;
+    case AESBackend::Bitsliced:
+        encryptBlocksBitsliced(state, 1);
+        break;
+    default:
+        encryptBlockTTable(state);
+        break;
+    }
+}
+
+/*
+ * Decrypts a single AES block (16 bytes) in place using the backend selected at construction.
+ *
+ * @param state A pointer to the input block to be decrypted.
+ */
+void AES::decryptBlock(unsigned char* state) const {
+    switch (backend) {
+    case AESBackend::Reference:
+        decryptBlockReference(state);
+        break;
+    case AESBackend::AESNI:
+        decryptBlocksAESNI(state, 1);
+        break;
+    case AESBackend::Bitsliced:
+        decryptBlocksBitsliced(state, 1);
+        break;
+    default:
+        decryptBlockTTable(state);
+        break;
+    }
+}
+
+/*
+ * Encrypts consecutive AES blocks in place, each block independently (ECB).
+ * Hardware backends interleave several blocks to hide the latency of the round instructions.
+ *
+ * @param data A pointer to numBlocks * AES_BLOCK_SIZE bytes to be encrypted.
+ * @param numBlocks The number of blocks to encrypt.
+ */
+void AES::encryptBlocks(unsigned char* data, size_t numBlocks) const {
+    if (backend == AESBackend::AESNI) {
+        encryptBlocksAESNI(data, numBlocks);
+        return;
+    }
+    if (backend == AESBackend::Bitsliced) {
+        encryptBlocksBitsliced(data, numBlocks);
+        return;
+    }
+    for (size_t i = 0; i < numBlocks; i++) {
+        encryptBlock(data + i * AES_BLOCK_SIZE);
+    }
+}
+
+/*
+ * Decrypts consecutive AES blocks in place, each block independently (ECB).
+ * Hardware backends interleave several blocks to hide the latency of the round instructions.
+ *
+ * @param data A pointer to numBlocks * AES_BLOCK_SIZE bytes to be decrypted.
+ * @param numBlocks The number of blocks to decrypt.
+ */
+void AES::decryptBlocks(unsigned char* data, size_t numBlocks) const {
+    if (backend == AESBackend::AESNI) {
+        decryptBlocksAESNI(data, numBlocks);
+        return;
+    }
+    if (backend == AESBackend::Bitsliced) {
+        decryptBlocksBitsliced(data, numBlocks);
+        return;
+    }
+    for (size_t i = 0; i < numBlocks; i++) {
+        decryptBlock(data + i * AES_BLOCK_SIZE);
+    }
+}
+
+/*
+ * XORs a 16 byte block into another as two 64-bit words.
+ */
+static inline void xorBlockInPlace(unsigned char* dst, const unsigned char* src) {
+    uint64_t d[2], s[2];
+    memcpy(d, dst, AES_BLOCK_SIZE);
+    memcpy(s, src, AES_BLOCK_SIZE);
+    d[0] ^= s[0];
+    d[1] ^= s[1];
+    memcpy(dst, d, AES_BLOCK_SIZE);
+}
+
+/*
+ * Encrypts consecutive AES blocks in place in CBC mode.
+ *
+ * The chaining value never leaves binary form; on return iv holds the last ciphertext block so a
+ * following call continues the same chain.
+ *
+ * @param data A pointer to numBlocks * AES_BLOCK_SIZE bytes to be encrypted.
+ * @param numBlocks The number of blocks to encrypt.
+ * @param iv The 16 byte chaining value, updated in place.
+ */
+void AES::encryptBlocksCBC(unsigned char* data, size_t numBlocks, unsigned char iv[AES_BLOCK_SIZE]) const {
+    if (numBlocks == 0) {
+        return;
+    }
+    if (backend == AESBackend::AESNI) {
+        encryptCBCAESNI(data, numBlocks, iv);
+        return;
+    }
+
+    const unsigned char* chain = iv;
+    for (size_t i = 0; i < numBlocks; i++) {
+        unsigned char* block = data + i * AES_BLOCK_SIZE;
+        xorBlockInPlace(block, chain);
+        encryptBlock(block);
+        chain = block;
+    }
+    memcpy(iv, chain, AES_BLOCK_SIZE);
+}
+
+/*
+ * Encrypts numBlocks blocks of several independent CBC streams in place, each under its own context.
+ *
+ * When every context uses the AES-NI backend the streams are interleaved block by block so their round
+ * instructions overlap. Otherwise each stream is encrypted on its own with encryptBlocksCBC.
+ *
+ * @param ciphers The context of each stream.
+ * @param data The numBlocks * AES_BLOCK_SIZE byte buffer of each stream.
+ * @param ivs The 16 byte chaining value of each stream, updated in place.
+ * @param numLanes The number of streams, at most AES_MULTI_BUFFER_LANES.
+ * @param numBlocks The number of blocks to encrypt in every stream.
+ * @throws std::invalid_argument if numLanes exceeds AES_MULTI_BUFFER_LANES.
+ */
+void AES::encryptBlocksCBCLanes(
+    const AES* const* ciphers, unsigned char* const* data, unsigned char* const* ivs, size_t numLanes, size_t numBlocks
+) {
+    if (numLanes > AES_MULTI_BUFFER_LANES) {
+        throw std::invalid_argument("Too many streams. Expected at most AES_MULTI_BUFFER_LANES.");
+    }
+
+    bool interleave = true;
+    for (size_t lane = 0; lane < numLanes; lane++) {
+        interleave = interleave && ciphers[lane]->backend == AESBackend::AESNI;
+    }
+
+    if (interleave) {
+        encryptCBCLanesAESNI(ciphers, data, ivs, numLanes, numBlocks);
+        return;
+    }
+    for (size_t lane = 0; lane < numLanes; lane++) {
+        ciphers[lane]->encryptBlocksCBC(data[lane], numBlocks, ivs[lane]);
+    }
+}
+
+/*
+ * Decrypts consecutive AES blocks in place in CBC mode.
+ *
+ * Every plaintext block is D(C[i]) ^ C[i - 1], so the block decryptions are independent. They are
+ * done AES_CBC_DECRYPT_BATCH blocks at a time through decryptBlocks, which lets the hardware backend
+ * interleave them and the table backends overlap their lookups, and the chaining XOR is applied
+ * afterwards from a copy of the ciphertext.
+ *
+ * On return iv holds the last ciphertext block so a following call continues the same chain.
+ *
+ * @param data A pointer to numBlocks * AES_BLOCK_SIZE bytes to be decrypted.
+ * @param numBlocks The number of blocks to decrypt.
+ * @param iv The 16 byte chaining value, updated in place.
+ */
+void AES::decryptBlocksCBC(unsigned char* data, size_t numBlocks, unsigned char iv[AES_BLOCK_SIZE]) const {
+    if (backend == AESBackend::AESNI) {
+        decryptCBCAESNI(data, numBlocks, iv);
+        return;
+    }
+
+    unsigned char ciphertext[AES_CBC_DECRYPT_BATCH * AES_BLOCK_SIZE];
+    for (size_t i = 0; i < numBlocks; i += AES_CBC_DECRYPT_BATCH) {
+        size_t batch = numBlocks - i < AES_CBC_DECRYPT_BATCH ? numBlocks - i : AES_CBC_DECRYPT_BATCH;
+        unsigned char* blocks = data + i * AES_BLOCK_SIZE;
+
+        memcpy(ciphertext, blocks, batch * AES_BLOCK_SIZE);
+        decryptBlocks(blocks, batch);
+
+        xorBlockInPlace(blocks, iv);
+        for (size_t j = 1; j < batch; j++) {
+            xorBlockInPlace(blocks + j * AES_BLOCK_SIZE, ciphertext + (j - 1) * AES_BLOCK_SIZE);
+        }
+        memcpy(iv, ciphertext + (batch - 1) * AES_BLOCK_SIZE, AES_BLOCK_SIZE);
+    }
+}
+
+static inline uint64_t loadBigEndian64(const unsigned char* in) {
+    uint64_t value = 0;
+    for (int i = 0; i < 8; i++) {
+        value = (value << 8) | in[i];
+    }
+    return value;
+}
 
-    // Allocate memory for round keys and perform key expansion
-    roundKey = new unsigned char[AES_BLOCK_SIZE * (Nr + 1)];
-    keyExpansion(key, roundKey);
+static inline void storeBigEndian64(unsigned char* out, uint64_t value) {
+    for (int i = 7; i >= 0; i--) {
+        out[i] = static_cast<unsigned char>(value);
+        value >>= 8;
+    }
 }
 
-// Deconstructor 
-AES::~AES() {
-    delete[] roundKey;
+/*
+ * XORs length bytes of keystream into in and writes the result to out, eight bytes at a time.
+ */
+static inline void xorKeystream(const unsigned char* in, unsigned char* out, const unsigned char* keystream, size_t length) {
+    size_t i = 0;
+    for (; i + 8 <= length; i += 8) {
+        uint64_t a, b;
+        memcpy(&a, in + i, 8);
+        memcpy(&b, keystream + i, 8);
+        a ^= b;
+        memcpy(out + i, &a, 8);
+    }
+    for (; i < length; i++) {
+        out[i] = in[i] ^ keystream[i];
+    }
 }
 
-// Copy constructor
-AES::AES(AES& other) {
-    Nw = other.Nw;
-    Nr = other.Nr;
-    roundKey = new unsigned char[AES_BLOCK_SIZE * (Nr + 1)];
-    std::copy(other.roundKey, other.roundKey + AES_BLOCK_SIZE * (Nr + 1), roundKey);
+/*
+ * Writes numBlocks successive counter blocks to keystream, encrypts them and advances the counter.
+ */
+void AES::generateKeystream(unsigned char* keystream, size_t numBlocks, uint64_t& high, uint64_t& low) const {
+    for (size_t i = 0; i < numBlocks; i++) {
+        storeBigEndian64(keystream + i * AES_BLOCK_SIZE, high);
+        storeBigEndian64(keystream + i * AES_BLOCK_SIZE + 8, low);
+        if (++low == 0) {
+            high++;
+        }
+    }
+    encryptBlocks(keystream, numBlocks);
 }
 
-// Assignment operator
-AES& AES::operator=(const AES& other) {
-    if (this != &other) {
-        delete[] roundKey;
-        Nw = other.Nw;
-        Nr = other.Nr;
-        roundKey = new unsigned char[AES_BLOCK_SIZE * (Nr + 1)];
-        std::copy(other.roundKey, other.roundKey + AES_BLOCK_SIZE * (Nr + 1), roundKey);
+/*
+ * Encrypts or decrypts (the operations are identical) length bytes in CTR mode.
+ *
+ * The keystream is the encryption of successive counter blocks, where counter is the first block and
+ * each following block adds one to the whole block as a 128-bit big-endian integer. Counter blocks are
+ * encrypted AES_CTR_BATCH at a time (AES_NI_PARALLEL_BLOCKS in registers on the AES-NI backend), so
+ * the round pipeline stays full.
+ *
+ * Because block i of the keystream only depends on counter + i, any position can be reached directly:
+ * offset is the keystream byte position of in[0], which lets a caller start in the middle of a stream
+ * or split a buffer between threads.
+ *
+ * @param in The input bytes.
+ * @param out The output buffer of length bytes, may alias in.
+ * @param length The number of bytes to process.
+ * @param counter The 16 byte initial counter block.
+ * @param offset The keystream byte position of the first input byte.
+ */
+void AES::applyCTR(
+    const unsigned char* in, unsigned char* out, size_t length, const unsigned char counter[AES_BLOCK_SIZE], uint64_t offset
+) const {
+    uint64_t high = loadBigEndian64(counter);
+    uint64_t low = loadBigEndian64(counter + 8);
+
+    uint64_t blockOffset = offset / AES_BLOCK_SIZE;
+    low += blockOffset;
+    if (low < blockOffset) {
+        high++;
+    }
+
+    unsigned char keystream[AES_CTR_BATCH * AES_BLOCK_SIZE];
+
+    // Leading partial block when starting in the middle of a keystream block
+    size_t skip = static_cast<size_t>(offset % AES_BLOCK_SIZE);
+    if (skip != 0 && length > 0) {
+        size_t partial = AES_BLOCK_SIZE - skip < length ? AES_BLOCK_SIZE - skip : length;
+        generateKeystream(keystream, 1, high, low);
+        xorKeystream(in, out, keystream + skip, partial);
+        in += partial;
+        out += partial;
+        length -= partial;
+    }
+
+    size_t numBlocks = length / AES_BLOCK_SIZE;
+    if (backend == AESBackend::AESNI) {
+        encryptCTRAESNI(in, out, numBlocks, high, low);
+    } else {
+        for (size_t i = 0; i < numBlocks; i += AES_CTR_BATCH) {
+            size_t batch = numBlocks - i < AES_CTR_BATCH ? numBlocks - i : AES_CTR_BATCH;
+            generateKeystream(keystream, batch, high, low);
+            xorKeystream(in + i * AES_BLOCK_SIZE, out + i * AES_BLOCK_SIZE, keystream, batch * AES_BLOCK_SIZE);
+        }
+    }
+    in += numBlocks * AES_BLOCK_SIZE;
+    out += numBlocks * AES_BLOCK_SIZE;
+    length -= numBlocks * AES_BLOCK_SIZE;
+
+    // Trailing partial block
+    if (length > 0) {
+        generateKeystream(keystream, 1, high, low);
+        xorKeystream(in, out, keystream, length);
     }
-    return *this;
 }
 
 /*
- * Encrypts a single AES block (16 bytes) in place.
+ * Encrypts a single AES block (16 bytes) in place with the byte-oriented reference engine.
  *
  * @param state A pointer to the input block to be encrypted.
  */
-void AES::encryptBlock(unsigned char* state) {
+void AES::encryptBlockReference(unsigned char* state) const {
     addRoundKey(state, roundKey);
     size_t round = 1;
     while (round < Nr) {
@@ -135,11 +529,11 @@ void AES::encryptBlock(unsigned char* state) {
 }
 
 /*
- * Decrypts a single AES block (16 bytes) in place.
+ * Decrypts a single AES block (16 bytes) in place with the byte-oriented reference engine.
  *
  * @param state A pointer to the input block to be decrypted.
  */
-void AES::decryptBlock(unsigned char* state) {
+void AES::decryptBlockReference(unsigned char* state) const {
     addRoundKey(state, roundKey + Nr * AES_BLOCK_SIZE);
     size_t round = Nr - 1;
     while (round > 0) {
@@ -159,7 +553,7 @@ void AES::decryptBlock(unsigned char* state) {
  *
  * @param state The state array to be transformed.
  */
-void AES::subByte(unsigned char* state) {
+void AES::subByte(unsigned char* state) const {
     state[0] = SBOX[state[0]];
     state[1] = SBOX[state[1]];
     state[2] = SBOX[state[2]];
@@ -183,7 +577,7 @@ void AES::subByte(unsigned char* state) {
  *
  * @param state The state array to be transformed.
  */
-void AES::shiftRows(unsigned char* state) {
+void AES::shiftRows(unsigned char* state) const {
     unsigned char tmp[AES_BLOCK_SIZE];
 
 	/* Column 1 */
@@ -218,7 +612,7 @@ void AES::shiftRows(unsigned char* state) {
  *
  * @param state The state array to be transformed.
  */
-void AES::mixColumns(unsigned char* state) {
+void AES::mixColumns(unsigned char* state) const {
     unsigned char tmp[AES_BLOCK_SIZE];
 
     tmp[0] = GF_MUL_TABLE[2][state[0]] ^ GF_MUL_TABLE[3][state[1]] ^ state[2] ^ state[3];
@@ -250,7 +644,7 @@ void AES::mixColumns(unsigned char* state) {
  * @param state The state array to which the round key is added.
  * @param roundKey Pointer to the round key array.
  */
-void AES::addRoundKey(unsigned char* state, const unsigned char* roundKey) {
+void AES::addRoundKey(unsigned char* state, const unsigned char* roundKey) const {
     state[0] ^= roundKey[0];
     state[1] ^= roundKey[1];
     state[2] ^= roundKey[2];
@@ -274,7 +668,7 @@ void AES::addRoundKey(unsigned char* state, const unsigned char* roundKey) {
  *
  * @param state The state array to be transformed.
  */
-void AES::invSubByte(unsigned char state[AES_BLOCK_SIZE]) {
+void AES::invSubByte(unsigned char state[AES_BLOCK_SIZE]) const {
     state[0] = INVSBOX[state[0]];
     state[1] = INVSBOX[state[1]];
     state[2] = INVSBOX[state[2]];
@@ -298,7 +692,7 @@ void AES::invSubByte(unsigned char state[AES_BLOCK_SIZE]) {
  *
  * @param state The state array to be transformed.
  */
-void AES::invShiftRows(unsigned char state[AES_BLOCK_SIZE]) {
+void AES::invShiftRows(unsigned char state[AES_BLOCK_SIZE]) const {
     unsigned char tmp[AES_BLOCK_SIZE];
 
 	/* Column 1 */
@@ -333,7 +727,7 @@ void AES::invShiftRows(unsigned char state[AES_BLOCK_SIZE]) {
  *
  * @param state The state array to be transformed.
  */
-void AES::invMixColumns(unsigned char state[AES_BLOCK_SIZE]) {
+void AES::invMixColumns(unsigned char state[AES_BLOCK_SIZE]) const {
     unsigned char tmp[AES_BLOCK_SIZE];
 
     tmp[0]  = GF_MUL_TABLE[14][state[0]] ^ GF_MUL_TABLE[11][state[1]] ^ GF_MUL_TABLE[13][state[2]] ^ GF_MUL_TABLE[9][state[3]];
@@ -369,19 +763,25 @@ void AES::invMixColumns(unsigned char state[AES_BLOCK_SIZE]) {
  * @param roundKey Pointer to the array where the round keys will be stored.
  */
 void AES::keyExpansion(const std::string& key, unsigned char* roundKey) {
-    unsigned char temp[4] = { 0x00, 0x00, 0x00, 0x00 };
+    unsigned char keyBytes[32];
+    parseHexKey(key.substr(0, 8 * Nw), keyBytes);
+    keyExpansion(keyBytes, roundKey);
+}
 
-    unsigned int i = 0;
-    for (i = 0; i < 4 * Nw; i++) {
-        int index = i * 2;
-        // Extract two hexadecimal characters
-        std::string hexByte = key.substr(index, 2);
+/*
+ * Key Expansion
+ *
+ * Expands a raw binary key into a key schedule for encryption and decryption.
+ *
+ * @param key The original encryption key of 4 * Nw bytes.
+ * @param roundKey Pointer to the array where the round keys will be stored.
+ */
+void AES::keyExpansion(const unsigned char* key, unsigned char* roundKey) {
+    unsigned char temp[4] = { 0x00, 0x00, 0x00, 0x00 };
 
-        // Convert the hexadecimal string to an unsigned char
-        roundKey[i] = static_cast<unsigned char>(std::stoi(hexByte, nullptr, 16));
-    }
+    memcpy(roundKey, key, 4 * Nw);
 
-    i = 4 * Nw;
+    unsigned int i = 4 * Nw;
     while (i < AES_BLOCK_SIZE * (Nr + 1)) {
         temp[0] = roundKey[i - 4 + 0];
         temp[1] = roundKey[i - 4 + 1];
@@ -438,37 +838,3 @@ void AES::subWord(unsigned char temp[4]) {
 void AES::rcon(unsigned char temp[4], int round) {
     temp[0] ^= RCON[round];
 }
-
-/*
- * Applies PKCS7 padding to the input message.
- * PKCS7 padding is a method used to pad messages to a multiple of the block size.
- * The padding value is the number of bytes added, each byte being equal to the number of bytes added.
- *
- * @param data String which padding should be applied too.
- */
-std::string applyPKCS7Padding(const std::string& data) {
-    size_t blockSize = 16;
-    size_t paddingLength = blockSize - (data.size() % blockSize);
-    std::string paddedData = data;
-    paddedData.append(paddingLength, static_cast<char>(paddingLength));
-    return paddedData;
-}
-
-/*
- * Removes PKCS7 padding from the input message.
- * PKCS7 padding is removed by examining the last byte of the padded message,
- * which indicates the number of bytes added as padding. This value is used
- * to determine how many bytes to remove from the end of the message.
- *
- * @param data String which padding should be removed from.
- */
-std::string removePKCS7Padding(const std::string& data) {
-    if (data.empty()) {
-        throw std::runtime_error("Data is empty, cannot remove padding.");
-    }
-    size_t paddingLength = static_cast<uint8_t>(data.back());
-    if (paddingLength > data.size() || paddingLength > AES_BLOCK_SIZE) {
-        throw std::runtime_error("Invalid padding length.");
-    }
-    return data.substr(0, data.size() - paddingLength);
-}
\ No newline at end of file
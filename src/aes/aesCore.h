@@ -25,41 +25,11 @@
 
 #pragma once
 
-const size_t AES_BLOCK_SIZE = 16;
+#include <string>
+#include <cstdint>
 
-class AES {
-private:
-	unsigned int Nw = 0; // Number of words in a state
-	unsigned int Nr = 0; // Number of rounds
+#include <gestalt/aes.h>
 
-	unsigned char* roundKey; // Expanded Key
-
-	void subByte(unsigned char* state);
-	void shiftRows(unsigned char* state);
-	void mixColumns(unsigned char* state);
-	void addRoundKey(unsigned char* state, const unsigned char* roundKey);
-
-	void invSubByte(unsigned char* state);
-	void invShiftRows(unsigned char* state);
-	void invMixColumns(unsigned char* state);
-
-	void keyExpansion(const std::string& key, unsigned char* roundKey);
-	void rotWord(unsigned char temp[4]);
-	void subWord(unsigned char temp[4]);
-	void rcon(unsigned char temp[4], int round);
-	
-	friend class AES_Functions;
-public:
-
-	explicit AES(const std::string& key);
-	~AES();
-
-    AES(AES& other);
-    AES& operator=(const AES& other);
-
-	void encryptBlock(unsigned char* state);
-	void decryptBlock(unsigned char* state);
-};
-
-std::string applyPKCS7Padding(const std::string& data);
-std::string removePKCS7Padding(const std::string& data);
\ No newline at end of file
+const size_t AES_CBC_DECRYPT_BATCH = 8; // Blocks decrypted together by the CBC decryption path
+const size_t AES_CTR_BATCH = 8; // Counter blocks encrypted together by the CTR path
+const size_t AES_BITSLICED_BLOCKS = 8; // Blocks per pass of the bitsliced engine, in groups of four
\ No newline at end of file
@@ -0,0 +1,485 @@
+/*
+ * Copyright 2023-2024 The Gestalt Project Authors. All Rights Reserved.
+ *
+ * Licensed under the MIT License. See the file LICENSE for the full text.
+ */
+
+/*
+ * aesGCM.cpp
+ *
+ * This file contains the portable GHASH engine and the AES-GCM mode.
+ *
+ * References:
+ * - NIST SP 800-38D, Sections 6.4 (GHASH), 7.1 (GCM-AE) and 7.2 (GCM-AD)
+ * - "The Galois/Counter Mode of Operation (GCM)" by David McGrew and John Viega, Section 4.1
+ *
+ * GHASH multiplies in GF(2^128) with the bit-reflected convention of the standard: the most
+ * significant bit of byte 0 is the coefficient of x^0, so multiplying by x is a right shift of the
+ * 128-bit big-endian value followed by a conditional XOR with R = 0xe1 || 0^120.
+ *
+ * The table engine is Shoup's 4-bit method: the 16 products of H with every 4-bit polynomial are
+ * precomputed per key, and X * H is accumulated a nibble at a time from the last byte to the first,
+ * shifting the accumulator right by 4 bits between nibbles. The 4 bits shifted out are folded back
+ * with the small REDUCTION_4BIT table.
+ */
+
+#include <cstring>
+#include <stdexcept>
+
+#include "aesGCM.h"
+#include "cpu_features/cpu_features.h"
+
+// Reduction of the 4 bits shifted out of the accumulator, positioned in the top 16 bits of the high half
+static const uint64_t REDUCTION_4BIT[16] = {
+    0x0000, 0x1c20, 0x3840, 0x2460, 0x7080, 0x6ca0, 0x48c0, 0x54e0,
+    0xe100, 0xfd20, 0xd940, 0xc560, 0x9180, 0x8da0, 0xa9c0, 0xb5e0
+};
+
+static inline uint64_t loadBigEndian64(const unsigned char* in) {
+    uint64_t value = 0;
+    for (int i = 0; i < 8; i++) {
+        value = (value << 8) | in[i];
+    }
+    return value;
+}
+
+static inline void storeBigEndian64(unsigned char* out, uint64_t value) {
+    for (int i = 7; i >= 0; i--) {
+        out[i] = static_cast<unsigned char>(value);
+        value >>= 8;
+    }
+}
+
+static inline void xorBytes(unsigned char* dst, const unsigned char* src, size_t length) {
+    for (size_t i = 0; i < length; i++) {
+        dst[i] ^= src[i];
+    }
+}
+
+/*
+ * Reports whether a GHASH engine can run on the executing CPU.
+ *
+ * @param backend The engine to check.
+ * @return True if the engine can be used.
+ */
+bool isGHASHBackendSupported(GHASHBackend backend) {
+    if (backend == GHASHBackend::CLMUL) {
+        return getCPUFeatures().pclmul && getCPUFeatures().ssse3;
+    }
+    return true;
+}
+
+/*
+ * Prepares GHASH for the hash subkey h, normally the encryption of the zero block.
+ *
+ * @param h The 16 byte hash subkey.
+ * @param backend The multiplication engine, Auto picks CLMUL when supported.
+ * @throws std::runtime_error if the requested engine is not supported by the executing CPU.
+ */
+GHASH::GHASH(const unsigned char h[16], GHASHBackend backend) : backend(backend) {
+    if (this->backend == GHASHBackend::Auto) {
+        this->backend = isGHASHBackendSupported(GHASHBackend::CLMUL) ? GHASHBackend::CLMUL : GHASHBackend::Table;
+    } else if (!isGHASHBackendSupported(this->backend)) {
+        throw std::runtime_error("Requested GHASH backend is not supported on this CPU.");
+    }
+
+    memset(tableHigh, 0, sizeof(tableHigh));
+    memset(tableLow, 0, sizeof(tableLow));
+    memset(hPowers, 0, sizeof(hPowers));
+
+    if (this->backend == GHASHBackend::CLMUL) {
+        ghashInitCLMUL(h, hPowers);
+    } else {
+        // Index 8 (the polynomial 1) holds H itself, each halving index multiplies by x
+        uint64_t high = loadBigEndian64(h);
+        uint64_t low = loadBigEndian64(h + 8);
+        tableHigh[8] = high;
+        tableLow[8] = low;
+
+        for (int i = 4; i > 0; i >>= 1) {
+            uint64_t carry = (low & 1) ? 0xe100000000000000ULL : 0;
+            low = (high << 63) | (low >> 1);
+            high = (high >> 1) ^ carry;
+            tableHigh[i] = high;
+            tableLow[i] = low;
+        }
+
+        // The remaining entries are sums of the single bit multiples
+        for (int i = 2; i <= 8; i <<= 1) {
+            for (int j = 1; j < i; j++) {
+                tableHigh[i + j] = tableHigh[i] ^ tableHigh[j];
+                tableLow[i + j] = tableLow[i] ^ tableLow[j];
+            }
+        }
+    }
+
+    reset();
+}
+
+void GHASH::reset() {
+    memset(state, 0, sizeof(state));
+}
+
+/*
+ * Multiplies x by H in place with the 4-bit tables.
+ */
+void GHASH::multiplyTable(unsigned char x[16]) const {
+    unsigned int nibble = x[15] & 0x0f;
+    uint64_t high = tableHigh[nibble];
+    uint64_t low = tableLow[nibble];
+
+    for (int i = 15; i >= 0; i--) {
+        unsigned int lowNibble = x[i] & 0x0f;
+        unsigned int highNibble = x[i] >> 4;
+
+        if (i != 15) {
+            unsigned int rem = static_cast<unsigned int>(low & 0x0f);
+            low = (high << 60) | (low >> 4);
+            high = (high >> 4) ^ (REDUCTION_4BIT[rem] << 48);
+            high ^= tableHigh[lowNibble];
+            low ^= tableLow[lowNibble];
+        }
+
+        unsigned int rem = static_cast<unsigned int>(low & 0x0f);
+        low = (high << 60) | (low >> 4);
+        high = (high >> 4) ^ (REDUCTION_4BIT[rem] << 48);
+        high ^= tableHigh[highNibble];
+        low ^= tableLow[highNibble];
+    }
+
+    storeBigEndian64(x, high);
+    storeBigEndian64(x + 8, low);
+}
+
+/*
+ * Absorbs whole 16 byte blocks into the hash state.
+ *
+ * @param data A pointer to numBlocks * 16 bytes.
+ * @param numBlocks The number of blocks to absorb.
+ */
+void GHASH::update(const unsigned char* data, size_t numBlocks) {
+    if (backend == GHASHBackend::CLMUL) {
+        ghashUpdateCLMUL(state, hPowers, data, numBlocks);
+        return;
+    }
+    for (size_t i = 0; i < numBlocks; i++) {
+        xorBytes(state, data + 16 * i, 16);
+        multiplyTable(state);
+    }
+}
+
+void GHASH::digest(unsigned char out[16]) const {
+    memcpy(out, state, sizeof(state));
+}
+
+GHASH GCM::deriveGHASH(const AES& cipher, GHASHBackend backend) {
+    unsigned char h[AES_BLOCK_SIZE] = { 0 };
+    cipher.encryptBlock(h);
+    return GHASH(h, backend);
+}
+
+/*
+ * Expands the key and derives the hash subkey. The instance can then process any number of messages.
+ *
+ * @param key The 16, 24, or 32 byte key.
+ * @param keyLen The length of the key in bytes.
+ * @param aesBackend The AES round engine.
+ * @param ghashBackend The GHASH multiplication engine.
+ * @throws std::invalid_argument if the key size is not 128, 192, or 256 bits.
+ */
+GCM::GCM(const unsigned char* key, size_t keyLen, AESBackend aesBackend, GHASHBackend ghashBackend)
+    : GCM(AES(key, keyLen, aesBackend), ghashBackend) {}
+
+/*
+ * Derives the hash subkey from an already expanded key, so a cached AES context is not expanded again.
+ *
+ * @param cipher The keyed AES context, copied into the instance.
+ * @param ghashBackend The GHASH multiplication engine.
+ */
+GCM::GCM(const AES& cipher, GHASHBackend ghashBackend) : cipher(cipher), ghash(deriveGHASH(cipher, ghashBackend)) {
+    memset(j0, 0, sizeof(j0));
+    memset(counter, 0, sizeof(counter));
+    memset(keystream, 0, sizeof(keystream));
+    memset(pending, 0, sizeof(pending));
+}
+
+/*
+ * Begins a new message.
+ *
+ * A 12 byte IV is used directly as IV || 0^31 || 1, any other length is hashed with GHASH as the
+ * standard requires.
+ *
+ * @param iv The initialization vector, which must never repeat under the same key.
+ * @param ivLen The length of the IV in bytes.
+ * @throws std::invalid_argument if the IV is empty.
+ */
+void GCM::start(const unsigned char* iv, size_t ivLen) {
+    if (ivLen == 0) {
+        throw std::invalid_argument("GCM IV must not be empty.");
+    }
+
+    ghash.reset();
+    if (ivLen == GCM_IV_SIZE) {
+        memcpy(j0, iv, GCM_IV_SIZE);
+        j0[12] = 0;
+        j0[13] = 0;
+        j0[14] = 0;
+        j0[15] = 1;
+    } else {
+        unsigned char block[AES_BLOCK_SIZE];
+        size_t fullBlocks = ivLen / AES_BLOCK_SIZE;
+        ghash.update(iv, fullBlocks);
+
+        size_t remainder = ivLen % AES_BLOCK_SIZE;
+        if (remainder != 0) {
+            memset(block, 0, sizeof(block));
+            memcpy(block, iv + fullBlocks * AES_BLOCK_SIZE, remainder);
+            ghash.update(block, 1);
+        }
+
+        storeBigEndian64(block, 0);
+        storeBigEndian64(block + 8, static_cast<uint64_t>(ivLen) * 8);
+        ghash.update(block, 1);
+        ghash.digest(j0);
+        ghash.reset();
+    }
+
+    memcpy(counter, j0, AES_BLOCK_SIZE);
+    pendingLen = 0;
+    aadLen = 0;
+    textLen = 0;
+    phase = Phase::AAD;
+}
+
+/*
+ * Feeds bytes to GHASH, buffering any partial block until it is completed or the section ends.
+ */
+void GCM::hash(const unsigned char* data, size_t length) {
+    if (length == 0) {
+        return;
+    }
+    if (pendingLen > 0) {
+        size_t take = AES_BLOCK_SIZE - pendingLen < length ? AES_BLOCK_SIZE - pendingLen : length;
+        memcpy(pending + pendingLen, data, take);
+        pendingLen += take;
+        data += take;
+        length -= take;
+        if (pendingLen < AES_BLOCK_SIZE) {
+            return;
+        }
+        ghash.update(pending, 1);
+        pendingLen = 0;
+    }
+
+    size_t fullBlocks = length / AES_BLOCK_SIZE;
+    ghash.update(data, fullBlocks);
+
+    pendingLen = length % AES_BLOCK_SIZE;
+    memcpy(pending, data + fullBlocks * AES_BLOCK_SIZE, pendingLen);
+}
+
+/*
+ * Zero pads and absorbs a pending partial block, ending the current section (AAD or ciphertext).
+ */
+void GCM::flushPending() {
+    if (pendingLen > 0) {
+        memset(pending + pendingLen, 0, AES_BLOCK_SIZE - pendingLen);
+        ghash.update(pending, 1);
+        pendingLen = 0;
+    }
+}
+
+void GCM::beginText() {
+    if (phase == Phase::Idle) {
+        throw std::runtime_error("GCM start must be called before processing data.");
+    }
+    if (phase == Phase::AAD) {
+        flushPending();
+        phase = Phase::Text;
+    }
+}
+
+/*
+ * Absorbs additional authenticated data. All AAD must be supplied before any plaintext or ciphertext.
+ *
+ * @param aad The additional authenticated data.
+ * @param length The length of the data in bytes.
+ * @throws std::runtime_error if called before start or after data has been processed.
+ */
+void GCM::updateAAD(const unsigned char* aad, size_t length) {
+    if (phase != Phase::AAD) {
+        throw std::runtime_error("GCM AAD must be supplied after start and before any plaintext or ciphertext.");
+    }
+    hash(aad, length);
+    aadLen += length;
+}
+
+/*
+ * Applies the keystream of numBlocks counter blocks to whole blocks. GCM increments only the low 32
+ * bits of the counter, so a run that would wrap them is split at the wrap point.
+ */
+void GCM::applyCTR(const unsigned char* in, unsigned char* out, size_t numBlocks) {
+    while (numBlocks > 0) {
+        uint32_t low = (static_cast<uint32_t>(counter[12]) << 24) | (static_cast<uint32_t>(counter[13]) << 16) |
+                       (static_cast<uint32_t>(counter[14]) << 8) | static_cast<uint32_t>(counter[15]);
+
+        // GCM counts from inc32(J0), so the first keystream block uses low + 1
+        uint32_t first = low + 1;
+        counter[12] = static_cast<unsigned char>(first >> 24);
+        counter[13] = static_cast<unsigned char>(first >> 16);
+        counter[14] = static_cast<unsigned char>(first >> 8);
+        counter[15] = static_cast<unsigned char>(first);
+
+        uint64_t untilWrap = first == 0 ? 0x100000000ULL : 0x100000000ULL - first;
+        size_t run = numBlocks < untilWrap ? numBlocks : static_cast<size_t>(untilWrap);
+        cipher.applyCTR(in, out, run * AES_BLOCK_SIZE, counter);
+
+        uint32_t last = first + static_cast<uint32_t>(run - 1);
+        counter[12] = static_cast<unsigned char>(last >> 24);
+        counter[13] = static_cast<unsigned char>(last >> 16);
+        counter[14] = static_cast<unsigned char>(last >> 8);
+        counter[15] = static_cast<unsigned char>(last);
+
+        in += run * AES_BLOCK_SIZE;
+        out += run * AES_BLOCK_SIZE;
+        numBlocks -= run;
+    }
+}
+
+void GCM::nextKeystreamBlock() {
+    memset(keystream, 0, sizeof(keystream));
+    applyCTR(keystream, keystream, 1);
+}
+
+void GCM::update(const unsigned char* in, unsigned char* out, size_t length, bool encrypting) {
+    beginText();
+    if (length == 0) {
+        return;
+    }
+    textLen += length;
+
+    // Finish the keystream block left over by the previous update
+    size_t used = pendingLen;
+    if (used > 0) {
+        size_t take = AES_BLOCK_SIZE - used < length ? AES_BLOCK_SIZE - used : length;
+        for (size_t i = 0; i < take; i++) {
+            unsigned char c = encrypting ? static_cast<unsigned char>(in[i] ^ keystream[used + i]) : in[i];
+            out[i] = static_cast<unsigned char>(in[i] ^ keystream[used + i]);
+            pending[used + i] = c;
+        }
+        pendingLen += take;
+        in += take;
+        out += take;
+        length -= take;
+        if (pendingLen < AES_BLOCK_SIZE) {
+            return;
+        }
+        ghash.update(pending, 1);
+        pendingLen = 0;
+    }
+
+    // Encrypt and hash each chunk back to back while it is in cache. Decryption hashes the ciphertext
+    // before it is overwritten, so in-place operation is safe.
+    size_t numBlocks = length / AES_BLOCK_SIZE;
+    for (size_t i = 0; i < numBlocks; i += GCM_CHUNK_BLOCKS) {
+        size_t chunk = numBlocks - i < GCM_CHUNK_BLOCKS ? numBlocks - i : GCM_CHUNK_BLOCKS;
+        const unsigned char* src = in + i * AES_BLOCK_SIZE;
+        unsigned char* dst = out + i * AES_BLOCK_SIZE;
+
+        if (encrypting) {
+            applyCTR(src, dst, chunk);
+            ghash.update(dst, chunk);
+        } else {
+            ghash.update(src, chunk);
+            applyCTR(src, dst, chunk);
+        }
+    }
+    in += numBlocks * AES_BLOCK_SIZE;
+    out += numBlocks * AES_BLOCK_SIZE;
+    length -= numBlocks * AES_BLOCK_SIZE;
+
+    // Start a new keystream block for the trailing bytes
+    if (length > 0) {
+        nextKeystreamBlock();
+        for (size_t i = 0; i < length; i++) {
+            unsigned char c = encrypting ? static_cast<unsigned char>(in[i] ^ keystream[i]) : in[i];
+            out[i] = static_cast<unsigned char>(in[i] ^ keystream[i]);
+            pending[i] = c;
+        }
+        pendingLen = length;
+    }
+}
+
+/*
+ * Encrypts the next part of the message. Updates may have any length, out may alias in.
+ *
+ * @param in The plaintext bytes.
+ * @param out The output buffer for length ciphertext bytes.
+ * @param length The number of bytes.
+ * @throws std::runtime_error if called before start.
+ */
+void GCM::encryptUpdate(const unsigned char* in, unsigned char* out, size_t length) {
+    update(in, out, length, true);
+}
+
+/*
+ * Decrypts the next part of the message. Updates may have any length, out may alias in.
+ * The plaintext must not be trusted until verify succeeds.
+ *
+ * @param in The ciphertext bytes.
+ * @param out The output buffer for length plaintext bytes.
+ * @param length The number of bytes.
+ * @throws std::runtime_error if called before start.
+ */
+void GCM::decryptUpdate(const unsigned char* in, unsigned char* out, size_t length) {
+    update(in, out, length, false);
+}
+
+/*
+ * Completes the message and produces the authentication tag.
+ *
+ * @param tag The output buffer for the tag.
+ * @param tagLen The tag length in bytes: 4, 8, or 12 to 16.
+ * @throws std::invalid_argument if the tag length is not allowed.
+ * @throws std::runtime_error if called before start.
+ */
+void GCM::finish(unsigned char* tag, size_t tagLen) {
+    if (tagLen != 4 && tagLen != 8 && (tagLen < 12 || tagLen > GCM_TAG_SIZE)) {
+        throw std::invalid_argument("Invalid GCM tag length. Expected 4, 8, or 12 to 16 bytes.");
+    }
+    beginText();
+    flushPending();
+
+    unsigned char block[AES_BLOCK_SIZE];
+    storeBigEndian64(block, aadLen * 8);
+    storeBigEndian64(block + 8, textLen * 8);
+    ghash.update(block, 1);
+
+    unsigned char s[AES_BLOCK_SIZE];
+    ghash.digest(s);
+    memcpy(block, j0, AES_BLOCK_SIZE);
+    cipher.encryptBlock(block);
+    xorBytes(s, block, AES_BLOCK_SIZE);
+
+    memcpy(tag, s, tagLen);
+    phase = Phase::Idle;
+}
+
+/*
+ * Completes the message and compares the expected tag in constant time.
+ *
+ * @param tag The received tag.
+ * @param tagLen The tag length in bytes: 4, 8, or 12 to 16.
+ * @return True if the tag matches.
+ * @throws std::invalid_argument if the tag length is not allowed.
+ */
+bool GCM::verify(const unsigned char* tag, size_t tagLen) {
+    unsigned char expected[GCM_TAG_SIZE];
+    finish(expected, tagLen);
+
+    unsigned char diff = 0;
+    for (size_t i = 0; i < tagLen; i++) {
+        diff |= static_cast<unsigned char>(expected[i] ^ tag[i]);
+    }
+    return diff == 0;
+}
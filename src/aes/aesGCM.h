@@ -0,0 +1,122 @@
+/*
+ * Copyright 2023-2024 The Gestalt Project Authors. All Rights Reserved.
+ *
+ * Licensed under the MIT License. See the file LICENSE for the full text.
+ */
+
+/*
+ * aesGCM.h
+ *
+ * This file contains the definitions of the GHASH universal hash and the AES-GCM engine built on it.
+ *
+ * References:
+ * - NIST SP 800-38D, "Recommendation for Block Cipher Modes of Operation: Galois/Counter Mode (GCM) and GMAC"
+ * - "The Galois/Counter Mode of Operation (GCM)" by David McGrew and John Viega
+ */
+
+#pragma once
+
+#include <cstddef>
+#include <cstdint>
+
+#include "aesCore.h"
+
+const size_t GCM_TAG_SIZE = 16;
+const size_t GCM_IV_SIZE = 12; // Recommended IV size, used directly as the counter prefix
+const size_t GCM_CHUNK_BLOCKS = 32; // Blocks encrypted and hashed together while they are in cache
+const size_t GHASH_CLMUL_AGGREGATE = 4; // Blocks multiplied per reduction by the carry-less multiply engine
+
+/*
+ * Selects the multiplication engine used by a GHASH instance.
+ *
+ * Auto:   Uses CLMUL when the executing CPU supports it, otherwise Table.
+ * Table:  Portable 4-bit table multiplication (Shoup's method) with 16 precomputed multiples of H.
+ * CLMUL:  Uses the x86 PCLMULQDQ carry-less multiply instruction, with H^1..H^4 precomputed so four
+ *         blocks share one reduction.
+ */
+enum class GHASHBackend {
+	Auto,
+	Table,
+	CLMUL
+};
+
+class GHASH {
+private:
+	GHASHBackend backend;
+
+	uint64_t tableHigh[16]; // Multiples of H by every 4-bit value, high halves
+	uint64_t tableLow[16];  // Multiples of H by every 4-bit value, low halves
+
+	unsigned char hPowers[GHASH_CLMUL_AGGREGATE * 16]; // H^1..H^4 in the byte order used by the CLMUL engine
+
+	unsigned char state[16];
+
+	void multiplyTable(unsigned char x[16]) const;
+
+public:
+	explicit GHASH(const unsigned char h[16], GHASHBackend backend = GHASHBackend::Auto);
+
+	void reset();
+	void update(const unsigned char* data, size_t numBlocks);
+	void digest(unsigned char out[16]) const;
+
+	GHASHBackend getBackend() const { return backend; }
+};
+
+bool isGHASHBackendSupported(GHASHBackend backend);
+
+void ghashInitCLMUL(const unsigned char h[16], unsigned char hPowers[GHASH_CLMUL_AGGREGATE * 16]);
+void ghashUpdateCLMUL(
+	unsigned char state[16], const unsigned char hPowers[GHASH_CLMUL_AGGREGATE * 16], const unsigned char* data, size_t numBlocks
+);
+
+/*
+ * Streaming AES-GCM encryption and decryption.
+ *
+ * A message is processed as start(iv), any number of updateAAD calls, any number of encryptUpdate or
+ * decryptUpdate calls, and finally finish or verify. Updates may have any length. Each chunk of
+ * GCM_CHUNK_BLOCKS blocks is encrypted and hashed back to back, so the data is read from memory once.
+ */
+class GCM {
+private:
+	enum class Phase {
+		Idle,
+		AAD,
+		Text
+	};
+
+	AES cipher;
+	GHASH ghash;
+
+	unsigned char j0[AES_BLOCK_SIZE];      // Pre-counter block, encrypts the tag
+	unsigned char counter[AES_BLOCK_SIZE]; // Counter block of the last keystream block generated
+
+	unsigned char keystream[AES_BLOCK_SIZE]; // Current partial keystream block
+	unsigned char pending[AES_BLOCK_SIZE];   // Bytes waiting to form a full GHASH block
+	size_t pendingLen = 0;
+
+	uint64_t aadLen = 0;
+	uint64_t textLen = 0;
+	Phase phase = Phase::Idle;
+
+	static GHASH deriveGHASH(const AES& cipher, GHASHBackend backend);
+
+	void hash(const unsigned char* data, size_t length);
+	void flushPending();
+	void beginText();
+	void applyCTR(const unsigned char* in, unsigned char* out, size_t numBlocks);
+	void nextKeystreamBlock();
+	void update(const unsigned char* in, unsigned char* out, size_t length, bool encrypting);
+
+	friend class GCM_Functions;
+public:
+	GCM(const unsigned char* key, size_t keyLen, AESBackend aesBackend = AESBackend::Auto, GHASHBackend ghashBackend = GHASHBackend::Auto);
+	explicit GCM(const AES& cipher, GHASHBackend ghashBackend = GHASHBackend::Auto);
+
+	void start(const unsigned char* iv, size_t ivLen);
+	void updateAAD(const unsigned char* aad, size_t length);
+	void encryptUpdate(const unsigned char* in, unsigned char* out, size_t length);
+	void decryptUpdate(const unsigned char* in, unsigned char* out, size_t length);
+	void finish(unsigned char* tag, size_t tagLen = GCM_TAG_SIZE);
+	bool verify(const unsigned char* tag, size_t tagLen = GCM_TAG_SIZE);
+};
@@ -0,0 +1,361 @@
+/*
+ * Copyright 2023-2024 The Gestalt Project Authors. All Rights Reserved.
+ *
+ * Licensed under the MIT License. See the file LICENSE for the full text.
+ */
+
+/*
+ * aesKeyWrap.cpp
+ *
+ * This file contains the AES key wrap modes KW and KWP.
+ *
+ * References:
+ * - RFC 3394, "Advanced Encryption Standard (AES) Key Wrap Algorithm"
+ * - RFC 5649, "Advanced Encryption Standard (AES) Key Wrap with Padding Algorithm"
+ * - NIST SP 800-38F, "Recommendation for Block Cipher Modes of Operation: Methods for Key Wrapping"
+ *
+ * The key is split into n 64-bit registers R[1..n] and an integrity register A starting at a fixed
+ * value. Wrapping runs six passes over the registers,
+ *    B = E_K(A | R[i]), A = MSB64(B) ^ t, R[i] = LSB64(B)    with t = n * j + i,
+ * and unwrapping runs them backwards with the inverse cipher, after which A must hold its initial
+ * value again. Every step depends on the previous one, so a single unwrap gives the engine one block at
+ * a time. The batch unwrap instead steps several wrapped keys of the same length together and passes
+ * one block from each to decryptBlocks, which the AES-NI and bitsliced engines process in parallel.
+ */
+
+#include <algorithm>
+#include <cstring>
+#include <stdexcept>
+#include <vector>
+
+#include <gestalt/aes.h>
+#include "aesCore.h"
+
+static const unsigned char KW_IV[8] = { 0xa6, 0xa6, 0xa6, 0xa6, 0xa6, 0xa6, 0xa6, 0xa6 };
+static const unsigned char KWP_IV_PREFIX[4] = { 0xa6, 0x59, 0x59, 0xa6 };
+
+static const size_t KW_PASSES = 6;
+static const size_t KW_SEMIBLOCK = 8;
+
+static inline void xorCounter(unsigned char a[KW_SEMIBLOCK], uint64_t t) {
+    for (size_t i = 0; i < KW_SEMIBLOCK; i++) {
+        a[KW_SEMIBLOCK - 1 - i] ^= static_cast<unsigned char>(t >> (8 * i));
+    }
+}
+
+/*
+ * Runs the wrapping function W over n registers already stored after the integrity value in data.
+ *
+ * @param kek The key encryption key.
+ * @param data The integrity value followed by the n registers, wrapped in place.
+ * @param n The number of 64-bit registers.
+ */
+static void wrapRegisters(const AES& kek, unsigned char* data, size_t n) {
+    unsigned char block[AES_BLOCK_SIZE];
+    memcpy(block, data, KW_SEMIBLOCK);
+
+    for (size_t j = 0; j < KW_PASSES; j++) {
+        for (size_t i = 1; i <= n; i++) {
+            unsigned char* r = data + i * KW_SEMIBLOCK;
+            memcpy(block + KW_SEMIBLOCK, r, KW_SEMIBLOCK);
+            kek.encryptBlock(block);
+            xorCounter(block, n * j + i);
+            memcpy(r, block + KW_SEMIBLOCK, KW_SEMIBLOCK);
+        }
+    }
+    memcpy(data, block, KW_SEMIBLOCK);
+}
+
+/*
+ * Runs the unwrapping function W^-1 over wrapped keys of the same length in lockstep.
+ *
+ * @param kek The key encryption key.
+ * @param a The integrity register of each key.
+ * @param r The n registers of each key, unwrapped in place.
+ * @param numLanes The number of keys, at most AES_MULTI_BUFFER_LANES.
+ * @param n The number of 64-bit registers per key.
+ */
+static void unwrapRegisters(
+    const AES& kek, unsigned char a[][KW_SEMIBLOCK], unsigned char* const* r, size_t numLanes, size_t n
+) {
+    unsigned char blocks[AES_MULTI_BUFFER_LANES * AES_BLOCK_SIZE];
+
+    for (size_t j = KW_PASSES; j-- > 0;) {
+        for (size_t i = n; i >= 1; i--) {
+            for (size_t lane = 0; lane < numLanes; lane++) {
+                unsigned char* block = blocks + lane * AES_BLOCK_SIZE;
+                memcpy(block, a[lane], KW_SEMIBLOCK);
+                xorCounter(block, n * j + i);
+                memcpy(block + KW_SEMIBLOCK, r[lane] + (i - 1) * KW_SEMIBLOCK, KW_SEMIBLOCK);
+            }
+            kek.decryptBlocks(blocks, numLanes);
+            for (size_t lane = 0; lane < numLanes; lane++) {
+                const unsigned char* block = blocks + lane * AES_BLOCK_SIZE;
+                memcpy(a[lane], block, KW_SEMIBLOCK);
+                memcpy(r[lane] + (i - 1) * KW_SEMIBLOCK, block + KW_SEMIBLOCK, KW_SEMIBLOCK);
+            }
+        }
+    }
+}
+
+/*
+ * Checks the integrity register of a KWP key and finds the length of the key.
+ *
+ * @param a The unwrapped integrity register.
+ * @param key The unwrapped registers, including the padding.
+ * @param n The number of 64-bit registers.
+ * @param keyLen Set to the length of the key.
+ * @return True if the prefix, the length and the padding are all valid.
+ */
+static bool checkPaddedIntegrity(const unsigned char a[KW_SEMIBLOCK], const unsigned char* key, size_t n, size_t& keyLen) {
+    unsigned char diff = 0;
+    for (size_t i = 0; i < 4; i++) {
+        diff |= static_cast<unsigned char>(a[i] ^ KWP_IV_PREFIX[i]);
+    }
+
+    keyLen = (static_cast<size_t>(a[4]) << 24) | (static_cast<size_t>(a[5]) << 16) |
+             (static_cast<size_t>(a[6]) << 8) | static_cast<size_t>(a[7]);
+    if (keyLen <= KW_SEMIBLOCK * (n - 1) || keyLen > KW_SEMIBLOCK * n) {
+        return false;
+    }
+    for (size_t i = keyLen; i < KW_SEMIBLOCK * n; i++) {
+        diff |= key[i];
+    }
+    return diff == 0;
+}
+
+static bool isValidWrappedLength(size_t wrappedLen, bool padded) {
+    return wrappedLen % KW_SEMIBLOCK == 0 && wrappedLen >= (padded ? 2 : 3) * KW_SEMIBLOCK;
+}
+
+/*
+ * Unwraps up to AES_MULTI_BUFFER_LANES keys of the same wrapped length and sets their status.
+ *
+ * @param kek The key encryption key.
+ * @param items The wrapped keys, all with a valid length equal to that of the first.
+ * @param numLanes The number of keys.
+ * @param padded True for KWP, false for KW.
+ * @result The number of keys that passed the integrity check.
+ */
+static size_t unwrapGroup(const AES& kek, AESKeyWrapItem* const* items, size_t numLanes, bool padded) {
+    size_t n = items[0]->inLen / KW_SEMIBLOCK - 1;
+    unsigned char a[AES_MULTI_BUFFER_LANES][KW_SEMIBLOCK];
+    unsigned char* r[AES_MULTI_BUFFER_LANES];
+
+    for (size_t lane = 0; lane < numLanes; lane++) {
+        memcpy(a[lane], items[lane]->in, KW_SEMIBLOCK);
+        memmove(items[lane]->out, items[lane]->in + KW_SEMIBLOCK, n * KW_SEMIBLOCK);
+        r[lane] = items[lane]->out;
+    }
+
+    if (padded && n == 1) {
+        // A single register is wrapped as one ECB block
+        unsigned char blocks[AES_MULTI_BUFFER_LANES * AES_BLOCK_SIZE];
+        for (size_t lane = 0; lane < numLanes; lane++) {
+            memcpy(blocks + lane * AES_BLOCK_SIZE, a[lane], KW_SEMIBLOCK);
+            memcpy(blocks + lane * AES_BLOCK_SIZE + KW_SEMIBLOCK, r[lane], KW_SEMIBLOCK);
+        }
+        kek.decryptBlocks(blocks, numLanes);
+        for (size_t lane = 0; lane < numLanes; lane++) {
+            memcpy(a[lane], blocks + lane * AES_BLOCK_SIZE, KW_SEMIBLOCK);
+            memcpy(r[lane], blocks + lane * AES_BLOCK_SIZE + KW_SEMIBLOCK, KW_SEMIBLOCK);
+        }
+    } else {
+        unwrapRegisters(kek, a, r, numLanes, n);
+    }
+
+    size_t succeeded = 0;
+    for (size_t lane = 0; lane < numLanes; lane++) {
+        AESKeyWrapItem* item = items[lane];
+        bool valid;
+        if (padded) {
+            valid = checkPaddedIntegrity(a[lane], item->out, n, item->outLen);
+        } else {
+            unsigned char diff = 0;
+            for (size_t i = 0; i < KW_SEMIBLOCK; i++) {
+                diff |= static_cast<unsigned char>(a[lane][i] ^ KW_IV[i]);
+            }
+            valid = diff == 0;
+            item->outLen = n * KW_SEMIBLOCK;
+        }
+
+        if (valid) {
+            item->status = AESBatchStatus::Ok;
+            succeeded++;
+        } else {
+            memset(item->out, 0, n * KW_SEMIBLOCK);
+            item->outLen = 0;
+            item->status = AESBatchStatus::IntegrityCheckFailed;
+        }
+    }
+    return succeeded;
+}
+
+/*
+ * Unwraps a batch in groups of up to AES_MULTI_BUFFER_LANES keys. Keys are grouped by wrapped length
+ * regardless of their order in the batch, so interleaved lengths still fill the lanes.
+ */
+static size_t unwrapBatch(const AES& kek, AESKeyWrapItem* items, size_t count, bool padded) {
+    std::vector<AESKeyWrapItem*> pending;
+    pending.reserve(count);
+    for (size_t i = 0; i < count; i++) {
+        if (!isValidWrappedLength(items[i].inLen, padded)) {
+            items[i].outLen = 0;
+            items[i].status = AESBatchStatus::InvalidLength;
+            continue;
+        }
+        pending.push_back(&items[i]);
+    }
+
+    std::stable_sort(pending.begin(), pending.end(), [](const AESKeyWrapItem* x, const AESKeyWrapItem* y) {
+        return x->inLen < y->inLen;
+    });
+
+    size_t succeeded = 0;
+    size_t next = 0;
+    while (next < pending.size()) {
+        size_t numLanes = 1;
+        while (next + numLanes < pending.size() && numLanes < AES_MULTI_BUFFER_LANES &&
+               pending[next + numLanes]->inLen == pending[next]->inLen) {
+            numLanes++;
+        }
+        succeeded += unwrapGroup(kek, pending.data() + next, numLanes, padded);
+        next += numLanes;
+    }
+    return succeeded;
+}
+
+static size_t unwrapSingle(const AES& kek, const uint8_t* wrapped, size_t wrappedLen, uint8_t* out, bool padded) {
+    if (!isValidWrappedLength(wrappedLen, padded)) {
+        throw std::invalid_argument("Invalid wrapped key length. Expected a multiple of 8 bytes.");
+    }
+
+    AESKeyWrapItem item = { wrapped, wrappedLen, out, 0, AESBatchStatus::Ok };
+    AESKeyWrapItem* group[1] = { &item };
+    if (unwrapGroup(kek, group, 1, padded) == 0) {
+        throw std::runtime_error("Key unwrap failed the integrity check.");
+    }
+    return item.outLen;
+}
+
+/*
+ * Wraps a key with AES-KW under this context's key.
+ *
+ * @param key The key to wrap.
+ * @param keyLen The length of the key in bytes, a multiple of 8 and at least 16.
+ * @param out Output buffer of at least keyLen + 8 bytes, may alias key.
+ * @result The number of bytes written, keyLen + 8.
+ * @throws std::invalid_argument if the key length is invalid.
+ */
+size_t AES::wrapKey(const uint8_t* key, size_t keyLen, uint8_t* out) const {
+    if (keyLen % KW_SEMIBLOCK != 0 || keyLen < 2 * KW_SEMIBLOCK) {
+        throw std::invalid_argument("Invalid key length. Expected a multiple of 8 bytes and at least 16 bytes.");
+    }
+
+    memmove(out + KW_SEMIBLOCK, key, keyLen);
+    memcpy(out, KW_IV, KW_SEMIBLOCK);
+    wrapRegisters(*this, out, keyLen / KW_SEMIBLOCK);
+    return keyLen + KW_SEMIBLOCK;
+}
+
+/*
+ * Unwraps an AES-KW wrapped key under this context's key.
+ *
+ * @param wrapped The wrapped key.
+ * @param wrappedLen The length of the wrapped key in bytes, a multiple of 8 and at least 24.
+ * @param out Output buffer of at least wrappedLen - 8 bytes, may alias wrapped.
+ * @result The length of the unwrapped key, wrappedLen - 8.
+ * @throws std::invalid_argument if the wrapped length is invalid.
+ * @throws std::runtime_error if the integrity check fails. The output is cleared.
+ */
+size_t AES::unwrapKey(const uint8_t* wrapped, size_t wrappedLen, uint8_t* out) const {
+    return unwrapSingle(*this, wrapped, wrappedLen, out, false);
+}
+
+/*
+ * Wraps a key of any length with AES-KWP under this context's key.
+ *
+ * @param key The key to wrap.
+ * @param keyLen The length of the key in bytes, at least 1.
+ * @param out Output buffer of at least aesKeyWrapPaddedLength(keyLen) bytes, may alias key.
+ * @result The number of bytes written, aesKeyWrapPaddedLength(keyLen).
+ * @throws std::invalid_argument if the key length is invalid.
+ */
+size_t AES::wrapKeyPadded(const uint8_t* key, size_t keyLen, uint8_t* out) const {
+    if (keyLen == 0 || keyLen > 0xffffffff) {
+        throw std::invalid_argument("Invalid key length. Expected 1 to 2^32 - 1 bytes.");
+    }
+
+    size_t wrappedLen = aesKeyWrapPaddedLength(keyLen);
+    memmove(out + KW_SEMIBLOCK, key, keyLen);
+    memset(out + KW_SEMIBLOCK + keyLen, 0, wrappedLen - KW_SEMIBLOCK - keyLen);
+    memcpy(out, KWP_IV_PREFIX, 4);
+    for (size_t i = 0; i < 4; i++) {
+        out[4 + i] = static_cast<uint8_t>(keyLen >> (24 - 8 * i));
+    }
+
+    if (wrappedLen == AES_BLOCK_SIZE) {
+        encryptBlock(out);
+    } else {
+        wrapRegisters(*this, out, wrappedLen / KW_SEMIBLOCK - 1);
+    }
+    return wrappedLen;
+}
+
+/*
+ * Unwraps an AES-KWP wrapped key under this context's key.
+ *
+ * @param wrapped The wrapped key.
+ * @param wrappedLen The length of the wrapped key in bytes, a multiple of 8 and at least 16.
+ * @param out Output buffer of at least wrappedLen - 8 bytes, may alias wrapped.
+ * @result The length of the unwrapped key.
+ * @throws std::invalid_argument if the wrapped length is invalid.
+ * @throws std::runtime_error if the integrity check fails. The output is cleared.
+ */
+size_t AES::unwrapKeyPadded(const uint8_t* wrapped, size_t wrappedLen, uint8_t* out) const {
+    return unwrapSingle(*this, wrapped, wrappedLen, out, true);
+}
+
+/*
+ * Unwraps a batch of AES-KW wrapped keys under one key encryption key.
+ *
+ * @param kek The key encryption key.
+ * @param items The wrapped keys. outLen and status are set for every item.
+ * @param count The number of items.
+ * @result The number of keys unwrapped successfully.
+ */
+size_t unwrapAESKeyBatch(const AES& kek, AESKeyWrapItem* items, size_t count) {
+    return unwrapBatch(kek, items, count, false);
+}
+
+/*
+ * Unwraps a batch of AES-KWP wrapped keys under one key encryption key.
+ *
+ * @param kek The key encryption key.
+ * @param items The wrapped keys. outLen and status are set for every item.
+ * @param count The number of items.
+ * @result The number of keys unwrapped successfully.
+ */
+size_t unwrapAESKeyPaddedBatch(const AES& kek, AESKeyWrapItem* items, size_t count) {
+    return unwrapBatch(kek, items, count, true);
+}
+
+size_t wrapAESKey(const uint8_t* key, size_t keyLen, const uint8_t* kek, size_t kekLen, uint8_t* out) {
+    AES cipher(kek, kekLen);
+    return cipher.wrapKey(key, keyLen, out);
+}
+
+size_t unwrapAESKey(const uint8_t* wrapped, size_t wrappedLen, const uint8_t* kek, size_t kekLen, uint8_t* out) {
+    AES cipher(kek, kekLen);
+    return cipher.unwrapKey(wrapped, wrappedLen, out);
+}
+
+size_t wrapAESKeyPadded(const uint8_t* key, size_t keyLen, const uint8_t* kek, size_t kekLen, uint8_t* out) {
+    AES cipher(kek, kekLen);
+    return cipher.wrapKeyPadded(key, keyLen, out);
+}
+
+size_t unwrapAESKeyPadded(const uint8_t* wrapped, size_t wrappedLen, const uint8_t* kek, size_t kekLen, uint8_t* out) {
+    AES cipher(kek, kekLen);
+    return cipher.unwrapKeyPadded(wrapped, wrappedLen, out);
+}
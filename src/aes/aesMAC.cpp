@@ -0,0 +1,249 @@
+/*
+ * Copyright 2023-2024 The Gestalt Project Authors. All Rights Reserved.
+ *
+ * Licensed under the MIT License. See the file LICENSE for the full text.
+ */
+
+/*
+ * aesMAC.cpp
+ *
+ * This file contains the AES based message authentication codes, AES-CMAC and GMAC.
+ *
+ * References:
+ * - NIST SP 800-38B, "Recommendation for Block Cipher Modes of Operation: The CMAC Mode for Authentication"
+ * - RFC 4493, "The AES-CMAC Algorithm"
+ * - NIST SP 800-38D, "Recommendation for Block Cipher Modes of Operation: Galois/Counter Mode (GCM) and GMAC"
+ *
+ * CMAC is a CBC-MAC with a zero IV in which the last block is masked with one of two subkeys derived
+ * from L = E_K(0): K1 = L * x when the last block is complete, K2 = L * x^2 when it had to be padded
+ * with 10*. Every block but the last is run through the CBC engine a chunk at a time, so the AES-NI
+ * backend keeps the round keys in registers across the chunk. GMAC is GCM with all data passed as
+ * additional authenticated data and is delegated to the GCM engine.
+ */
+
+#include <cstring>
+#include <stdexcept>
+
+#include <gestalt/aes.h>
+#include "aesCore.h"
+#include "aesGCM.h"
+
+static const size_t AES_CMAC_CHUNK_BLOCKS = 16; // Blocks copied and chained per CBC engine call
+
+/*
+ * Multiplies a block by x in GF(2^128) with the CMAC bit order, without a data dependent branch.
+ */
+static void doubleBlock(const unsigned char in[AES_BLOCK_SIZE], unsigned char out[AES_BLOCK_SIZE]) {
+    unsigned char carry = static_cast<unsigned char>(0 - (in[0] >> 7));
+    for (size_t i = 0; i < AES_BLOCK_SIZE - 1; i++) {
+        out[i] = static_cast<unsigned char>((in[i] << 1) | (in[i + 1] >> 7));
+    }
+    out[AES_BLOCK_SIZE - 1] = static_cast<unsigned char>((in[AES_BLOCK_SIZE - 1] << 1) ^ (carry & 0x87));
+}
+
+static bool tagsEqual(const unsigned char* a, const unsigned char* b, size_t length) {
+    unsigned char diff = 0;
+    for (size_t i = 0; i < length; i++) {
+        diff |= static_cast<unsigned char>(a[i] ^ b[i]);
+    }
+    return diff == 0;
+}
+
+/*
+ * Creates a CMAC instance and derives its subkeys.
+ *
+ * @param key The key bytes.
+ * @param keyLen The key length in bytes: 16, 24, or 32.
+ * @param backend The AES engine to use.
+ * @throws std::invalid_argument if the key size is not 128, 192, or 256 bits.
+ */
+AESCMAC::AESCMAC(const uint8_t* key, size_t keyLen, AESBackend backend) : cipher(key, keyLen, backend) {
+    deriveSubkeys();
+}
+
+AESCMAC::AESCMAC(const AES& cipher) : cipher(cipher) {
+    deriveSubkeys();
+}
+
+void AESCMAC::deriveSubkeys() {
+    unsigned char l[AES_BLOCK_SIZE] = {};
+    cipher.encryptBlock(l);
+    doubleBlock(l, k1);
+    doubleBlock(k1, k2);
+    reset();
+}
+
+/*
+ * Discards any data of the current message.
+ */
+void AESCMAC::reset() {
+    memset(state, 0, AES_BLOCK_SIZE);
+    pendingLen = 0;
+}
+
+/*
+ * Adds data to the current message. The last complete block is held back until more data arrives
+ * or finish is called, since it is masked differently when it ends the message.
+ *
+ * @param data The message bytes.
+ * @param length The number of bytes, may be zero.
+ */
+void AESCMAC::update(const uint8_t* data, size_t length) {
+    if (pendingLen + length <= AES_BLOCK_SIZE) {
+        memcpy(pending + pendingLen, data, length);
+        pendingLen += length;
+        return;
+    }
+
+    if (pendingLen > 0) {
+        size_t fill = AES_BLOCK_SIZE - pendingLen;
+        memcpy(pending + pendingLen, data, fill);
+        cipher.encryptBlocksCBC(pending, 1, state);
+        data += fill;
+        length -= fill;
+    }
+
+    unsigned char chunk[AES_CMAC_CHUNK_BLOCKS * AES_BLOCK_SIZE];
+    size_t numBlocks = (length - 1) / AES_BLOCK_SIZE;
+    for (size_t i = 0; i < numBlocks; i += AES_CMAC_CHUNK_BLOCKS) {
+        size_t count = numBlocks - i < AES_CMAC_CHUNK_BLOCKS ? numBlocks - i : AES_CMAC_CHUNK_BLOCKS;
+        memcpy(chunk, data + i * AES_BLOCK_SIZE, count * AES_BLOCK_SIZE);
+        cipher.encryptBlocksCBC(chunk, count, state);
+    }
+
+    pendingLen = length - numBlocks * AES_BLOCK_SIZE;
+    memcpy(pending, data + numBlocks * AES_BLOCK_SIZE, pendingLen);
+}
+
+/*
+ * Completes the message, produces its tag and starts the next message.
+ *
+ * @param tag The output buffer for the tag.
+ * @param tagLen The tag length in bytes: 8 to 16.
+ * @throws std::invalid_argument if the tag length is not allowed.
+ */
+void AESCMAC::finish(uint8_t* tag, size_t tagLen) {
+    if (tagLen < 8 || tagLen > AES_BLOCK_SIZE) {
+        throw std::invalid_argument("Invalid CMAC tag length. Expected 8 to 16 bytes.");
+    }
+
+    unsigned char block[AES_BLOCK_SIZE];
+    const unsigned char* subkey = k1;
+    memcpy(block, pending, pendingLen);
+    if (pendingLen < AES_BLOCK_SIZE) {
+        block[pendingLen] = 0x80;
+        memset(block + pendingLen + 1, 0, AES_BLOCK_SIZE - pendingLen - 1);
+        subkey = k2;
+    }
+    for (size_t i = 0; i < AES_BLOCK_SIZE; i++) {
+        block[i] ^= subkey[i] ^ state[i];
+    }
+    cipher.encryptBlock(block);
+
+    memcpy(tag, block, tagLen);
+    reset();
+}
+
+/*
+ * Completes the message and compares the expected tag in constant time.
+ *
+ * @param tag The received tag.
+ * @param tagLen The tag length in bytes: 8 to 16.
+ * @return True if the tag matches.
+ * @throws std::invalid_argument if the tag length is not allowed.
+ */
+bool AESCMAC::verify(const uint8_t* tag, size_t tagLen) {
+    unsigned char expected[AES_BLOCK_SIZE];
+    finish(expected, tagLen);
+    return tagsEqual(expected, tag, tagLen);
+}
+
+/*
+ * Computes the AES-CMAC tag of a message.
+ *
+ * @param msg The message bytes.
+ * @param msgLen The length of the message in bytes.
+ * @param key The key bytes.
+ * @param keyLen The key length in bytes: 16, 24, or 32.
+ * @param tag The output buffer for the tag.
+ * @param tagLen The tag length in bytes: 8 to 16.
+ * @throws std::invalid_argument if the key size or the tag length is invalid.
+ */
+void cmacAES(const uint8_t* msg, size_t msgLen, const uint8_t* key, size_t keyLen, uint8_t* tag, size_t tagLen) {
+    AESCMAC cmac(key, keyLen);
+    cmac.update(msg, msgLen);
+    cmac.finish(tag, tagLen);
+}
+
+/*
+ * Checks the AES-CMAC tag of a message in constant time.
+ *
+ * @return True if the tag matches.
+ * @throws std::invalid_argument if the key size or the tag length is invalid.
+ */
+bool verifyCMACAES(const uint8_t* msg, size_t msgLen, const uint8_t* key, size_t keyLen, const uint8_t* tag, size_t tagLen) {
+    AESCMAC cmac(key, keyLen);
+    cmac.update(msg, msgLen);
+    return cmac.verify(tag, tagLen);
+}
+
+AESGMAC::AESGMAC(const uint8_t* key, size_t keyLen) : gcm(new GCM(key, keyLen)) {}
+
+AESGMAC::AESGMAC(const AES& cipher) : gcm(new GCM(cipher)) {}
+
+AESGMAC::~AESGMAC() = default;
+
+void AESGMAC::start(const uint8_t* iv, size_t ivLen) {
+    gcm->start(iv, ivLen);
+}
+
+void AESGMAC::update(const uint8_t* data, size_t length) {
+    gcm->updateAAD(data, length);
+}
+
+void AESGMAC::finish(uint8_t* tag, size_t tagLen) {
+    gcm->finish(tag, tagLen);
+}
+
+bool AESGMAC::verify(const uint8_t* tag, size_t tagLen) {
+    return gcm->verify(tag, tagLen);
+}
+
+/*
+ * Computes the GMAC tag of a message.
+ *
+ * @param msg The message bytes.
+ * @param msgLen The length of the message in bytes.
+ * @param iv The IV, unique per message under a key.
+ * @param ivLen The IV length in bytes, 12 recommended.
+ * @param key The key bytes.
+ * @param keyLen The key length in bytes: 16, 24, or 32.
+ * @param tag The output buffer for the tag.
+ * @param tagLen The tag length in bytes: 4, 8, or 12 to 16.
+ * @throws std::invalid_argument if the key size, the IV or the tag length is invalid.
+ */
+void gmacAES(
+    const uint8_t* msg, size_t msgLen, const uint8_t* iv, size_t ivLen, const uint8_t* key, size_t keyLen,
+    uint8_t* tag, size_t tagLen
+) {
+    GCM gcm(key, keyLen);
+    gcm.start(iv, ivLen);
+    gcm.updateAAD(msg, msgLen);
+    gcm.finish(tag, tagLen);
+}
+
+/*
+ * Checks the GMAC tag of a message in constant time.
+ *
+ * @return True if the tag matches.
+ * @throws std::invalid_argument if the key size, the IV or the tag length is invalid.
+ */
+bool verifyGMACAES(
+    const uint8_t* msg, size_t msgLen, const uint8_t* iv, size_t ivLen, const uint8_t* key, size_t keyLen,
+    const uint8_t* tag, size_t tagLen
+) {
+    GCM gcm(key, keyLen);
+    gcm.start(iv, ivLen);
+    gcm.updateAAD(msg, msgLen);
+    return gcm.verify(tag, tagLen);
+}
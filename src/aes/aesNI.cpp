@@ -0,0 +1,492 @@
+/*
+ * Copyright 2023-2024 The Gestalt Project Authors. All Rights Reserved.
+ *
+ * Licensed under the MIT License. See the file LICENSE for the full text.
+ */
+
+/*
+ * aesNI.cpp
+ *
+ * This file contains the AES-NI hardware round engine for the AES class.
+ *
+ * References:
+ * - "Intel Advanced Encryption Standard (AES) New Instructions Set" white paper by Shay Gueron
+ *
+ * AESENC/AESENCLAST perform a full (or final) encryption round on a 128-bit register and
+ * AESDEC/AESDECLAST do the same for the equivalent inverse cipher, whose middle round keys are
+ * produced from the encryption schedule with AESIMC. The key schedule itself is expanded with
+ * AESKEYGENASSIST, which computes SubWord(RotWord(w)) ^ Rcon for the words that need it.
+ *
+ * The round instructions have a latency of several cycles but can issue every cycle, so the
+ * multi-block functions keep AES_NI_PARALLEL_BLOCKS independent blocks in flight at once.
+ *
+ * This translation unit is compiled with AES-NI code generation enabled and must only be
+ * entered after getCPUFeatures() has reported AES-NI support.
+ */
+
+#include "aesCore.h"
+#include "cpu_features/cpu_features.h"
+
+#if defined(GESTALT_X86)
+
+#include <wmmintrin.h>
+#include <emmintrin.h>
+#if defined(_MSC_VER)
+#include <stdlib.h>
+#endif
+
+static const size_t AES_NI_PARALLEL_BLOCKS = 8;
+
+static inline __m128i expand128Assist(__m128i key, __m128i keygened) {
+    keygened = _mm_shuffle_epi32(keygened, 0xff);
+    key = _mm_xor_si128(key, _mm_slli_si128(key, 4));
+    key = _mm_xor_si128(key, _mm_slli_si128(key, 4));
+    key = _mm_xor_si128(key, _mm_slli_si128(key, 4));
+    return _mm_xor_si128(key, keygened);
+}
+
+static inline void expand192Assist(__m128i* temp1, __m128i* temp2, __m128i* temp3) {
+    *temp2 = _mm_shuffle_epi32(*temp2, 0x55);
+    __m128i temp4 = _mm_slli_si128(*temp1, 4);
+    *temp1 = _mm_xor_si128(*temp1, temp4);
+    temp4 = _mm_slli_si128(temp4, 4);
+    *temp1 = _mm_xor_si128(*temp1, temp4);
+    temp4 = _mm_slli_si128(temp4, 4);
+    *temp1 = _mm_xor_si128(*temp1, temp4);
+    *temp1 = _mm_xor_si128(*temp1, *temp2);
+    *temp2 = _mm_shuffle_epi32(*temp1, 0xff);
+    temp4 = _mm_slli_si128(*temp3, 4);
+    *temp3 = _mm_xor_si128(*temp3, temp4);
+    *temp3 = _mm_xor_si128(*temp3, *temp2);
+}
+
+static inline __m128i combineLow(__m128i low, __m128i high) {
+    return _mm_castpd_si128(_mm_shuffle_pd(_mm_castsi128_pd(low), _mm_castsi128_pd(high), 0));
+}
+
+static inline __m128i combineCross(__m128i low, __m128i high) {
+    return _mm_castpd_si128(_mm_shuffle_pd(_mm_castsi128_pd(low), _mm_castsi128_pd(high), 1));
+}
+
+static inline void expand256Assist1(__m128i* temp1, __m128i* temp2) {
+    *temp2 = _mm_shuffle_epi32(*temp2, 0xff);
+    __m128i temp4 = _mm_slli_si128(*temp1, 4);
+    *temp1 = _mm_xor_si128(*temp1, temp4);
+    temp4 = _mm_slli_si128(temp4, 4);
+    *temp1 = _mm_xor_si128(*temp1, temp4);
+    temp4 = _mm_slli_si128(temp4, 4);
+    *temp1 = _mm_xor_si128(*temp1, temp4);
+    *temp1 = _mm_xor_si128(*temp1, *temp2);
+}
+
+static inline void expand256Assist2(__m128i* temp1, __m128i* temp3) {
+    __m128i temp2 = _mm_shuffle_epi32(_mm_aeskeygenassist_si128(*temp1, 0x00), 0xaa);
+    __m128i temp4 = _mm_slli_si128(*temp3, 4);
+    *temp3 = _mm_xor_si128(*temp3, temp4);
+    temp4 = _mm_slli_si128(temp4, 4);
+    *temp3 = _mm_xor_si128(*temp3, temp4);
+    temp4 = _mm_slli_si128(temp4, 4);
+    *temp3 = _mm_xor_si128(*temp3, temp4);
+    *temp3 = _mm_xor_si128(*temp3, temp2);
+}
+
+/*
+ * Expands the raw key into the encryption schedule (roundKey) and the equivalent inverse
+ * cipher schedule (decRoundKey) using AESKEYGENASSIST and AESIMC.
+ *
+ * @param key The 16, 24, or 32 byte cipher key, as selected by Nw.
+ */
+void AES::keyExpansionAESNI(const unsigned char* key) {
+    __m128i ks[AES_MAX_ROUNDS + 1];
+
+    if (Nw == 4) {
+        ks[0] = _mm_loadu_si128(reinterpret_cast<const __m128i*>(key));
+        ks[1]  = expand128Assist(ks[0], _mm_aeskeygenassist_si128(ks[0], 0x01));
+        ks[2]  = expand128Assist(ks[1], _mm_aeskeygenassist_si128(ks[1], 0x02));
+        ks[3]  = expand128Assist(ks[2], _mm_aeskeygenassist_si128(ks[2], 0x04));
+        ks[4]  = expand128Assist(ks[3], _mm_aeskeygenassist_si128(ks[3], 0x08));
+        ks[5]  = expand128Assist(ks[4], _mm_aeskeygenassist_si128(ks[4], 0x10));
+        ks[6]  = expand128Assist(ks[5], _mm_aeskeygenassist_si128(ks[5], 0x20));
+        ks[7]  = expand128Assist(ks[6], _mm_aeskeygenassist_si128(ks[6], 0x40));
+        ks[8]  = expand128Assist(ks[7], _mm_aeskeygenassist_si128(ks[7], 0x80));
+        ks[9]  = expand128Assist(ks[8], _mm_aeskeygenassist_si128(ks[8], 0x1b));
+        ks[10] = expand128Assist(ks[9], _mm_aeskeygenassist_si128(ks[9], 0x36));
+    } else if (Nw == 6) {
+        // The 192-bit schedule produces 1.5 round keys per step, so halves are stitched together
+        __m128i temp1 = _mm_loadu_si128(reinterpret_cast<const __m128i*>(key));
+        __m128i temp3 = _mm_loadl_epi64(reinterpret_cast<const __m128i*>(key + 16));
+        __m128i temp2;
+        ks[0] = temp1;
+        ks[1] = temp3;
+        temp2 = _mm_aeskeygenassist_si128(temp3, 0x01);
+        expand192Assist(&temp1, &temp2, &temp3);
+        ks[1] = combineLow(ks[1], temp1);
+        ks[2] = combineCross(temp1, temp3);
+        temp2 = _mm_aeskeygenassist_si128(temp3, 0x02);
+        expand192Assist(&temp1, &temp2, &temp3);
+        ks[3] = temp1;
+        ks[4] = temp3;
+        temp2 = _mm_aeskeygenassist_si128(temp3, 0x04);
+        expand192Assist(&temp1, &temp2, &temp3);
+        ks[4] = combineLow(ks[4], temp1);
+        ks[5] = combineCross(temp1, temp3);
+        temp2 = _mm_aeskeygenassist_si128(temp3, 0x08);
+        expand192Assist(&temp1, &temp2, &temp3);
+        ks[6] = temp1;
+        ks[7] = temp3;
+        temp2 = _mm_aeskeygenassist_si128(temp3, 0x10);
+        expand192Assist(&temp1, &temp2, &temp3);
+        ks[7] = combineLow(ks[7], temp1);
+        ks[8] = combineCross(temp1, temp3);
+        temp2 = _mm_aeskeygenassist_si128(temp3, 0x20);
+        expand192Assist(&temp1, &temp2, &temp3);
+        ks[9] = temp1;
+        ks[10] = temp3;
+        temp2 = _mm_aeskeygenassist_si128(temp3, 0x40);
+        expand192Assist(&temp1, &temp2, &temp3);
+        ks[10] = combineLow(ks[10], temp1);
+        ks[11] = combineCross(temp1, temp3);
+        temp2 = _mm_aeskeygenassist_si128(temp3, 0x80);
+        expand192Assist(&temp1, &temp2, &temp3);
+        ks[12] = temp1;
+    } else {
+        __m128i temp1 = _mm_loadu_si128(reinterpret_cast<const __m128i*>(key));
+        __m128i temp3 = _mm_loadu_si128(reinterpret_cast<const __m128i*>(key + 16));
+        __m128i temp2;
+        ks[0] = temp1;
+        ks[1] = temp3;
+        temp2 = _mm_aeskeygenassist_si128(temp3, 0x01);
+        expand256Assist1(&temp1, &temp2);
+        ks[2] = temp1;
+        expand256Assist2(&temp1, &temp3);
+        ks[3] = temp3;
+        temp2 = _mm_aeskeygenassist_si128(temp3, 0x02);
+        expand256Assist1(&temp1, &temp2);
+        ks[4] = temp1;
+        expand256Assist2(&temp1, &temp3);
+        ks[5] = temp3;
+        temp2 = _mm_aeskeygenassist_si128(temp3, 0x04);
+        expand256Assist1(&temp1, &temp2);
+        ks[6] = temp1;
+        expand256Assist2(&temp1, &temp3);
+        ks[7] = temp3;
+        temp2 = _mm_aeskeygenassist_si128(temp3, 0x08);
+        expand256Assist1(&temp1, &temp2);
+        ks[8] = temp1;
+        expand256Assist2(&temp1, &temp3);
+        ks[9] = temp3;
+        temp2 = _mm_aeskeygenassist_si128(temp3, 0x10);
+        expand256Assist1(&temp1, &temp2);
+        ks[10] = temp1;
+        expand256Assist2(&temp1, &temp3);
+        ks[11] = temp3;
+        temp2 = _mm_aeskeygenassist_si128(temp3, 0x20);
+        expand256Assist1(&temp1, &temp2);
+        ks[12] = temp1;
+        expand256Assist2(&temp1, &temp3);
+        ks[13] = temp3;
+        temp2 = _mm_aeskeygenassist_si128(temp3, 0x40);
+        expand256Assist1(&temp1, &temp2);
+        ks[14] = temp1;
+    }
+
+    for (unsigned int round = 0; round <= Nr; round++) {
+        _mm_storeu_si128(reinterpret_cast<__m128i*>(roundKey + AES_BLOCK_SIZE * round), ks[round]);
+    }
+
+    // Equivalent inverse cipher: reversed order, InvMixColumns on the middle round keys
+    _mm_storeu_si128(reinterpret_cast<__m128i*>(decRoundKey), ks[Nr]);
+    for (unsigned int round = 1; round < Nr; round++) {
+        _mm_storeu_si128(reinterpret_cast<__m128i*>(decRoundKey + AES_BLOCK_SIZE * round),
+                         _mm_aesimc_si128(ks[Nr - round]));
+    }
+    _mm_storeu_si128(reinterpret_cast<__m128i*>(decRoundKey + AES_BLOCK_SIZE * Nr), ks[0]);
+}
+
+/*
+ * Encrypts consecutive blocks in place with AES-NI, AES_NI_PARALLEL_BLOCKS at a time.
+ *
+ * @param data A pointer to numBlocks * AES_BLOCK_SIZE bytes to be encrypted.
+ * @param numBlocks The number of blocks to encrypt.
+ */
+void AES::encryptBlocksAESNI(unsigned char* data, size_t numBlocks) const {
+    __m128i rk[AES_MAX_ROUNDS + 1];
+    for (unsigned int round = 0; round <= Nr; round++) {
+        rk[round] = _mm_loadu_si128(reinterpret_cast<const __m128i*>(roundKey + AES_BLOCK_SIZE * round));
+    }
+
+    __m128i* blocks = reinterpret_cast<__m128i*>(data);
+    size_t i = 0;
+
+    for (; i + AES_NI_PARALLEL_BLOCKS <= numBlocks; i += AES_NI_PARALLEL_BLOCKS) {
+        __m128i b[AES_NI_PARALLEL_BLOCKS];
+        for (size_t j = 0; j < AES_NI_PARALLEL_BLOCKS; j++) {
+            b[j] = _mm_xor_si128(_mm_loadu_si128(blocks + i + j), rk[0]);
+        }
+        for (unsigned int round = 1; round < Nr; round++) {
+            for (size_t j = 0; j < AES_NI_PARALLEL_BLOCKS; j++) {
+                b[j] = _mm_aesenc_si128(b[j], rk[round]);
+            }
+        }
+        for (size_t j = 0; j < AES_NI_PARALLEL_BLOCKS; j++) {
+            _mm_storeu_si128(blocks + i + j, _mm_aesenclast_si128(b[j], rk[Nr]));
+        }
+    }
+
+    for (; i < numBlocks; i++) {
+        __m128i b = _mm_xor_si128(_mm_loadu_si128(blocks + i), rk[0]);
+        for (unsigned int round = 1; round < Nr; round++) {
+            b = _mm_aesenc_si128(b, rk[round]);
+        }
+        _mm_storeu_si128(blocks + i, _mm_aesenclast_si128(b, rk[Nr]));
+    }
+}
+
+/*
+ * Decrypts consecutive blocks in place with AES-NI, AES_NI_PARALLEL_BLOCKS at a time.
+ *
+ * @param data A pointer to numBlocks * AES_BLOCK_SIZE bytes to be decrypted.
+ * @param numBlocks The number of blocks to decrypt.
+ */
+void AES::decryptBlocksAESNI(unsigned char* data, size_t numBlocks) const {
+    __m128i rk[AES_MAX_ROUNDS + 1];
+    for (unsigned int round = 0; round <= Nr; round++) {
+        rk[round] = _mm_loadu_si128(reinterpret_cast<const __m128i*>(decRoundKey + AES_BLOCK_SIZE * round));
+    }
+
+    __m128i* blocks = reinterpret_cast<__m128i*>(data);
+    size_t i = 0;
+
+    for (; i + AES_NI_PARALLEL_BLOCKS <= numBlocks; i += AES_NI_PARALLEL_BLOCKS) {
+        __m128i b[AES_NI_PARALLEL_BLOCKS];
+        for (size_t j = 0; j < AES_NI_PARALLEL_BLOCKS; j++) {
+            b[j] = _mm_xor_si128(_mm_loadu_si128(blocks + i + j), rk[0]);
+        }
+        for (unsigned int round = 1; round < Nr; round++) {
+            for (size_t j = 0; j < AES_NI_PARALLEL_BLOCKS; j++) {
+                b[j] = _mm_aesdec_si128(b[j], rk[round]);
+            }
+        }
+        for (size_t j = 0; j < AES_NI_PARALLEL_BLOCKS; j++) {
+            _mm_storeu_si128(blocks + i + j, _mm_aesdeclast_si128(b[j], rk[Nr]));
+        }
+    }
+
+    for (; i < numBlocks; i++) {
+        __m128i b = _mm_xor_si128(_mm_loadu_si128(blocks + i), rk[0]);
+        for (unsigned int round = 1; round < Nr; round++) {
+            b = _mm_aesdec_si128(b, rk[round]);
+        }
+        _mm_storeu_si128(blocks + i, _mm_aesdeclast_si128(b, rk[Nr]));
+    }
+}
+
+/*
+ * Encrypts consecutive blocks in place in CBC mode with AES-NI, keeping the chaining value in a register.
+ *
+ * @param data A pointer to numBlocks * AES_BLOCK_SIZE bytes to be encrypted.
+ * @param numBlocks The number of blocks to encrypt.
+ * @param iv The 16 byte chaining value, updated to the last ciphertext block.
+ */
+void AES::encryptCBCAESNI(unsigned char* data, size_t numBlocks, unsigned char iv[AES_BLOCK_SIZE]) const {
+    __m128i rk[AES_MAX_ROUNDS + 1];
+    for (unsigned int round = 0; round <= Nr; round++) {
+        rk[round] = _mm_loadu_si128(reinterpret_cast<const __m128i*>(roundKey + AES_BLOCK_SIZE * round));
+    }
+
+    __m128i* blocks = reinterpret_cast<__m128i*>(data);
+    __m128i chain = _mm_loadu_si128(reinterpret_cast<const __m128i*>(iv));
+
+    for (size_t i = 0; i < numBlocks; i++) {
+        __m128i b = _mm_xor_si128(_mm_xor_si128(_mm_loadu_si128(blocks + i), chain), rk[0]);
+        for (unsigned int round = 1; round < Nr; round++) {
+            b = _mm_aesenc_si128(b, rk[round]);
+        }
+        chain = _mm_aesenclast_si128(b, rk[Nr]);
+        _mm_storeu_si128(blocks + i, chain);
+    }
+
+    _mm_storeu_si128(reinterpret_cast<__m128i*>(iv), chain);
+}
+
+/*
+ * Decrypts consecutive blocks in place in CBC mode with AES-NI.
+ *
+ * CBC decryption has no dependency between block decryptions, so AES_NI_PARALLEL_BLOCKS blocks are
+ * decrypted in an interleaved batch and then XORed with the ciphertext blocks that precede them.
+ *
+ * @param data A pointer to numBlocks * AES_BLOCK_SIZE bytes to be decrypted.
+ * @param numBlocks The number of blocks to decrypt.
+ * @param iv The 16 byte chaining value, updated to the last ciphertext block.
+ */
+void AES::decryptCBCAESNI(unsigned char* data, size_t numBlocks, unsigned char iv[AES_BLOCK_SIZE]) const {
+    __m128i rk[AES_MAX_ROUNDS + 1];
+    for (unsigned int round = 0; round <= Nr; round++) {
+        rk[round] = _mm_loadu_si128(reinterpret_cast<const __m128i*>(decRoundKey + AES_BLOCK_SIZE * round));
+    }
+
+    __m128i* blocks = reinterpret_cast<__m128i*>(data);
+    __m128i chain = _mm_loadu_si128(reinterpret_cast<const __m128i*>(iv));
+    size_t i = 0;
+
+    for (; i + AES_NI_PARALLEL_BLOCKS <= numBlocks; i += AES_NI_PARALLEL_BLOCKS) {
+        __m128i c[AES_NI_PARALLEL_BLOCKS];
+        __m128i b[AES_NI_PARALLEL_BLOCKS];
+        for (size_t j = 0; j < AES_NI_PARALLEL_BLOCKS; j++) {
+            c[j] = _mm_loadu_si128(blocks + i + j);
+            b[j] = _mm_xor_si128(c[j], rk[0]);
+        }
+        for (unsigned int round = 1; round < Nr; round++) {
+            for (size_t j = 0; j < AES_NI_PARALLEL_BLOCKS; j++) {
+                b[j] = _mm_aesdec_si128(b[j], rk[round]);
+            }
+        }
+        _mm_storeu_si128(blocks + i, _mm_xor_si128(_mm_aesdeclast_si128(b[0], rk[Nr]), chain));
+        for (size_t j = 1; j < AES_NI_PARALLEL_BLOCKS; j++) {
+            _mm_storeu_si128(blocks + i + j, _mm_xor_si128(_mm_aesdeclast_si128(b[j], rk[Nr]), c[j - 1]));
+        }
+        chain = c[AES_NI_PARALLEL_BLOCKS - 1];
+    }
+
+    for (; i < numBlocks; i++) {
+        __m128i ciphertext = _mm_loadu_si128(blocks + i);
+        __m128i b = _mm_xor_si128(ciphertext, rk[0]);
+        for (unsigned int round = 1; round < Nr; round++) {
+            b = _mm_aesdec_si128(b, rk[round]);
+        }
+        _mm_storeu_si128(blocks + i, _mm_xor_si128(_mm_aesdeclast_si128(b, rk[Nr]), chain));
+        chain = ciphertext;
+    }
+
+    _mm_storeu_si128(reinterpret_cast<__m128i*>(iv), chain);
+}
+
+static inline uint64_t byteSwap64(uint64_t value) {
+#if defined(_MSC_VER)
+    return _byteswap_uint64(value);
+#else
+    return __builtin_bswap64(value);
+#endif
+}
+
+/*
+ * Builds the counter block for the 128-bit big-endian counter high:low.
+ */
+static inline __m128i counterBlock(uint64_t high, uint64_t low) {
+    return _mm_set_epi64x(static_cast<long long>(byteSwap64(low)), static_cast<long long>(byteSwap64(high)));
+}
+
+/*
+ * XORs the CTR keystream into numBlocks full blocks with AES-NI, encrypting AES_NI_PARALLEL_BLOCKS
+ * counter blocks at a time directly in registers.
+ *
+ * @param in The input blocks.
+ * @param out The output blocks, may alias in.
+ * @param numBlocks The number of blocks to process.
+ * @param high The high 64 bits of the counter, advanced past the last block.
+ * @param low The low 64 bits of the counter, advanced past the last block.
+ */
+void AES::encryptCTRAESNI(const unsigned char* in, unsigned char* out, size_t numBlocks, uint64_t& high, uint64_t& low) const {
+    __m128i rk[AES_MAX_ROUNDS + 1];
+    for (unsigned int round = 0; round <= Nr; round++) {
+        rk[round] = _mm_loadu_si128(reinterpret_cast<const __m128i*>(roundKey + AES_BLOCK_SIZE * round));
+    }
+
+    const __m128i* src = reinterpret_cast<const __m128i*>(in);
+    __m128i* dst = reinterpret_cast<__m128i*>(out);
+    size_t i = 0;
+
+    for (; i + AES_NI_PARALLEL_BLOCKS <= numBlocks; i += AES_NI_PARALLEL_BLOCKS) {
+        __m128i b[AES_NI_PARALLEL_BLOCKS];
+        for (size_t j = 0; j < AES_NI_PARALLEL_BLOCKS; j++) {
+            b[j] = _mm_xor_si128(counterBlock(high, low), rk[0]);
+            if (++low == 0) {
+                high++;
+            }
+        }
+        for (unsigned int round = 1; round < Nr; round++) {
+            for (size_t j = 0; j < AES_NI_PARALLEL_BLOCKS; j++) {
+                b[j] = _mm_aesenc_si128(b[j], rk[round]);
+            }
+        }
+        for (size_t j = 0; j < AES_NI_PARALLEL_BLOCKS; j++) {
+            b[j] = _mm_aesenclast_si128(b[j], rk[Nr]);
+            _mm_storeu_si128(dst + i + j, _mm_xor_si128(b[j], _mm_loadu_si128(src + i + j)));
+        }
+    }
+
+    for (; i < numBlocks; i++) {
+        __m128i b = _mm_xor_si128(counterBlock(high, low), rk[0]);
+        if (++low == 0) {
+            high++;
+        }
+        for (unsigned int round = 1; round < Nr; round++) {
+            b = _mm_aesenc_si128(b, rk[round]);
+        }
+        b = _mm_aesenclast_si128(b, rk[Nr]);
+        _mm_storeu_si128(dst + i, _mm_xor_si128(b, _mm_loadu_si128(src + i)));
+    }
+}
+
+/*
+ * Encrypts numBlocks blocks of several independent CBC streams in place, one block of every stream per
+ * step. Each stream is serial, but the streams do not depend on each other, so their rounds are
+ * interleaved and up to AES_MULTI_BUFFER_LANES AESENC instructions are in flight at once. Streams may
+ * use different key sizes; a stream's final round is applied once its own round count is reached.
+ *
+ * @param ciphers The AES-NI contexts of the streams.
+ * @param data The numBlocks * AES_BLOCK_SIZE byte buffer of each stream.
+ * @param ivs The 16 byte chaining value of each stream, updated to its last ciphertext block.
+ * @param numLanes The number of streams, at most AES_MULTI_BUFFER_LANES.
+ * @param numBlocks The number of blocks to encrypt in every stream.
+ */
+void AES::encryptCBCLanesAESNI(
+    const AES* const* ciphers, unsigned char* const* data, unsigned char* const* ivs, size_t numLanes, size_t numBlocks
+) {
+    const __m128i* rk[AES_MULTI_BUFFER_LANES];
+    unsigned int rounds[AES_MULTI_BUFFER_LANES];
+    __m128i chain[AES_MULTI_BUFFER_LANES];
+    unsigned int maxRounds = 0;
+
+    for (size_t lane = 0; lane < numLanes; lane++) {
+        rk[lane] = reinterpret_cast<const __m128i*>(ciphers[lane]->roundKey);
+        rounds[lane] = ciphers[lane]->Nr;
+        chain[lane] = _mm_loadu_si128(reinterpret_cast<const __m128i*>(ivs[lane]));
+        maxRounds = rounds[lane] > maxRounds ? rounds[lane] : maxRounds;
+    }
+
+    for (size_t i = 0; i < numBlocks; i++) {
+        for (size_t lane = 0; lane < numLanes; lane++) {
+            __m128i block = _mm_loadu_si128(reinterpret_cast<const __m128i*>(data[lane]) + i);
+            chain[lane] = _mm_xor_si128(_mm_xor_si128(block, chain[lane]), _mm_loadu_si128(rk[lane]));
+        }
+        for (unsigned int round = 1; round < maxRounds; round++) {
+            for (size_t lane = 0; lane < numLanes; lane++) {
+                if (round < rounds[lane]) {
+                    chain[lane] = _mm_aesenc_si128(chain[lane], _mm_loadu_si128(rk[lane] + round));
+                }
+            }
+        }
+        for (size_t lane = 0; lane < numLanes; lane++) {
+            chain[lane] = _mm_aesenclast_si128(chain[lane], _mm_loadu_si128(rk[lane] + rounds[lane]));
+            _mm_storeu_si128(reinterpret_cast<__m128i*>(data[lane]) + i, chain[lane]);
+        }
+    }
+
+    for (size_t lane = 0; lane < numLanes; lane++) {
+        _mm_storeu_si128(reinterpret_cast<__m128i*>(ivs[lane]), chain[lane]);
+    }
+}
+
+#else
+
+// AES-NI is x86 only; isAESBackendSupported never reports it elsewhere, so these are unreachable.
+void AES::keyExpansionAESNI(const unsigned char*) {}
+void AES::encryptBlocksAESNI(unsigned char*, size_t) const {}
+void AES::decryptBlocksAESNI(unsigned char*, size_t) const {}
+void AES::encryptCBCAESNI(unsigned char*, size_t, unsigned char*) const {}
+void AES::decryptCBCAESNI(unsigned char*, size_t, unsigned char*) const {}
+void AES::encryptCTRAESNI(const unsigned char*, unsigned char*, size_t, uint64_t&, uint64_t&) const {}
+void AES::encryptCBCLanesAESNI(const AES* const*, unsigned char* const*, unsigned char* const*, size_t, size_t) {}
+
+#endif
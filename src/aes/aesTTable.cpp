@@ -0,0 +1,162 @@
+/*
+ * Copyright 2023-2024 The Gestalt Project Authors. All Rights Reserved.
+ *
+ * Licensed under the MIT License. See the file LICENSE for the full text.
+ */
+
+/*
+ * aesTTable.cpp
+ *
+ * This file contains the word-oriented (T-table) round engine for the AES class.
+ *
+ * References:
+ * - The Design of Rijndael: AES - The Advanced Encryption Standard, Section 4.2 (Daemen and Rijmen)
+ * - FIPS 197, Section 5.3.5 "Equivalent Inverse Cipher"
+ *
+ * Each column of the state is held in a 32-bit word with the row 0 byte in the most significant
+ * position, so column c of the state is the big-endian word loaded from state[4c .. 4c + 3]. A full
+ * round then becomes four table lookups and four XORs per column:
+ *
+ *    t0 = TE0[s0 >> 24] ^ TE1[(s1 >> 16) & 0xff] ^ TE2[(s2 >> 8) & 0xff] ^ TE3[s3 & 0xff] ^ rk[0]
+ *
+ * where choosing the source column of each byte applies ShiftRows, the table applies SubBytes and
+ * MixColumns, and the round key word applies AddRoundKey. The last round has no MixColumns and uses
+ * the plain S-box instead.
+ *
+ * Decryption uses the equivalent inverse cipher, which keeps the same round structure as encryption
+ * by applying InvMixColumns to the middle round keys once during key setup.
+ */
+
+#include "aesCore.h"
+#include "aesConstants.h"
+
+static inline uint32_t loadWord(const unsigned char* in) {
+    return (static_cast<uint32_t>(in[0]) << 24) | (static_cast<uint32_t>(in[1]) << 16) |
+           (static_cast<uint32_t>(in[2]) << 8)  |  static_cast<uint32_t>(in[3]);
+}
+
+static inline void storeWord(unsigned char* out, uint32_t word) {
+    out[0] = static_cast<unsigned char>(word >> 24);
+    out[1] = static_cast<unsigned char>(word >> 16);
+    out[2] = static_cast<unsigned char>(word >> 8);
+    out[3] = static_cast<unsigned char>(word);
+}
+
+/*
+ * Builds the word round key schedules from the byte schedule produced by keyExpansion.
+ *
+ * The encryption schedule is the byte schedule regrouped into words. The decryption schedule lists the
+ * round keys in reverse order with InvMixColumns applied to every key except the first and last. The
+ * InvMixColumns of a word w is computed as TD0[SBOX[w0]] ^ TD1[SBOX[w1]] ^ TD2[SBOX[w2]] ^ TD3[SBOX[w3]]
+ * because the TD tables already include the inverse S-box.
+ */
+void AES::expandRoundKeyWords() {
+    const unsigned int numWords = 4 * (Nr + 1);
+
+    for (unsigned int i = 0; i < numWords; i++) {
+        encRoundKeyWords[i] = loadWord(roundKey + 4 * i);
+    }
+
+    for (unsigned int round = 0; round <= Nr; round++) {
+        const uint32_t* src = encRoundKeyWords + 4 * (Nr - round);
+        uint32_t* dst = decRoundKeyWords + 4 * round;
+
+        for (int i = 0; i < 4; i++) {
+            uint32_t w = src[i];
+            if (round == 0 || round == Nr) {
+                dst[i] = w;
+            } else {
+                dst[i] = TD0[SBOX[(w >> 24) & 0xff]] ^
+                         TD1[SBOX[(w >> 16) & 0xff]] ^
+                         TD2[SBOX[(w >> 8) & 0xff]] ^
+                         TD3[SBOX[w & 0xff]];
+            }
+        }
+    }
+}
+
+/*
+ * Encrypts a single AES block (16 bytes) in place with the T-table engine.
+ *
+ * @param state A pointer to the input block to be encrypted.
+ */
+void AES::encryptBlockTTable(unsigned char* state) const {
+    const uint32_t* rk = encRoundKeyWords;
+
+    uint32_t s0 = loadWord(state)      ^ rk[0];
+    uint32_t s1 = loadWord(state + 4)  ^ rk[1];
+    uint32_t s2 = loadWord(state + 8)  ^ rk[2];
+    uint32_t s3 = loadWord(state + 12) ^ rk[3];
+    uint32_t t0, t1, t2, t3;
+
+    for (unsigned int round = 1; round < Nr; round++) {
+        rk += 4;
+        t0 = TE0[s0 >> 24] ^ TE1[(s1 >> 16) & 0xff] ^ TE2[(s2 >> 8) & 0xff] ^ TE3[s3 & 0xff] ^ rk[0];
+        t1 = TE0[s1 >> 24] ^ TE1[(s2 >> 16) & 0xff] ^ TE2[(s3 >> 8) & 0xff] ^ TE3[s0 & 0xff] ^ rk[1];
+        t2 = TE0[s2 >> 24] ^ TE1[(s3 >> 16) & 0xff] ^ TE2[(s0 >> 8) & 0xff] ^ TE3[s1 & 0xff] ^ rk[2];
+        t3 = TE0[s3 >> 24] ^ TE1[(s0 >> 16) & 0xff] ^ TE2[(s1 >> 8) & 0xff] ^ TE3[s2 & 0xff] ^ rk[3];
+        s0 = t0;
+        s1 = t1;
+        s2 = t2;
+        s3 = t3;
+    }
+
+    // Final round: SubBytes, ShiftRows and AddRoundKey only
+    rk += 4;
+    t0 = (static_cast<uint32_t>(SBOX[s0 >> 24]) << 24) ^ (static_cast<uint32_t>(SBOX[(s1 >> 16) & 0xff]) << 16) ^
+         (static_cast<uint32_t>(SBOX[(s2 >> 8) & 0xff]) << 8) ^ static_cast<uint32_t>(SBOX[s3 & 0xff]) ^ rk[0];
+    t1 = (static_cast<uint32_t>(SBOX[s1 >> 24]) << 24) ^ (static_cast<uint32_t>(SBOX[(s2 >> 16) & 0xff]) << 16) ^
+         (static_cast<uint32_t>(SBOX[(s3 >> 8) & 0xff]) << 8) ^ static_cast<uint32_t>(SBOX[s0 & 0xff]) ^ rk[1];
+    t2 = (static_cast<uint32_t>(SBOX[s2 >> 24]) << 24) ^ (static_cast<uint32_t>(SBOX[(s3 >> 16) & 0xff]) << 16) ^
+         (static_cast<uint32_t>(SBOX[(s0 >> 8) & 0xff]) << 8) ^ static_cast<uint32_t>(SBOX[s1 & 0xff]) ^ rk[2];
+    t3 = (static_cast<uint32_t>(SBOX[s3 >> 24]) << 24) ^ (static_cast<uint32_t>(SBOX[(s0 >> 16) & 0xff]) << 16) ^
+         (static_cast<uint32_t>(SBOX[(s1 >> 8) & 0xff]) << 8) ^ static_cast<uint32_t>(SBOX[s2 & 0xff]) ^ rk[3];
+
+    storeWord(state, t0);
+    storeWord(state + 4, t1);
+    storeWord(state + 8, t2);
+    storeWord(state + 12, t3);
+}
+
+/*
+ * Decrypts a single AES block (16 bytes) in place with the T-table engine.
+ *
+ * @param state A pointer to the input block to be decrypted.
+ */
+void AES::decryptBlockTTable(unsigned char* state) const {
+    const uint32_t* rk = decRoundKeyWords;
+
+    uint32_t s0 = loadWord(state)      ^ rk[0];
+    uint32_t s1 = loadWord(state + 4)  ^ rk[1];
+    uint32_t s2 = loadWord(state + 8)  ^ rk[2];
+    uint32_t s3 = loadWord(state + 12) ^ rk[3];
+    uint32_t t0, t1, t2, t3;
+
+    for (unsigned int round = 1; round < Nr; round++) {
+        rk += 4;
+        t0 = TD0[s0 >> 24] ^ TD1[(s3 >> 16) & 0xff] ^ TD2[(s2 >> 8) & 0xff] ^ TD3[s1 & 0xff] ^ rk[0];
+        t1 = TD0[s1 >> 24] ^ TD1[(s0 >> 16) & 0xff] ^ TD2[(s3 >> 8) & 0xff] ^ TD3[s2 & 0xff] ^ rk[1];
+        t2 = TD0[s2 >> 24] ^ TD1[(s1 >> 16) & 0xff] ^ TD2[(s0 >> 8) & 0xff] ^ TD3[s3 & 0xff] ^ rk[2];
+        t3 = TD0[s3 >> 24] ^ TD1[(s2 >> 16) & 0xff] ^ TD2[(s1 >> 8) & 0xff] ^ TD3[s0 & 0xff] ^ rk[3];
+        s0 = t0;
+        s1 = t1;
+        s2 = t2;
+        s3 = t3;
+    }
+
+    // Final round: InvShiftRows, InvSubBytes and AddRoundKey only
+    rk += 4;
+    t0 = (static_cast<uint32_t>(INVSBOX[s0 >> 24]) << 24) ^ (static_cast<uint32_t>(INVSBOX[(s3 >> 16) & 0xff]) << 16) ^
+         (static_cast<uint32_t>(INVSBOX[(s2 >> 8) & 0xff]) << 8) ^ static_cast<uint32_t>(INVSBOX[s1 & 0xff]) ^ rk[0];
+    t1 = (static_cast<uint32_t>(INVSBOX[s1 >> 24]) << 24) ^ (static_cast<uint32_t>(INVSBOX[(s0 >> 16) & 0xff]) << 16) ^
+         (static_cast<uint32_t>(INVSBOX[(s3 >> 8) & 0xff]) << 8) ^ static_cast<uint32_t>(INVSBOX[s2 & 0xff]) ^ rk[1];
+    t2 = (static_cast<uint32_t>(INVSBOX[s2 >> 24]) << 24) ^ (static_cast<uint32_t>(INVSBOX[(s1 >> 16) & 0xff]) << 16) ^
+         (static_cast<uint32_t>(INVSBOX[(s0 >> 8) & 0xff]) << 8) ^ static_cast<uint32_t>(INVSBOX[s3 & 0xff]) ^ rk[2];
+    t3 = (static_cast<uint32_t>(INVSBOX[s3 >> 24]) << 24) ^ (static_cast<uint32_t>(INVSBOX[(s2 >> 16) & 0xff]) << 16) ^
+         (static_cast<uint32_t>(INVSBOX[(s1 >> 8) & 0xff]) << 8) ^ static_cast<uint32_t>(INVSBOX[s0 & 0xff]) ^ rk[3];
+
+    storeWord(state, t0);
+    storeWord(state + 4, t1);
+    storeWord(state + 8, t2);
+    storeWord(state + 12, t3);
+}
@@ -0,0 +1,288 @@
+/*
+ * Copyright 2023-2024 The Gestalt Project Authors. All Rights Reserved.
+ *
+ * Licensed under the MIT License. See the file LICENSE for the full text.
+ */
+
+/*
+ * aesXTS.cpp
+ *
+ * This file contains the XTS-AES mode for storage encryption.
+ *
+ * References:
+ * - IEEE Std 1619-2018, "IEEE Standard for Cryptographic Protection of Data on Block-Oriented Storage Devices"
+ * - NIST SP 800-38E, "Recommendation for Block Cipher Modes of Operation: The XTS-AES Mode for
+ *   Confidentiality on Storage Devices"
+ *
+ * A data unit (sector or page) with data unit number i is processed block by block as
+ *    T_0 = E_K2(i), T_j+1 = T_j * alpha
+ *    C_j = E_K1(P_j ^ T_j) ^ T_j
+ * where the tweak multiplication by alpha is a one bit shift of the 128-bit little-endian tweak
+ * with 0x87 folded back in. The blocks of a unit are independent once their tweaks are known, so
+ * they are encrypted AES_XTS_BATCH at a time through encryptBlocks, and whole units run on separate
+ * threads.
+ *
+ * A unit that does not end on a block boundary uses ciphertext stealing: the last full block is
+ * encrypted with the final tweak after borrowing the tail of the previous ciphertext block, so the
+ * ciphertext has exactly the length of the plaintext.
+ */
+
+#include <cstring>
+#include <stdexcept>
+#include <vector>
+
+#include <gestalt/aes.h>
+#include "aesCore.h"
+#include "parallel/parallel.h"
+
+static const size_t AES_XTS_BATCH = 8; // Blocks whitened and encrypted together
+
+static inline uint64_t loadLittleEndian64(const unsigned char* in) {
+    uint64_t value = 0;
+    for (int i = 7; i >= 0; i--) {
+        value = (value << 8) | in[i];
+    }
+    return value;
+}
+
+static inline void storeLittleEndian64(unsigned char* out, uint64_t value) {
+    for (int i = 0; i < 8; i++) {
+        out[i] = static_cast<unsigned char>(value);
+        value >>= 8;
+    }
+}
+
+/*
+ * Multiplies the tweak by alpha in GF(2^128), without a branch on the tweak.
+ */
+static inline void multiplyAlpha(uint64_t& low, uint64_t& high) {
+    uint64_t carry = high >> 63;
+    high = (high << 1) | (low >> 63);
+    low = (low << 1) ^ (0x87 & (0 - carry));
+}
+
+static inline void xorBlocks(unsigned char* out, const unsigned char* in, const unsigned char* mask, size_t length) {
+    for (size_t i = 0; i < length; i++) {
+        out[i] = in[i] ^ mask[i];
+    }
+}
+
+static size_t halfKeyLength(size_t keyLen) {
+    if (keyLen != 32 && keyLen != 64) {
+        throw std::invalid_argument("Invalid XTS key size. Expected 256 or 512 bits.");
+    }
+    return keyLen / 2;
+}
+
+/*
+ * Splits the double-length key into the data key and the tweak key.
+ *
+ * @param key The 32 byte (XTS-AES-128) or 64 byte (XTS-AES-256) key, data key first.
+ * @param keyLen The length of the key in bytes.
+ * @throws std::invalid_argument if the key is not 32 or 64 bytes.
+ */
+AESXTS::AESXTS(const uint8_t* key, size_t keyLen)
+    : dataCipher(key, halfKeyLength(keyLen)), tweakCipher(key + keyLen / 2, keyLen / 2) {}
+
+/*
+ * Encrypts or decrypts one data unit.
+ *
+ * @param in The input bytes.
+ * @param length The length of the data unit, at least AES_BLOCK_SIZE.
+ * @param dataUnit The data unit number.
+ * @param out The output buffer of length bytes, may alias in.
+ * @param encrypting Selects encryption or decryption.
+ */
+void AESXTS::processDataUnit(const uint8_t* in, size_t length, uint64_t dataUnit, uint8_t* out, bool encrypting) const {
+    unsigned char tweak[AES_BLOCK_SIZE] = { 0 };
+    storeLittleEndian64(tweak, dataUnit);
+    tweakCipher.encryptBlock(tweak);
+
+    uint64_t low = loadLittleEndian64(tweak);
+    uint64_t high = loadLittleEndian64(tweak + 8);
+
+    size_t tail = length % AES_BLOCK_SIZE;
+    size_t bulkBlocks = length / AES_BLOCK_SIZE - (tail != 0 ? 1 : 0);
+
+    unsigned char tweaks[AES_XTS_BATCH * AES_BLOCK_SIZE];
+    for (size_t i = 0; i < bulkBlocks; i += AES_XTS_BATCH) {
+        size_t batch = bulkBlocks - i < AES_XTS_BATCH ? bulkBlocks - i : AES_XTS_BATCH;
+        size_t batchBytes = batch * AES_BLOCK_SIZE;
+        unsigned char* blocks = out + i * AES_BLOCK_SIZE;
+
+        for (size_t j = 0; j < batch; j++) {
+            storeLittleEndian64(tweaks + j * AES_BLOCK_SIZE, low);
+            storeLittleEndian64(tweaks + j * AES_BLOCK_SIZE + 8, high);
+            multiplyAlpha(low, high);
+        }
+
+        xorBlocks(blocks, in + i * AES_BLOCK_SIZE, tweaks, batchBytes);
+        if (encrypting) {
+            dataCipher.encryptBlocks(blocks, batch);
+        } else {
+            dataCipher.decryptBlocks(blocks, batch);
+        }
+        xorBlocks(blocks, blocks, tweaks, batchBytes);
+    }
+
+    if (tail == 0) {
+        return;
+    }
+
+    // Ciphertext stealing over the last full block and the partial block after it
+    unsigned char previousTweak[AES_BLOCK_SIZE];
+    unsigned char lastTweak[AES_BLOCK_SIZE];
+    storeLittleEndian64(previousTweak, low);
+    storeLittleEndian64(previousTweak + 8, high);
+    multiplyAlpha(low, high);
+    storeLittleEndian64(lastTweak, low);
+    storeLittleEndian64(lastTweak + 8, high);
+
+    // Encryption whitens the full block with the earlier tweak, decryption undoes the later one first
+    const unsigned char* firstTweak = encrypting ? previousTweak : lastTweak;
+    const unsigned char* secondTweak = encrypting ? lastTweak : previousTweak;
+
+    const unsigned char* inBlock = in + bulkBlocks * AES_BLOCK_SIZE;
+    unsigned char* outBlock = out + bulkBlocks * AES_BLOCK_SIZE;
+    unsigned char block[AES_BLOCK_SIZE];
+    unsigned char stolen[AES_BLOCK_SIZE];
+
+    xorBlocks(block, inBlock, firstTweak, AES_BLOCK_SIZE);
+    memcpy(stolen, inBlock + AES_BLOCK_SIZE, tail);
+    if (encrypting) {
+        dataCipher.encryptBlock(block);
+    } else {
+        dataCipher.decryptBlock(block);
+    }
+    xorBlocks(block, block, firstTweak, AES_BLOCK_SIZE);
+
+    memcpy(stolen + tail, block + tail, AES_BLOCK_SIZE - tail);
+    memcpy(outBlock + AES_BLOCK_SIZE, block, tail);
+
+    xorBlocks(block, stolen, secondTweak, AES_BLOCK_SIZE);
+    if (encrypting) {
+        dataCipher.encryptBlock(block);
+    } else {
+        dataCipher.decryptBlock(block);
+    }
+    xorBlocks(outBlock, block, secondTweak, AES_BLOCK_SIZE);
+}
+
+/*
+ * Encrypts consecutive data units of dataUnitSize bytes, numbered from firstDataUnit. Large buffers
+ * are split into ranges of whole units that are encrypted on separate threads.
+ */
+void AESXTS::processDataUnits(
+    const uint8_t* in, size_t length, size_t dataUnitSize, uint64_t firstDataUnit, uint8_t* out, bool encrypting
+) const {
+    if (dataUnitSize < AES_BLOCK_SIZE || length % dataUnitSize != 0) {
+        throw std::invalid_argument("Invalid XTS data unit. Expected at least 16 bytes and a whole number of units.");
+    }
+
+    std::vector<BlockRange> ranges = splitBlockRange(length / dataUnitSize, dataUnitSize);
+    parallelFor(ranges.size(), [&](size_t i) {
+        for (size_t unit = ranges[i].first; unit < ranges[i].first + ranges[i].count; unit++) {
+            processDataUnit(in + unit * dataUnitSize, dataUnitSize, firstDataUnit + unit, out + unit * dataUnitSize, encrypting);
+        }
+    });
+}
+
+/*
+ * Encrypts a single data unit.
+ *
+ * @param in The plaintext of the data unit.
+ * @param length The length of the data unit in bytes, at least 16.
+ * @param dataUnit The data unit number, such as the sector or page index.
+ * @param out Output buffer of length bytes, may alias in.
+ * @throws std::invalid_argument if the data unit is shorter than 16 bytes.
+ */
+void AESXTS::encryptDataUnit(const uint8_t* in, size_t length, uint64_t dataUnit, uint8_t* out) const {
+    if (length < AES_BLOCK_SIZE) {
+        throw std::invalid_argument("Invalid XTS data unit. Expected at least 16 bytes.");
+    }
+    processDataUnit(in, length, dataUnit, out, true);
+}
+
+/*
+ * Decrypts a single data unit.
+ *
+ * @param in The ciphertext of the data unit.
+ * @param length The length of the data unit in bytes, at least 16.
+ * @param dataUnit The data unit number used for encryption.
+ * @param out Output buffer of length bytes, may alias in.
+ * @throws std::invalid_argument if the data unit is shorter than 16 bytes.
+ */
+void AESXTS::decryptDataUnit(const uint8_t* in, size_t length, uint64_t dataUnit, uint8_t* out) const {
+    if (length < AES_BLOCK_SIZE) {
+        throw std::invalid_argument("Invalid XTS data unit. Expected at least 16 bytes.");
+    }
+    processDataUnit(in, length, dataUnit, out, false);
+}
+
+/*
+ * Encrypts consecutive data units, such as a run of sectors.
+ *
+ * @param in The plaintext of the data units.
+ * @param length The total length in bytes, a multiple of dataUnitSize.
+ * @param dataUnitSize The size of each data unit in bytes, at least 16.
+ * @param firstDataUnit The number of the first data unit; the following units are numbered consecutively.
+ * @param out Output buffer of length bytes, may alias in.
+ * @throws std::invalid_argument if the data unit size or the length is invalid.
+ */
+void AESXTS::encryptDataUnits(const uint8_t* in, size_t length, size_t dataUnitSize, uint64_t firstDataUnit, uint8_t* out) const {
+    processDataUnits(in, length, dataUnitSize, firstDataUnit, out, true);
+}
+
+/*
+ * Decrypts consecutive data units, such as a run of sectors.
+ *
+ * @param in The ciphertext of the data units.
+ * @param length The total length in bytes, a multiple of dataUnitSize.
+ * @param dataUnitSize The size of each data unit in bytes, at least 16.
+ * @param firstDataUnit The number of the first data unit.
+ * @param out Output buffer of length bytes, may alias in.
+ * @throws std::invalid_argument if the data unit size or the length is invalid.
+ */
+void AESXTS::decryptDataUnits(const uint8_t* in, size_t length, size_t dataUnitSize, uint64_t firstDataUnit, uint8_t* out) const {
+    processDataUnits(in, length, dataUnitSize, firstDataUnit, out, false);
+}
+
+/*
+ * Encrypts consecutive data units with XTS-AES.
+ *
+ * @param in The plaintext bytes.
+ * @param length The total length in bytes, a multiple of dataUnitSize.
+ * @param key The 32 or 64 byte XTS key.
+ * @param keyLen The length of the key in bytes.
+ * @param dataUnitSize The size of each data unit in bytes, at least 16.
+ * @param firstDataUnit The number of the first data unit.
+ * @param out Output buffer of length bytes, may alias in.
+ * @throws std::invalid_argument if the key, data unit size or length is invalid.
+ */
+void encryptAESXTS(
+    const uint8_t* in, size_t length, const uint8_t* key, size_t keyLen, size_t dataUnitSize, uint64_t firstDataUnit,
+    uint8_t* out
+) {
+    AESXTS xts(key, keyLen);
+    xts.encryptDataUnits(in, length, dataUnitSize, firstDataUnit, out);
+}
+
+/*
+ * Decrypts consecutive data units with XTS-AES.
+ *
+ * @param in The ciphertext bytes.
+ * @param length The total length in bytes, a multiple of dataUnitSize.
+ * @param key The 32 or 64 byte XTS key.
+ * @param keyLen The length of the key in bytes.
+ * @param dataUnitSize The size of each data unit in bytes, at least 16.
+ * @param firstDataUnit The number of the first data unit.
+ * @param out Output buffer of length bytes, may alias in.
+ * @throws std::invalid_argument if the key, data unit size or length is invalid.
+ */
+void decryptAESXTS(
+    const uint8_t* in, size_t length, const uint8_t* key, size_t keyLen, size_t dataUnitSize, uint64_t firstDataUnit,
+    uint8_t* out
+) {
+    AESXTS xts(key, keyLen);
+    xts.decryptDataUnits(in, length, dataUnitSize, firstDataUnit, out);
+}
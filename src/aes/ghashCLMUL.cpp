@@ -0,0 +1,170 @@
+/*
+ * Copyright 2023-2024 The Gestalt Project Authors. All Rights Reserved.
+ *
+ * Licensed under the MIT License. See the file LICENSE for the full text.
+ */
+
+/*
+ * ghashCLMUL.cpp
+ *
+ * This file contains the PCLMULQDQ GHASH engine.
+ *
+ * References:
+ * - "Intel Carry-Less Multiplication Instruction and its Usage for Computing the GCM Mode" white paper
+ *   by Shay Gueron and Michael E. Kounavis, Algorithms 2, 4 and 5
+ *
+ * Blocks are byte reversed on load, which turns the bit-reflected GHASH field elements into
+ * polynomials whose bits are reflected as a whole. The 256-bit carry-less product of two such values
+ * is then shifted left by one bit to undo the reflection and reduced modulo x^128 + x^7 + x^2 + x + 1.
+ *
+ * The reduction is linear, so four products can be summed before it is applied once:
+ *    X' = (X ^ B0) * H^4 ^ B1 * H^3 ^ B2 * H^2 ^ B3 * H
+ * which is why the powers H^1..H^4 are precomputed per key.
+ *
+ * This translation unit is compiled with PCLMULQDQ and SSSE3 code generation enabled and must only be
+ * entered after getCPUFeatures() has reported both.
+ */
+
+#include "aesGCM.h"
+#include "cpu_features/cpu_features.h"
+
+#if defined(GESTALT_X86)
+
+#include <emmintrin.h>
+#include <tmmintrin.h>
+#include <wmmintrin.h>
+
+static inline __m128i byteReverse(__m128i x) {
+    const __m128i mask = _mm_set_epi8(0, 1, 2, 3, 4, 5, 6, 7, 8, 9, 10, 11, 12, 13, 14, 15);
+    return _mm_shuffle_epi8(x, mask);
+}
+
+/*
+ * Computes the unreduced 256-bit carry-less product of a and b as low and high halves.
+ */
+static inline void multiplyUnreduced(__m128i a, __m128i b, __m128i* low, __m128i* high) {
+    __m128i lo = _mm_clmulepi64_si128(a, b, 0x00);
+    __m128i mid = _mm_xor_si128(_mm_clmulepi64_si128(a, b, 0x10), _mm_clmulepi64_si128(a, b, 0x01));
+    __m128i hi = _mm_clmulepi64_si128(a, b, 0x11);
+
+    *low = _mm_xor_si128(lo, _mm_slli_si128(mid, 8));
+    *high = _mm_xor_si128(hi, _mm_srli_si128(mid, 8));
+}
+
+/*
+ * Shifts the 256-bit product left by one bit and reduces it modulo the GCM polynomial.
+ */
+static inline __m128i reduce(__m128i low, __m128i high) {
+    // Shift the 256-bit value high:low left by one bit
+    __m128i lowCarry = _mm_srli_epi32(low, 31);
+    __m128i highCarry = _mm_srli_epi32(high, 31);
+    low = _mm_slli_epi32(low, 1);
+    high = _mm_slli_epi32(high, 1);
+
+    __m128i crossCarry = _mm_srli_si128(lowCarry, 12);
+    highCarry = _mm_slli_si128(highCarry, 4);
+    lowCarry = _mm_slli_si128(lowCarry, 4);
+    low = _mm_or_si128(low, lowCarry);
+    high = _mm_or_si128(high, highCarry);
+    high = _mm_or_si128(high, crossCarry);
+
+    // First phase of the reduction
+    __m128i a = _mm_slli_epi32(low, 31);
+    __m128i b = _mm_slli_epi32(low, 30);
+    __m128i c = _mm_slli_epi32(low, 25);
+    a = _mm_xor_si128(a, b);
+    a = _mm_xor_si128(a, c);
+    b = _mm_srli_si128(a, 4);
+    a = _mm_slli_si128(a, 12);
+    low = _mm_xor_si128(low, a);
+
+    // Second phase of the reduction
+    __m128i d = _mm_srli_epi32(low, 1);
+    __m128i e = _mm_srli_epi32(low, 2);
+    __m128i f = _mm_srli_epi32(low, 7);
+    d = _mm_xor_si128(d, e);
+    d = _mm_xor_si128(d, f);
+    d = _mm_xor_si128(d, b);
+    low = _mm_xor_si128(low, d);
+
+    return _mm_xor_si128(high, low);
+}
+
+static inline __m128i multiply(__m128i a, __m128i b) {
+    __m128i low, high;
+    multiplyUnreduced(a, b, &low, &high);
+    return reduce(low, high);
+}
+
+/*
+ * Precomputes H^1..H^4 in byte reversed form.
+ *
+ * @param h The 16 byte hash subkey.
+ * @param hPowers Output for the four powers, H^1 first.
+ */
+void ghashInitCLMUL(const unsigned char h[16], unsigned char hPowers[GHASH_CLMUL_AGGREGATE * 16]) {
+    __m128i h1 = byteReverse(_mm_loadu_si128(reinterpret_cast<const __m128i*>(h)));
+    __m128i power = h1;
+
+    for (size_t i = 0; i < GHASH_CLMUL_AGGREGATE; i++) {
+        _mm_storeu_si128(reinterpret_cast<__m128i*>(hPowers + 16 * i), power);
+        power = multiply(power, h1);
+    }
+}
+
+/*
+ * Absorbs whole blocks into the GHASH state, four blocks per reduction.
+ *
+ * @param state The 16 byte hash state.
+ * @param hPowers The powers of H from ghashInitCLMUL.
+ * @param data A pointer to numBlocks * 16 bytes.
+ * @param numBlocks The number of blocks to absorb.
+ */
+void ghashUpdateCLMUL(
+    unsigned char state[16], const unsigned char hPowers[GHASH_CLMUL_AGGREGATE * 16], const unsigned char* data, size_t numBlocks
+) {
+    const __m128i* powers = reinterpret_cast<const __m128i*>(hPowers);
+    const __m128i h1 = _mm_loadu_si128(powers);
+    const __m128i h2 = _mm_loadu_si128(powers + 1);
+    const __m128i h3 = _mm_loadu_si128(powers + 2);
+    const __m128i h4 = _mm_loadu_si128(powers + 3);
+
+    const __m128i* blocks = reinterpret_cast<const __m128i*>(data);
+    __m128i x = byteReverse(_mm_loadu_si128(reinterpret_cast<const __m128i*>(state)));
+    size_t i = 0;
+
+    for (; i + GHASH_CLMUL_AGGREGATE <= numBlocks; i += GHASH_CLMUL_AGGREGATE) {
+        __m128i b0 = _mm_xor_si128(x, byteReverse(_mm_loadu_si128(blocks + i)));
+        __m128i b1 = byteReverse(_mm_loadu_si128(blocks + i + 1));
+        __m128i b2 = byteReverse(_mm_loadu_si128(blocks + i + 2));
+        __m128i b3 = byteReverse(_mm_loadu_si128(blocks + i + 3));
+
+        __m128i low, high, partLow, partHigh;
+        multiplyUnreduced(b0, h4, &low, &high);
+        multiplyUnreduced(b1, h3, &partLow, &partHigh);
+        low = _mm_xor_si128(low, partLow);
+        high = _mm_xor_si128(high, partHigh);
+        multiplyUnreduced(b2, h2, &partLow, &partHigh);
+        low = _mm_xor_si128(low, partLow);
+        high = _mm_xor_si128(high, partHigh);
+        multiplyUnreduced(b3, h1, &partLow, &partHigh);
+        low = _mm_xor_si128(low, partLow);
+        high = _mm_xor_si128(high, partHigh);
+
+        x = reduce(low, high);
+    }
+
+    for (; i < numBlocks; i++) {
+        x = multiply(_mm_xor_si128(x, byteReverse(_mm_loadu_si128(blocks + i))), h1);
+    }
+
+    _mm_storeu_si128(reinterpret_cast<__m128i*>(state), byteReverse(x));
+}
+
+#else
+
+// PCLMULQDQ is x86 only; isGHASHBackendSupported never reports it elsewhere, so these are unreachable.
+void ghashInitCLMUL(const unsigned char*, unsigned char*) {}
+void ghashUpdateCLMUL(unsigned char*, const unsigned char*, const unsigned char*, size_t) {}
+
+#endif
@@ -11,39 +11,494 @@
  */
 
 #include <string>
+#include <cstring>
+#include <stdexcept>
 
 #include <gestalt/des.h>
 #include "des/desCore.h"
+#include "des/desBitsliced.h"
+#include "parallel/parallel.h"
 
-std::string encryptDESECB(const std::string& plaintext, const std::string& key) {
-    validateKey(key);
-    DES des(key);
+// Blocks loaded from the message at a time, enough for one pass of the widest bitsliced engine
+const size_t DES_BULK_BLOCKS = DES_BITSLICED_AVX2_BLOCKS;
+
+/*
+ * Single DES for the modes whose blocks are independent, ECB and CBC decryption: whole groups of
+ * DES_BITSLICED_BLOCKS go through the bitsliced engine and the rest through the table driven DES.
+ */
+struct BulkDES {
+    DES des;
+    DESBitsliced bitsliced;
+
+    explicit BulkDES(const DES& des) : des(des), bitsliced(des) {}
 
-    std::string paddedPlaintext = applyPCKS5Padding(plaintext);
-    std::vector<uint64_t> blocks = stringToBlocks(paddedPlaintext);
+    uint64_t encryptBlock(uint64_t block) const { return des.encryptBlock(block); }
+    uint64_t decryptBlock(uint64_t block) const { return des.decryptBlock(block); }
+    void encryptGroups(uint64_t* blocks, size_t numBlocks) const { bitsliced.encryptBlocks(blocks, numBlocks); }
+    void decryptGroups(uint64_t* blocks, size_t numBlocks) const { bitsliced.decryptBlocks(blocks, numBlocks); }
+};
 
-    std::vector<uint64_t> encryptedBlocks;
-    for (uint64_t block : blocks) {
-        encryptedBlocks.push_back(des.encryptBlock(block));
+/*
+ * The three key schedules of 3DES. Two-key 3DES (K1 = K3) copies the first schedule instead of
+ * deriving it again.
+ */
+struct TripleDESKeys {
+    DES des1;
+    DES des2;
+    DES des3;
+
+    TripleDESKeys(const uint8_t* key1, const uint8_t* key2, const uint8_t* key3)
+        : des1(loadDESBlock(key1)),
+          des2(loadDESBlock(key2)),
+          des3(memcmp(key1, key3, DES_BLOCK_BYTES) == 0 ? des1 : DES(loadDESBlock(key3))) {}
+};
+
+// Triple DES counterpart of BulkDES
+struct BulkTripleDES {
+    TripleDES tdes;
+    DESBitsliced bitsliced1;
+    DESBitsliced bitsliced2;
+    DESBitsliced bitsliced3;
+
+    explicit BulkTripleDES(const TripleDESKeys& keys)
+        : tdes(keys.des1, keys.des2, keys.des3),
+          bitsliced1(keys.des1),
+          bitsliced2(keys.des2),
+          bitsliced3(keys.des3) {}
+
+    uint64_t encryptBlock(uint64_t block) const { return tdes.encryptBlock(block); }
+    uint64_t decryptBlock(uint64_t block) const { return tdes.decryptBlock(block); }
+    void encryptGroups(uint64_t* blocks, size_t numBlocks) const {
+        DESBitsliced::encryptBlocksEDE(bitsliced1, bitsliced2, bitsliced3, blocks, numBlocks);
+    }
+    void decryptGroups(uint64_t* blocks, size_t numBlocks) const {
+        DESBitsliced::decryptBlocksEDE(bitsliced1, bitsliced2, bitsliced3, blocks, numBlocks);
     }
+};
 
-    return blocksToHexString(encryptedBlocks);
+/*
+ * Encrypts or decrypts loaded blocks: the whole groups of DES_BITSLICED_BLOCKS together, the
+ * remainder one at a time.
+ */
+template <typename Cipher>
+static void processBlocks(const Cipher& cipher, uint64_t* blocks, size_t numBlocks, bool decrypt) {
+    size_t grouped = numBlocks - numBlocks % DES_BITSLICED_BLOCKS;
+    if (grouped > 0) {
+        if (decrypt) {
+            cipher.decryptGroups(blocks, grouped);
+        } else {
+            cipher.encryptGroups(blocks, grouped);
+        }
+    }
+    for (size_t i = grouped; i < numBlocks; i++) {
+        blocks[i] = decrypt ? cipher.decryptBlock(blocks[i]) : cipher.encryptBlock(blocks[i]);
+    }
 }
 
-std::string decryptDESECB(const std::string& ciphertext, const std::string& key) {
-    validateKey(key);
-    DES des(key);
+/*
+ * Encrypts or decrypts ECB blocks in place, DES_BULK_BLOCKS at a time.
+ */
+template <typename Cipher>
+static void processECB(const Cipher& cipher, uint8_t* data, size_t numBlocks, bool decrypt) {
+    uint64_t blocks[DES_BULK_BLOCKS];
+
+    for (size_t i = 0; i < numBlocks; i += DES_BULK_BLOCKS) {
+        size_t batch = numBlocks - i < DES_BULK_BLOCKS ? numBlocks - i : DES_BULK_BLOCKS;
+        uint8_t* batchData = data + i * DES_BLOCK_BYTES;
+
+        for (size_t j = 0; j < batch; j++) {
+            blocks[j] = loadDESBlock(batchData + j * DES_BLOCK_BYTES);
+        }
+        processBlocks(cipher, blocks, batch, decrypt);
+        for (size_t j = 0; j < batch; j++) {
+            storeDESBlock(blocks[j], batchData + j * DES_BLOCK_BYTES);
+        }
+    }
+}
+
+/*
+ * Encrypts CBC blocks in place. Each block depends on the previous ciphertext block, so this is
+ * serial and uses the single block cipher.
+ */
+template <typename Cipher>
+static void encryptCBCBlocks(const Cipher& cipher, uint8_t* data, size_t numBlocks, uint64_t iv) {
+    uint64_t chain = iv;
+    for (size_t i = 0; i < numBlocks; i++) {
+        chain = cipher.encryptBlock(loadDESBlock(data + i * DES_BLOCK_BYTES) ^ chain);
+        storeDESBlock(chain, data + i * DES_BLOCK_BYTES);
+    }
+}
 
-    std::vector<uint64_t> blocks = hexStringToBlocks(ciphertext);
+/*
+ * Decrypts a range of CBC blocks in place, starting from the given chaining value.
+ *
+ * Each plaintext block is D(C[i]) ^ C[i - 1], so the block decryptions do not depend on each other.
+ * They are issued DES_BULK_BLOCKS at a time from a saved copy of the ciphertext, which lets whole
+ * groups go through the bitsliced engine, and the chaining XOR is applied afterwards.
+ */
+template <typename Cipher>
+static void decryptCBCRange(const Cipher& cipher, uint8_t* data, size_t numBlocks, uint64_t chain) {
+    uint64_t ciphertext[DES_BULK_BLOCKS];
+    uint64_t blocks[DES_BULK_BLOCKS];
+
+    for (size_t i = 0; i < numBlocks; i += DES_BULK_BLOCKS) {
+        size_t batch = numBlocks - i < DES_BULK_BLOCKS ? numBlocks - i : DES_BULK_BLOCKS;
+        uint8_t* batchData = data + i * DES_BLOCK_BYTES;
+
+        for (size_t j = 0; j < batch; j++) {
+            ciphertext[j] = loadDESBlock(batchData + j * DES_BLOCK_BYTES);
+            blocks[j] = ciphertext[j];
+        }
+        processBlocks(cipher, blocks, batch, true);
+
+        storeDESBlock(blocks[0] ^ chain, batchData);
+        for (size_t j = 1; j < batch; j++) {
+            storeDESBlock(blocks[j] ^ ciphertext[j - 1], batchData + j * DES_BLOCK_BYTES);
+        }
+        chain = ciphertext[batch - 1];
+    }
+}
 
-    std::vector<uint64_t> decryptedBlocks;
-    for (uint64_t block : blocks) {
-        decryptedBlocks.push_back(des.decryptBlock(block));
+/*
+ * Decrypts CBC blocks in place. Large inputs are split into ranges that are decrypted on separate
+ * threads, each seeded with the ciphertext block just before its range.
+ */
+template <typename Cipher>
+static void decryptCBCBlocks(const Cipher& cipher, uint8_t* data, size_t numBlocks, uint64_t iv) {
+    std::vector<BlockRange> ranges = splitBlockRange(numBlocks, DES_BLOCK_BYTES);
+
+    // Seeds are captured before any range overwrites its ciphertext
+    std::vector<uint64_t> seeds(ranges.size());
+    seeds[0] = iv;
+    for (size_t i = 1; i < ranges.size(); i++) {
+        seeds[i] = loadDESBlock(data + (ranges[i].first - 1) * DES_BLOCK_BYTES);
     }
 
-    std::string decryptedString = blocksToString(decryptedBlocks);
+    parallelFor(ranges.size(), [&](size_t i) {
+        decryptCBCRange(cipher, data + ranges[i].first * DES_BLOCK_BYTES, ranges[i].count, seeds[i]);
+    });
+}
+
+static void validateCiphertextLength(size_t ciphertextLen) {
+    if (ciphertextLen % DES_BLOCK_BYTES != 0) {
+        throw std::invalid_argument("Invalid ciphertext length. Expected a multiple of the DES block size.");
+    }
+}
+
+/*
+ * Moves a ciphertext into the output buffer, where it is decrypted in place.
+ */
+static void prepareDecryption(const uint8_t* ciphertext, size_t ciphertextLen, uint8_t* out) {
+    validateCiphertextLength(ciphertextLen);
+    if (out != ciphertext) {
+        memmove(out, ciphertext, ciphertextLen);
+    }
+}
+
+static const uint8_t* bytes(const std::string& str) {
+    return reinterpret_cast<const uint8_t*>(str.data());
+}
+
+/*
+ * Encrypts a binary message with DES_ECB into a caller-provided buffer.
+ *
+ * @param msg The message bytes.
+ * @param msgLen The length of the message in bytes.
+ * @param key The 8 byte key.
+ * @param out Output buffer of at least desPaddedLength(msgLen) bytes, may alias msg.
+ * @result The number of ciphertext bytes written.
+ */
+size_t encryptDESECB(const uint8_t* msg, size_t msgLen, const uint8_t key[8], uint8_t* out) {
+    BulkDES cipher((DES(loadDESBlock(key))));
+
+    size_t paddedLen = padPKCS5(msg, msgLen, out);
+    processECB(cipher, out, paddedLen / DES_BLOCK_BYTES, false);
+    return paddedLen;
+}
+
+/*
+ * Decrypts a binary DES_ECB ciphertext into a caller-provided buffer.
+ *
+ * @param ciphertext The ciphertext bytes.
+ * @param ciphertextLen The length of the ciphertext in bytes.
+ * @param key The 8 byte key.
+ * @param out Output buffer of at least ciphertextLen bytes, may alias ciphertext.
+ * @result The number of plaintext bytes after the padding is removed.
+ * @throws std::invalid_argument if the ciphertext length is not a multiple of 8.
+ * @throws std::runtime_error if the padding is invalid.
+ */
+size_t decryptDESECB(const uint8_t* ciphertext, size_t ciphertextLen, const uint8_t key[8], uint8_t* out) {
+    prepareDecryption(ciphertext, ciphertextLen, out);
+    BulkDES cipher((DES(loadDESBlock(key))));
+
+    processECB(cipher, out, ciphertextLen / DES_BLOCK_BYTES, true);
+    return unpadPKCS5(out, ciphertextLen);
+}
+
+/*
+ * Encrypts a binary message with 3DES_ECB (EDE) into a caller-provided buffer.
+ *
+ * @param msg The message bytes.
+ * @param msgLen The length of the message in bytes.
+ * @param key1, key2, key3 The 8 byte keys; key3 may equal key1 for two-key 3DES.
+ * @param out Output buffer of at least desPaddedLength(msgLen) bytes, may alias msg.
+ * @result The number of ciphertext bytes written.
+ * @throws std::invalid_argument if the keys are not a valid 3DES keying option.
+ */
+size_t encrypt3DESECB(
+    const uint8_t* msg, size_t msgLen, const uint8_t key1[8], const uint8_t key2[8], const uint8_t key3[8],
+    uint8_t* out
+) {
+    validateKeys(key1, key2, key3);
+    BulkTripleDES cipher(TripleDESKeys(key1, key2, key3));
+
+    size_t paddedLen = padPKCS5(msg, msgLen, out);
+    processECB(cipher, out, paddedLen / DES_BLOCK_BYTES, false);
+    return paddedLen;
+}
+
+/*
+ * Decrypts a binary 3DES_ECB (EDE) ciphertext into a caller-provided buffer.
+ *
+ * @param ciphertext The ciphertext bytes.
+ * @param ciphertextLen The length of the ciphertext in bytes.
+ * @param key1, key2, key3 The 8 byte keys; key3 may equal key1 for two-key 3DES.
+ * @param out Output buffer of at least ciphertextLen bytes, may alias ciphertext.
+ * @result The number of plaintext bytes after the padding is removed.
+ * @throws std::invalid_argument if the keys or the ciphertext length are invalid.
+ * @throws std::runtime_error if the padding is invalid.
+ */
+size_t decrypt3DESECB(
+    const uint8_t* ciphertext, size_t ciphertextLen, const uint8_t key1[8], const uint8_t key2[8],
+    const uint8_t key3[8], uint8_t* out
+) {
+    validateKeys(key1, key2, key3);
+    prepareDecryption(ciphertext, ciphertextLen, out);
+    BulkTripleDES cipher(TripleDESKeys(key1, key2, key3));
+
+    processECB(cipher, out, ciphertextLen / DES_BLOCK_BYTES, true);
+    return unpadPKCS5(out, ciphertextLen);
+}
+
+/*
+ * Encrypts a binary message with DES_CBC into a caller-provided buffer.
+ *
+ * @param msg The message bytes.
+ * @param msgLen The length of the message in bytes.
+ * @param iv The 8 byte initialization vector.
+ * @param key The 8 byte key.
+ * @param out Output buffer of at least desPaddedLength(msgLen) bytes, may alias msg.
+ * @result The number of ciphertext bytes written.
+ */
+size_t encryptDESCBC(const uint8_t* msg, size_t msgLen, const uint8_t iv[8], const uint8_t key[8], uint8_t* out) {
+    DES cipher(loadDESBlock(key));
 
-    return removePKCS5Padding(decryptedString);
+    size_t paddedLen = padPKCS5(msg, msgLen, out);
+    encryptCBCBlocks(cipher, out, paddedLen / DES_BLOCK_BYTES, loadDESBlock(iv));
+    return paddedLen;
+}
+
+/*
+ * Decrypts a binary DES_CBC ciphertext into a caller-provided buffer.
+ *
+ * @param ciphertext The ciphertext bytes.
+ * @param ciphertextLen The length of the ciphertext in bytes.
+ * @param iv The 8 byte initialization vector.
+ * @param key The 8 byte key.
+ * @param out Output buffer of at least ciphertextLen bytes, may alias ciphertext.
+ * @result The number of plaintext bytes after the padding is removed.
+ * @throws std::invalid_argument if the ciphertext length is not a multiple of 8.
+ * @throws std::runtime_error if the padding is invalid.
+ */
+size_t decryptDESCBC(
+    const uint8_t* ciphertext, size_t ciphertextLen, const uint8_t iv[8], const uint8_t key[8], uint8_t* out
+) {
+    uint64_t chain = loadDESBlock(iv);
+    prepareDecryption(ciphertext, ciphertextLen, out);
+    BulkDES cipher((DES(loadDESBlock(key))));
+
+    decryptCBCBlocks(cipher, out, ciphertextLen / DES_BLOCK_BYTES, chain);
+    return unpadPKCS5(out, ciphertextLen);
+}
+
+/*
+ * Encrypts a binary message with 3DES_CBC (EDE) into a caller-provided buffer.
+ *
+ * @param msg The message bytes.
+ * @param msgLen The length of the message in bytes.
+ * @param iv The 8 byte initialization vector.
+ * @param key1, key2, key3 The 8 byte keys; key3 may equal key1 for two-key 3DES.
+ * @param out Output buffer of at least desPaddedLength(msgLen) bytes, may alias msg.
+ * @result The number of ciphertext bytes written.
+ * @throws std::invalid_argument if the keys are not a valid 3DES keying option.
+ */
+size_t encrypt3DESCBC(
+    const uint8_t* msg, size_t msgLen, const uint8_t iv[8], const uint8_t key1[8], const uint8_t key2[8],
+    const uint8_t key3[8], uint8_t* out
+) {
+    validateKeys(key1, key2, key3);
+    TripleDESKeys keys(key1, key2, key3);
+    TripleDES cipher(keys.des1, keys.des2, keys.des3);
+
+    size_t paddedLen = padPKCS5(msg, msgLen, out);
+    encryptCBCBlocks(cipher, out, paddedLen / DES_BLOCK_BYTES, loadDESBlock(iv));
+    return paddedLen;
+}
+
+/*
+ * Decrypts a binary 3DES_CBC (EDE) ciphertext into a caller-provided buffer.
+ *
+ * @param ciphertext The ciphertext bytes.
+ * @param ciphertextLen The length of the ciphertext in bytes.
+ * @param iv The 8 byte initialization vector.
+ * @param key1, key2, key3 The 8 byte keys; key3 may equal key1 for two-key 3DES.
+ * @param out Output buffer of at least ciphertextLen bytes, may alias ciphertext.
+ * @result The number of plaintext bytes after the padding is removed.
+ * @throws std::invalid_argument if the keys or the ciphertext length are invalid.
+ * @throws std::runtime_error if the padding is invalid.
+ */
+size_t decrypt3DESCBC(
+    const uint8_t* ciphertext, size_t ciphertextLen, const uint8_t iv[8], const uint8_t key1[8],
+    const uint8_t key2[8], const uint8_t key3[8], uint8_t* out
+) {
+    validateKeys(key1, key2, key3);
+    uint64_t chain = loadDESBlock(iv);
+    prepareDecryption(ciphertext, ciphertextLen, out);
+    BulkTripleDES cipher(TripleDESKeys(key1, key2, key3));
+
+    decryptCBCBlocks(cipher, out, ciphertextLen / DES_BLOCK_BYTES, chain);
+    return unpadPKCS5(out, ciphertextLen);
+}
+
+static void validateKey(const std::vector<uint8_t>& key) {
+    if (key.size() != DES_BLOCK_BYTES) {
+        throw std::invalid_argument("DES key must be 8 bytes.");
+    }
+}
+
+static void validateKeys(
+    const std::vector<uint8_t>& key1, const std::vector<uint8_t>& key2, const std::vector<uint8_t>& key3
+) {
+    if (key1.size() != DES_BLOCK_BYTES || key2.size() != DES_BLOCK_BYTES || key3.size() != DES_BLOCK_BYTES) {
+        throw std::invalid_argument("Each DES key must be 8 bytes.");
+    }
+}
+
+static void validateIV(const std::vector<uint8_t>& iv) {
+    if (iv.size() != DES_BLOCK_BYTES) {
+        throw std::invalid_argument("Invalid IV size. Expected 64 bits.");
+    }
+}
+
+std::vector<uint8_t> encryptDESECB(const std::vector<uint8_t>& msg, const std::vector<uint8_t>& key) {
+    validateKey(key);
+    std::vector<uint8_t> output(desPaddedLength(msg.size()));
+    encryptDESECB(msg.data(), msg.size(), key.data(), output.data());
+    return output;
+}
+
+std::vector<uint8_t> decryptDESECB(const std::vector<uint8_t>& ciphertext, const std::vector<uint8_t>& key) {
+    validateKey(key);
+    std::vector<uint8_t> output(ciphertext.size());
+    output.resize(decryptDESECB(ciphertext.data(), ciphertext.size(), key.data(), output.data()));
+    return output;
+}
+
+std::vector<uint8_t> encrypt3DESECB(
+    const std::vector<uint8_t>& msg,
+    const std::vector<uint8_t>& key1,
+    const std::vector<uint8_t>& key2,
+    const std::vector<uint8_t>& key3
+) {
+    validateKeys(key1, key2, key3);
+    std::vector<uint8_t> output(desPaddedLength(msg.size()));
+    encrypt3DESECB(msg.data(), msg.size(), key1.data(), key2.data(), key3.data(), output.data());
+    return output;
+}
+
+std::vector<uint8_t> decrypt3DESECB(
+    const std::vector<uint8_t>& ciphertext,
+    const std::vector<uint8_t>& key1,
+    const std::vector<uint8_t>& key2,
+    const std::vector<uint8_t>& key3
+) {
+    validateKeys(key1, key2, key3);
+    std::vector<uint8_t> output(ciphertext.size());
+    output.resize(decrypt3DESECB(
+        ciphertext.data(), ciphertext.size(), key1.data(), key2.data(), key3.data(), output.data()
+    ));
+    return output;
+}
+
+std::vector<uint8_t> encryptDESCBC(
+    const std::vector<uint8_t>& msg, const std::vector<uint8_t>& iv, const std::vector<uint8_t>& key
+) {
+    validateIV(iv);
+    validateKey(key);
+    std::vector<uint8_t> output(desPaddedLength(msg.size()));
+    encryptDESCBC(msg.data(), msg.size(), iv.data(), key.data(), output.data());
+    return output;
+}
+
+std::vector<uint8_t> decryptDESCBC(
+    const std::vector<uint8_t>& ciphertext, const std::vector<uint8_t>& iv, const std::vector<uint8_t>& key
+) {
+    validateIV(iv);
+    validateKey(key);
+    std::vector<uint8_t> output(ciphertext.size());
+    output.resize(decryptDESCBC(ciphertext.data(), ciphertext.size(), iv.data(), key.data(), output.data()));
+    return output;
+}
+
+std::vector<uint8_t> encrypt3DESCBC(
+    const std::vector<uint8_t>& msg,
+    const std::vector<uint8_t>& iv,
+    const std::vector<uint8_t>& key1,
+    const std::vector<uint8_t>& key2,
+    const std::vector<uint8_t>& key3
+) {
+    validateIV(iv);
+    validateKeys(key1, key2, key3);
+    std::vector<uint8_t> output(desPaddedLength(msg.size()));
+    encrypt3DESCBC(msg.data(), msg.size(), iv.data(), key1.data(), key2.data(), key3.data(), output.data());
+    return output;
+}
+
+std::vector<uint8_t> decrypt3DESCBC(
+    const std::vector<uint8_t>& ciphertext,
+    const std::vector<uint8_t>& iv,
+    const std::vector<uint8_t>& key1,
+    const std::vector<uint8_t>& key2,
+    const std::vector<uint8_t>& key3
+) {
+    validateIV(iv);
+    validateKeys(key1, key2, key3);
+    std::vector<uint8_t> output(ciphertext.size());
+    output.resize(decrypt3DESCBC(
+        ciphertext.data(), ciphertext.size(), iv.data(), key1.data(), key2.data(), key3.data(), output.data()
+    ));
+    return output;
+}
+
+std::string encryptDESECB(const std::string& plaintext, const std::string& key) {
+    validateKey(key);
+    std::string keyBytes = fromHex(key);
+
+    std::vector<uint8_t> output(desPaddedLength(plaintext.size()));
+    size_t outputLen = encryptDESECB(bytes(plaintext), plaintext.size(), bytes(keyBytes), output.data());
+
+    return toHex(output.data(), outputLen);
+}
+
+std::string decryptDESECB(const std::string& ciphertext, const std::string& key) {
+    validateKey(key);
+    std::string keyBytes = fromHex(key);
+
+    std::string msg = fromHex(ciphertext);
+    uint8_t* data = reinterpret_cast<uint8_t*>(&msg[0]);
+    msg.resize(decryptDESECB(data, msg.size(), bytes(keyBytes), data));
+
+    return msg;
 }
 
 std::string encrypt3DESECB(
@@ -53,22 +508,16 @@ std::string encrypt3DESECB(
     const std::string& key3
 ) {
     validateKeys(key1, key2, key3);
-    DES des1(key1);
-    DES des2(key2);
-    DES des3(key3);
-
-    std::string paddedPlaintext = applyPCKS5Padding(plaintext);
-    std::vector<uint64_t> blocks = stringToBlocks(paddedPlaintext);
-
-    std::vector<uint64_t> encryptedBlocks;
-    for (uint64_t block : blocks) {
-        uint64_t encryptedBlock = des1.encryptBlock(block);
-        encryptedBlock = des2.decryptBlock(encryptedBlock);
-        encryptedBlock = des3.encryptBlock(encryptedBlock);
-        encryptedBlocks.push_back(encryptedBlock);
-    }
+    std::string keyBytes1 = fromHex(key1);
+    std::string keyBytes2 = fromHex(key2);
+    std::string keyBytes3 = fromHex(key3);
 
-    return blocksToHexString(encryptedBlocks);
+    std::vector<uint8_t> output(desPaddedLength(plaintext.size()));
+    size_t outputLen = encrypt3DESECB(
+        bytes(plaintext), plaintext.size(), bytes(keyBytes1), bytes(keyBytes2), bytes(keyBytes3), output.data()
+    );
+
+    return toHex(output.data(), outputLen);
 }
 
 std::string decrypt3DESECB(
@@ -78,65 +527,40 @@ std::string decrypt3DESECB(
     const std::string& key3
 ) {
     validateKeys(key1, key2, key3);
-    DES des1(key1);
-    DES des2(key2);
-    DES des3(key3);
-
-    std::vector<uint64_t> blocks = hexStringToBlocks(ciphertext);
-
-    std::vector<uint64_t> decryptedBlocks;
-    for (uint64_t block : blocks) {
-        uint64_t decryptedBlock = des3.decryptBlock(block);
-        decryptedBlock = des2.encryptBlock(decryptedBlock);
-        decryptedBlock = des1.decryptBlock(decryptedBlock);
-        decryptedBlocks.push_back(decryptedBlock);
-    }
+    std::string keyBytes1 = fromHex(key1);
+    std::string keyBytes2 = fromHex(key2);
+    std::string keyBytes3 = fromHex(key3);
 
-    std::string decryptedString = blocksToString(decryptedBlocks);
+    std::string msg = fromHex(ciphertext);
+    uint8_t* data = reinterpret_cast<uint8_t*>(&msg[0]);
+    msg.resize(decrypt3DESECB(data, msg.size(), bytes(keyBytes1), bytes(keyBytes2), bytes(keyBytes3), data));
 
-    return removePKCS5Padding(decryptedString);
+    return msg;
 }
 
 std::string encryptDESCBC(const std::string& plaintext, const std::string& iv, const std::string& key) {
     validateKey(key);
-    DES des(key);
+    std::string keyBytes = fromHex(key);
+    uint8_t ivBytes[DES_BLOCK_BYTES];
+    storeDESBlock(hexStringToUint64(iv), ivBytes);
 
-    std::string paddedPlaintext = applyPCKS5Padding(plaintext);
-    std::vector<uint64_t> blocks = stringToBlocks(paddedPlaintext);
+    std::vector<uint8_t> output(desPaddedLength(plaintext.size()));
+    size_t outputLen = encryptDESCBC(bytes(plaintext), plaintext.size(), ivBytes, bytes(keyBytes), output.data());
 
-    uint64_t ivVec = hexStringToUint64(iv);
-
-    std::vector<uint64_t> encryptedBlocks;
-    uint64_t currentIV = ivVec;
-    for (uint64_t block : blocks) {
-        block ^= currentIV;
-        uint64_t encryptedBlock = des.encryptBlock(block);
-        encryptedBlocks.push_back(encryptedBlock);
-        currentIV = encryptedBlock;
-    }
-
-    return blocksToHexString(encryptedBlocks);
+    return toHex(output.data(), outputLen);
 }
 
 std::string decryptDESCBC(const std::string& ciphertext, const std::string& iv, const std::string& key) {
     validateKey(key);
-    DES des(key);
-
-    std::vector<uint64_t> blocks = hexStringToBlocks(ciphertext);
-    uint64_t ivVec = hexStringToUint64(iv);
-
-    std::vector<uint64_t> decryptedBlocks;
-    uint64_t currentIV = ivVec;
-    for (uint64_t block : blocks) {
-        uint64_t decryptedBlock = des.decryptBlock(block);
-        decryptedBlock ^= currentIV;
-        decryptedBlocks.push_back(decryptedBlock);
-        currentIV = block; // Update IV to the current ciphertext block
-    }
+    std::string keyBytes = fromHex(key);
+    uint8_t ivBytes[DES_BLOCK_BYTES];
+    storeDESBlock(hexStringToUint64(iv), ivBytes);
 
-    std::string decryptedString = blocksToString(decryptedBlocks);
+    std::string msg = fromHex(ciphertext);
+    uint8_t* data = reinterpret_cast<uint8_t*>(&msg[0]);
+    msg.resize(decryptDESCBC(data, msg.size(), ivBytes, bytes(keyBytes), data));
 
-    return removePKCS5Padding(decryptedString);
+    return msg;
 }
 
 std::string encrypt3DESCBC(
@@ -147,29 +571,19 @@ std::string encrypt3DESCBC(
     const std::string& key3
 ) {
     validateKeys(key1, key2, key3);
-    DES des1(key1);
-    DES des2(key2);
-    DES des3(key3);
-
-    std::string paddedPlaintext = applyPCKS5Padding(plaintext);
-    std::vector<uint64_t> blocks = stringToBlocks(paddedPlaintext);
-
-    uint64_t ivVec = hexStringToUint64(iv);
-
-    std::vector<uint64_t> encryptedBlocks;
-    uint64_t currentIV = ivVec;
-    for (uint64_t block : blocks) {
-        block ^= currentIV;
-
-        uint64_t encryptedBlock = des1.encryptBlock(block);
-        encryptedBlock = des2.decryptBlock(encryptedBlock);
-        encryptedBlock = des3.encryptBlock(encryptedBlock);
-        encryptedBlocks.push_back(encryptedBlock);
-
-        currentIV = encryptedBlock;
-    }
-
-    return blocksToHexString(encryptedBlocks);
+    std::string keyBytes1 = fromHex(key1);
+    std::string keyBytes2 = fromHex(key2);
+    std::string keyBytes3 = fromHex(key3);
+    uint8_t ivBytes[DES_BLOCK_BYTES];
+    storeDESBlock(hexStringToUint64(iv), ivBytes);
+
+    std::vector<uint8_t> output(desPaddedLength(plaintext.size()));
+    size_t outputLen = encrypt3DESCBC(
+        bytes(plaintext), plaintext.size(), ivBytes, bytes(keyBytes1), bytes(keyBytes2), bytes(keyBytes3),
+        output.data()
+    );
+
+    return toHex(output.data(), outputLen);
 }
 
 std::string decrypt3DESCBC(
@@ -180,26 +594,17 @@ std::string decrypt3DESCBC(
     const std::string& key3
 ) {
     validateKeys(key1, key2, key3);
-    DES des1(key1);
-    DES des2(key2);
-    DES des3(key3);
-
-    std::vector<uint64_t> blocks = hexStringToBlocks(ciphertext);
-    uint64_t ivVec = hexStringToUint64(iv);
-
-    std::vector<uint64_t> decryptedBlocks;
-    uint64_t currentIV = ivVec;
-    for (uint64_t block : blocks) {
-        uint64_t decryptedBlock = des3.decryptBlock(block);
-        decryptedBlock = des2.encryptBlock(decryptedBlock);
-        decryptedBlock = des1.decryptBlock(decryptedBlock);
-
-        decryptedBlock ^= currentIV;
-        decryptedBlocks.push_back(decryptedBlock);
-        currentIV = block; // Update IV to the current ciphertext block
-    }
-
-    std::string decryptedString = blocksToString(decryptedBlocks);
-
-    return removePKCS5Padding(decryptedString);
-}
\ No newline at end of file
+    std::string keyBytes1 = fromHex(key1);
+    std::string keyBytes2 = fromHex(key2);
+    std::string keyBytes3 = fromHex(key3);
+    uint8_t ivBytes[DES_BLOCK_BYTES];
+    storeDESBlock(hexStringToUint64(iv), ivBytes);
+
+    std::string msg = fromHex(ciphertext);
+    uint8_t* data = reinterpret_cast<uint8_t*>(&msg[0]);
+    msg.resize(decrypt3DESCBC(
+        data, msg.size(), ivBytes, bytes(keyBytes1), bytes(keyBytes2), bytes(keyBytes3), data
+    ));
+
+    return msg;
+}
@@ -0,0 +1,137 @@
+/*
+ * Copyright 2023-2024 The Gestalt Project Authors. All Rights Reserved.
+ *
+ * Licensed under the MIT License. See the file LICENSE for the full text.
+ */
+
+/*
+ * desBitsliced.cpp
+ *
+ * This file contains the DESBitsliced class and the 64-bit word instantiation of the bitsliced engine
+ * in desBitsliced.h. Groups of DES_BITSLICED_AVX2_BLOCKS blocks go to the AVX2 instantiation when
+ * the executing CPU supports it.
+ */
+
+#include <cstring>
+
+#include "desCore.h"
+#include "desBitsliced.h"
+
+/*
+ * Encrypts or decrypts DES_BITSLICED_BLOCKS blocks in place with 64-bit words.
+ *
+ * @param blocks The blocks.
+ * @param roundKeys The key masks of each round, in the order of use.
+ * @param numRounds The number of rounds, a multiple of 16.
+ */
+void desBitslicedRounds(uint64_t* blocks, const uint64_t* const* roundKeys, size_t numRounds) {
+    uint64_t slices[DES_BITSLICED_BLOCKS];
+    uint64_t state[IP_SIZE];
+
+    memcpy(slices, blocks, sizeof(slices));
+    transpose64(slices);
+    for (int i = 0; i < IP_SIZE; i++) {
+        state[i] = slices[IP[i] - 1];
+    }
+
+    runRoundsBitsliced(state, roundKeys, numRounds, [](uint64_t mask) { return mask; });
+
+    // FP is the inverse of IP
+    for (int i = 0; i < IP_SIZE; i++) {
+        slices[IP[i] - 1] = state[i];
+    }
+    transpose64(slices);
+    memcpy(blocks, slices, sizeof(slices));
+}
+
+/*
+ * Copies the round keys of a DES instance as masks, bit 1 of each round key first.
+ */
+DESBitsliced::DESBitsliced(const DES& des) {
+    for (size_t round = 0; round < DES_NUM_OF_ROUNDS; round++) {
+        for (size_t bit = 0; bit < DES_KEY_SIZE; bit++) {
+            keyMasks[round][bit] = 0 - ((des.roundKeys[round] >> (DES_KEY_SIZE - 1 - bit)) & 0x01);
+        }
+    }
+}
+
+/*
+ * Runs every group of blocks through the rounds, the widest groups the CPU supports first. A final
+ * partial group is padded with zero blocks.
+ */
+void DESBitsliced::runRounds(uint64_t* blocks, size_t numBlocks, const uint64_t* const* roundKeys, size_t numRounds) {
+    size_t i = 0;
+    if (desBitslicedAVX2Supported()) {
+        for (; numBlocks - i >= DES_BITSLICED_AVX2_BLOCKS; i += DES_BITSLICED_AVX2_BLOCKS) {
+            desBitslicedRoundsAVX2(blocks + i, roundKeys, numRounds);
+        }
+    }
+    for (; numBlocks - i >= DES_BITSLICED_BLOCKS; i += DES_BITSLICED_BLOCKS) {
+        desBitslicedRounds(blocks + i, roundKeys, numRounds);
+    }
+
+    if (i < numBlocks) {
+        uint64_t group[DES_BITSLICED_BLOCKS] = {};
+        memcpy(group, blocks + i, (numBlocks - i) * sizeof(uint64_t));
+        desBitslicedRounds(group, roundKeys, numRounds);
+        memcpy(blocks + i, group, (numBlocks - i) * sizeof(uint64_t));
+    }
+}
+
+/*
+ * Encrypts blocks in place.
+ *
+ * @param blocks The blocks.
+ * @param numBlocks The number of blocks.
+ */
+void DESBitsliced::encryptBlocks(uint64_t* blocks, size_t numBlocks) const {
+    const uint64_t* roundKeys[DES_NUM_OF_ROUNDS];
+    for (size_t round = 0; round < DES_NUM_OF_ROUNDS; round++) {
+        roundKeys[round] = keyMasks[round];
+    }
+    runRounds(blocks, numBlocks, roundKeys, DES_NUM_OF_ROUNDS);
+}
+
+/*
+ * Decrypts blocks in place.
+ *
+ * @param blocks The blocks.
+ * @param numBlocks The number of blocks.
+ */
+void DESBitsliced::decryptBlocks(uint64_t* blocks, size_t numBlocks) const {
+    const uint64_t* roundKeys[DES_NUM_OF_ROUNDS];
+    for (size_t round = 0; round < DES_NUM_OF_ROUNDS; round++) {
+        roundKeys[round] = keyMasks[DES_NUM_OF_ROUNDS - 1 - round];
+    }
+    runRounds(blocks, numBlocks, roundKeys, DES_NUM_OF_ROUNDS);
+}
+
+/*
+ * Encrypts blocks in place with Triple DES: E(k3, D(k2, E(k1, block))).
+ */
+void DESBitsliced::encryptBlocksEDE(
+    const DESBitsliced& k1, const DESBitsliced& k2, const DESBitsliced& k3, uint64_t* blocks, size_t numBlocks
+) {
+    const uint64_t* roundKeys[3 * DES_NUM_OF_ROUNDS];
+    for (size_t round = 0; round < DES_NUM_OF_ROUNDS; round++) {
+        roundKeys[round] = k1.keyMasks[round];
+        roundKeys[DES_NUM_OF_ROUNDS + round] = k2.keyMasks[DES_NUM_OF_ROUNDS - 1 - round];
+        roundKeys[2 * DES_NUM_OF_ROUNDS + round] = k3.keyMasks[round];
+    }
+    runRounds(blocks, numBlocks, roundKeys, 3 * DES_NUM_OF_ROUNDS);
+}
+
+/*
+ * Decrypts blocks in place with Triple DES: D(k1, E(k2, D(k3, block))).
+ */
+void DESBitsliced::decryptBlocksEDE(
+    const DESBitsliced& k1, const DESBitsliced& k2, const DESBitsliced& k3, uint64_t* blocks, size_t numBlocks
+) {
+    const uint64_t* roundKeys[3 * DES_NUM_OF_ROUNDS];
+    for (size_t round = 0; round < DES_NUM_OF_ROUNDS; round++) {
+        roundKeys[round] = k3.keyMasks[DES_NUM_OF_ROUNDS - 1 - round];
+        roundKeys[DES_NUM_OF_ROUNDS + round] = k2.keyMasks[round];
+        roundKeys[2 * DES_NUM_OF_ROUNDS + round] = k1.keyMasks[DES_NUM_OF_ROUNDS - 1 - round];
+    }
+    runRounds(blocks, numBlocks, roundKeys, 3 * DES_NUM_OF_ROUNDS);
+}
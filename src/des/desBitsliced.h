@@ -0,0 +1,921 @@
+/*
+ * Copyright 2023-2024 The Gestalt Project Authors. All Rights Reserved.
+ *
+ * Licensed under the MIT License. See the file LICENSE for the full text.
+ */
+
+/*
+ * desBitsliced.h
+ *
+ * This file contains the word-size independent parts of the bitsliced DES engine: the S-box circuits,
+ * the bit matrix transpose and the round loop. It is included by the translation units that instantiate
+ * the engine for 64-bit words and for 256-bit AVX2 vectors.
+ *
+ * References:
+ * - "A fast new DES implementation in software" by Eli Biham
+ * - "Hacker's Delight" by Henry S. Warren, section 7-3 "Transposing a Bit Matrix"
+ *
+ * A group of blocks is transposed so that word k holds bit k (counting from the most significant) of
+ * every block. In that form the bit permutations of DES cost nothing: IP, E, P and FP only decide which
+ * word is read or written, and the round key bits become words of all zeros or all ones. What remains is
+ * the S-boxes, evaluated as boolean circuits on whole words, so a pass computes 64 blocks per bit of
+ * word width, with no table lookups and no data dependent branches.
+ *
+ * The S-box circuits were derived from the SBOX tables by Shannon decomposition, reusing every
+ * intermediate function already computed for the S-box, and checked against all 64 inputs. Input a0 is
+ * the first (most significant) bit of the 6-bit S-box input and out[0] the first bit of its output.
+ */
+
+#pragma once
+
+#include <cstddef>
+#include <cstdint>
+
+#include "desConstants.h"
+
+const size_t DES_BITSLICED_BLOCKS = 64;        // Blocks per pass with 64-bit words
+const size_t DES_BITSLICED_AVX2_BLOCKS = 256;  // Blocks per pass with 256-bit vectors
+const size_t DES_BITSLICED_CIPHER_ROUNDS = 16;  // Rounds of each chained cipher
+
+// Position in the P output of each S-box output bit, the inverse of P
+const int P_INVERSE[P_SIZE] = { 8, 16, 22, 30, 12, 27, 1, 17, 23, 15, 29, 5, 25, 19, 9, 0,
+                                7, 13, 24, 2, 3, 28, 10, 18, 31, 11, 21, 6, 4, 26, 14, 20 };
+
+void desBitslicedRounds(uint64_t* blocks, const uint64_t* const* roundKeys, size_t numRounds);
+bool desBitslicedAVX2Supported();
+void desBitslicedRoundsAVX2(uint64_t* blocks, const uint64_t* const* roundKeys, size_t numRounds);
+
+/*
+ * Transposes a 64x64 bit matrix in place: afterwards bit 63 - c of word r is what bit 63 - r of word c
+ * was. Applying it twice restores the matrix.
+ */
+static inline void transpose64(uint64_t* a) {
+    uint64_t mask = 0x00000000FFFFFFFFULL;
+    for (int j = 32; j != 0; j >>= 1, mask ^= mask << j) {
+        for (int k = 0; k < 64; k = ((k | j) + 1) & ~j) {
+            uint64_t t = (a[k] ^ (a[k | j] >> j)) & mask;
+            a[k] ^= t;
+            a[k | j] ^= t << j;
+        }
+    }
+}
+
+template <typename Word>
+static inline void sbox1(Word a0, Word a1, Word a2, Word a3, Word a4, Word a5, Word out[4]) {
+    Word t0 = ~a4;
+    Word t1 = t0 | a1;
+    Word t2 = a1 & t0;
+    Word t3 = t1 ^ t2;
+    Word t4 = t3 & a3;
+    Word t5 = t1 ^ t4;
+    Word t6 = a4 ^ t3;
+    Word t7 = a4 & a3;
+    Word t8 = t6 ^ t7;
+    Word t9 = t5 ^ t8;
+    Word t10 = t9 & a2;
+    Word t11 = t5 ^ t10;
+    Word t12 = t1 & a3;
+    Word t13 = t2 ^ t12;
+    Word t14 = a4 ^ t13;
+    Word t15 = a4 & a2;
+    Word t16 = t13 ^ t15;
+    Word t17 = t11 ^ t16;
+    Word t18 = t17 & a0;
+    Word t19 = t11 ^ t18;
+    Word t20 = t7 ^ t14;
+    Word t21 = t1 ^ t20;
+    Word t22 = t1 & a2;
+    Word t23 = t20 ^ t22;
+    Word t24 = a4 ^ t21;
+    Word t25 = a3 ^ t13;
+    Word t26 = t24 ^ t25;
+    Word t27 = t26 & a2;
+    Word t28 = t24 ^ t27;
+    Word t29 = t23 ^ t28;
+    Word t30 = t29 & a0;
+    Word t31 = t23 ^ t30;
+    Word t32 = t19 ^ t31;
+    Word t33 = t32 & a5;
+    Word t34 = t19 ^ t33;
+    Word t35 = t4 ^ t21;
+    Word t36 = t0 ^ t35;
+    Word t37 = t0 & a2;
+    Word t38 = t35 ^ t37;
+    Word t39 = t11 ^ t12;
+    Word t40 = t38 ^ t39;
+    Word t41 = t40 & a0;
+    Word t42 = t38 ^ t41;
+    Word t43 = a4 ^ t12;
+    Word t44 = a3 ^ t24;
+    Word t45 = t43 ^ t44;
+    Word t46 = t45 & a2;
+    Word t47 = t43 ^ t46;
+    Word t48 = t20 ^ t44;
+    Word t49 = a1 ^ t1;
+    Word t50 = a4 ^ t2;
+    Word t51 = t49 ^ t50;
+    Word t52 = t49 ^ a3;
+    Word t53 = t48 ^ t52;
+    Word t54 = t53 & a2;
+    Word t55 = t48 ^ t54;
+    Word t56 = t47 ^ t55;
+    Word t57 = t56 & a0;
+    Word t58 = t47 ^ t57;
+    Word t59 = t42 ^ t58;
+    Word t60 = t59 & a5;
+    Word t61 = t42 ^ t60;
+    Word t62 = t7 ^ t16;
+    Word t63 = t0 ^ t8;
+    Word t64 = t6 & a3;
+    Word t65 = t0 ^ t64;
+    Word t66 = t63 ^ t65;
+    Word t67 = t66 & a2;
+    Word t68 = t63 ^ t67;
+    Word t69 = t62 ^ t68;
+    Word t70 = t69 & a0;
+    Word t71 = t62 ^ t70;
+    Word t72 = t8 & t9;
+    Word t73 = t44 ^ t65;
+    Word t74 = t50 & a2;
+    Word t75 = t72 ^ t74;
+    Word t76 = a2 ^ t5;
+    Word t77 = t75 ^ t76;
+    Word t78 = t77 & a0;
+    Word t79 = t75 ^ t78;
+    Word t80 = t71 ^ t79;
+    Word t81 = t80 & a5;
+    Word t82 = t71 ^ t81;
+    Word t83 = t3 ^ t67;
+    Word t84 = t37 ^ t73;
+    Word t85 = t83 ^ t84;
+    Word t86 = t85 & a0;
+    Word t87 = t83 ^ t86;
+    Word t88 = a3 ^ t65;
+    Word t89 = t63 ^ t88;
+    Word t90 = t89 & a2;
+    Word t91 = t63 ^ t90;
+    Word t92 = t25 ^ t51;
+    Word t93 = t92 ^ t36;
+    Word t94 = t93 & a2;
+    Word t95 = t92 ^ t94;
+    Word t96 = t91 ^ t95;
+    Word t97 = t96 & a0;
+    Word t98 = t91 ^ t97;
+    Word t99 = t87 ^ t98;
+    Word t100 = t99 & a5;
+    Word t101 = t87 ^ t100;
+    out[0] = t101;
+    out[1] = t61;
+    out[2] = t34;
+    out[3] = t82;
+}
+
+template <typename Word>
+static inline void sbox2(Word a0, Word a1, Word a2, Word a3, Word a4, Word a5, Word out[4]) {
+    Word t0 = ~a4;
+    Word t1 = t0 ^ a4;
+    Word t2 = t0 ^ a2;
+    Word t3 = a2 & a1;
+    Word t4 = t2 ^ t3;
+    Word t5 = a2 ^ t1;
+    Word t6 = t2 & a1;
+    Word t7 = t5 ^ t6;
+    Word t8 = t4 ^ t7;
+    Word t9 = t8 & a3;
+    Word t10 = t4 ^ t9;
+    Word t11 = a2 ^ a4;
+    Word t12 = a1 ^ t11;
+    Word t13 = a1 & a3;
+    Word t14 = t11 ^ t13;
+    Word t15 = t10 ^ t14;
+    Word t16 = t15 & a0;
+    Word t17 = t10 ^ t16;
+    Word t18 = t9 ^ t12;
+    Word t19 = a4 | t2;
+    Word t20 = a4 ^ t19;
+    Word t21 = a4 & a1;
+    Word t22 = t19 ^ t21;
+    Word t23 = a1 ^ t20;
+    Word t24 = t22 ^ t9;
+    Word t25 = t18 ^ t24;
+    Word t26 = t25 & a0;
+    Word t27 = t18 ^ t26;
+    Word t28 = t17 ^ t27;
+    Word t29 = t28 & a5;
+    Word t30 = t17 ^ t29;
+    Word t31 = a2 ^ t23;
+    Word t32 = t19 & a3;
+    Word t33 = t31 ^ t32;
+    Word t34 = t12 & ~t4;
+    Word t35 = t3 | t7;
+    Word t36 = t34 ^ t35;
+    Word t37 = t36 & a3;
+    Word t38 = t34 ^ t37;
+    Word t39 = t33 ^ t38;
+    Word t40 = t39 & a0;
+    Word t41 = t33 ^ t40;
+    Word t42 = t3 ^ t25;
+    Word t43 = a4 ^ t3;
+    Word t44 = t42 ^ t43;
+    Word t45 = t44 & a3;
+    Word t46 = t42 ^ t45;
+    Word t47 = a1 ^ a2;
+    Word t48 = t47 ^ t37;
+    Word t49 = t46 ^ t48;
+    Word t50 = t49 & a0;
+    Word t51 = t46 ^ t50;
+    Word t52 = t41 ^ t51;
+    Word t53 = t52 & a5;
+    Word t54 = t41 ^ t53;
+    Word t55 = t36 ^ t43;
+    Word t56 = t55 & a3;
+    Word t57 = t36 ^ t56;
+    Word t58 = t8 & t22;
+    Word t59 = t5 ^ t34;
+    Word t60 = t58 ^ t59;
+    Word t61 = t60 & a3;
+    Word t62 = t58 ^ t61;
+    Word t63 = t57 ^ t62;
+    Word t64 = t63 & a0;
+    Word t65 = t57 ^ t64;
+    Word t66 = t24 ^ t46;
+    Word t68 = t66 ^ a0;
+    Word t69 = t65 ^ t68;
+    Word t70 = t69 & a5;
+    Word t71 = t65 ^ t70;
+    Word t72 = t5 | t22;
+    Word t73 = t11 & t36;
+    Word t74 = t72 ^ t73;
+    Word t75 = t74 & a3;
+    Word t76 = t72 ^ t75;
+    Word t77 = t5 ^ t35;
+    Word t79 = t77 ^ t75;
+    Word t80 = t76 ^ t79;
+    Word t81 = t80 & a0;
+    Word t82 = t76 ^ t81;
+    Word t83 = a4 ^ t31;
+    Word t85 = t0 & a3;
+    Word t86 = t83 ^ t85;
+    Word t87 = t22 ^ t34;
+    Word t89 = t87 ^ t56;
+    Word t90 = t86 ^ t89;
+    Word t91 = t90 & a0;
+    Word t92 = t86 ^ t91;
+    Word t93 = t82 ^ t92;
+    Word t94 = t93 & a5;
+    Word t95 = t82 ^ t94;
+    out[0] = t30;
+    out[1] = t71;
+    out[2] = t54;
+    out[3] = t95;
+}
+
+template <typename Word>
+static inline void sbox3(Word a0, Word a1, Word a2, Word a3, Word a4, Word a5, Word out[4]) {
+    Word t0 = ~a4;
+    Word t1 = t0 | a2;
+    Word t2 = a2 & t0;
+    Word t3 = t1 ^ t2;
+    Word t4 = t3 & a1;
+    Word t5 = t1 ^ t4;
+    Word t6 = a2 ^ a4;
+    Word t8 = t6 ^ a1;
+    Word t9 = t5 ^ t8;
+    Word t10 = t9 & a5;
+    Word t11 = t5 ^ t10;
+    Word t12 = a4 & a1;
+    Word t13 = a2 ^ t12;
+    Word t14 = t6 ^ t13;
+    Word t15 = t14 & a5;
+    Word t16 = t6 ^ t15;
+    Word t17 = t11 ^ t16;
+    Word t18 = t17 & a3;
+    Word t19 = t11 ^ t18;
+    Word t20 = t4 ^ t14;
+    Word t21 = t20 ^ t6;
+    Word t22 = t21 & a5;
+    Word t23 = t20 ^ t22;
+    Word t24 = t2 ^ t4;
+    Word t25 = a2 ^ t2;
+    Word t27 = t25 ^ a1;
+    Word t28 = t24 ^ t27;
+    Word t29 = t28 & a5;
+    Word t30 = t24 ^ t29;
+    Word t31 = t23 ^ t30;
+    Word t32 = t31 & a3;
+    Word t33 = t23 ^ t32;
+    Word t34 = t19 ^ t33;
+    Word t35 = t34 & a0;
+    Word t36 = t19 ^ t35;
+    Word t37 = t28 & ~t14;
+    Word t38 = t1 ^ t8;
+    Word t39 = t37 ^ t38;
+    Word t40 = t39 & a5;
+    Word t41 = t37 ^ t40;
+    Word t42 = t20 ^ t37;
+    Word t43 = t12 ^ t24;
+    Word t44 = t42 ^ t43;
+    Word t45 = t44 & a5;
+    Word t46 = t42 ^ t45;
+    Word t47 = t41 ^ t46;
+    Word t48 = t47 & a3;
+    Word t49 = t41 ^ t48;
+    Word t50 = a5 ^ t38;
+    Word t51 = a4 ^ t38;
+    Word t52 = t27 & a5;
+    Word t53 = t51 ^ t52;
+    Word t54 = t50 ^ t53;
+    Word t55 = t54 & a3;
+    Word t56 = t50 ^ t55;
+    Word t57 = t49 ^ t56;
+    Word t58 = t57 & a0;
+    Word t59 = t49 ^ t58;
+    Word t60 = a5 ^ t27;
+    Word t62 = t0 & a3;
+    Word t63 = t60 ^ t62;
+    Word t64 = t1 ^ t37;
+    Word t66 = t4 & a5;
+    Word t67 = t64 ^ t66;
+    Word t68 = a2 ^ t44;
+    Word t69 = t64 & ~t24;
+    Word t70 = t68 ^ t69;
+    Word t71 = t70 & a5;
+    Word t72 = t68 ^ t71;
+    Word t73 = t67 ^ t72;
+    Word t74 = t73 & a3;
+    Word t75 = t67 ^ t74;
+    Word t76 = t63 ^ t75;
+    Word t77 = t76 & a0;
+    Word t78 = t63 ^ t77;
+    Word t79 = t51 & t67;
+    Word t80 = t1 ^ t44;
+    Word t81 = a1 ^ t20;
+    Word t82 = t80 ^ t81;
+    Word t83 = t82 & a5;
+    Word t84 = t80 ^ t83;
+    Word t85 = t79 ^ t84;
+    Word t86 = t85 & a3;
+    Word t87 = t79 ^ t86;
+    Word t88 = t14 ^ t80;
+    Word t89 = t88 ^ t81;
+    Word t90 = t89 & a5;
+    Word t91 = t88 ^ t90;
+    Word t93 = t91 ^ a3;
+    Word t94 = t87 ^ t93;
+    Word t95 = t94 & a0;
+    Word t96 = t87 ^ t95;
+    out[0] = t96;
+    out[1] = t59;
+    out[2] = t36;
+    out[3] = t78;
+}
+
+template <typename Word>
+static inline void sbox4(Word a0, Word a1, Word a2, Word a3, Word a4, Word a5, Word out[4]) {
+    Word t0 = ~a1;
+    Word t1 = t0 ^ a1;
+    Word t2 = t0 ^ a4;
+    Word t3 = a1 ^ a4;
+    Word t4 = t2 ^ a2;
+    Word t5 = t2 & a2;
+    Word t6 = t0 ^ t5;
+    Word t7 = t4 ^ t6;
+    Word t8 = t7 & a3;
+    Word t9 = t4 ^ t8;
+    Word t10 = t0 | t3;
+    Word t11 = t10 ^ a4;
+    Word t12 = t11 & a2;
+    Word t13 = t10 ^ t12;
+    Word t14 = a1 ^ t12;
+    Word t15 = t13 ^ t14;
+    Word t16 = t15 & a3;
+    Word t17 = t13 ^ t16;
+    Word t18 = t9 ^ t17;
+    Word t19 = t18 & a0;
+    Word t20 = t9 ^ t19;
+    Word t21 = t0 ^ t15;
+    Word t22 = t0 & a2;
+    Word t23 = t21 ^ t22;
+    Word t24 = t11 ^ t23;
+    Word t25 = t11 & a3;
+    Word t26 = t23 ^ t25;
+    Word t27 = t6 ^ t22;
+    Word t28 = t27 ^ t7;
+    Word t29 = t28 & a3;
+    Word t30 = t27 ^ t29;
+    Word t31 = t26 ^ t30;
+    Word t32 = t31 & a0;
+    Word t33 = t26 ^ t32;
+    Word t34 = t20 ^ t33;
+    Word t35 = t34 & a5;
+    Word t36 = t20 ^ t35;
+    Word t37 = t13 ^ t24;
+    Word t39 = t10 & a3;
+    Word t40 = t37 ^ t39;
+    Word t41 = t1 ^ t7;
+    Word t42 = t41 ^ t4;
+    Word t43 = t42 & a3;
+    Word t44 = t41 ^ t43;
+    Word t45 = t40 ^ t44;
+    Word t46 = t45 & a0;
+    Word t47 = t40 ^ t46;
+    Word t48 = t5 ^ t28;
+    Word t49 = t6 ^ t48;
+    Word t50 = t49 & a3;
+    Word t51 = t6 ^ t50;
+    Word t52 = t0 ^ t24;
+    Word t53 = t52 ^ t23;
+    Word t54 = t53 & a3;
+    Word t55 = t52 ^ t54;
+    Word t56 = t51 ^ t55;
+    Word t57 = t56 & a0;
+    Word t58 = t51 ^ t57;
+    Word t59 = t47 ^ t58;
+    Word t60 = t59 & a5;
+    Word t61 = t47 ^ t60;
+    Word t62 = t1 ^ t47;
+    Word t63 = t58 ^ t62;
+    Word t64 = t63 & a5;
+    Word t65 = t58 ^ t64;
+    Word t66 = t1 ^ t33;
+    Word t67 = t66 ^ t20;
+    Word t68 = t67 & a5;
+    Word t69 = t66 ^ t68;
+    out[0] = t61;
+    out[1] = t65;
+    out[2] = t36;
+    out[3] = t69;
+}
+
+template <typename Word>
+static inline void sbox5(Word a0, Word a1, Word a2, Word a3, Word a4, Word a5, Word out[4]) {
+    Word t0 = a1 & a4;
+    Word t1 = t0 ^ a1;
+    Word t2 = t1 & a0;
+    Word t3 = t0 ^ t2;
+    Word t4 = ~a4;
+    Word t5 = t4 ^ a4;
+    Word t6 = t4 ^ a0;
+    Word t7 = t3 ^ t6;
+    Word t8 = t7 & a2;
+    Word t9 = t3 ^ t8;
+    Word t10 = a1 ^ a4;
+    Word t11 = a1 ^ t4;
+    Word t12 = t10 ^ a0;
+    Word t14 = t0 & a2;
+    Word t15 = t12 ^ t14;
+    Word t16 = t9 ^ t15;
+    Word t17 = t16 & a5;
+    Word t18 = t9 ^ t17;
+    Word t19 = a4 | t12;
+    Word t21 = t0 & a0;
+    Word t22 = t11 ^ t21;
+    Word t23 = t19 ^ t22;
+    Word t24 = t23 & a2;
+    Word t25 = t19 ^ t24;
+    Word t26 = t6 & t19;
+    Word t27 = t1 ^ t23;
+    Word t28 = t26 ^ t27;
+    Word t29 = t28 & a2;
+    Word t30 = t26 ^ t29;
+    Word t31 = t25 ^ t30;
+    Word t32 = t31 & a5;
+    Word t33 = t25 ^ t32;
+    Word t34 = t18 ^ t33;
+    Word t35 = t34 & a3;
+    Word t36 = t18 ^ t35;
+    Word t37 = t7 & t27;
+    Word t38 = t7 ^ t19;
+    Word t39 = t37 ^ t38;
+    Word t40 = t39 & a2;
+    Word t41 = t37 ^ t40;
+    Word t42 = t38 ^ t10;
+    Word t43 = t42 & a2;
+    Word t44 = t38 ^ t43;
+    Word t45 = t41 ^ t44;
+    Word t46 = t45 & a5;
+    Word t47 = t41 ^ t46;
+    Word t48 = t0 ^ t26;
+    Word t49 = t1 ^ t38;
+    Word t50 = t48 ^ t49;
+    Word t51 = t50 & a2;
+    Word t52 = t48 ^ t51;
+    Word t53 = t0 ^ t6;
+    Word t54 = t42 ^ t53;
+    Word t55 = t53 ^ t43;
+    Word t56 = t52 ^ t55;
+    Word t57 = t56 & a5;
+    Word t58 = t52 ^ t57;
+    Word t59 = t47 ^ t58;
+    Word t60 = t59 & a3;
+    Word t61 = t47 ^ t60;
+    Word t62 = t23 ^ t37;
+    Word t63 = a0 ^ t62;
+    Word t64 = a0 & a2;
+    Word t65 = t62 ^ t64;
+    Word t66 = a4 ^ t22;
+    Word t67 = a0 ^ t54;
+    Word t68 = t66 ^ t67;
+    Word t69 = t68 & a2;
+    Word t70 = t66 ^ t69;
+    Word t71 = t65 ^ t70;
+    Word t72 = t71 & a5;
+    Word t73 = t65 ^ t72;
+    Word t74 = a1 ^ t37;
+    Word t75 = t67 ^ t74;
+    Word t76 = t75 & a2;
+    Word t77 = t67 ^ t76;
+    Word t78 = t39 ^ t52;
+    Word t79 = t77 ^ t78;
+    Word t80 = t79 & a5;
+    Word t81 = t77 ^ t80;
+    Word t82 = t73 ^ t81;
+    Word t83 = t82 & a3;
+    Word t84 = t73 ^ t83;
+    Word t85 = a0 ^ a4;
+    Word t86 = t3 ^ t74;
+    Word t87 = t85 ^ t86;
+    Word t88 = t87 & a2;
+    Word t89 = t85 ^ t88;
+    Word t91 = t10 & a2;
+    Word t92 = t75 ^ t91;
+    Word t93 = t89 ^ t92;
+    Word t94 = t93 & a5;
+    Word t95 = t89 ^ t94;
+    Word t96 = t5 ^ t63;
+    Word t97 = t96 ^ t12;
+    Word t98 = t97 & a2;
+    Word t99 = t96 ^ t98;
+    Word t101 = t99 ^ a5;
+    Word t102 = t95 ^ t101;
+    Word t103 = t102 & a3;
+    Word t104 = t95 ^ t103;
+    out[0] = t84;
+    out[1] = t104;
+    out[2] = t61;
+    out[3] = t36;
+}
+
+template <typename Word>
+static inline void sbox6(Word a0, Word a1, Word a2, Word a3, Word a4, Word a5, Word out[4]) {
+    Word t0 = ~a5;
+    Word t1 = t0 ^ a5;
+    Word t2 = t0 ^ a4;
+    Word t3 = a4 ^ a5;
+    Word t4 = t2 ^ a1;
+    Word t5 = a1 ^ t3;
+    Word t6 = t4 ^ a0;
+    Word t7 = a1 ^ a5;
+    Word t8 = a4 & a5;
+    Word t9 = t8 ^ t3;
+    Word t10 = t9 & a1;
+    Word t11 = t8 ^ t10;
+    Word t12 = t7 ^ t11;
+    Word t13 = t12 & a0;
+    Word t14 = t7 ^ t13;
+    Word t15 = t6 ^ t14;
+    Word t16 = t15 & a2;
+    Word t17 = t6 ^ t16;
+    Word t18 = t3 | t10;
+    Word t19 = t0 ^ t8;
+    Word t20 = t19 ^ t2;
+    Word t21 = t20 & a1;
+    Word t22 = t19 ^ t21;
+    Word t23 = t18 ^ t22;
+    Word t24 = t23 & a0;
+    Word t25 = t18 ^ t24;
+    Word t26 = t1 ^ t18;
+    Word t27 = a5 ^ t4;
+    Word t28 = t26 ^ t27;
+    Word t29 = t28 & a0;
+    Word t30 = t26 ^ t29;
+    Word t31 = t25 ^ t30;
+    Word t32 = t31 & a2;
+    Word t33 = t25 ^ t32;
+    Word t34 = t17 ^ t33;
+    Word t35 = t34 & a3;
+    Word t36 = t17 ^ t35;
+    Word t37 = a1 ^ t28;
+    Word t39 = t5 & a0;
+    Word t40 = t37 ^ t39;
+    Word t41 = t5 ^ t21;
+    Word t42 = t7 ^ t23;
+    Word t43 = t41 ^ t42;
+    Word t44 = t43 & a0;
+    Word t45 = t41 ^ t44;
+    Word t46 = t40 ^ t45;
+    Word t47 = t46 & a2;
+    Word t48 = t40 ^ t47;
+    Word t49 = t22 ^ t27;
+    Word t50 = t49 & a0;
+    Word t51 = t22 ^ t50;
+    Word t53 = t51 ^ t47;
+    Word t54 = t48 ^ t53;
+    Word t55 = t54 & a3;
+    Word t56 = t48 ^ t55;
+    Word t57 = t26 | t42;
+    Word t58 = a4 ^ t57;
+    Word t59 = t58 & a0;
+    Word t60 = a4 ^ t59;
+    Word t61 = t2 & a0;
+    Word t62 = t27 ^ t61;
+    Word t63 = t60 ^ t62;
+    Word t64 = t63 & a2;
+    Word t65 = t60 ^ t64;
+    Word t66 = t43 & ~t62;
+    Word t67 = t7 | t11;
+    Word t68 = t67 ^ t5;
+    Word t69 = t68 & a0;
+    Word t70 = t67 ^ t69;
+    Word t71 = t66 ^ t70;
+    Word t72 = t71 & a2;
+    Word t73 = t66 ^ t72;
+    Word t74 = t65 ^ t73;
+    Word t75 = t74 & a3;
+    Word t76 = t65 ^ t75;
+    Word t77 = t5 ^ t19;
+    Word t78 = a1 ^ t0;
+    Word t79 = t9 & a0;
+    Word t80 = t77 ^ t79;
+    Word t81 = a5 ^ t68;
+    Word t82 = t2 ^ t81;
+    Word t83 = t82 & a0;
+    Word t84 = t2 ^ t83;
+    Word t85 = t80 ^ t84;
+    Word t86 = t85 & a2;
+    Word t87 = t80 ^ t86;
+    Word t88 = t69 ^ t78;
+    Word t89 = t8 ^ t71;
+    Word t90 = t88 ^ t89;
+    Word t91 = t90 & a2;
+    Word t92 = t88 ^ t91;
+    Word t93 = t87 ^ t92;
+    Word t94 = t93 & a3;
+    Word t95 = t87 ^ t94;
+    out[0] = t95;
+    out[1] = t36;
+    out[2] = t56;
+    out[3] = t76;
+}
+
+template <typename Word>
+static inline void sbox7(Word a0, Word a1, Word a2, Word a3, Word a4, Word a5, Word out[4]) {
+    Word t0 = a1 ^ a4;
+    Word t1 = a4 & a3;
+    Word t2 = t0 ^ t1;
+    Word t3 = ~a4;
+    Word t4 = t3 ^ a4;
+    Word t5 = t3 ^ a3;
+    Word t6 = t2 ^ t5;
+    Word t7 = t6 & a2;
+    Word t8 = t2 ^ t7;
+    Word t10 = t8 ^ a0;
+    Word t11 = a1 ^ t3;
+    Word t12 = t0 | t3;
+    Word t13 = t11 ^ t12;
+    Word t14 = t13 & a3;
+    Word t15 = t11 ^ t14;
+    Word t17 = t15 ^ t7;
+    Word t18 = t12 & a3;
+    Word t19 = t13 ^ t18;
+    Word t20 = t4 ^ t19;
+    Word t21 = t19 ^ a2;
+    Word t22 = t17 ^ t21;
+    Word t23 = t22 & a0;
+    Word t24 = t17 ^ t23;
+    Word t25 = t10 ^ t24;
+    Word t26 = t25 & a5;
+    Word t27 = t10 ^ t26;
+    Word t28 = t2 ^ t18;
+    Word t29 = t4 ^ t28;
+    Word t30 = t28 ^ a2;
+    Word t31 = t11 & a3;
+    Word t32 = a1 ^ t31;
+    Word t34 = t13 & a2;
+    Word t35 = t32 ^ t34;
+    Word t36 = t30 ^ t35;
+    Word t37 = t36 & a0;
+    Word t38 = t30 ^ t37;
+    Word t39 = a1 ^ a3;
+    Word t40 = a3 ^ t32;
+    Word t41 = t31 & a2;
+    Word t42 = t39 ^ t41;
+    Word t43 = t6 ^ t14;
+    Word t45 = t43 ^ a2;
+    Word t46 = t42 ^ t45;
+    Word t47 = t46 & a0;
+    Word t48 = t42 ^ t47;
+    Word t49 = t38 ^ t48;
+    Word t50 = t49 & a5;
+    Word t51 = t38 ^ t50;
+    Word t52 = t2 ^ t40;
+    Word t53 = t1 ^ t11;
+    Word t54 = t52 ^ t53;
+    Word t55 = t54 & a2;
+    Word t56 = t52 ^ t55;
+    Word t57 = a1 ^ t18;
+    Word t58 = t57 ^ t20;
+    Word t59 = t58 & a2;
+    Word t60 = t57 ^ t59;
+    Word t61 = t56 ^ t60;
+    Word t62 = t61 & a0;
+    Word t63 = t56 ^ t62;
+    Word t64 = t2 ^ t54;
+    Word t65 = t64 ^ a2;
+    Word t66 = t30 ^ t59;
+    Word t67 = t65 ^ t66;
+    Word t68 = t67 & a0;
+    Word t69 = t65 ^ t68;
+    Word t70 = t63 ^ t69;
+    Word t71 = t70 & a5;
+    Word t72 = t63 ^ t71;
+    Word t73 = t14 ^ t29;
+    Word t75 = a1 & a2;
+    Word t76 = t73 ^ t75;
+    Word t77 = t76 ^ t56;
+    Word t78 = t77 & a0;
+    Word t79 = t76 ^ t78;
+    Word t80 = t0 ^ t43;
+    Word t81 = a3 ^ t15;
+    Word t82 = t80 ^ t81;
+    Word t83 = t82 & a2;
+    Word t84 = t80 ^ t83;
+    Word t85 = a1 ^ t52;
+    Word t86 = t11 ^ t85;
+    Word t87 = t86 & a2;
+    Word t88 = t11 ^ t87;
+    Word t89 = t84 ^ t88;
+    Word t90 = t89 & a0;
+    Word t91 = t84 ^ t90;
+    Word t92 = t79 ^ t91;
+    Word t93 = t92 & a5;
+    Word t94 = t79 ^ t93;
+    out[0] = t72;
+    out[1] = t94;
+    out[2] = t51;
+    out[3] = t27;
+}
+
+template <typename Word>
+static inline void sbox8(Word a0, Word a1, Word a2, Word a3, Word a4, Word a5, Word out[4]) {
+    Word t0 = ~a4;
+    Word t1 = t0 | a1;
+    Word t2 = ~t1;
+    Word t3 = t1 ^ t2;
+    Word t4 = t1 ^ a2;
+    Word t5 = a1 ^ t0;
+    Word t6 = a1 & a2;
+    Word t7 = t5 ^ t6;
+    Word t8 = t4 ^ t7;
+    Word t9 = t8 & a3;
+    Word t10 = t4 ^ t9;
+    Word t12 = t0 & a2;
+    Word t13 = t2 ^ t12;
+    Word t14 = a1 ^ t12;
+    Word t15 = t13 ^ t14;
+    Word t16 = t15 & a3;
+    Word t17 = t13 ^ t16;
+    Word t18 = t10 ^ t17;
+    Word t19 = t18 & a0;
+    Word t20 = t10 ^ t19;
+    Word t21 = a1 ^ a4;
+    Word t22 = t21 ^ a2;
+    Word t23 = t1 ^ t22;
+    Word t24 = t1 & a3;
+    Word t25 = t22 ^ t24;
+    Word t26 = t4 & t15;
+    Word t28 = t5 & a3;
+    Word t29 = t26 ^ t28;
+    Word t30 = t25 ^ t29;
+    Word t31 = t30 & a0;
+    Word t32 = t25 ^ t31;
+    Word t33 = t20 ^ t32;
+    Word t34 = t33 & a5;
+    Word t35 = t20 ^ t34;
+    Word t36 = a4 ^ t14;
+    Word t37 = a4 & a3;
+    Word t38 = t36 ^ t37;
+    Word t39 = t6 | t23;
+    Word t41 = t39 ^ a3;
+    Word t42 = t38 ^ t41;
+    Word t43 = t42 & a0;
+    Word t44 = t38 ^ t43;
+    Word t45 = t6 ^ t13;
+    Word t46 = t45 ^ t14;
+    Word t47 = t46 & a3;
+    Word t48 = t45 ^ t47;
+    Word t49 = t23 ^ t46;
+    Word t50 = t0 ^ t22;
+    Word t51 = t49 ^ t50;
+    Word t52 = t51 & a3;
+    Word t53 = t49 ^ t52;
+    Word t54 = t48 ^ t53;
+    Word t55 = t54 & a0;
+    Word t56 = t48 ^ t55;
+    Word t57 = t44 ^ t56;
+    Word t58 = t57 & a5;
+    Word t59 = t44 ^ t58;
+    Word t60 = t30 ^ t41;
+    Word t61 = t18 ^ t38;
+    Word t62 = t60 ^ t61;
+    Word t63 = t62 & a0;
+    Word t64 = t60 ^ t63;
+    Word t65 = t3 ^ t60;
+    Word t66 = a3 ^ t14;
+    Word t67 = t65 ^ t66;
+    Word t68 = t67 & a0;
+    Word t69 = t65 ^ t68;
+    Word t70 = t64 ^ t69;
+    Word t71 = t70 & a5;
+    Word t72 = t64 ^ t71;
+    Word t73 = t3 ^ t32;
+    Word t74 = t5 ^ t45;
+    Word t75 = t13 & a3;
+    Word t76 = t74 ^ t75;
+    Word t77 = a2 ^ t36;
+    Word t78 = t77 ^ t51;
+    Word t79 = t78 & a3;
+    Word t80 = t77 ^ t79;
+    Word t81 = t76 ^ t80;
+    Word t82 = t81 & a0;
+    Word t83 = t76 ^ t82;
+    Word t84 = t73 ^ t83;
+    Word t85 = t84 & a5;
+    Word t86 = t73 ^ t85;
+    out[0] = t35;
+    out[1] = t72;
+    out[2] = t59;
+    out[3] = t86;
+}
+
+template <typename Word>
+using SboxCircuit = void (*)(Word, Word, Word, Word, Word, Word, Word*);
+
+/*
+ * Applies one S-box of the round function: gathers its six expanded input bits from the right half,
+ * adds the round key bits and XORs the four output bits into the left half through P.
+ */
+template <typename Word, typename Splat>
+static inline void sboxStep(
+    Word* left, const Word* right, const uint64_t* roundKey, int box, SboxCircuit<Word> circuit, Splat splat
+) {
+    const int* e = E + 6 * box;
+    const uint64_t* k = roundKey + 6 * box;
+    Word out[4];
+
+    circuit(
+        right[e[0] - 1] ^ splat(k[0]), right[e[1] - 1] ^ splat(k[1]), right[e[2] - 1] ^ splat(k[2]),
+        right[e[3] - 1] ^ splat(k[3]), right[e[4] - 1] ^ splat(k[4]), right[e[5] - 1] ^ splat(k[5]), out
+    );
+
+    for (int b = 0; b < 4; b++) {
+        left[P_INVERSE[4 * box + b]] ^= out[b];
+    }
+}
+
+/*
+ * Runs DES rounds on bitsliced state.
+ *
+ * The state is indexed in IP order: words 0-31 are the left half and 32-63 the right half after the
+ * initial permutation. The halves are exchanged by renaming after every round except the last of each
+ * cipher, which DES does not exchange. Chained ciphers need no extra work: the FP of one cipher and the
+ * IP of the next cancel out, and the next cipher starts from the halves as they are. If the renaming
+ * leaves the output's left half in the upper words, the halves are moved back into place at the end.
+ *
+ * @param state The 64 state words.
+ * @param roundKeys One row of 48 key masks (all zeros or all ones) per round, in the order of use.
+ * @param numRounds The number of rounds, 16 per chained DES.
+ * @param splat Converts a key mask to a Word.
+ */
+template <typename Word, typename Splat>
+static void runRoundsBitsliced(Word* state, const uint64_t* const* roundKeys, size_t numRounds, Splat splat) {
+    Word* left = state;
+    Word* right = state + 32;
+
+    for (size_t round = 0; round < numRounds; round++) {
+        const uint64_t* k = roundKeys[round];
+        sboxStep<Word>(left, right, k, 0, sbox1<Word>, splat);
+        sboxStep<Word>(left, right, k, 1, sbox2<Word>, splat);
+        sboxStep<Word>(left, right, k, 2, sbox3<Word>, splat);
+        sboxStep<Word>(left, right, k, 3, sbox4<Word>, splat);
+        sboxStep<Word>(left, right, k, 4, sbox5<Word>, splat);
+        sboxStep<Word>(left, right, k, 5, sbox6<Word>, splat);
+        sboxStep<Word>(left, right, k, 6, sbox7<Word>, splat);
+        sboxStep<Word>(left, right, k, 7, sbox8<Word>, splat);
+
+        if ((round + 1) % DES_BITSLICED_CIPHER_ROUNDS != 0) {
+            Word* temp = left;
+            left = right;
+            right = temp;
+        }
+    }
+
+    if (left == state) {
+        return;
+    }
+    for (int i = 0; i < 32; i++) {
+        Word temp = left[i];
+        left[i] = right[i];
+        right[i] = temp;
+    }
+}
@@ -0,0 +1,81 @@
+/*
+ * Copyright 2023-2024 The Gestalt Project Authors. All Rights Reserved.
+ *
+ * Licensed under the MIT License. See the file LICENSE for the full text.
+ */
+
+/*
+ * desBitslicedAVX2.cpp
+ *
+ * This file contains the 256-bit instantiation of the bitsliced DES engine in desBitsliced.h. Each
+ * state word is a vector of four 64-bit lanes and every lane carries its own group of 64 blocks, so a
+ * pass processes DES_BITSLICED_AVX2_BLOCKS blocks. The vectors use the GCC and Clang vector extensions,
+ * which this translation unit turns into AVX2 instructions.
+ *
+ * This translation unit is compiled with AVX2 code generation enabled and must only be entered after
+ * desBitslicedAVX2Supported() has returned true.
+ */
+
+#include <cstring>
+
+#include "desBitsliced.h"
+#include "cpu_features/cpu_features.h"
+
+#if defined(GESTALT_X86) && defined(__GNUC__)
+
+typedef uint64_t DESWord256 __attribute__((vector_size(32)));
+
+const size_t DES_AVX2_LANES = 4;
+
+bool desBitslicedAVX2Supported() {
+    return getCPUFeatures().avx2;
+}
+
+/*
+ * Encrypts or decrypts DES_BITSLICED_AVX2_BLOCKS blocks in place with 256-bit vectors.
+ *
+ * @param blocks The blocks.
+ * @param roundKeys The key masks of each round, in the order of use.
+ * @param numRounds The number of rounds, a multiple of 16.
+ */
+void desBitslicedRoundsAVX2(uint64_t* blocks, const uint64_t* const* roundKeys, size_t numRounds) {
+    uint64_t slices[DES_AVX2_LANES][DES_BITSLICED_BLOCKS];
+    DESWord256 state[IP_SIZE];
+
+    for (size_t lane = 0; lane < DES_AVX2_LANES; lane++) {
+        memcpy(slices[lane], blocks + lane * DES_BITSLICED_BLOCKS, sizeof(slices[lane]));
+        transpose64(slices[lane]);
+    }
+    for (int i = 0; i < IP_SIZE; i++) {
+        for (size_t lane = 0; lane < DES_AVX2_LANES; lane++) {
+            state[i][lane] = slices[lane][IP[i] - 1];
+        }
+    }
+
+    runRoundsBitsliced(state, roundKeys, numRounds, [](uint64_t mask) {
+        DESWord256 word = { mask, mask, mask, mask };
+        return word;
+    });
+
+    // FP is the inverse of IP
+    for (int i = 0; i < IP_SIZE; i++) {
+        for (size_t lane = 0; lane < DES_AVX2_LANES; lane++) {
+            slices[lane][IP[i] - 1] = state[i][lane];
+        }
+    }
+    for (size_t lane = 0; lane < DES_AVX2_LANES; lane++) {
+        transpose64(slices[lane]);
+        memcpy(blocks + lane * DES_BITSLICED_BLOCKS, slices[lane], sizeof(slices[lane]));
+    }
+}
+
+#else
+
+// The vector extensions are not available; desBitslicedAVX2Supported keeps the engine unreachable.
+bool desBitslicedAVX2Supported() {
+    return false;
+}
+
+void desBitslicedRoundsAVX2(uint64_t*, const uint64_t* const*, size_t) {}
+
+#endif
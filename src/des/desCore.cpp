@@ -10,14 +10,14 @@
  * This file contains the implementation of Gestalts DES security functions.
  */
 
-#include <iomanip>
+#include <cstring>
 #include <string>
-#include <bitset>
-#include <sstream>
 #include <vector>
+#include <stdexcept>
 
 #include "desCore.h"
 #include "desConstants.h"
+#include "utils.h"
 
 uint64_t DES::permute(uint64_t input, const int* table, int inputSize, int outputSize) {
     uint64_t output = 0;
@@ -41,9 +41,65 @@ uint32_t DES::leftRotate(uint32_t key, int shifts) {
     return ((key << shifts) & 0x0FFFFFFF) | (key >> (28 - shifts));
 }
 
-void DES::generateRoundKeys(const std::string& binaryKey) {
-    uint64_t key = std::bitset<64>(binaryKey).to_ullong();
-    uint64_t permutedKey = permute(key, PC1, 64, PC1_SIZE);
+/*
+ * PC-1 and PC-2 split into one table per input byte. Every entry holds the output bits that come from
+ * one value of that byte, so a permutation is the OR of one lookup per byte instead of a loop over
+ * every output bit. The tables are built from PC1 and PC2 the first time a key is expanded.
+ */
+struct KeyScheduleTables {
+    uint64_t pc1[8][256]; // 64-bit key to the 56-bit C and D registers
+    uint64_t pc2[7][256]; // 56-bit C and D registers to a 48-bit round key
+
+    KeyScheduleTables() {
+        buildByteTables(pc1[0], 8, PC1, PC1_SIZE);
+        buildByteTables(pc2[0], 7, PC2, PC2_SIZE);
+    }
+
+    static void buildByteTables(uint64_t* tables, int numBytes, const int* table, int outputSize) {
+        int inputSize = numBytes * 8;
+        for (int byte = 0; byte < numBytes; ++byte) {
+            for (int value = 0; value < 256; ++value) {
+                uint64_t input = static_cast<uint64_t>(value) << (inputSize - 8 - 8 * byte);
+                uint64_t output = 0;
+                for (int i = 0; i < outputSize; ++i) {
+                    output = (output << 1) | ((input >> (inputSize - table[i])) & 0x01);
+                }
+                tables[byte * 256 + value] = output;
+            }
+        }
+    }
+};
+
+static const KeyScheduleTables& keyScheduleTables() {
+    static const KeyScheduleTables tables;
+    return tables;
+}
+
+/*
+ * Creates a DES instance from a key given as 16 hexadecimal digits.
+ *
+ * @param hexKey The key in hex.
+ * @throws std::invalid_argument if the key contains a non-hexadecimal character.
+ */
+DES::DES(const std::string& hexKey) {
+    uint64_t key = 0;
+    for (char c : hexKey) {
+        int nibble = hexDigitValue(c);
+        if (nibble < 0) {
+            throw std::invalid_argument("Invalid DES key. Expected hexadecimal digits.");
+        }
+        key = (key << 4) | static_cast<uint64_t>(nibble);
+    }
+    generateRoundKeys(key);
+}
+
+void DES::generateRoundKeys(uint64_t key) {
+    const KeyScheduleTables& tables = keyScheduleTables();
+
+    uint64_t permutedKey = 0;
+    for (int i = 0; i < 8; ++i) {
+        permutedKey |= tables.pc1[i][(key >> (56 - 8 * i)) & 0xFF];
+    }
 
     uint32_t left = (permutedKey >> 28) & 0xFFFFFFF;
     uint32_t right = permutedKey & 0xFFFFFFF;
@@ -53,10 +109,59 @@ void DES::generateRoundKeys(const std::string& binaryKey) {
         right = leftRotate(right, keyShifts[i]);
 
         uint64_t combinedKey = (static_cast<uint64_t>(left) << 28) | right;
-        roundKeys[i] = permute(combinedKey, PC2, 56, PC2_SIZE);
+        roundKeys[i] = 0;
+        for (int j = 0; j < 7; ++j) {
+            roundKeys[i] |= tables.pc2[j][(combinedKey >> (48 - 8 * j)) & 0xFF];
+        }
+
+        for (int j = 0; j < 8; ++j) {
+            roundKeyChunks[i][j] = (roundKeys[i] >> (42 - 6 * j)) & 0x3F;
+        }
     }
 }
 
+/*
+ * Exchanges the bits of a selected by mask, shifted right by shift, with the bits of b selected by mask.
+ */
+static inline void deltaSwap(uint32_t& a, uint32_t& b, int shift, uint32_t mask) {
+    uint32_t t = ((a >> shift) ^ b) & mask;
+    b ^= t;
+    a ^= t << shift;
+}
+
+/*
+ * IP as five delta swaps between the two halves of the block: it transposes the block viewed as an
+ * 8x8 bit matrix and reorders the rows, and each swap moves blocks of 4, 16, 2, 8 and 1 bits into place.
+ */
+uint64_t DES::initialPermutation(uint64_t block) {
+    uint32_t left = static_cast<uint32_t>(block >> 32);
+    uint32_t right = static_cast<uint32_t>(block);
+
+    deltaSwap(left, right, 4, 0x0F0F0F0F);
+    deltaSwap(left, right, 16, 0x0000FFFF);
+    deltaSwap(right, left, 2, 0x33333333);
+    deltaSwap(right, left, 8, 0x00FF00FF);
+    deltaSwap(left, right, 1, 0x55555555);
+
+    return (static_cast<uint64_t>(left) << 32) | right;
+}
+
+/*
+ * FP is the inverse of IP, the same swaps in reverse order.
+ */
+uint64_t DES::finalPermutation(uint64_t block) {
+    uint32_t left = static_cast<uint32_t>(block >> 32);
+    uint32_t right = static_cast<uint32_t>(block);
+
+    deltaSwap(left, right, 1, 0x55555555);
+    deltaSwap(right, left, 8, 0x00FF00FF);
+    deltaSwap(right, left, 2, 0x33333333);
+    deltaSwap(left, right, 16, 0x0000FFFF);
+    deltaSwap(left, right, 4, 0x0F0F0F0F);
+
+    return (static_cast<uint64_t>(left) << 32) | right;
+}
+
 uint32_t DES::sboxSubstitution(uint64_t input) {
     uint32_t output = 0;
     for (int i = 0; i < 8; ++i) {
@@ -69,13 +174,30 @@ uint32_t DES::sboxSubstitution(uint64_t input) {
     return output;
 }
 
-uint32_t DES::f(uint32_t rightChunk, size_t round) {
-    uint64_t expandedChunk = permute(static_cast<uint64_t>(rightChunk), E, 32, E_SIZE) & 0x0000FFFFFFFFFFFF;
-    return permute(sboxSubstitution(expandedChunk ^ roundKeys[round]), P, 32, P_SIZE);
-}  
+/*
+ * The DES round function. f applies it with the key of the given round, feistel with any key chunks.
+ *
+ * E copies every 4-bit group of the half block together with the bit on either side of it, so the
+ * 6-bit input of S-box i is bits 4i - 1 to 4i + 4 (counting from 1, wrapping around). Rotating the half
+ * right by one lines the first seven groups up at shifts 26, 22, ..., 2 and the last one, which wraps,
+ * is the low six bits of the half rotated left by one. Each group is XORed with its round key chunk
+ * and looked up in the SP table, which already holds the S-box output moved through P.
+ */
+uint32_t DES::f(uint32_t rightChunk, size_t round) const {
+    return feistel(rightChunk, roundKeyChunks[round]);
+}
+
+uint32_t DES::feistel(uint32_t rightChunk, const uint8_t* k) {
+    uint32_t r = (rightChunk >> 1) | (rightChunk << 31);
+
+    return SP[0][((r >> 26) & 0x3F) ^ k[0]] ^ SP[1][((r >> 22) & 0x3F) ^ k[1]] ^
+           SP[2][((r >> 18) & 0x3F) ^ k[2]] ^ SP[3][((r >> 14) & 0x3F) ^ k[3]] ^
+           SP[4][((r >> 10) & 0x3F) ^ k[4]] ^ SP[5][((r >> 6) & 0x3F) ^ k[5]] ^
+           SP[6][((r >> 2) & 0x3F) ^ k[6]] ^ SP[7][(((rightChunk << 1) | (rightChunk >> 31)) & 0x3F) ^ k[7]];
+}
 
-uint64_t DES::encryptBlock(uint64_t block) {
-    block = permute(block, IP, DES_BLOCK_SIZE, IP_SIZE); // Initial permutation
+uint64_t DES::encryptBlock(uint64_t block) const {
+    block = initialPermutation(block);
 
     uint32_t left = (block >> 32) & 0xFFFFFFFF;
     uint32_t right = block & 0xFFFFFFFF;
@@ -91,11 +213,11 @@ uint64_t DES::encryptBlock(uint64_t block) {
     left ^= f(right, DES_NUM_OF_ROUNDS - 1);
     block = (static_cast<uint64_t>(left) << 32) | right;
 
-    return permute(block, FP, DES_BLOCK_SIZE, FP_SIZE); // Final permutation
+    return finalPermutation(block);
 }
 
-uint64_t DES::decryptBlock(uint64_t block) {
-    block = permute(block, IP, DES_BLOCK_SIZE, IP_SIZE); // Initial permutation
+uint64_t DES::decryptBlock(uint64_t block) const {
+    block = initialPermutation(block);
 
     uint32_t left = (block >> 32) & 0xFFFFFFFF;
     uint32_t right = block & 0xFFFFFFFF;
@@ -111,96 +233,100 @@ uint64_t DES::decryptBlock(uint64_t block) {
     left ^= f(right, 0);
     block = (static_cast<uint64_t>(left) << 32) | right;
 
-    return permute(block, FP, DES_BLOCK_SIZE, FP_SIZE); // Final permutation
+    return finalPermutation(block);
 }
 
-std::string applyPCKS5Padding(const std::string& data) {
-    size_t blockSize = 8;
-    size_t paddingLength = blockSize - (data.size() % blockSize);
-    std::string paddedData = data;
-    paddedData.append(paddingLength, static_cast<char>(paddingLength));
-    return paddedData;
+/*
+ * Builds the 48 round schedule from three single DES schedules: K1 forwards, K2 backwards (its
+ * decryption) and K3 forwards. Decryption walks the same schedule from the end.
+ */
+TripleDES::TripleDES(const DES& key1, const DES& key2, const DES& key3) {
+    for (size_t round = 0; round < DES_NUM_OF_ROUNDS; round++) {
+        memcpy(roundKeyChunks[round], key1.roundKeyChunks[round], 8);
+        memcpy(roundKeyChunks[DES_NUM_OF_ROUNDS + round], key2.roundKeyChunks[DES_NUM_OF_ROUNDS - 1 - round], 8);
+        memcpy(roundKeyChunks[2 * DES_NUM_OF_ROUNDS + round], key3.roundKeyChunks[round], 8);
+    }
+}
+
+/*
+ * Runs the 48 rounds between a single IP and FP. The FP of one DES and the IP of the next cancel out,
+ * so chaining only has to undo the exchange of halves after the last round of each DES, which a single
+ * DES leaves out.
+ */
+uint64_t TripleDES::processBlock(uint64_t block, bool decrypt) const {
+    block = DES::initialPermutation(block);
+
+    uint32_t left = (block >> 32) & 0xFFFFFFFF;
+    uint32_t right = block & 0xFFFFFFFF;
+
+    for (size_t round = 0; round < TDES_NUM_OF_ROUNDS; round++) {
+        const uint8_t* k = roundKeyChunks[decrypt ? TDES_NUM_OF_ROUNDS - 1 - round : round];
+        uint32_t temp = left ^ DES::feistel(right, k);
+
+        if ((round + 1) % DES_NUM_OF_ROUNDS == 0) {
+            left = temp;
+        } else {
+            left = right;
+            right = temp;
+        }
+    }
+
+    block = (static_cast<uint64_t>(left) << 32) | right;
+
+    return DES::finalPermutation(block);
+}
+
+uint64_t TripleDES::encryptBlock(uint64_t block) const {
+    return processBlock(block, false);
+}
+
+uint64_t TripleDES::decryptBlock(uint64_t block) const {
+    return processBlock(block, true);
+}
+
+/*
+ * Copies a message to the output buffer and appends PKCS5 padding.
+ *
+ * @param msg The message bytes.
+ * @param msgLen The length of the message in bytes.
+ * @param out Output buffer of at least desPaddedLength(msgLen) bytes, may alias msg.
+ * @result The padded length in bytes.
+ */
+size_t padPKCS5(const uint8_t* msg, size_t msgLen, uint8_t* out) {
+    size_t paddedLen = desPaddedLength(msgLen);
+    if (out != msg) {
+        memmove(out, msg, msgLen);
+    }
+    memset(out + msgLen, static_cast<int>(paddedLen - msgLen), paddedLen - msgLen);
+    return paddedLen;
 }
 
-std::string removePKCS5Padding(const std::string& data) {
-    if (data.empty()) {
+/*
+ * Validates the PKCS5 padding at the end of a decrypted buffer.
+ *
+ * @param data The decrypted bytes.
+ * @param len The length of the decrypted data in bytes.
+ * @result The length of the data without padding.
+ * @throws std::runtime_error if the padding is invalid.
+ */
+size_t unpadPKCS5(const uint8_t* data, size_t len) {
+    if (len == 0) {
         throw std::runtime_error("Data is empty, cannot remove padding.");
     }
-    size_t paddingLength = static_cast<uint8_t>(data.back());
-    if (paddingLength > data.size() || paddingLength > 8) {
+    size_t paddingLength = data[len - 1];
+    if (paddingLength == 0 || paddingLength > len || paddingLength > DES_BLOCK_BYTES) {
         throw std::runtime_error("Invalid padding length.");
     }
-    return data.substr(0, data.size() - paddingLength);
+    return len - paddingLength;
 }
 
 uint64_t hexStringToUint64(const std::string& hexStr) {
     if (hexStr.length() != 16) {
         throw std::invalid_argument("Hex string must be 16 characters long");
     }
-    
-    uint64_t result = 0;
-    std::stringstream ss;
-    ss << std::hex << hexStr;
-    ss >> result;
-    
-    if (ss.fail()) {
-        throw std::invalid_argument("Invalid hex string");
-    }
-    
-    return result;
-}
-
-std::vector<uint64_t> stringToBlocks(const std::string& str) {
-    std::vector<uint64_t> blocks;
-    for (size_t i = 0; i < str.size(); i += 8) {
-        uint64_t block = 0;
-        for (size_t j = 0; j < 8 && i + j < str.size(); ++j) {
-            block <<= 8;
-            block |= static_cast<uint8_t>(str[i + j]);
-        }
-        blocks.push_back(block);
-    }
-    return blocks;
-}
-
-std::vector<uint64_t> hexStringToBlocks(const std::string& hex) {
-    std::vector<uint64_t> blocks;
-    for (size_t i = 0; i < hex.size(); i += 16) {
-        uint64_t block = 0;
-        for (size_t j = 0; j < 16 && i + j < hex.size(); ++j) {
-            block <<= 4;
-            char hexChar = hex[i + j];
-            if (hexChar >= '0' && hexChar <= '9') {
-                block |= (hexChar - '0');
-            } else if (hexChar >= 'A' && hexChar <= 'F') {
-                block |= (hexChar - 'A' + 10);
-            } else if (hexChar >= 'a' && hexChar <= 'f') {
-                block |= (hexChar - 'a' + 10);
-            } else {
-                throw std::runtime_error("Invalid hex character.");
-            }
-        }
-        blocks.push_back(block);
-    }
-    return blocks;
-}
-
-std::string blocksToHexString(const std::vector<uint64_t>& blocks) {
-    std::ostringstream oss;
-    for (uint64_t block : blocks) {
-        oss << std::hex << std::setw(16) << std::setfill('0') << block;
-    }
-    return oss.str();
-}
 
-std::string blocksToString(const std::vector<uint64_t>& blocks) {
-    std::string str;
-    for (uint64_t block : blocks) {
-        for (int i = 7; i >= 0; --i) {
-            str += static_cast<char>((block >> (i * 8)) & 0xFF);
-        }
-    }
-    return str;
+    std::string bytes = fromHex(hexStr);
+    return loadDESBlock(reinterpret_cast<const uint8_t*>(bytes.data()));
 }
 
 void validateKey(const std::string& key) {
@@ -223,4 +349,19 @@ void validateKeys(const std::string& key1, const std::string& key2, const std::s
             "for 2-key 3DES, key1 must equal key3 and key1 must be distinct from key2."
         );
     }
-}
\ No newline at end of file
+}
+void validateKeys(const uint8_t* key1, const uint8_t* key2, const uint8_t* key3) {
+    bool equal12 = memcmp(key1, key2, DES_BLOCK_BYTES) == 0;
+    bool equal13 = memcmp(key1, key3, DES_BLOCK_BYTES) == 0;
+    bool equal23 = memcmp(key2, key3, DES_BLOCK_BYTES) == 0;
+
+    bool isThreeKey = !equal12 && !equal13 && !equal23;
+    bool isTwoKey = equal13 && !equal12;
+
+    if (!isThreeKey && !isTwoKey) {
+        throw std::invalid_argument(
+            "Invalid keys: for 3-key 3DES, all keys must be distinct; "
+            "for 2-key 3DES, key1 must equal key3 and key1 must be distinct from key2."
+        );
+    }
+}
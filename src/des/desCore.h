@@ -13,43 +13,121 @@
 #pragma once
 
 #include <array>
+#include <gestalt/des.h>
 
 #include "../../tools/utils.h"
 
 const size_t DES_KEY_SIZE = 48;
 const size_t DES_BLOCK_SIZE = 64;
 const size_t DES_NUM_OF_ROUNDS = 16;
+const size_t DES_BLOCK_BYTES = 8;
+const size_t TDES_NUM_OF_ROUNDS = 3 * DES_NUM_OF_ROUNDS;
 
 class DES {
 private:
     std::array<uint64_t, 16> roundKeys;
+    uint8_t roundKeyChunks[16][8]; // Each round key split into the 6-bit inputs of the eight S-boxes
 
     uint64_t permute(uint64_t input, const int* table, int inputSize, int outputSize);
     uint32_t permute(uint32_t input, const int* table, int inputSize, int outputSize);
     uint32_t leftRotate(uint32_t key, int shifts);
-    void generateRoundKeys(const std::string& binaryKey);
+    void generateRoundKeys(uint64_t key);
+
+    static uint64_t initialPermutation(uint64_t block);
+    static uint64_t finalPermutation(uint64_t block);
 
     uint32_t sboxSubstitution(uint64_t input);
-    uint32_t f(uint32_t rightChunk, size_t round);
+    uint32_t f(uint32_t rightChunk, size_t round) const;
+    static uint32_t feistel(uint32_t rightChunk, const uint8_t* keyChunks);
 
     friend class DES_Functions;
+    friend class DESBitsliced;
+    friend class TripleDES;
 
 public:
-    explicit DES(const std::string& hexKey) {
-        generateRoundKeys(hexToBinary(hexKey));
+    explicit DES(const std::string& hexKey);
+    explicit DES(uint64_t key) {
+        generateRoundKeys(key);
     }
 
-    uint64_t encryptBlock(uint64_t block);
-    uint64_t decryptBlock(uint64_t block);
+    uint64_t encryptBlock(uint64_t block) const;
+    uint64_t decryptBlock(uint64_t block) const;
+};
+
+/*
+ * Triple DES engine (EDE).
+ *
+ * Holds the round keys of all three ciphers as one 48 round schedule, so each block goes through a
+ * single IP, 48 rounds and a single FP instead of three full DES operations. Two-key 3DES (K1 = K3)
+ * reuses the first key's schedule instead of deriving it again.
+ */
+class TripleDES {
+private:
+    uint8_t roundKeyChunks[TDES_NUM_OF_ROUNDS][8]; // Encryption order: K1, K2 reversed, K3
+
+    uint64_t processBlock(uint64_t block, bool decrypt) const;
+
+public:
+    TripleDES(const DES& key1, const DES& key2, const DES& key3);
+    TripleDES(const DES& key1, const DES& key2) : TripleDES(key1, key2, key1) {}
+    TripleDES(uint64_t key1, uint64_t key2, uint64_t key3) : TripleDES(DES(key1), DES(key2), DES(key3)) {}
+    TripleDES(uint64_t key1, uint64_t key2) : TripleDES(DES(key1), DES(key2)) {}
+
+    uint64_t encryptBlock(uint64_t block) const;
+    uint64_t decryptBlock(uint64_t block) const;
+};
+
+/*
+ * Bitsliced DES engine.
+ *
+ * Encrypts many independent blocks at once as boolean circuits over machine words: 64 blocks per pass,
+ * or 256 with AVX2 when the executing CPU supports it. It uses no lookup tables and no data dependent
+ * branches, so its timing depends on neither the key nor the data. Any number of blocks is accepted;
+ * a partial group is padded internally, so the engine pays off for ECB and CBC decryption of long
+ * messages, not for single blocks.
+ */
+class DESBitsliced {
+private:
+    uint64_t keyMasks[DES_NUM_OF_ROUNDS][DES_KEY_SIZE]; // Round key bits as words of all zeros or all ones
+
+    static void runRounds(uint64_t* blocks, size_t numBlocks, const uint64_t* const* roundKeys, size_t numRounds);
+
+public:
+    explicit DESBitsliced(const DES& des);
+    explicit DESBitsliced(uint64_t key) : DESBitsliced(DES(key)) {}
+
+    void encryptBlocks(uint64_t* blocks, size_t numBlocks) const;
+    void decryptBlocks(uint64_t* blocks, size_t numBlocks) const;
+
+    // Triple DES (encrypt with k1, decrypt with k2, encrypt with k3) without leaving the bitsliced form
+    static void encryptBlocksEDE(
+        const DESBitsliced& k1, const DESBitsliced& k2, const DESBitsliced& k3, uint64_t* blocks, size_t numBlocks
+    );
+    static void decryptBlocksEDE(
+        const DESBitsliced& k1, const DESBitsliced& k2, const DESBitsliced& k3, uint64_t* blocks, size_t numBlocks
+    );
 };
 
-std::string applyPCKS5Padding(const std::string& data);
-std::string removePKCS5Padding(const std::string& data);
+// Big-endian conversion between 8 message bytes and a block
+inline uint64_t loadDESBlock(const uint8_t* in) {
+    uint64_t block = 0;
+    for (size_t i = 0; i < DES_BLOCK_BYTES; i++) {
+        block = (block << 8) | in[i];
+    }
+    return block;
+}
+
+inline void storeDESBlock(uint64_t block, uint8_t* out) {
+    for (size_t i = DES_BLOCK_BYTES; i-- > 0;) {
+        out[i] = static_cast<uint8_t>(block);
+        block >>= 8;
+    }
+}
+
+size_t padPKCS5(const uint8_t* msg, size_t msgLen, uint8_t* out);
+size_t unpadPKCS5(const uint8_t* data, size_t len);
 uint64_t hexStringToUint64(const std::string& hexStr);
-std::vector<uint64_t> stringToBlocks(const std::string& str);
-std::vector<uint64_t> hexStringToBlocks(const std::string& hex);
-std::string blocksToHexString(const std::vector<uint64_t>& blocks);
-std::string blocksToString(const std::vector<uint64_t>& blocks);
 
 void validateKey(const std::string& key);
-void validateKeys(const std::string& key1, const std::string& key2, const std::string& key3);
\ No newline at end of file
+void validateKeys(const std::string& key1, const std::string& key2, const std::string& key3);
+void validateKeys(const uint8_t* key1, const uint8_t* key2, const uint8_t* key3);
\ No newline at end of file
@@ -41,17 +41,50 @@ void ECDSA::prepareMessage(const std::string& messageHash, mpz_t& result) {
     }
 }
 
+/*
+ * Converts a raw digest to the integer e of FIPS 186-5, keeping its leftmost bits when it is longer
+ * than the curve order.
+ *
+ * @param digest The digest.
+ * @param length The digest length in bytes.
+ * @param result Receives e.
+ */
+void ECDSA::prepareDigest(const uint8_t* digest, size_t length, mpz_t& result) {
+    size_t usedBytes = length;
+    if (8 * length > ellipticCurve.bitLength) {
+        usedBytes = (ellipticCurve.bitLength + 7) / 8;
+    }
+
+    mpz_import(result, usedBytes, 1, 1, 1, 0, digest);
+    if (8 * usedBytes > ellipticCurve.bitLength) {
+        mpz_tdiv_q_2exp(result, result, 8 * usedBytes - ellipticCurve.bitLength);
+    }
+}
+
+/*
+ * Hashes a message and converts the digest to e. With HashAlgorithm::None the message is taken to be
+ * the hash already, in hex.
+ */
+void ECDSA::hashMessage(const std::string& message, HashAlgorithm hashAlg, mpz_t& result) {
+    if (hashAlg == HashAlgorithm::None) {
+        prepareMessage(message, result);
+        return;
+    }
+
+    uint8_t digest[static_cast<size_t>(HashAlgorithm::SHA512)];
+    digestFunction(hashAlg)(message.data(), message.length(), digest);
+    prepareDigest(digest, static_cast<size_t>(hashAlg), result);
+}
+
 bool ECDSA::isInvalidSignature(Signature S) {
     // mpz_cmp returns a positive value if l > r, 0 if l = r, and a negative value if l < r
     return (mpz_cmp_ui(S.r, 0) == 0 || mpz_cmp_ui(S.s, 0) == 0);
 }
 
 Signature ECDSA::signMessage(const std::string& message, HashAlgorithm hashAlg) {
-    std::string messageHash = hash(hashAlg)(message);
-
     mpz_t e;
     mpz_init(e);
-    prepareMessage(messageHash, e);
+    hashMessage(message, hashAlg, e);
 
     mpz_t randomNumber, minBound;
     mpz_init(randomNumber);
@@ -69,11 +102,9 @@ Signature ECDSA::signMessage(const std::string& message, HashAlgorithm hashAlg)
 }
 
 Signature ECDSA::signMessage(const std::string& message, BigInt& K, HashAlgorithm hashAlg) {
-    std::string messageHash = hash(hashAlg)(message);
-
     mpz_t e;
     mpz_init(e);
-    prepareMessage(messageHash, e);
+    hashMessage(message, hashAlg, e);
 
     Signature signature = generateSignature(e, K.n);
 
@@ -115,11 +146,9 @@ Signature ECDSA::generateSignature(const mpz_t& e, mpz_t& k) {
 }
 
 bool ECDSA::verifySignature(const std::string& message, const ECDSAPublicKey& peerPublicKey, const Signature& signature, HashAlgorithm hashAlg) {
-    std::string messageHash = hash(hashAlg)(message);
-
     mpz_t e;
     mpz_init(e);
-    prepareMessage(messageHash, e);
+    hashMessage(message, hashAlg, e);
 
     Curve peerCurve = getCurveParams(peerPublicKey.getPublicKeyCurve());
 
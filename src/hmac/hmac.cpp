@@ -18,15 +18,17 @@
 #include "hmac.h"
 #include "utils.h"
 
+static const size_t MAX_DIGEST_SIZE = 64; // SHA-512
+
 std::pair<unsigned int, unsigned int> HMAC::getHashParameters(const HASH_ALGORITHM HASH) {
     switch (HASH) {
-        case SHA1: return {64, 20};
-        case SHA224: return {64, 28};
-        case SHA256: return {64, 32};
-        case SHA384: return {128, 48};
-        case SHA512: return {128, 64};
-        case SHA512_224: return {128, 28};
-        case SHA512_256: return {128, 32};
+        case HASH_ALGORITHM::SHA1: return {64, 20};
+        case HASH_ALGORITHM::SHA224: return {64, 28};
+        case HASH_ALGORITHM::SHA256: return {64, 32};
+        case HASH_ALGORITHM::SHA384: return {128, 48};
+        case HASH_ALGORITHM::SHA512: return {128, 64};
+        case HASH_ALGORITHM::SHA512_224: return {128, 28};
+        case HASH_ALGORITHM::SHA512_256: return {128, 32};
         default: throw std::invalid_argument("Error: Invalid hash algorithm given for HMAC");
     }
 }
@@ -37,12 +39,12 @@ void HMAC::hmacManager(const HASH_ALGORITHM HASH) {
     L = params.second;
 }
 
-void HMAC::processKey(const std::string& key, hash_f hash) {
+void HMAC::processKey(const std::string& key, digest_f digest) {
     size_t keySize = key.length();
 
     if (keySize > B) {
-        std::string hashedKey = hexToBytes(hash(key));
-        std::copy(hashedKey.begin(), hashedKey.end(), K.begin());
+        // L <= B, so the digest fits in K
+        digest(key.data(), keySize, K.data());
     } 
     // No need to append zeros manually because K is already initialized with zeros
     else {
@@ -62,7 +64,26 @@ std::string HMAC::xorVectors(const std::vector<unsigned char>& a, const std::vec
     return result;
 }
 
-std::string HMAC::keyedHash(const std::string& key, const std::string& input, hash_f hash) {
-    processKey(key, hash);
-    return hash(xorVectors(K, opad) + hexToBytes(hash(xorVectors(K, ipad) + input)));
-}
\ No newline at end of file
+/*
+ * Computes H((K ^ opad) || H((K ^ ipad) || input)). The inner digest stays binary; only the result
+ * is converted to hex.
+ *
+ * @param key The key.
+ * @param input The message.
+ * @param digest The raw digest function of the hash the HMAC was constructed for.
+ * @return The MAC in hex.
+ */
+std::string HMAC::keyedHash(const std::string& key, const std::string& input, digest_f digest) {
+    processKey(key, digest);
+
+    uint8_t innerHash[MAX_DIGEST_SIZE];
+    std::string inner = xorVectors(K, ipad) + input;
+    digest(inner.data(), inner.length(), innerHash);
+
+    uint8_t mac[MAX_DIGEST_SIZE];
+    std::string outer = xorVectors(K, opad);
+    outer.append(reinterpret_cast<const char*>(innerHash), L);
+    digest(outer.data(), outer.length(), mac);
+
+    return toHex(mac, L);
+}
@@ -14,10 +14,12 @@
 
 #include <string>
 #include <vector>
+#include <cstdint>
+#include <cstddef>
 
-typedef std::string (*hash_f)(const std::string& in);
+typedef void (*digest_f)(const void* in, size_t inLen, uint8_t* digest);
 
-enum HASH_ALGORITHM { SHA1, SHA224, SHA256, SHA384, SHA512, SHA512_224, SHA512_256 };
+enum class HASH_ALGORITHM { SHA1, SHA224, SHA256, SHA384, SHA512, SHA512_224, SHA512_256 };
 
 class HMAC {
 private:
@@ -30,7 +32,7 @@ private:
     
     static std::pair<unsigned int, unsigned int> getHashParameters(const HASH_ALGORITHM HASH);
     void hmacManager(const HASH_ALGORITHM HASH);
-    void processKey(const std::string& key, hash_f hash);
+    void processKey(const std::string& key, digest_f digest);
     std::string xorVectors(const std::vector<unsigned char>& a, const std::vector<unsigned char>& b);
 
 public:
@@ -42,5 +44,5 @@ public:
         K    = std::vector<unsigned char>(B, 0x00);
     }
 
-    std::string keyedHash(const std::string& key, const std::string& input, hash_f hash);
+    std::string keyedHash(const std::string& key, const std::string& input, digest_f digest);
 };
\ No newline at end of file
@@ -35,24 +35,20 @@ std::string applyOAEP_Padding(const std::string& input, const OAEPParams& params
     }
     std::string PS(psLen, 0x00);
 
-    // TODO: convert the output of hashSHA256 to bytes because you will find that the DB length is 255
-    // because it is doing it correctly, but since the output of hashSHA256 is in hex, and the length of DB
-    // is expected as bytes its "counting the byte twice", so its adding 32 to the length
-    // Maybe this is an overall flaw of the SHA implementations I have...
-    std::string DB = hexToBytes(hash(params.hashFunc)(params.label)) + PS + "\x01" + input;
+    std::string DB = hashBytes(params.hashFunc, params.label) + PS + "\x01" + input;
 
     std::string seed = params.seed;
     if (seed.empty()) {
         seed = generateRandomHexData(hashLength);
     }
 
-    std::string dbMask = hexToBytes(mgf1(hexToBytes(seed), modulusSizeBytes - hashLength - 1, params.hashFunc));
+    std::string dbMask = mgf1(hexToBytes(seed), modulusSizeBytes - hashLength - 1, params.hashFunc);
     std::string maskedDB;
     for (size_t i = 0; i < DB.length(); ++i) {
         maskedDB += DB[i] ^ dbMask[i];
     }
 
-    std::string seedMask = hexToBytes(mgf1(maskedDB, hashLength, params.hashFunc));
+    std::string seedMask = mgf1(maskedDB, hashLength, params.hashFunc);
     std::string maskedSeed;
     seed = hexToBytes(seed);
     for (size_t i = 0; i < hashLength; ++i) {
@@ -72,20 +68,20 @@ std::string removeOAEP_Padding(const std::string& input, const OAEPParams& param
     std::string maskedSeed = input.substr(1, hashLength);
     std::string maskedDB = input.substr(hashLength + 1, input.length());
 
-    std::string seedMask = hexToBytes(mgf1(maskedDB, hashLength, params.hashFunc));
+    std::string seedMask = mgf1(maskedDB, hashLength, params.hashFunc);
     std::string seed;
     for (size_t i = 0; i < seedMask.length(); ++i) {
         seed += maskedSeed[i] ^ seedMask[i];
     }
 
-    std::string dbMask = hexToBytes(mgf1(seed, modulusSizeBytes - hashLength - 1, params.hashFunc));
+    std::string dbMask = mgf1(seed, modulusSizeBytes - hashLength - 1, params.hashFunc);
 
     std::string DB;
     for (size_t i = 0; i < maskedDB.length(); ++i) {
         DB += maskedDB[i] ^ dbMask[i];
     }
 
-    std::string lhash = hexToBytes(hash(params.hashFunc)(params.label));
+    std::string lhash = hashBytes(params.hashFunc, params.label);
     if (DB.substr(0, hashLength) != lhash) {
         throw std::invalid_argument("OAEP Decode Error: The encoded lhash and computed lhash are not the same.");
     }
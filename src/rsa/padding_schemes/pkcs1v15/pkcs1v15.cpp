@@ -57,7 +57,7 @@ std::string decodeForEncryptionPKCS1v15(const std::string& input) {
 
 std::string encodeForSigningPKCS1v15(const std::string& input, const HashAlgorithm& hashAlg) {
     // 1. Hash the input message
-    std::string H = hexToBytes(hash(hashAlg)(input));
+    std::string H = hashBytes(hashAlg, input);
 
     // 2. Get DER-encoded AlgorithmIdentifier || Hash (H)
     std::string T = hexToBytes(getAlgorithmIdentifier(hashAlg)) + H;
@@ -27,20 +27,20 @@ std::string encodePSS_Padding(const std::string& input, const PSSParams& params,
     unsigned int hLen = static_cast<unsigned int>(params.hashFunc);
     if (emLen < hLen + params.sLen + 2) throw std::invalid_argument("Error PSS Encode: emLen is too short."); // Step 3
     
-    std::string mHash = hexToBytes(hash(params.hashFunc)(input)); // Step 1 & 2
+    std::string mHash = hashBytes(params.hashFunc, input); // Step 1 & 2
 
     std::string salt = params.salt;
     if (salt.empty()) salt = generateRandomHexData(params.sLen); // Step 4
 
     std::string PS1(PADDING1_SIZE, 0x00);
     std::string mPrime = PS1 + mHash + hexToBytes(salt); // Step 5
-    std::string H = hexToBytes(hash(params.hashFunc)(mPrime)); // Step 6
+    std::string H = hashBytes(params.hashFunc, mPrime); // Step 6
 
     int ps2Len = emLen - params.sLen - hLen - 2;
     std::string PS2(ps2Len, 0x00); // Step 7
     std::string DB = PS2 + "\x01" + hexToBytes(salt); // Step 8
 
-    std::string dbMask = hexToBytes(mgf1(H, emLen - hLen - 1, params.hashFunc)); // Step 9
+    std::string dbMask = mgf1(H, emLen - hLen - 1, params.hashFunc); // Step 9
     std::string maskedDB;
     for (size_t i = 0; i < DB.length(); ++i) {
         maskedDB += DB[i] ^ dbMask[i]; // Step 10
@@ -63,12 +63,12 @@ bool verifyPSS_Padding(const std::string& EM, const std::string& message, const
         throw std::invalid_argument("Error PSS Verification: emLen is too short."); // Step 3
     }
 
-    std::string mHash = hexToBytes(hash(params.hashFunc)(message)); // Step 1 & 2
+    std::string mHash = hashBytes(params.hashFunc, message); // Step 1 & 2
 
     std::string maskedDB = EM.substr(0, emLen - hLen - 1); // Step 5
     std::string H = EM.substr(emLen - hLen - 1, hLen); // Step 5
 
-    std::string dbMask = hexToBytes(mgf1(H, emLen - hLen - 1, params.hashFunc)); // Step 7
+    std::string dbMask = mgf1(H, emLen - hLen - 1, params.hashFunc); // Step 7
     std::string DB;
     for (size_t i = 0; i < maskedDB.length(); ++i) {
         DB += maskedDB[i] ^ dbMask[i]; // Step 8
@@ -90,7 +90,7 @@ bool verifyPSS_Padding(const std::string& EM, const std::string& message, const
     std::string salt = DB.substr(DB.length() - params.sLen, params.sLen); // Step 11
     std::string PS1(PADDING1_SIZE, 0x00);
     std::string mPrime = PS1 + mHash + salt; // Step 12
-    std::string hPrime = hexToBytes(hash(params.hashFunc)(mPrime)); // Step 13
+    std::string hPrime = hashBytes(params.hashFunc, mPrime); // Step 13
     
     if (H == hPrime) return true; // Step 14
 
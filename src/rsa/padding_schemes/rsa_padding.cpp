@@ -17,22 +17,33 @@
 
 #include "rsa_padding.h"
 
+/*
+ * MGF1 (RFC 8017, B.2.1): the digests of seed || C for C = 0, 1, ..., concatenated and truncated.
+ *
+ * @param seed The seed, as bytes.
+ * @param maskLen The mask length in bytes.
+ * @param hashAlg The hash function.
+ * @return The mask, as bytes.
+ */
 std::string mgf1(const std::string& seed, unsigned int maskLen, HashAlgorithm hashAlg) {
     unsigned int hashLength = static_cast<unsigned int>(hashAlg);
-    std::string mask = "";
-    unsigned char C[4];
+    DigestFunction digest = digestFunction(hashAlg);
     int iterations = (maskLen + hashLength - 1) / hashLength; // This is the same as ceil(maskLen/ SHA256_LENGTH)
 
+    // seed || C, with the counter C rewritten in place for every block
+    std::string input = seed + std::string(4, '\0');
+    std::string mask(static_cast<size_t>(iterations) * hashLength, '\0');
+
     for (int i = 0; i < iterations; i++) {
         // Construct the counter C
-        C[0] = (i >> 24) & 0xFF;
-        C[1] = (i >> 16) & 0xFF;
-        C[2] = (i >> 8) & 0xFF;
-        C[3] = i & 0xFF;
+        input[seed.length()] = static_cast<char>((i >> 24) & 0xFF);
+        input[seed.length() + 1] = static_cast<char>((i >> 16) & 0xFF);
+        input[seed.length() + 2] = static_cast<char>((i >> 8) & 0xFF);
+        input[seed.length() + 3] = static_cast<char>(i & 0xFF);
 
-        std::string computedHash = hash(hashAlg)(seed + std::string(reinterpret_cast<char*>(C), 4));
-        mask += computedHash;
+        digest(input.data(), input.length(), reinterpret_cast<uint8_t*>(&mask[i * hashLength]));
     }
 
-    return mask.substr(0, maskLen * 2); // mask is in hex, but we need bytes so we double the maskLen
-}
\ No newline at end of file
+    mask.resize(maskLen);
+    return mask;
+}
@@ -10,10 +10,131 @@
  * This file contains the implementation of Gestalts SHA1 security functions.
  */
 
+#include <cstring>
+#include <stdexcept>
+
 #include <gestalt/sha1.h>
 #include "sha1Core.h"
+#include "utils.h"
+
+// See reference [1] of sha1Core.cpp
+static const uint32_t SHA1_H[5] = { 0x67452301, 0xefcdab89, 0x98badcfe, 0x10325476, 0xc3d2e1f0 };
+
+SHA1::SHA1() {
+    reset();
+}
+
+/*
+ * Discards any message data and starts a new message.
+ */
+void SHA1::reset() {
+    memcpy(state, SHA1_H, sizeof(state));
+    bufferLen = 0;
+    totalLen = 0;
+}
+
+/*
+ * Adds message data. Whole blocks are compressed directly from data; only a trailing incomplete
+ * block is copied into the context.
+ *
+ * @param data The message bytes.
+ * @param length The number of bytes.
+ * @throws std::invalid_argument if the message grows beyond the 2^64 - 1 bits SHA-1 can encode.
+ */
+void SHA1::update(const void* data, size_t length) {
+    const uint8_t* in = static_cast<const uint8_t*>(data);
+
+    if (length > ((1ULL << 61) - 1) - totalLen) {
+        throw std::invalid_argument("Error: Given input for SHA1 is larger than 0 <= length < 2^64.");
+    }
+    totalLen += length;
+
+    if (bufferLen > 0) {
+        size_t take = length < BLOCK_SIZE - bufferLen ? length : BLOCK_SIZE - bufferLen;
+        memcpy(buffer + bufferLen, in, take);
+        bufferLen += take;
+        in += take;
+        length -= take;
+
+        if (bufferLen < BLOCK_SIZE) {
+            return;
+        }
+        sha1Compress(state, buffer, 1);
+        bufferLen = 0;
+    }
+
+    size_t numBlocks = length / BLOCK_SIZE;
+    if (numBlocks > 0) {
+        sha1Compress(state, in, numBlocks);
+        in += numBlocks * BLOCK_SIZE;
+        length -= numBlocks * BLOCK_SIZE;
+    }
+
+    memcpy(buffer, in, length);
+    bufferLen = length;
+}
+
+/*
+ * Pads the message, writes the digest and resets the context.
+ *
+ * The padding is a 1 bit, zeros, and the message length in bits as the last 8 bytes of the final
+ * block, built on the stack and spilling into a second block when the length does not fit after the
+ * message.
+ *
+ * @param out Output buffer of DIGEST_SIZE bytes.
+ */
+void SHA1::final(uint8_t* out) {
+    size_t numFinalBlocks = bufferLen + 1 > BLOCK_SIZE - 8 ? 2 : 1;
+    uint8_t finalBlocks[2 * BLOCK_SIZE];
+    uint8_t* lengthField = finalBlocks + numFinalBlocks * BLOCK_SIZE - 8;
+
+    memcpy(finalBlocks, buffer, bufferLen);
+    finalBlocks[bufferLen] = 0x80;
+    memset(finalBlocks + bufferLen + 1, 0, numFinalBlocks * BLOCK_SIZE - bufferLen - 1);
+    uint64_t bitLength = totalLen << 3;
+    for (size_t i = 0; i < 8; i++) {
+        lengthField[i] = static_cast<uint8_t>(bitLength >> (56 - 8 * i));
+    }
+    sha1Compress(state, finalBlocks, numFinalBlocks);
+
+    for (size_t i = 0; i < DIGEST_SIZE; i++) {
+        out[i] = static_cast<uint8_t>(state[i / 4] >> (24 - 8 * (i % 4)));
+    }
+
+    reset();
+}
+
+/*
+ * Generates the SHA-1 hash value for the input string.
+ *
+ * @param in The input string to be hashed.
+ * @return The SHA-1 hash value as a hexadecimal string.
+ */
+std::string SHA1::hash(const std::string& in) {
+    uint8_t digest[DIGEST_SIZE];
+
+    reset();
+    update(in);
+    final(digest);
+
+    return toHex(digest, DIGEST_SIZE);
+}
 
 std::string hashSHA1(const std::string& in) {
-    SHA1 SHA1object;
-    return SHA1object.hash(in);
-}
\ No newline at end of file
+    uint8_t digest[SHA1::DIGEST_SIZE];
+    digestSHA1(in.data(), in.size(), digest);
+    return toHex(digest, SHA1::DIGEST_SIZE);
+}
+
+/*
+ * Hashes a whole message with SHA-1.
+ *
+ * @param in The message.
+ * @param inLen The message length in bytes.
+ * @param digest Output buffer of SHA1::DIGEST_SIZE bytes.
+ */
+void digestSHA1(const void* in, size_t inLen, uint8_t* digest) {
+    SHA1 context;
+    context.update(in, inLen);
+    context.final(digest);
+}
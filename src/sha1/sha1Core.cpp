@@ -7,7 +7,7 @@
 /*
  * sha1Core.cpp
  *
- * This file contains the implementation of the SHA-1 (Secure Hash Algorithm 1) hashing function.
+ * This file contains the implementation of the SHA-1 (Secure Hash Algorithm 1) compression function.
  * SHA-1 is a cryptographic hash function that produces a 160-bit (20-byte) hash value, typically represented as a
  * 40-digit hexadecimal number. It is widely used in security applications and protocols, including TLS, SSL, SSH, and
  * IPsec.
@@ -19,40 +19,41 @@
  */
 
 #include "sha1Core.h"
-#include "../tools/utils.h"
 
-#include <iomanip>
-#include <sstream>
-
-
-SHA1::SHA1() {
-    // Constructor implementation, if needed
+/*
+ * Expands a 64 byte block into the 80 word message schedule.
+ */
+static void fillSha1Schedule(const uint8_t* in, uint32_t w[80]) {
+    for (int j = 0; j < 16; ++j) {
+        w[j] = (static_cast<uint32_t>(in[j * 4 + 0]) << 24) |
+               (static_cast<uint32_t>(in[j * 4 + 1]) << 16) |
+               (static_cast<uint32_t>(in[j * 4 + 2]) << 8) |
+               (static_cast<uint32_t>(in[j * 4 + 3]));
+    }
+    for (int j = 16; j < 80; ++j) {
+        uint32_t temp = w[j - 3] ^ w[j - 8] ^ w[j - 14] ^ w[j - 16];
+        w[j] = (temp << 1) | (temp >> 31);
+    }
 }
 
 /*
- * Generates the SHA-1 hash value for the input string.
+ * The portable SHA-1 compression function.
  *
- * @param in The input string to be hashed.
- * @return The SHA-1 hash value as a hexadecimal string.
+ * @param state The five hash words, updated in place.
+ * @param blocks The message blocks.
+ * @param numBlocks The number of 64 byte blocks.
  */
-std::string SHA1::hash(std::string in) {
-    reset();
-    applySha1Padding(in);
+void sha1CompressScalar(uint32_t state[5], const uint8_t* blocks, size_t numBlocks) {
+    for (size_t i = 0; i < numBlocks; i++) {
+        uint32_t w[80];
+        fillSha1Schedule(blocks + i * 64, w);
 
-    for (size_t i = 0; i < in.length(); i += 64) {
-        uint32_t w[BLOCK_SIZE];
-        
-        // Break the input into chunks of 64 bytes
-        std::string chunk = in.substr(i, 64);
-        // Fill SHA-1 block
-        fillBlock(chunk, w);
-        
         // Initialize hash value for this chunk
-        uint32_t a = h0;
-        uint32_t b = h1;
-        uint32_t c = h2;
-        uint32_t d = h3;
-        uint32_t e = h4;
+        uint32_t a = state[0];
+        uint32_t b = state[1];
+        uint32_t c = state[2];
+        uint32_t d = state[3];
+        uint32_t e = state[4];
 
         for (int j = 0; j < 80; ++j) {
             uint32_t f = 0, k = 0;
@@ -79,104 +80,20 @@ std::string SHA1::hash(std::string in) {
         }
 
         // Add this chunk's hash to result so far
-        h0 += a;
-        h1 += b;
-        h2 += c;
-        h3 += d;
-        h4 += e;
+        state[0] += a;
+        state[1] += b;
+        state[2] += c;
+        state[3] += d;
+        state[4] += e;
     }
-
-    return digest();
 }
 
-/*
- * Calculates the SHA-1 hash digest from the accumulated hash values.
- *
- * @return The SHA-1 hash digest as a hexadecimal string.
- */
-std::string SHA1::digest() {
-    uint8_t hashValue[20];
-    hashValue[0] = (h0 >> 24) & 0xFF;
-    hashValue[1] = (h0 >> 16) & 0xFF;
-    hashValue[2] = (h0 >> 8) & 0xFF;
-    hashValue[3] = h0 & 0xFF;
-    hashValue[4] = (h1 >> 24) & 0xFF;
-    hashValue[5] = (h1 >> 16) & 0xFF;
-    hashValue[6] = (h1 >> 8) & 0xFF;
-    hashValue[7] = h1 & 0xFF;
-    hashValue[8] = (h2 >> 24) & 0xFF;
-    hashValue[9] = (h2 >> 16) & 0xFF;
-    hashValue[10] = (h2 >> 8) & 0xFF;
-    hashValue[11] = h2 & 0xFF;
-    hashValue[12] = (h3 >> 24) & 0xFF;
-    hashValue[13] = (h3 >> 16) & 0xFF;
-    hashValue[14] = (h3 >> 8) & 0xFF;
-    hashValue[15] = h3 & 0xFF;
-    hashValue[16] = (h4 >> 24) & 0xFF;
-    hashValue[17] = (h4 >> 16) & 0xFF;
-    hashValue[18] = (h4 >> 8) & 0xFF;
-    hashValue[19] = h4 & 0xFF;
+void sha1Compress(uint32_t state[5], const uint8_t* blocks, size_t numBlocks) {
+    static const bool useNI = sha1NISupported();
 
-    std::ostringstream oss;
-    for (int i = 0; i < 20; ++i) {
-        oss << std::hex << std::setw(2) << std::setfill('0') << (int)hashValue[i];
+    if (useNI) {
+        sha1CompressNI(state, blocks, numBlocks);
+    } else {
+        sha1CompressScalar(state, blocks, numBlocks);
     }
-    return oss.str();
-}
-
-/*
- * Resets the internal hash state to its initial values.
- *
- * See reference [1] for details.
- */
-void SHA1::reset() {
-    h0 = 0x67452301;
-    h1 = 0xefcdab89;
-    h2 = 0x98badcfe;
-    h3 = 0x10325476;
-    h4 = 0xc3d2e1f0;
 }
-
-/*
- * Fills a 512-bit block with the input message data.
- *
- * @param in The input string from which data is filled into the block.
- * @param w The output block array.
- * @param index The starting index in the input string from which data is read.
- */
-void SHA1::fillBlock(std::string in, uint32_t w[BLOCK_SIZE]) {
-    for (int j = 0; j < 16; ++j) {
-        w[j] = ((in[j * 4 + 3] & 0xff)) |
-               ((in[j * 4 + 2] & 0xff) << 8) |
-               ((in[j * 4 + 1] & 0xff) << 16) |
-               ((in[j * 4 + 0] & 0xff) << 24);
-    }
-    for (int j = 16; j < 80; ++j) {
-        uint32_t temp = w[j - 3] ^ w[j - 8] ^ w[j - 14] ^ w[j - 16];
-        w[j] = (temp << 1) | (temp >> 31);
-    }
-}
-
-/*
- * Applies SHA-1 padding to the input string.
- *
- * @param in The input string to which padding is applied.
- */
-void SHA1::applySha1Padding(std::string& in) {
-    size_t messageLength = in.length() * 8;
-
-    // Add the '1' bit
-    in += (char)0x80;
-
-    // Append '0' bits until the padded message length is 64 bits less than 
-    // a multiple of 512
-    while ((in.length() % 64) != 56) {
-        in += (char)0x00;
-    }
-
-    // Append the length of the original message in bits as a 64-bit big-endian
-    // integer
-    for (int i = 7; i >= 0; --i) {
-        in += (char)((messageLength >> (i * 8)) & 0xFF);
-    }
-}
\ No newline at end of file
@@ -0,0 +1,124 @@
+/*
+ * Copyright 2023-2024 The Gestalt Project Authors. All Rights Reserved.
+ *
+ * Licensed under the MIT License. See the file LICENSE for the full text.
+ */
+
+/*
+ * sha1NI.cpp
+ *
+ * This file contains the SHA-1 compression function on the Intel SHA extensions.
+ *
+ * References:
+ * - "Intel SHA Extensions" white paper by Sean Gulley et al.
+ *
+ * SHA1RNDS4 performs four rounds on ABCD, using the round function selected by its immediate, and
+ * takes E already added to the four message words. SHA1NEXTE derives that next E from the ABCD of
+ * four rounds earlier and adds the message words. The schedule is computed four words at a time with
+ * SHA1MSG1, an XOR and SHA1MSG2. The twenty four-round groups are expanded at compile time, so the
+ * schedule words stay in registers.
+ *
+ * This translation unit is compiled with SHA extension code generation enabled and must only be
+ * entered after sha1NISupported() has returned true.
+ */
+
+#include "sha1Core.h"
+#include "cpu_features/cpu_features.h"
+
+#if defined(GESTALT_X86)
+
+#include <immintrin.h>
+
+bool sha1NISupported() {
+    const CPUFeatures& features = getCPUFeatures();
+    return features.sha && features.ssse3 && features.sse41;
+}
+
+/*
+ * Four rounds, G = 0..19 being the group, with the message schedule work that interleaves with them.
+ * m[G % 4] holds W[4G .. 4G + 3]. E alternates between e0 and e1: one feeds this group while the other
+ * keeps the ABCD it will be derived from.
+ */
+template <int G>
+static inline void rounds4(__m128i& abcd, __m128i& e0, __m128i& e1, __m128i m[4]) {
+    __m128i& e = G % 2 == 0 ? e0 : e1;
+    __m128i& saved = G % 2 == 0 ? e1 : e0;
+
+    if (G == 0) {
+        e = _mm_add_epi32(e, m[0]);
+    } else {
+        e = _mm_sha1nexte_epu32(e, m[G % 4]);
+    }
+    saved = abcd;
+
+    if (G >= 3 && G <= 18) {
+        m[(G + 1) % 4] = _mm_sha1msg2_epu32(m[(G + 1) % 4], m[G % 4]);
+    }
+
+    abcd = _mm_sha1rnds4_epu32(abcd, e, G / 5);
+
+    if (G >= 1 && G <= 16) {
+        m[(G + 3) % 4] = _mm_sha1msg1_epu32(m[(G + 3) % 4], m[G % 4]);
+    }
+    if (G >= 2 && G <= 17) {
+        m[(G + 2) % 4] = _mm_xor_si128(m[(G + 2) % 4], m[G % 4]);
+    }
+}
+
+void sha1CompressNI(uint32_t state[5], const uint8_t* blocks, size_t numBlocks) {
+    const __m128i byteSwap = _mm_set_epi64x(0x0001020304050607ULL, 0x08090a0b0c0d0e0fULL);
+
+    __m128i abcd = _mm_shuffle_epi32(_mm_loadu_si128(reinterpret_cast<const __m128i*>(state)), 0x1B);
+    __m128i e0 = _mm_set_epi32(static_cast<int>(state[4]), 0, 0, 0);
+    __m128i e1;
+
+    for (size_t i = 0; i < numBlocks; i++) {
+        const __m128i* block = reinterpret_cast<const __m128i*>(blocks + i * 64);
+        __m128i savedABCD = abcd;
+        __m128i savedE = e0;
+
+        __m128i m[4];
+        for (int j = 0; j < 4; j++) {
+            m[j] = _mm_shuffle_epi8(_mm_loadu_si128(block + j), byteSwap);
+        }
+
+        rounds4<0>(abcd, e0, e1, m);
+        rounds4<1>(abcd, e0, e1, m);
+        rounds4<2>(abcd, e0, e1, m);
+        rounds4<3>(abcd, e0, e1, m);
+        rounds4<4>(abcd, e0, e1, m);
+        rounds4<5>(abcd, e0, e1, m);
+        rounds4<6>(abcd, e0, e1, m);
+        rounds4<7>(abcd, e0, e1, m);
+        rounds4<8>(abcd, e0, e1, m);
+        rounds4<9>(abcd, e0, e1, m);
+        rounds4<10>(abcd, e0, e1, m);
+        rounds4<11>(abcd, e0, e1, m);
+        rounds4<12>(abcd, e0, e1, m);
+        rounds4<13>(abcd, e0, e1, m);
+        rounds4<14>(abcd, e0, e1, m);
+        rounds4<15>(abcd, e0, e1, m);
+        rounds4<16>(abcd, e0, e1, m);
+        rounds4<17>(abcd, e0, e1, m);
+        rounds4<18>(abcd, e0, e1, m);
+        rounds4<19>(abcd, e0, e1, m);
+
+        // e0 holds the ABCD of the last group, from which the final E follows
+        e0 = _mm_sha1nexte_epu32(e0, savedE);
+        abcd = _mm_add_epi32(abcd, savedABCD);
+    }
+
+    _mm_storeu_si128(reinterpret_cast<__m128i*>(state), _mm_shuffle_epi32(abcd, 0x1B));
+    state[4] = static_cast<uint32_t>(_mm_extract_epi32(e0, 3));
+}
+
+#else
+
+// The SHA extensions are x86 only; sha1NISupported keeps the backend unreachable elsewhere.
+bool sha1NISupported() {
+    return false;
+}
+
+void sha1CompressNI(uint32_t*, const uint8_t*, size_t) {}
+
+#endif
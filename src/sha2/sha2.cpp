@@ -10,158 +10,345 @@
  * This file contains the implementation of Gestalts SHA2 security functions.
  */
 
-#include <sstream>
-#include <iomanip>
-#include <climits>
+#include <cstring>
+#include <stdexcept>
 
 #include <gestalt/sha2.h>
+#include "sha2Core.h"
 #include "sha2Constants.h"
+#include "utils.h"
 
-#define ROTR(n, x) ((x >> n) | (x << (32 - n)))
-#define ROTR512(n, x) ((x >> n) | (x << (64 - n)))
+// The SHA-256 family counts message bits in 64 bits
+const uint64_t SHA256_MAX_MESSAGE_BYTES = (1ULL << 61) - 1;
 
-#define SHR(n, x) (x >> n)
-#define CH(x, y, z) ((x & y) ^ ((~x) & z))
-#define MAJ(x, y, z) ((x & y) ^ (x & z) ^ (y & z))
+static void compressBlocks(uint32_t state[8], const uint8_t* blocks, size_t numBlocks) {
+    sha256Compress(state, blocks, numBlocks);
+}
 
-inline uint32_t BSIG0(uint32_t x) { return ROTR(2, x) ^ ROTR(13, x) ^ ROTR(22, x); }
-inline uint32_t BSIG1(uint32_t x) { return ROTR(6, x) ^ ROTR(11, x) ^ ROTR(25, x); }
-inline uint32_t SSIG0(uint32_t x) { return ROTR(7, x)  ^ ROTR(18, x) ^ SHR(3, x); }
-inline uint32_t SSIG1(uint32_t x) { return ROTR(17, x) ^ ROTR(19, x) ^ SHR(10, x); }
+static void compressBlocks(uint64_t state[8], const uint8_t* blocks, size_t numBlocks) {
+    sha512Compress(state, blocks, numBlocks);
+}
 
-inline uint64_t BSIG0(uint64_t x) { return ROTR512(28, x) ^ ROTR512(34, x) ^ ROTR512(39, x); }
-inline uint64_t BSIG1(uint64_t x) { return ROTR512(14, x) ^ ROTR512(18, x) ^ ROTR512(41, x); }
-inline uint64_t SSIG0(uint64_t x) { return ROTR512(1, x)  ^ ROTR512(8, x)  ^ SHR(7, x); }
-inline uint64_t SSIG1(uint64_t x) { return ROTR512(19, x) ^ ROTR512(61, x) ^ SHR(6, x); }
+template <typename Word>
+SHA2Context<Word>::SHA2Context(const Word* initialState, size_t digestSize)
+    : initialState(initialState), digestSize(digestSize) {
+    reset();
+}
+
+/*
+ * Discards any message data and starts a new message.
+ */
+template <typename Word>
+void SHA2Context<Word>::reset() {
+    memcpy(state, initialState, sizeof(state));
+    bufferLen = 0;
+    totalLen = 0;
+}
 
-bool isValidSHA2Length(uint64_t length) {
-    return length >= 0 && length < ULLONG_MAX - 1;
+template <typename Word>
+void SHA2Context<Word>::compress(const uint8_t* blocks, size_t numBlocks) {
+    compressBlocks(state, blocks, numBlocks);
 }
 
-std::string applyPadding(const std::string& in, size_t wordSize) {
-    std::string out = in;
-    uint64_t bitLengthLow = static_cast<uint64_t>(in.length()) * 8;
-    uint64_t bitLengthHigh = (wordSize == 4) ? 0 : (static_cast<uint64_t>(in.length()) >> 61);
+/*
+ * Adds message data. Whole blocks are compressed directly from data; only a trailing incomplete
+ * block is copied into the context.
+ *
+ * @param data The message bytes.
+ * @param length The number of bytes.
+ * @throws std::invalid_argument if the message grows beyond the length the algorithm can encode.
+ */
+template <typename Word>
+void SHA2Context<Word>::update(const void* data, size_t length) {
+    const uint8_t* in = static_cast<const uint8_t*>(data);
 
-    // Validate input length against SHA-2 bounds
-    if (wordSize == 4 && !isValidSHA2Length(bitLengthLow))
+    if (sizeof(Word) == 4 && length > SHA256_MAX_MESSAGE_BYTES - totalLen) {
         throw std::invalid_argument("Error: Given input for SHA256 family is larger than 0 <= length < 2^64.");
-    if (wordSize == 8 && !isValidSHA2Length(bitLengthHigh))
+    }
+    if (sizeof(Word) == 8 && length > UINT64_MAX - totalLen) {
         throw std::invalid_argument("Error: Given input for SHA512 family is out of bounds 0 <= length < 2^128.");
-
-    out += (char)0x80; // apend that character '1'
-
-    // Append zeros until reaching the message length boundary
-    while ((out.length() % (wordSize * 16)) != 14 * wordSize) { // 14 * wordsize = wordSize * 16 - (wordSize * 2)
-        out += (char)0x00;
     }
+    totalLen += length;
 
-    // Append message length
-    if (wordSize == 8) { // Append high 64 bits if using SHA-512
-        for (int i = 7; i >= 0; --i) {
-            out += (char)((bitLengthHigh >> (i * 8)) & 0xFF);
+    if (bufferLen > 0) {
+        size_t take = length < BLOCK_SIZE - bufferLen ? length : BLOCK_SIZE - bufferLen;
+        memcpy(buffer + bufferLen, in, take);
+        bufferLen += take;
+        in += take;
+        length -= take;
+
+        if (bufferLen < BLOCK_SIZE) {
+            return;
         }
+        compress(buffer, 1);
+        bufferLen = 0;
     }
-    // Append low 64 bits in any case
-    for (int i = 7; i >= 0; --i) {
-        out += (char)((bitLengthLow >> (i * 8)) & 0xFF);
+
+    size_t numBlocks = length / BLOCK_SIZE;
+    if (numBlocks > 0) {
+        compress(in, numBlocks);
+        in += numBlocks * BLOCK_SIZE;
+        length -= numBlocks * BLOCK_SIZE;
     }
-    
-    return out;
+
+    memcpy(buffer, in, length);
+    bufferLen = length;
 }
 
 /*
- * Fills block to be hashed by SHA2 function.
- * @tparam T Type of the word (uint32_t or uint64_t).
- * @tparam NumOfWords Number of words in the W array (64 for SHA-256, 80 for SHA-512).
+ * Builds the final blocks of a message: the bytes after its last whole block, a 1 bit, zeros, and the
+ * message length in bits as the last 8 (SHA-256 family) or 16 (SHA-512 family) bytes. A second block
+ * is needed when the length does not fit after the message bytes.
+ *
+ * @param rest The message bytes after the last whole block.
+ * @param restLen The number of those bytes, less than one block.
+ * @param totalLen The length of the whole message in bytes.
+ * @param out Output buffer of two blocks.
+ * @result The number of blocks written, 1 or 2.
  */
-template<typename T, int NumOfWords>
-void fillBlock(const std::string& in, T W[NumOfWords]) {
-    size_t wordSize = sizeof(T);
-    
-    for (int i = 0; i < 16; ++i) {
-        W[i] = 0;
-        for (size_t j = 0; j < wordSize; j++) {
-            W[i] |= ((static_cast<T>(in[i * wordSize + j] & 0xFF)) << ((wordSize - 1 - j) * 8));
+template <typename Word>
+static size_t padFinalBlocks(const uint8_t* rest, size_t restLen, uint64_t totalLen, uint8_t* out) {
+    const size_t blockSize = 16 * sizeof(Word);
+    const size_t lengthSize = 2 * sizeof(Word);
+    const size_t numBlocks = restLen + 1 > blockSize - lengthSize ? 2 : 1;
+    uint8_t* lengthLow = out + numBlocks * blockSize - 8;
+
+    memcpy(out, rest, restLen);
+    out[restLen] = 0x80;
+    memset(out + restLen + 1, 0, numBlocks * blockSize - restLen - 1);
+
+    // Bit length, big-endian; the SHA-512 family's upper 64 bits only hold the top bits of the byte count
+    uint64_t bitLengthLow = totalLen << 3;
+    uint64_t bitLengthHigh = totalLen >> 61;
+    for (size_t i = 0; i < 8; i++) {
+        lengthLow[i] = static_cast<uint8_t>(bitLengthLow >> (56 - 8 * i));
+    }
+    if (sizeof(Word) == 8) {
+        uint8_t* lengthHigh = lengthLow - 8;
+        for (size_t i = 0; i < 8; i++) {
+            lengthHigh[i] = static_cast<uint8_t>(bitLengthHigh >> (56 - 8 * i));
         }
     }
 
-    for (int i = 16; i < NumOfWords; ++i) {
-        W[i] = SSIG1(W[i - 2]) + W[i - 7] + SSIG0(W[i - 15]) + W[i - 16];
-    }
+    return numBlocks;
 }
 
 /*
- * Computes SHA-2 hash for the input message.
- * @tparam T Type of the word (uint32_t or uint64_t).
- * @tparam NumOfWords Number of words in the W array (64 for SHA-256, 80 for SHA-512).
- * @tparam K Array of constants (K256 or K512).
- * @tparam HashSize Size of the hash output in bytes.
- * @param in The input message.
- * @param H Initial hash values.
- * @return The computed hash as a hex string.
+ * Writes the digest: the big-endian state truncated to the digest size, which for SHA-512/224 ends
+ * halfway through a word.
  */
-template<typename T, size_t NumOfWords, const std::array<T, NumOfWords>& K, size_t HashSize>
-std::string sha2(const std::string& in, std::array<T, 8> H) {
-    size_t wordSize = sizeof(T);
-    std::string msg = applyPadding(in, wordSize);
-
-    for (size_t i = 0; i < msg.length(); i += (wordSize == 4 ? 64 : 128)) {
-        T W[NumOfWords] = {0};
-        std::string chunk = msg.substr(i, (wordSize == 4 ? 64 : 128));
-        fillBlock<T, NumOfWords>(chunk, W);
-
-        // Initialize hash value for this chunk
-        T a = H[0], b = H[1], c = H[2], d = H[3], e = H[4], f = H[5], g = H[6], h = H[7];
-
-        for (size_t t = 0; t < NumOfWords; t++) {
-            T T1 = h + BSIG1(e) + CH(e, f, g) + K[t] + W[t];
-            T T2 = BSIG0(a) + MAJ(a, b, c);
-            h = g;
-            g = f;
-            f = e;
-            e = d + T1;
-            d = c;
-            c = b;
-            b = a;
-            a = T1 + T2;
+template <typename Word>
+static void storeDigest(const Word state[8], size_t digestSize, uint8_t* out) {
+    size_t i = 0;
+    for (; i + sizeof(Word) <= digestSize; i += sizeof(Word)) {
+        const Word word = state[i / sizeof(Word)];
+        for (size_t j = 0; j < sizeof(Word); j++) {
+            out[i + j] = static_cast<uint8_t>(word >> (8 * (sizeof(Word) - 1 - j)));
         }
+    }
+    for (; i < digestSize; i++) {
+        out[i] = static_cast<uint8_t>(state[i / sizeof(Word)] >> (8 * (sizeof(Word) - 1 - i % sizeof(Word))));
+    }
+}
+
+/*
+ * Pads the message, writes the digest and resets the context.
+ *
+ * @param out Output buffer of digestLength() bytes.
+ */
+template <typename Word>
+void SHA2Context<Word>::final(uint8_t* out) {
+    uint8_t finalBlocks[2 * BLOCK_SIZE];
+
+    compress(finalBlocks, padFinalBlocks<Word>(buffer, bufferLen, totalLen, finalBlocks));
+    storeDigest(state, digestSize, out);
+
+    reset();
+}
+
+template class SHA2Context<uint32_t>;
+template class SHA2Context<uint64_t>;
+
+SHA224::SHA224() : SHA2Context<uint32_t>(SHA_224_H.data(), DIGEST_SIZE) {}
+SHA256::SHA256() : SHA2Context<uint32_t>(SHA_256_H.data(), DIGEST_SIZE) {}
+SHA384::SHA384() : SHA2Context<uint64_t>(SHA_384_H.data(), DIGEST_SIZE) {}
+SHA512::SHA512() : SHA2Context<uint64_t>(SHA_512_H.data(), DIGEST_SIZE) {}
+SHA512_224::SHA512_224() : SHA2Context<uint64_t>(SHA_512_224_H.data(), DIGEST_SIZE) {}
+SHA512_256::SHA512_256() : SHA2Context<uint64_t>(SHA_512_256_H.data(), DIGEST_SIZE) {}
+
+/*
+ * Hashes a whole message with one of the contexts.
+ */
+template <typename Context>
+static void digestWith(const void* in, size_t inLen, uint8_t* digest) {
+    Context context;
+    context.update(in, inLen);
+    context.final(digest);
+}
 
-        H[0] += a;
-        H[1] += b;
-        H[2] += c;
-        H[3] += d;
-        H[4] += e;
-        H[5] += f;
-        H[6] += g;
-        H[7] += h;
+template <typename Context>
+static std::string hashHex(const std::string& in) {
+    uint8_t digest[Context::DIGEST_SIZE];
+    digestWith<Context>(in.data(), in.size(), digest);
+    return toHex(digest, Context::DIGEST_SIZE);
+}
+
+std::string hashSHA224    (const std::string& in) { return hashHex<SHA224>(in); }
+std::string hashSHA256    (const std::string& in) { return hashHex<SHA256>(in); }
+std::string hashSHA384    (const std::string& in) { return hashHex<SHA384>(in); }
+std::string hashSHA512    (const std::string& in) { return hashHex<SHA512>(in); }
+std::string hashSHA512_224(const std::string& in) { return hashHex<SHA512_224>(in); }
+std::string hashSHA512_256(const std::string& in) { return hashHex<SHA512_256>(in); }
+
+void digestSHA224    (const void* in, size_t inLen, uint8_t* digest) { digestWith<SHA224>(in, inLen, digest); }
+void digestSHA256    (const void* in, size_t inLen, uint8_t* digest) { digestWith<SHA256>(in, inLen, digest); }
+void digestSHA384    (const void* in, size_t inLen, uint8_t* digest) { digestWith<SHA384>(in, inLen, digest); }
+void digestSHA512    (const void* in, size_t inLen, uint8_t* digest) { digestWith<SHA512>(in, inLen, digest); }
+void digestSHA512_224(const void* in, size_t inLen, uint8_t* digest) { digestWith<SHA512_224>(in, inLen, digest); }
+void digestSHA512_256(const void* in, size_t inLen, uint8_t* digest) { digestWith<SHA512_256>(in, inLen, digest); }
+
+static size_t laneCount(SHA2LaneBackend backend, uint32_t) { return sha256LaneCount(backend); }
+static size_t laneCount(SHA2LaneBackend backend, uint64_t) { return sha512LaneCount(backend); }
+
+static void compressLanes(
+    SHA2LaneBackend backend, uint32_t* const* states, const uint8_t* const* blocks, size_t numLanes, size_t numBlocks
+) {
+    sha256CompressLanes(backend, states, blocks, numLanes, numBlocks);
+}
+
+static void compressLanes(
+    SHA2LaneBackend backend, uint64_t* const* states, const uint8_t* const* blocks, size_t numLanes, size_t numBlocks
+) {
+    sha512CompressLanes(backend, states, blocks, numLanes, numBlocks);
+}
+
+/*
+ * A message in flight in the multi-buffer hasher. Its whole blocks are compressed straight from the
+ * caller's buffer, followed by the padded final blocks built in the lane.
+ */
+template <typename Word>
+struct HashLane {
+    static const size_t BLOCK_SIZE = 16 * sizeof(Word);
+
+    const SHA2BatchItem* item = nullptr; // nullptr while the lane is free
+    Word state[8];
+    const uint8_t* next;                 // Next block to compress
+    size_t remainingBlocks;              // Blocks left at next
+    uint8_t finalBlocks[2 * BLOCK_SIZE];
+    size_t numFinalBlocks;               // Final blocks not yet started on
+
+    void start(const SHA2BatchItem* batchItem, const Word* initialState) {
+        item = batchItem;
+        memcpy(state, initialState, sizeof(state));
+
+        size_t wholeBlocks = item->inLen / BLOCK_SIZE;
+        numFinalBlocks = padFinalBlocks<Word>(
+            item->in + wholeBlocks * BLOCK_SIZE, item->inLen % BLOCK_SIZE, item->inLen, finalBlocks
+        );
+        next = item->in;
+        remainingBlocks = wholeBlocks;
+        advance(0);
     }
 
-    std::ostringstream oss;
-    uint8_t hashValue[HashSize] = {0};
-    for (size_t i = 0; i < HashSize / wordSize; i++) {
-        for (size_t j = 0; j < wordSize; j++) {
-            hashValue[i * wordSize + j] = (H[i] >> ((wordSize - 1 - j) * 8)) & 0xFF;
+    /*
+     * Moves past blocks just compressed, switching to the final blocks at the end of the message.
+     * @result true while the message has blocks left.
+     */
+    bool advance(size_t numBlocks) {
+        next += numBlocks * BLOCK_SIZE;
+        remainingBlocks -= numBlocks;
+        if (remainingBlocks == 0 && numFinalBlocks > 0) {
+            next = finalBlocks;
+            remainingBlocks = numFinalBlocks;
+            numFinalBlocks = 0;
         }
+        return remainingBlocks > 0;
     }
+};
 
-    // Handle special case that function call is SHA512_224
-    // I agree its ugly
-    if (wordSize == 8 && HashSize == 28) {
-        for (int i = 0; i < 4; ++i) {
-            hashValue[24 + i] = static_cast<uint8_t>((H[3] >> (56 - i * 8)) & 0xFF);
+/*
+ * Hashes a batch of independent messages.
+ *
+ * Every lane of the backend holds a message in flight. Every step compresses the number of blocks left
+ * in the shortest segment across the lanes, and a message that finishes frees its lane for the next
+ * item, so messages of different lengths keep the lanes full.
+ *
+ * @param initialState The algorithm's initial hash value.
+ * @param digestSize The algorithm's digest size in bytes.
+ * @param items The messages.
+ * @param count The number of items.
+ * @throws std::invalid_argument if a message is longer than the algorithm can encode. No digests are
+ *         written in that case.
+ */
+template <typename Word>
+static void hashBatch(const Word* initialState, size_t digestSize, const SHA2BatchItem* items, size_t count) {
+    for (size_t i = 0; i < count; i++) {
+        if (sizeof(Word) == 4 && items[i].inLen > SHA256_MAX_MESSAGE_BYTES) {
+            throw std::invalid_argument("Error: Given input for SHA256 family is larger than 0 <= length < 2^64.");
         }
     }
 
-    for (size_t i = 0; i < HashSize; i++) {
-        oss << std::hex << std::setw(2) << std::setfill('0') << (int)hashValue[i];
+    const SHA2LaneBackend backend = sizeof(Word) == 4 ? sha256LaneBackend() : sha512LaneBackend();
+    const size_t numLanes = laneCount(backend, Word());
+    HashLane<Word> lanes[SHA2_MAX_LANES];
+    size_t next = 0;
+
+    for (;;) {
+        Word* states[SHA2_MAX_LANES];
+        const uint8_t* blocks[SHA2_MAX_LANES];
+        HashLane<Word>* active[SHA2_MAX_LANES];
+        size_t numActive = 0;
+        size_t step = 0;
+
+        for (size_t lane = 0; lane < numLanes; lane++) {
+            if (lanes[lane].item == nullptr && next < count) {
+                lanes[lane].start(&items[next++], initialState);
+            }
+            if (lanes[lane].item == nullptr) {
+                continue;
+            }
+            if (numActive == 0 || lanes[lane].remainingBlocks < step) {
+                step = lanes[lane].remainingBlocks;
+            }
+            states[numActive] = lanes[lane].state;
+            blocks[numActive] = lanes[lane].next;
+            active[numActive++] = &lanes[lane];
+        }
+        if (numActive == 0) {
+            break;
+        }
+
+        compressLanes(backend, states, blocks, numActive, step);
+
+        for (size_t i = 0; i < numActive; i++) {
+            if (!active[i]->advance(step)) {
+                storeDigest(active[i]->state, digestSize, active[i]->item->digest);
+                active[i]->item = nullptr;
+            }
+        }
     }
-    return oss.str();
 }
 
-std::string hashSHA224    (const std::string& in) { return sha2<uint32_t, 64, K256, 28>(in, SHA_224_H); }
-std::string hashSHA256    (const std::string& in) { return sha2<uint32_t, 64, K256, 32>(in, SHA_256_H); }
-std::string hashSHA384    (const std::string& in) { return sha2<uint64_t, 80, K512, 48>(in, SHA_384_H); }
-std::string hashSHA512    (const std::string& in) { return sha2<uint64_t, 80, K512, 64>(in, SHA_512_H); }
-std::string hashSHA512_224(const std::string& in) { return sha2<uint64_t, 80, K512, 28>(in, SHA_512_224_H); }
-std::string hashSHA512_256(const std::string& in) { return sha2<uint64_t, 80, K512, 32>(in, SHA_512_256_H); }
\ No newline at end of file
+void hashSHA224Batch(const SHA2BatchItem* items, size_t count) {
+    hashBatch(SHA_224_H.data(), SHA224::DIGEST_SIZE, items, count);
+}
+
+void hashSHA256Batch(const SHA2BatchItem* items, size_t count) {
+    hashBatch(SHA_256_H.data(), SHA256::DIGEST_SIZE, items, count);
+}
+
+void hashSHA384Batch(const SHA2BatchItem* items, size_t count) {
+    hashBatch(SHA_384_H.data(), SHA384::DIGEST_SIZE, items, count);
+}
+
+void hashSHA512Batch(const SHA2BatchItem* items, size_t count) {
+    hashBatch(SHA_512_H.data(), SHA512::DIGEST_SIZE, items, count);
+}
+
+void hashSHA512_224Batch(const SHA2BatchItem* items, size_t count) {
+    hashBatch(SHA_512_224_H.data(), SHA512_224::DIGEST_SIZE, items, count);
+}
+
+void hashSHA512_256Batch(const SHA2BatchItem* items, size_t count) {
+    hashBatch(SHA_512_256_H.data(), SHA512_256::DIGEST_SIZE, items, count);
+}
@@ -0,0 +1,117 @@
+/*
+ * Copyright 2023-2024 The Gestalt Project Authors. All Rights Reserved.
+ *
+ * Licensed under the MIT License. See the file LICENSE for the full text.
+ */
+
+/*
+ * sha256NI.cpp
+ *
+ * This file contains the SHA-256 compression function on the Intel SHA extensions.
+ *
+ * References:
+ * - "Intel SHA Extensions" white paper by Sean Gulley et al.
+ *
+ * SHA256RNDS2 performs two rounds on the state held as the register pair ABEF and CDGH, taking the
+ * two W + K words from the low half of its third operand, so every four rounds are two instructions
+ * with the message words shifted down in between. SHA256MSG1 and SHA256MSG2 compute the message
+ * schedule four words at a time; the W[t - 7] term between them comes from PALIGNR. The sixteen
+ * four-round groups are expanded at compile time, so the schedule words stay in registers.
+ *
+ * This translation unit is compiled with SHA extension code generation enabled and must only be
+ * entered after sha256NISupported() has returned true.
+ */
+
+#include <array>
+
+#include "sha2Core.h"
+#include "sha2Constants.h"
+#include "cpu_features/cpu_features.h"
+
+#if defined(GESTALT_X86)
+
+#include <immintrin.h>
+
+bool sha256NISupported() {
+    const CPUFeatures& features = getCPUFeatures();
+    return features.sha && features.ssse3 && features.sse41;
+}
+
+/*
+ * Four rounds, I = 0..15 being the group, with the message schedule work that interleaves with them:
+ * the SHA256MSG2 completing the words four groups ahead and the SHA256MSG1 starting the ones after.
+ * m[I % 4] holds W[4I .. 4I + 3].
+ */
+template <int I>
+static inline void rounds4(__m128i& state0, __m128i& state1, __m128i m[4]) {
+    __m128i msg = _mm_add_epi32(m[I % 4], _mm_loadu_si128(reinterpret_cast<const __m128i*>(K256.data() + 4 * I)));
+    state1 = _mm_sha256rnds2_epu32(state1, state0, msg);
+
+    if (I >= 3 && I <= 14) {
+        __m128i next = _mm_add_epi32(m[(I + 1) % 4], _mm_alignr_epi8(m[I % 4], m[(I + 3) % 4], 4));
+        m[(I + 1) % 4] = _mm_sha256msg2_epu32(next, m[I % 4]);
+    }
+
+    state0 = _mm_sha256rnds2_epu32(state0, state1, _mm_shuffle_epi32(msg, 0x0E));
+
+    if (I >= 1 && I <= 12) {
+        m[(I + 3) % 4] = _mm_sha256msg1_epu32(m[(I + 3) % 4], m[I % 4]);
+    }
+}
+
+void sha256CompressNI(uint32_t state[8], const uint8_t* blocks, size_t numBlocks) {
+    const __m128i byteSwap = _mm_set_epi64x(0x0c0d0e0f08090a0bULL, 0x0405060700010203ULL);
+
+    // Rearrange the state from ABCD EFGH into the ABEF and CDGH pairs the instructions use
+    __m128i cdab = _mm_shuffle_epi32(_mm_loadu_si128(reinterpret_cast<const __m128i*>(state)), 0xB1);
+    __m128i efgh = _mm_shuffle_epi32(_mm_loadu_si128(reinterpret_cast<const __m128i*>(state + 4)), 0x1B);
+    __m128i state0 = _mm_alignr_epi8(cdab, efgh, 8);
+    __m128i state1 = _mm_blend_epi16(efgh, cdab, 0xF0);
+
+    for (size_t i = 0; i < numBlocks; i++) {
+        const __m128i* block = reinterpret_cast<const __m128i*>(blocks + i * SHA256_BLOCK_SIZE);
+        __m128i savedState0 = state0;
+        __m128i savedState1 = state1;
+
+        __m128i m[4];
+        for (int j = 0; j < 4; j++) {
+            m[j] = _mm_shuffle_epi8(_mm_loadu_si128(block + j), byteSwap);
+        }
+
+        rounds4<0>(state0, state1, m);
+        rounds4<1>(state0, state1, m);
+        rounds4<2>(state0, state1, m);
+        rounds4<3>(state0, state1, m);
+        rounds4<4>(state0, state1, m);
+        rounds4<5>(state0, state1, m);
+        rounds4<6>(state0, state1, m);
+        rounds4<7>(state0, state1, m);
+        rounds4<8>(state0, state1, m);
+        rounds4<9>(state0, state1, m);
+        rounds4<10>(state0, state1, m);
+        rounds4<11>(state0, state1, m);
+        rounds4<12>(state0, state1, m);
+        rounds4<13>(state0, state1, m);
+        rounds4<14>(state0, state1, m);
+        rounds4<15>(state0, state1, m);
+
+        state0 = _mm_add_epi32(state0, savedState0);
+        state1 = _mm_add_epi32(state1, savedState1);
+    }
+
+    __m128i feba = _mm_shuffle_epi32(state0, 0x1B);
+    __m128i dchg = _mm_shuffle_epi32(state1, 0xB1);
+    _mm_storeu_si128(reinterpret_cast<__m128i*>(state), _mm_blend_epi16(feba, dchg, 0xF0));
+    _mm_storeu_si128(reinterpret_cast<__m128i*>(state + 4), _mm_alignr_epi8(dchg, feba, 8));
+}
+
+#else
+
+// The SHA extensions are x86 only; sha256NISupported keeps the backend unreachable elsewhere.
+bool sha256NISupported() {
+    return false;
+}
+
+void sha256CompressNI(uint32_t*, const uint8_t*, size_t) {}
+
+#endif
@@ -0,0 +1,285 @@
+/*
+ * Copyright 2023-2024 The Gestalt Project Authors. All Rights Reserved.
+ *
+ * Licensed under the MIT License. See the file LICENSE for the full text.
+ */
+
+/*
+ * sha2Core.cpp
+ *
+ * This file contains the implementation of the SHA-2 compression functions.
+ */
+
+#include <array>
+#include <cstring>
+
+#include "sha2Core.h"
+#include "sha2Constants.h"
+
+// The unrolled rounds below are only fast when every one of them is inlined into compress
+#if defined(__GNUC__)
+#define SHA2_INLINE inline __attribute__((always_inline))
+#elif defined(_MSC_VER)
+#define SHA2_INLINE __forceinline
+#else
+#define SHA2_INLINE inline
+#endif
+
+#define ROTR(n, x) ((x >> n) | (x << (32 - n)))
+#define ROTR512(n, x) ((x >> n) | (x << (64 - n)))
+
+#define SHR(n, x) (x >> n)
+#define CH(x, y, z) ((x & y) ^ ((~x) & z))
+#define MAJ(x, y, z) ((x & y) ^ (x & z) ^ (y & z))
+
+inline uint32_t BSIG0(uint32_t x) { return ROTR(2, x) ^ ROTR(13, x) ^ ROTR(22, x); }
+inline uint32_t BSIG1(uint32_t x) { return ROTR(6, x) ^ ROTR(11, x) ^ ROTR(25, x); }
+inline uint32_t SSIG0(uint32_t x) { return ROTR(7, x)  ^ ROTR(18, x) ^ SHR(3, x); }
+inline uint32_t SSIG1(uint32_t x) { return ROTR(17, x) ^ ROTR(19, x) ^ SHR(10, x); }
+
+inline uint64_t BSIG0(uint64_t x) { return ROTR512(28, x) ^ ROTR512(34, x) ^ ROTR512(39, x); }
+inline uint64_t BSIG1(uint64_t x) { return ROTR512(14, x) ^ ROTR512(18, x) ^ ROTR512(41, x); }
+inline uint64_t SSIG0(uint64_t x) { return ROTR512(1, x)  ^ ROTR512(8, x)  ^ SHR(7, x); }
+inline uint64_t SSIG1(uint64_t x) { return ROTR512(19, x) ^ ROTR512(61, x) ^ SHR(6, x); }
+
+/*
+ * Reads a big-endian word. With GCC and Clang this is a single load and byte swap.
+ */
+template <typename T>
+static SHA2_INLINE T loadBigEndian(const uint8_t* in) {
+#if defined(__GNUC__)
+    T word;
+    memcpy(&word, in, sizeof(T));
+#if __BYTE_ORDER__ == __ORDER_LITTLE_ENDIAN__
+    word = sizeof(T) == 4 ? static_cast<T>(__builtin_bswap32(static_cast<uint32_t>(word)))
+                          : static_cast<T>(__builtin_bswap64(static_cast<uint64_t>(word)));
+#endif
+    return word;
+#else
+    T word = 0;
+    for (size_t j = 0; j < sizeof(T); j++) {
+        word = (word << 8) | in[j];
+    }
+    return word;
+#endif
+}
+
+/*
+ * Round t of the compression function.
+ *
+ * The working variables stay in place and their roles rotate instead: at round t, a is v[-t mod 8],
+ * b is v[1 - t mod 8] and so on, so a round only writes the new e (into d) and the new a (into h).
+ * The message schedule is a window of the last 16 words, loaded from the block in the first 16
+ * rounds and extended one word per round after that. t is a template parameter, so every index is
+ * a constant and the variables and the window can live in registers.
+ *
+ * @tparam T Type of the word (uint32_t or uint64_t).
+ * @tparam t The round number.
+ * @tparam NumOfWords Number of rounds (64 for SHA-256, 80 for SHA-512).
+ * @tparam K Array of constants (K256 or K512).
+ */
+template <typename T, size_t t, size_t NumOfWords, const std::array<T, NumOfWords>& K>
+static SHA2_INLINE void round(T v[8], T W[16], const uint8_t* block) {
+    const T& a = v[(8 - t % 8) % 8];
+    const T& b = v[(9 - t % 8) % 8];
+    const T& c = v[(10 - t % 8) % 8];
+    T& d = v[(11 - t % 8) % 8];
+    const T& e = v[(12 - t % 8) % 8];
+    const T& f = v[(13 - t % 8) % 8];
+    const T& g = v[(14 - t % 8) % 8];
+    T& h = v[(15 - t % 8) % 8];
+
+    if (t < 16) {
+        W[t % 16] = loadBigEndian<T>(block + t * sizeof(T));
+    } else {
+        W[t % 16] += SSIG1(W[(t - 2) % 16]) + W[(t - 7) % 16] + SSIG0(W[(t - 15) % 16]);
+    }
+
+    T T1 = h + BSIG1(e) + CH(e, f, g) + K[t] + W[t % 16];
+    T T2 = BSIG0(a) + MAJ(a, b, c);
+    d += T1;
+    h = T1 + T2;
+}
+
+/*
+ * Expands rounds t to NumOfWords - 1 at compile time.
+ */
+template <typename T, size_t t, size_t NumOfWords, const std::array<T, NumOfWords>& K>
+struct Rounds {
+    static SHA2_INLINE void run(T v[8], T W[16], const uint8_t* block) {
+        round<T, t, NumOfWords, K>(v, W, block);
+        Rounds<T, t + 1, NumOfWords, K>::run(v, W, block);
+    }
+};
+
+template <typename T, size_t NumOfWords, const std::array<T, NumOfWords>& K>
+struct Rounds<T, NumOfWords, NumOfWords, K> {
+    static inline void run(T*, T*, const uint8_t*) {}
+};
+
+/*
+ * Runs the SHA-2 compression function over consecutive message blocks.
+ * @tparam T Type of the word (uint32_t or uint64_t).
+ * @tparam NumOfWords Number of rounds (64 for SHA-256, 80 for SHA-512).
+ * @tparam K Array of constants (K256 or K512).
+ * @param H The hash state, updated in place.
+ * @param blocks The message blocks, 16 words each.
+ * @param numBlocks The number of blocks.
+ */
+template<typename T, size_t NumOfWords, const std::array<T, NumOfWords>& K>
+static void compress(T H[8], const uint8_t* blocks, size_t numBlocks) {
+    const size_t blockSize = 16 * sizeof(T);
+
+    for (size_t i = 0; i < numBlocks; i++) {
+        T v[8] = { H[0], H[1], H[2], H[3], H[4], H[5], H[6], H[7] };
+        T W[16];
+
+        // The round count is a multiple of 8, so the roles end where they started
+        Rounds<T, 0, NumOfWords, K>::run(v, W, blocks + i * blockSize);
+
+        for (size_t j = 0; j < 8; j++) {
+            H[j] += v[j];
+        }
+    }
+}
+
+void sha256CompressScalar(uint32_t state[8], const uint8_t* blocks, size_t numBlocks) {
+    compress<uint32_t, 64, K256>(state, blocks, numBlocks);
+}
+
+void sha256Compress(uint32_t state[8], const uint8_t* blocks, size_t numBlocks) {
+    static const bool useNI = sha256NISupported();
+
+    if (useNI) {
+        sha256CompressNI(state, blocks, numBlocks);
+    } else {
+        sha256CompressScalar(state, blocks, numBlocks);
+    }
+}
+
+void sha512Compress(uint64_t state[8], const uint8_t* blocks, size_t numBlocks) {
+    compress<uint64_t, 80, K512>(state, blocks, numBlocks);
+}
+
+bool isSHA2LaneBackendSupported(SHA2LaneBackend backend) {
+    switch (backend) {
+    case SHA2LaneBackend::SSE41:
+        return sha2LanesSSE41Supported();
+    case SHA2LaneBackend::AVX2:
+        return sha2LanesAVX2Supported();
+    case SHA2LaneBackend::AVX512:
+        return sha2LanesAVX512Supported();
+    default:
+        return true;
+    }
+}
+
+/*
+ * Returns the widest lane backend the CPU supports.
+ */
+static SHA2LaneBackend widestLaneBackend() {
+    if (sha2LanesAVX512Supported()) return SHA2LaneBackend::AVX512;
+    if (sha2LanesAVX2Supported()) return SHA2LaneBackend::AVX2;
+    if (sha2LanesSSE41Supported()) return SHA2LaneBackend::SSE41;
+    return SHA2LaneBackend::Scalar;
+}
+
+/*
+ * Returns the backend the batch functions use for SHA-256. The SHA extensions hash one message about
+ * as fast as eight AVX2 lanes, so with them only AVX-512 is worth batching for.
+ */
+static SHA2LaneBackend chooseSHA256LaneBackend() {
+    if (sha256NISupported() && !sha2LanesAVX512Supported()) {
+        return SHA2LaneBackend::Scalar;
+    }
+    return widestLaneBackend();
+}
+
+SHA2LaneBackend sha256LaneBackend() {
+    static const SHA2LaneBackend backend = chooseSHA256LaneBackend();
+    return backend;
+}
+
+/*
+ * Returns the backend the batch functions use for SHA-512.
+ */
+SHA2LaneBackend sha512LaneBackend() {
+    static const SHA2LaneBackend backend = widestLaneBackend();
+    return backend;
+}
+
+size_t sha256LaneCount(SHA2LaneBackend backend) {
+    switch (backend) {
+    case SHA2LaneBackend::SSE41: return 4;
+    case SHA2LaneBackend::AVX2: return 8;
+    case SHA2LaneBackend::AVX512: return 16;
+    default: return 1;
+    }
+}
+
+size_t sha512LaneCount(SHA2LaneBackend backend) {
+    switch (backend) {
+    case SHA2LaneBackend::SSE41: return 2;
+    case SHA2LaneBackend::AVX2: return 4;
+    case SHA2LaneBackend::AVX512: return 8;
+    default: return 1;
+    }
+}
+
+/*
+ * Compresses numBlocks consecutive blocks of each of numLanes independent SHA-256 messages.
+ *
+ * @param backend The lane backend, which must be supported.
+ * @param states The hash state of every message, updated in place.
+ * @param blocks The blocks of every message.
+ * @param numLanes The number of messages, at most sha256LaneCount(backend).
+ * @param numBlocks The number of blocks of each message.
+ */
+void sha256CompressLanes(
+    SHA2LaneBackend backend, uint32_t* const* states, const uint8_t* const* blocks, size_t numLanes, size_t numBlocks
+) {
+    switch (backend) {
+    case SHA2LaneBackend::SSE41:
+        sha256CompressLanesSSE41(states, blocks, numLanes, numBlocks);
+        break;
+    case SHA2LaneBackend::AVX2:
+        sha256CompressLanesAVX2(states, blocks, numLanes, numBlocks);
+        break;
+    case SHA2LaneBackend::AVX512:
+        sha256CompressLanesAVX512(states, blocks, numLanes, numBlocks);
+        break;
+    default:
+        for (size_t lane = 0; lane < numLanes; lane++) {
+            sha256Compress(states[lane], blocks[lane], numBlocks);
+        }
+    }
+}
+
+/*
+ * Compresses numBlocks consecutive blocks of each of numLanes independent SHA-512 messages.
+ *
+ * @param backend The lane backend, which must be supported.
+ * @param states The hash state of every message, updated in place.
+ * @param blocks The blocks of every message.
+ * @param numLanes The number of messages, at most sha512LaneCount(backend).
+ * @param numBlocks The number of blocks of each message.
+ */
+void sha512CompressLanes(
+    SHA2LaneBackend backend, uint64_t* const* states, const uint8_t* const* blocks, size_t numLanes, size_t numBlocks
+) {
+    switch (backend) {
+    case SHA2LaneBackend::SSE41:
+        sha512CompressLanesSSE41(states, blocks, numLanes, numBlocks);
+        break;
+    case SHA2LaneBackend::AVX2:
+        sha512CompressLanesAVX2(states, blocks, numLanes, numBlocks);
+        break;
+    case SHA2LaneBackend::AVX512:
+        sha512CompressLanesAVX512(states, blocks, numLanes, numBlocks);
+        break;
+    default:
+        for (size_t lane = 0; lane < numLanes; lane++) {
+            sha512Compress(states[lane], blocks[lane], numBlocks);
+        }
+    }
+}
@@ -0,0 +1,69 @@
+/*
+ * Copyright 2023-2024 The Gestalt Project Authors. All Rights Reserved.
+ *
+ * Licensed under the MIT License. See the file LICENSE for the full text.
+ */
+
+/*
+ * sha2Core.h
+ *
+ * This file contains the declarations of the SHA-2 compression functions. They process whole message
+ * blocks read directly from the caller's buffer; padding and buffering of partial blocks are left to
+ * the contexts in sha2.cpp.
+ *
+ * sha256Compress runs on the SHA extensions when the executing CPU has them and on the portable code
+ * otherwise. The backends are declared separately so they can be tested against each other.
+ *
+ * The lane functions compress several independent messages at once, one per vector lane. Every lane
+ * backend takes up to its lane count of messages and the same number of blocks from each.
+ */
+
+#pragma once
+
+#include <cstddef>
+#include <cstdint>
+
+const size_t SHA256_BLOCK_SIZE = 64;  // SHA-224 and SHA-256
+const size_t SHA512_BLOCK_SIZE = 128; // SHA-384, SHA-512, SHA-512/224 and SHA-512/256
+
+void sha256Compress(uint32_t state[8], const uint8_t* blocks, size_t numBlocks);
+void sha512Compress(uint64_t state[8], const uint8_t* blocks, size_t numBlocks);
+
+void sha256CompressScalar(uint32_t state[8], const uint8_t* blocks, size_t numBlocks);
+
+bool sha256NISupported();
+void sha256CompressNI(uint32_t state[8], const uint8_t* blocks, size_t numBlocks);
+
+enum class SHA2LaneBackend {
+    Scalar, // One message at a time through sha256Compress and sha512Compress
+    SSE41,  // 4 SHA-256 or 2 SHA-512 lanes
+    AVX2,   // 8 SHA-256 or 4 SHA-512 lanes
+    AVX512  // 16 SHA-256 or 8 SHA-512 lanes
+};
+
+const size_t SHA2_MAX_LANES = 16;
+
+bool isSHA2LaneBackendSupported(SHA2LaneBackend backend);
+SHA2LaneBackend sha256LaneBackend();
+SHA2LaneBackend sha512LaneBackend();
+size_t sha256LaneCount(SHA2LaneBackend backend);
+size_t sha512LaneCount(SHA2LaneBackend backend);
+
+void sha256CompressLanes(
+    SHA2LaneBackend backend, uint32_t* const* states, const uint8_t* const* blocks, size_t numLanes, size_t numBlocks
+);
+void sha512CompressLanes(
+    SHA2LaneBackend backend, uint64_t* const* states, const uint8_t* const* blocks, size_t numLanes, size_t numBlocks
+);
+
+bool sha2LanesSSE41Supported();
+void sha256CompressLanesSSE41(uint32_t* const* states, const uint8_t* const* blocks, size_t numLanes, size_t numBlocks);
+void sha512CompressLanesSSE41(uint64_t* const* states, const uint8_t* const* blocks, size_t numLanes, size_t numBlocks);
+
+bool sha2LanesAVX2Supported();
+void sha256CompressLanesAVX2(uint32_t* const* states, const uint8_t* const* blocks, size_t numLanes, size_t numBlocks);
+void sha512CompressLanesAVX2(uint64_t* const* states, const uint8_t* const* blocks, size_t numLanes, size_t numBlocks);
+
+bool sha2LanesAVX512Supported();
+void sha256CompressLanesAVX512(uint32_t* const* states, const uint8_t* const* blocks, size_t numLanes, size_t numBlocks);
+void sha512CompressLanesAVX512(uint64_t* const* states, const uint8_t* const* blocks, size_t numLanes, size_t numBlocks);
@@ -0,0 +1,148 @@
+/*
+ * Copyright 2023-2024 The Gestalt Project Authors. All Rights Reserved.
+ *
+ * Licensed under the MIT License. See the file LICENSE for the full text.
+ */
+
+/*
+ * sha2Lanes.h
+ *
+ * This file contains the multi-buffer SHA-2 compression function, which runs one independent message
+ * in every lane of a vector. Lane i of every state and schedule vector belongs to message i, so the
+ * rounds are the scalar rounds applied to whole vectors and no shuffling is needed between them.
+ *
+ * The code is written against the GCC and Clang vector extensions and instantiated in one translation
+ * unit per vector width, each compiled for its instruction set.
+ */
+
+#pragma once
+
+#include <array>
+#include <cstring>
+
+#include "sha2Core.h"
+#include "sha2Constants.h"
+
+// Everything here has internal linkage: each vector translation unit is compiled for a different
+// instruction set, so no copy of these helpers may be shared between them by the linker.
+namespace {
+
+template <typename Word, typename Vec>
+static inline Vec rotateRight(Vec x, int n) {
+    return (x >> n) | (x << (static_cast<int>(8 * sizeof(Word)) - n));
+}
+
+template <typename Word>
+struct SHA2LaneFunctions;
+
+template <>
+struct SHA2LaneFunctions<uint32_t> {
+    template <typename Vec> static Vec bsig0(Vec x) { return rotateRight<uint32_t>(x, 2) ^ rotateRight<uint32_t>(x, 13) ^ rotateRight<uint32_t>(x, 22); }
+    template <typename Vec> static Vec bsig1(Vec x) { return rotateRight<uint32_t>(x, 6) ^ rotateRight<uint32_t>(x, 11) ^ rotateRight<uint32_t>(x, 25); }
+    template <typename Vec> static Vec ssig0(Vec x) { return rotateRight<uint32_t>(x, 7) ^ rotateRight<uint32_t>(x, 18) ^ (x >> 3); }
+    template <typename Vec> static Vec ssig1(Vec x) { return rotateRight<uint32_t>(x, 17) ^ rotateRight<uint32_t>(x, 19) ^ (x >> 10); }
+
+    static uint32_t loadBigEndian(const uint8_t* in) {
+        uint32_t word;
+        memcpy(&word, in, sizeof(word));
+        return __builtin_bswap32(word);
+    }
+};
+
+template <>
+struct SHA2LaneFunctions<uint64_t> {
+    template <typename Vec> static Vec bsig0(Vec x) { return rotateRight<uint64_t>(x, 28) ^ rotateRight<uint64_t>(x, 34) ^ rotateRight<uint64_t>(x, 39); }
+    template <typename Vec> static Vec bsig1(Vec x) { return rotateRight<uint64_t>(x, 14) ^ rotateRight<uint64_t>(x, 18) ^ rotateRight<uint64_t>(x, 41); }
+    template <typename Vec> static Vec ssig0(Vec x) { return rotateRight<uint64_t>(x, 1) ^ rotateRight<uint64_t>(x, 8) ^ (x >> 7); }
+    template <typename Vec> static Vec ssig1(Vec x) { return rotateRight<uint64_t>(x, 19) ^ rotateRight<uint64_t>(x, 61) ^ (x >> 6); }
+
+    static uint64_t loadBigEndian(const uint8_t* in) {
+        uint64_t word;
+        memcpy(&word, in, sizeof(word));
+        return __builtin_bswap64(word);
+    }
+};
+
+/*
+ * Runs the SHA-2 compression function over numBlocks consecutive blocks of up to Lanes messages at once.
+ * Lanes beyond numLanes repeat the blocks of lane 0 and their results are discarded. The vector
+ * translation units are x86 only, so words are loaded little-endian and byte swapped.
+ *
+ * @tparam Vec Vector of Lanes words.
+ * @tparam Word Type of the word (uint32_t or uint64_t).
+ * @tparam Lanes Number of words in Vec.
+ * @tparam NumOfWords Number of words in the message schedule (64 for SHA-256, 80 for SHA-512).
+ * @param states The hash state of every message, updated in place.
+ * @param blocks The blocks of every message.
+ * @param numLanes The number of messages, at most Lanes.
+ * @param numBlocks The number of blocks of each message.
+ * @param K Array of constants (K256 or K512).
+ */
+template <typename Vec, typename Word, size_t Lanes, size_t NumOfWords>
+static inline void compressLanes(
+    Word* const* states, const uint8_t* const* blocks, size_t numLanes, size_t numBlocks, const std::array<Word, NumOfWords>& K
+) {
+    typedef SHA2LaneFunctions<Word> F;
+    const size_t blockSize = 16 * sizeof(Word);
+
+    // Copied out rather than indexed through std::array, whose accessors are shared weak symbols
+    Word k[NumOfWords];
+    static_assert(sizeof(K) == sizeof(k), "std::array must hold exactly its elements");
+    memcpy(k, &K, sizeof(k));
+
+    const uint8_t* in[Lanes];
+    Vec H[8];
+    for (size_t lane = 0; lane < Lanes; lane++) {
+        in[lane] = blocks[lane < numLanes ? lane : 0];
+    }
+    for (size_t i = 0; i < 8; i++) {
+        for (size_t lane = 0; lane < Lanes; lane++) {
+            H[i][lane] = lane < numLanes ? states[lane][i] : 0;
+        }
+    }
+
+    for (size_t block = 0; block < numBlocks; block++) {
+        // The schedule is kept as a window of the last 16 words
+        Vec W[16];
+        for (size_t i = 0; i < 16; i++) {
+            for (size_t lane = 0; lane < Lanes; lane++) {
+                W[i][lane] = F::loadBigEndian(in[lane] + block * blockSize + i * sizeof(Word));
+            }
+        }
+
+        Vec a = H[0], b = H[1], c = H[2], d = H[3], e = H[4], f = H[5], g = H[6], h = H[7];
+
+        for (size_t t = 0; t < NumOfWords; t++) {
+            if (t >= 16) {
+                W[t & 15] += F::ssig1(W[(t - 2) & 15]) + W[(t - 7) & 15] + F::ssig0(W[(t - 15) & 15]);
+            }
+            Vec T1 = h + F::bsig1(e) + ((e & f) ^ (~e & g)) + k[t] + W[t & 15];
+            Vec T2 = F::bsig0(a) + ((a & b) ^ (a & c) ^ (b & c));
+            h = g;
+            g = f;
+            f = e;
+            e = d + T1;
+            d = c;
+            c = b;
+            b = a;
+            a = T1 + T2;
+        }
+
+        H[0] += a;
+        H[1] += b;
+        H[2] += c;
+        H[3] += d;
+        H[4] += e;
+        H[5] += f;
+        H[6] += g;
+        H[7] += h;
+    }
+
+    for (size_t i = 0; i < 8; i++) {
+        for (size_t lane = 0; lane < numLanes; lane++) {
+            states[lane][i] = H[i][lane];
+        }
+    }
+}
+
+} // namespace
@@ -0,0 +1,49 @@
+/*
+ * Copyright 2023-2024 The Gestalt Project Authors. All Rights Reserved.
+ *
+ * Licensed under the MIT License. See the file LICENSE for the full text.
+ */
+
+/*
+ * sha2LanesAVX2.cpp
+ *
+ * This file contains the 256-bit instantiation of the multi-buffer SHA-2 compression in sha2Lanes.h:
+ * 8 SHA-256 or 4 SHA-512 messages per vector.
+ *
+ * This translation unit is compiled with AVX2 code generation enabled and must only be entered after
+ * isSHA2LaneBackendSupported(SHA2LaneBackend::AVX2) has returned true.
+ */
+
+#include "sha2Core.h"
+#include "cpu_features/cpu_features.h"
+
+#if defined(GESTALT_X86) && defined(__GNUC__)
+
+#include "sha2Lanes.h"
+
+typedef uint32_t SHA256Word256 __attribute__((vector_size(32)));
+typedef uint64_t SHA512Word256 __attribute__((vector_size(32)));
+
+bool sha2LanesAVX2Supported() {
+    return getCPUFeatures().avx2;
+}
+
+void sha256CompressLanesAVX2(uint32_t* const* states, const uint8_t* const* blocks, size_t numLanes, size_t numBlocks) {
+    compressLanes<SHA256Word256, uint32_t, 8, 64>(states, blocks, numLanes, numBlocks, K256);
+}
+
+void sha512CompressLanesAVX2(uint64_t* const* states, const uint8_t* const* blocks, size_t numLanes, size_t numBlocks) {
+    compressLanes<SHA512Word256, uint64_t, 4, 80>(states, blocks, numLanes, numBlocks, K512);
+}
+
+#else
+
+// The vector extensions are GCC and Clang only; sha2LanesAVX2Supported keeps the backend unreachable elsewhere.
+bool sha2LanesAVX2Supported() {
+    return false;
+}
+
+void sha256CompressLanesAVX2(uint32_t* const*, const uint8_t* const*, size_t, size_t) {}
+void sha512CompressLanesAVX2(uint64_t* const*, const uint8_t* const*, size_t, size_t) {}
+
+#endif
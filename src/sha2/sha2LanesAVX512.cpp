@@ -0,0 +1,49 @@
+/*
+ * Copyright 2023-2024 The Gestalt Project Authors. All Rights Reserved.
+ *
+ * Licensed under the MIT License. See the file LICENSE for the full text.
+ */
+
+/*
+ * sha2LanesAVX512.cpp
+ *
+ * This file contains the 512-bit instantiation of the multi-buffer SHA-2 compression in sha2Lanes.h:
+ * 16 SHA-256 or 8 SHA-512 messages per vector.
+ *
+ * This translation unit is compiled with AVX-512 code generation enabled and must only be entered after
+ * isSHA2LaneBackendSupported(SHA2LaneBackend::AVX512) has returned true.
+ */
+
+#include "sha2Core.h"
+#include "cpu_features/cpu_features.h"
+
+#if defined(GESTALT_X86) && defined(__GNUC__)
+
+#include "sha2Lanes.h"
+
+typedef uint32_t SHA256Word512 __attribute__((vector_size(64)));
+typedef uint64_t SHA512Word512 __attribute__((vector_size(64)));
+
+bool sha2LanesAVX512Supported() {
+    return getCPUFeatures().avx512f;
+}
+
+void sha256CompressLanesAVX512(uint32_t* const* states, const uint8_t* const* blocks, size_t numLanes, size_t numBlocks) {
+    compressLanes<SHA256Word512, uint32_t, 16, 64>(states, blocks, numLanes, numBlocks, K256);
+}
+
+void sha512CompressLanesAVX512(uint64_t* const* states, const uint8_t* const* blocks, size_t numLanes, size_t numBlocks) {
+    compressLanes<SHA512Word512, uint64_t, 8, 80>(states, blocks, numLanes, numBlocks, K512);
+}
+
+#else
+
+// The vector extensions are GCC and Clang only; sha2LanesAVX512Supported keeps the backend unreachable elsewhere.
+bool sha2LanesAVX512Supported() {
+    return false;
+}
+
+void sha256CompressLanesAVX512(uint32_t* const*, const uint8_t* const*, size_t, size_t) {}
+void sha512CompressLanesAVX512(uint64_t* const*, const uint8_t* const*, size_t, size_t) {}
+
+#endif
@@ -0,0 +1,49 @@
+/*
+ * Copyright 2023-2024 The Gestalt Project Authors. All Rights Reserved.
+ *
+ * Licensed under the MIT License. See the file LICENSE for the full text.
+ */
+
+/*
+ * sha2LanesSSE41.cpp
+ *
+ * This file contains the 128-bit instantiation of the multi-buffer SHA-2 compression in sha2Lanes.h:
+ * 4 SHA-256 or 2 SHA-512 messages per vector.
+ *
+ * This translation unit is compiled with SSE4.1 code generation enabled and must only be entered after
+ * isSHA2LaneBackendSupported(SHA2LaneBackend::SSE41) has returned true.
+ */
+
+#include "sha2Core.h"
+#include "cpu_features/cpu_features.h"
+
+#if defined(GESTALT_X86) && defined(__GNUC__)
+
+#include "sha2Lanes.h"
+
+typedef uint32_t SHA256Word128 __attribute__((vector_size(16)));
+typedef uint64_t SHA512Word128 __attribute__((vector_size(16)));
+
+bool sha2LanesSSE41Supported() {
+    return getCPUFeatures().sse41;
+}
+
+void sha256CompressLanesSSE41(uint32_t* const* states, const uint8_t* const* blocks, size_t numLanes, size_t numBlocks) {
+    compressLanes<SHA256Word128, uint32_t, 4, 64>(states, blocks, numLanes, numBlocks, K256);
+}
+
+void sha512CompressLanesSSE41(uint64_t* const* states, const uint8_t* const* blocks, size_t numLanes, size_t numBlocks) {
+    compressLanes<SHA512Word128, uint64_t, 2, 80>(states, blocks, numLanes, numBlocks, K512);
+}
+
+#else
+
+// The vector extensions are GCC and Clang only; sha2LanesSSE41Supported keeps the backend unreachable elsewhere.
+bool sha2LanesSSE41Supported() {
+    return false;
+}
+
+void sha256CompressLanesSSE41(uint32_t* const*, const uint8_t* const*, size_t, size_t) {}
+void sha512CompressLanesSSE41(uint64_t* const*, const uint8_t* const*, size_t, size_t) {}
+
+#endif
@@ -0,0 +1,224 @@
+/*
+ * Copyright 2023-2024 The Gestalt Project Authors. All Rights Reserved.
+ *
+ * Licensed under the MIT License. See the file LICENSE for the full text.
+ */
+
+/*
+ * test_aes_backends.cpp
+ *
+ * This file contains the unit tests that run every AES round engine against the same known answers.
+ */
+
+#include <cstring>
+
+#include "gtest/gtest.h"
+
+#include "aes/aesCore.h"
+#include "utils.h"
+
+struct AESBlockVector {
+	std::string name;
+	std::string key;
+	std::string plaintext;
+	std::string ciphertext;
+};
+
+// FIPS 197, Appendix C
+const AESBlockVector AES_BLOCK_VECTORS[] = {
+	{
+		"AES128",
+		"000102030405060708090a0b0c0d0e0f",
+		"00112233445566778899aabbccddeeff",
+		"69c4e0d86a7b0430d8cdb78070b4c55a"
+	},
+	{
+		"AES192",
+		"000102030405060708090a0b0c0d0e0f1011121314151617",
+		"00112233445566778899aabbccddeeff",
+		"dda97ca4864cdfe06eaf70a0ec0d7191"
+	},
+	{
+		"AES256",
+		"000102030405060708090a0b0c0d0e0f101112131415161718191a1b1c1d1e1f",
+		"00112233445566778899aabbccddeeff",
+		"8ea2b7ca516745bfeafc49904b496089"
+	}
+};
+
+class AES_Backends : public testing::TestWithParam<AESBackend> {
+protected:
+	void SetUp() override {
+		if (!isAESBackendSupported(GetParam()))
+			GTEST_SKIP();
+	}
+};
+
+std::string AESBackendNameGenerator(const testing::TestParamInfo<AESBackend>& info) {
+	switch (info.param) {
+	case AESBackend::Reference: return "Reference";
+	case AESBackend::TTable: return "TTable";
+	case AESBackend::AESNI: return "AESNI";
+	case AESBackend::Bitsliced: return "Bitsliced";
+	default: return "Unknown";
+	}
+}
+
+INSTANTIATE_TEST_SUITE_P(All, AES_Backends, testing::Values(AESBackend::Reference, AESBackend::TTable, AESBackend::AESNI, AESBackend::Bitsliced), AESBackendNameGenerator);
+
+TEST_P(AES_Backends, KAT) {
+	for (const AESBlockVector& vector : AES_BLOCK_VECTORS) {
+		SCOPED_TRACE(vector.name);
+		AES cipher(vector.key, GetParam());
+
+		unsigned char block[AES_BLOCK_SIZE];
+		hexStringToBytes(vector.plaintext, block);
+
+		cipher.encryptBlock(block);
+		EXPECT_EQ(toHex(block, AES_BLOCK_SIZE), vector.ciphertext);
+
+		cipher.decryptBlock(block);
+		EXPECT_EQ(toHex(block, AES_BLOCK_SIZE), vector.plaintext);
+	}
+}
+
+TEST_P(AES_Backends, matchesReference) {
+	const std::string keys[] = { generateRandomHexData(16), generateRandomHexData(24), generateRandomHexData(32) };
+
+	for (const std::string& key : keys) {
+		AES reference(key, AESBackend::Reference);
+		AES cipher(key, GetParam());
+
+		for (int i = 0; i < 64; i++) {
+			unsigned char expected[AES_BLOCK_SIZE];
+			unsigned char block[AES_BLOCK_SIZE];
+			hexStringToBytes(generateRandomHexData(AES_BLOCK_SIZE), block);
+			std::memcpy(expected, block, AES_BLOCK_SIZE);
+
+			reference.encryptBlock(expected);
+			cipher.encryptBlock(block);
+			EXPECT_EQ(0, std::memcmp(block, expected, AES_BLOCK_SIZE));
+
+			reference.decryptBlock(expected);
+			cipher.decryptBlock(block);
+			EXPECT_EQ(0, std::memcmp(block, expected, AES_BLOCK_SIZE));
+		}
+	}
+}
+
+TEST_P(AES_Backends, multiBlock) {
+	// Enough blocks to cover the interleaved path of the hardware backends plus a remainder
+	const size_t numBlocks = 19;
+	const std::string key = generateRandomHexData(32);
+	AES reference(key, AESBackend::Reference);
+	AES cipher(key, GetParam());
+
+	std::vector<unsigned char> expected = hexStringToBytesVec(generateRandomHexData(numBlocks * AES_BLOCK_SIZE));
+	std::vector<unsigned char> data = expected;
+
+	for (size_t i = 0; i < numBlocks; i++) {
+		reference.encryptBlock(expected.data() + i * AES_BLOCK_SIZE);
+	}
+	cipher.encryptBlocks(data.data(), numBlocks);
+	EXPECT_EQ(data, expected);
+
+	for (size_t i = 0; i < numBlocks; i++) {
+		reference.decryptBlock(expected.data() + i * AES_BLOCK_SIZE);
+	}
+	cipher.decryptBlocks(data.data(), numBlocks);
+	EXPECT_EQ(data, expected);
+}
+
+TEST_P(AES_Backends, allByteValues) {
+	// Every byte value at every state position, so the first round feeds every S-box input to every
+	// byte lane of the circuit-based backends
+	const size_t numBlocks = 256;
+	const std::string key = generateRandomHexData(24);
+	AES reference(key, AESBackend::Reference);
+	AES cipher(key, GetParam());
+
+	std::vector<unsigned char> data(numBlocks * AES_BLOCK_SIZE);
+	for (size_t i = 0; i < numBlocks; i++) {
+		for (size_t j = 0; j < AES_BLOCK_SIZE; j++) {
+			data[i * AES_BLOCK_SIZE + j] = static_cast<unsigned char>(i + 17 * j);
+		}
+	}
+	std::vector<unsigned char> expected = data;
+
+	for (size_t i = 0; i < numBlocks; i++) {
+		reference.encryptBlock(expected.data() + i * AES_BLOCK_SIZE);
+	}
+	cipher.encryptBlocks(data.data(), numBlocks);
+	EXPECT_EQ(data, expected);
+
+	for (size_t i = 0; i < numBlocks; i++) {
+		reference.decryptBlock(expected.data() + i * AES_BLOCK_SIZE);
+	}
+	cipher.decryptBlocks(data.data(), numBlocks);
+	EXPECT_EQ(data, expected);
+}
+
+TEST_P(AES_Backends, cbcChaining) {
+	const size_t numBlocks = 19;
+	const size_t splitBlocks = 7;
+	const std::string key = generateRandomHexData(16);
+	AES reference(key, AESBackend::Reference);
+	AES cipher(key, GetParam());
+
+	std::vector<unsigned char> iv = hexStringToBytesVec(generateRandomHexData(AES_BLOCK_SIZE));
+	std::vector<unsigned char> plaintext = hexStringToBytesVec(generateRandomHexData(numBlocks * AES_BLOCK_SIZE));
+
+	// Reference CBC built from single block operations
+	std::vector<unsigned char> expected = plaintext;
+	for (size_t i = 0; i < numBlocks; i++) {
+		const unsigned char* chain = i == 0 ? iv.data() : expected.data() + (i - 1) * AES_BLOCK_SIZE;
+		for (size_t j = 0; j < AES_BLOCK_SIZE; j++) {
+			expected[i * AES_BLOCK_SIZE + j] ^= chain[j];
+		}
+		reference.encryptBlock(expected.data() + i * AES_BLOCK_SIZE);
+	}
+
+	// Splitting the data across two calls must continue the same chain
+	std::vector<unsigned char> data = plaintext;
+	unsigned char chain[AES_BLOCK_SIZE];
+	std::memcpy(chain, iv.data(), AES_BLOCK_SIZE);
+	cipher.encryptBlocksCBC(data.data(), splitBlocks, chain);
+	cipher.encryptBlocksCBC(data.data() + splitBlocks * AES_BLOCK_SIZE, numBlocks - splitBlocks, chain);
+	EXPECT_EQ(data, expected);
+	EXPECT_EQ(0, std::memcmp(chain, expected.data() + (numBlocks - 1) * AES_BLOCK_SIZE, AES_BLOCK_SIZE));
+
+	std::memcpy(chain, iv.data(), AES_BLOCK_SIZE);
+	cipher.decryptBlocksCBC(data.data(), splitBlocks, chain);
+	cipher.decryptBlocksCBC(data.data() + splitBlocks * AES_BLOCK_SIZE, numBlocks - splitBlocks, chain);
+	EXPECT_EQ(data, plaintext);
+}
+
+TEST_P(AES_Backends, ctrMatchesReference) {
+	// Enough bytes for several full counter batches plus a partial block
+	const size_t length = 21 * AES_BLOCK_SIZE + 5;
+	const std::string key = generateRandomHexData(24);
+	AES reference(key, AESBackend::Reference);
+	AES cipher(key, GetParam());
+
+	std::vector<unsigned char> counter = hexStringToBytesVec(generateRandomHexData(AES_BLOCK_SIZE));
+	std::vector<unsigned char> plaintext = hexStringToBytesVec(generateRandomHexData(length));
+	std::vector<unsigned char> expected(length);
+	std::vector<unsigned char> data(length);
+
+	reference.applyCTR(plaintext.data(), expected.data(), length, counter.data());
+	cipher.applyCTR(plaintext.data(), data.data(), length, counter.data());
+	EXPECT_EQ(data, expected);
+}
+
+TEST(AES_Backend, autoResolvesToSupportedBackend) {
+	AES cipher("000102030405060708090a0b0c0d0e0f");
+	EXPECT_NE(cipher.getBackend(), AESBackend::Auto);
+	EXPECT_TRUE(isAESBackendSupported(cipher.getBackend()));
+
+#if defined(GESTALT_AES_FORCE_BACKEND)
+	EXPECT_EQ(cipher.getBackend(), AESBackend::GESTALT_AES_FORCE_BACKEND);
+#else
+	AESBackend expected = isAESBackendSupported(AESBackend::AESNI) ? AESBackend::AESNI : AESBackend::TTable;
+	EXPECT_EQ(cipher.getBackend(), expected);
+#endif
+}
@@ -0,0 +1,161 @@
+/*
+ * Copyright 2023-2024 The Gestalt Project Authors. All Rights Reserved.
+ *
+ * Licensed under the MIT License. See the file LICENSE for the full text.
+ */
+
+/*
+ * test_aes_batch.cpp
+ *
+ * This file contains the unit tests for the multi-buffer AES-CBC interface.
+ */
+
+#include "gtest/gtest.h"
+
+#include <gestalt/aes.h>
+#include "utils.h"
+
+struct BatchMessage {
+	std::vector<uint8_t> key;
+	std::vector<uint8_t> iv;
+	std::vector<uint8_t> msg;
+	std::vector<uint8_t> out;
+};
+
+// Messages with mixed key sizes and lengths, so lanes finish at different steps
+static std::vector<BatchMessage> makeMessages(size_t count) {
+	const size_t keySizes[] = { 16, 24, 32 };
+	std::vector<BatchMessage> messages(count);
+
+	for (size_t i = 0; i < count; i++) {
+		BatchMessage& m = messages[i];
+		m.key.resize(keySizes[i % 3]);
+		m.iv.resize(AES_BLOCK_SIZE);
+		m.msg.resize((i * 37) % 300);
+		for (size_t j = 0; j < m.key.size(); j++) m.key[j] = static_cast<uint8_t>(i * 7 + j);
+		for (size_t j = 0; j < m.iv.size(); j++) m.iv[j] = static_cast<uint8_t>(i * 13 + j);
+		for (size_t j = 0; j < m.msg.size(); j++) m.msg[j] = static_cast<uint8_t>(i + j * 3);
+		m.out.resize(aesPaddedLength(m.msg.size()));
+	}
+	return messages;
+}
+
+static AESBatchItem makeItem(const std::vector<uint8_t>& key, const std::vector<uint8_t>& iv, const std::vector<uint8_t>& in, std::vector<uint8_t>& out) {
+	AESBatchItem item;
+	item.key = key.data();
+	item.keyLen = key.size();
+	item.iv = iv.data();
+	item.in = in.data();
+	item.inLen = in.size();
+	item.out = out.data();
+	item.outLen = 0;
+	item.status = AESBatchStatus::Ok;
+	return item;
+}
+
+TEST(AES_Batch, matchesSingleCalls) {
+	std::vector<BatchMessage> messages = makeMessages(50);
+	std::vector<AESBatchItem> items;
+	for (BatchMessage& m : messages) {
+		items.push_back(makeItem(m.key, m.iv, m.msg, m.out));
+	}
+
+	EXPECT_EQ(encryptAESCBCBatch(items.data(), items.size()), items.size());
+	for (size_t i = 0; i < items.size(); i++) {
+		EXPECT_EQ(items[i].status, AESBatchStatus::Ok);
+		EXPECT_EQ(items[i].outLen, messages[i].out.size());
+		EXPECT_EQ(messages[i].out, encryptAESCBC(messages[i].msg, messages[i].iv, messages[i].key)) << "item " << i;
+	}
+
+	// Decrypt in place
+	for (size_t i = 0; i < items.size(); i++) {
+		items[i].in = messages[i].out.data();
+		items[i].inLen = messages[i].out.size();
+	}
+	EXPECT_EQ(decryptAESCBCBatch(items.data(), items.size()), items.size());
+	for (size_t i = 0; i < items.size(); i++) {
+		EXPECT_EQ(items[i].status, AESBatchStatus::Ok);
+		ASSERT_EQ(items[i].outLen, messages[i].msg.size());
+		EXPECT_TRUE(std::equal(messages[i].msg.begin(), messages[i].msg.end(), messages[i].out.begin())) << "item " << i;
+	}
+}
+
+TEST(AES_Batch, lanesMatchAcrossBackends) {
+	const AESBackend backends[] = { AESBackend::TTable, AESBackend::AESNI, AESBackend::Bitsliced };
+	std::vector<BatchMessage> messages = makeMessages(AES_MULTI_BUFFER_LANES);
+	const size_t numBlocks = 5;
+	std::vector<uint8_t> expected;
+
+	for (AESBackend backend : backends) {
+		if (!isAESBackendSupported(backend)) {
+			continue;
+		}
+		std::vector<AES> ciphers;
+		const AES* cipherPtrs[AES_MULTI_BUFFER_LANES];
+		unsigned char* data[AES_MULTI_BUFFER_LANES];
+		unsigned char* ivs[AES_MULTI_BUFFER_LANES];
+		std::vector<uint8_t> buffer(AES_MULTI_BUFFER_LANES * numBlocks * AES_BLOCK_SIZE, 0x3c);
+		std::vector<uint8_t> chains(AES_MULTI_BUFFER_LANES * AES_BLOCK_SIZE, 0x01);
+
+		ciphers.reserve(AES_MULTI_BUFFER_LANES);
+		for (size_t lane = 0; lane < AES_MULTI_BUFFER_LANES; lane++) {
+			ciphers.push_back(AES(messages[lane].key.data(), messages[lane].key.size(), backend));
+			cipherPtrs[lane] = &ciphers[lane];
+			data[lane] = buffer.data() + lane * numBlocks * AES_BLOCK_SIZE;
+			ivs[lane] = chains.data() + lane * AES_BLOCK_SIZE;
+		}
+
+		// Two calls continue the same chains
+		AES::encryptBlocksCBCLanes(cipherPtrs, data, ivs, AES_MULTI_BUFFER_LANES, 2);
+		for (size_t lane = 0; lane < AES_MULTI_BUFFER_LANES; lane++) {
+			data[lane] += 2 * AES_BLOCK_SIZE;
+		}
+		AES::encryptBlocksCBCLanes(cipherPtrs, data, ivs, AES_MULTI_BUFFER_LANES, numBlocks - 2);
+
+		if (expected.empty()) {
+			expected = buffer;
+		}
+		EXPECT_EQ(buffer, expected);
+	}
+}
+
+TEST(AES_Batch, perItemStatus) {
+	std::vector<uint8_t> key(16, 0x11);
+	std::vector<uint8_t> badKey(20, 0x11);
+	std::vector<uint8_t> iv(AES_BLOCK_SIZE, 0x22);
+	std::vector<uint8_t> msg(40, 0x33);
+	std::vector<uint8_t> out1(aesPaddedLength(msg.size()));
+	std::vector<uint8_t> out2(aesPaddedLength(msg.size()));
+	std::vector<uint8_t> out3(aesPaddedLength(msg.size()));
+
+	AESBatchItem items[] = {
+		makeItem(key, iv, msg, out1),
+		makeItem(badKey, iv, msg, out2),
+		makeItem(key, iv, msg, out3)
+	};
+	EXPECT_EQ(encryptAESCBCBatch(items, 3), 2u);
+	EXPECT_EQ(items[0].status, AESBatchStatus::Ok);
+	EXPECT_EQ(items[1].status, AESBatchStatus::InvalidKeySize);
+	EXPECT_EQ(items[1].outLen, 0u);
+	EXPECT_EQ(items[2].status, AESBatchStatus::Ok);
+	EXPECT_EQ(out1, encryptAESCBC(msg, iv, key));
+
+	// Ciphertext of bad length, then a flipped byte in the block before the last that zeroes the padding byte
+	out3[out3.size() - AES_BLOCK_SIZE - 1] ^= static_cast<uint8_t>(out3.size() - msg.size());
+	std::vector<uint8_t> shortCiphertext(out1.begin(), out1.begin() + 20);
+	AESBatchItem decryptItems[] = {
+		makeItem(key, iv, out1, out1),
+		makeItem(key, iv, shortCiphertext, out2),
+		makeItem(key, iv, out3, out3)
+	};
+	EXPECT_EQ(decryptAESCBCBatch(decryptItems, 3), 1u);
+	EXPECT_EQ(decryptItems[0].status, AESBatchStatus::Ok);
+	EXPECT_EQ(decryptItems[0].outLen, msg.size());
+	EXPECT_EQ(decryptItems[1].status, AESBatchStatus::InvalidLength);
+	EXPECT_EQ(decryptItems[2].status, AESBatchStatus::InvalidPadding);
+}
+
+TEST(AES_Batch, emptyBatch) {
+	EXPECT_EQ(encryptAESCBCBatch(nullptr, 0), 0u);
+	EXPECT_EQ(decryptAESCBCBatch(nullptr, 0), 0u);
+}
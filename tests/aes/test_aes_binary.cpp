@@ -0,0 +1,104 @@
+/*
+ * Copyright 2023-2024 The Gestalt Project Authors. All Rights Reserved.
+ *
+ * Licensed under the MIT License. See the file LICENSE for the full text.
+ */
+
+/*
+ * test_aes_binary.cpp
+ *
+ * This file contains the unit tests for the raw byte AES interface.
+ */
+
+#include "gtest/gtest.h"
+
+#include <gestalt/aes.h>
+#include "utils.h"
+#include "test_utils.h"
+#include "vectors/vectors_aes.h"
+
+TEST(AES_Binary, ecbMatchesHex) {
+	const std::string keys[] = { key128, key192, key256 };
+
+	for (const std::string& key : keys) {
+		std::vector<uint8_t> ciphertext = encryptAESECB(toBytes(multiBlockPT), hexStringToBytesVec(key));
+		EXPECT_EQ(toHex(ciphertext.data(), ciphertext.size()), encryptAESECB(multiBlockPT, key));
+
+		std::vector<uint8_t> decrypted = decryptAESECB(ciphertext, hexStringToBytesVec(key));
+		EXPECT_EQ(decrypted, toBytes(multiBlockPT));
+	}
+}
+
+TEST(AES_Binary, cbcMatchesHex) {
+	const std::string keys[] = { key128, key192, key256 };
+
+	for (const std::string& key : keys) {
+		std::vector<uint8_t> ciphertext = encryptAESCBC(toBytes(multiBlockPT), hexStringToBytesVec(nonce), hexStringToBytesVec(key));
+		EXPECT_EQ(toHex(ciphertext.data(), ciphertext.size()), encryptAESCBC(multiBlockPT, nonce, key));
+
+		std::vector<uint8_t> decrypted = decryptAESCBC(ciphertext, hexStringToBytesVec(nonce), hexStringToBytesVec(key));
+		EXPECT_EQ(decrypted, toBytes(multiBlockPT));
+	}
+}
+
+TEST(AES_Binary, cbcKnownAnswer) {
+	std::vector<uint8_t> ciphertext = encryptAESCBC(toBytes(plaintext), hexStringToBytesVec(nonce), hexStringToBytesVec(key128));
+	EXPECT_EQ(ciphertext, hexStringToBytesVec("54885260a1c3cd22be863ac4bf0e1dcc"));
+}
+
+TEST(AES_Binary, inPlace) {
+	std::vector<uint8_t> key = hexStringToBytesVec(key256);
+	std::vector<uint8_t> iv = hexStringToBytesVec(nonce);
+	std::vector<uint8_t> expected = encryptAESCBC(toBytes(multiBlockPT), iv, key);
+
+	std::vector<uint8_t> buffer(aesPaddedLength(multiBlockPT.size()));
+	std::copy(multiBlockPT.begin(), multiBlockPT.end(), buffer.begin());
+
+	size_t ciphertextLen = encryptAESCBC(buffer.data(), multiBlockPT.size(), iv.data(), key.data(), key.size(), buffer.data());
+	EXPECT_EQ(ciphertextLen, buffer.size());
+	EXPECT_EQ(buffer, expected);
+
+	size_t plaintextLen = decryptAESCBC(buffer.data(), ciphertextLen, iv.data(), key.data(), key.size(), buffer.data());
+	EXPECT_EQ(plaintextLen, multiBlockPT.size());
+	EXPECT_EQ(std::string(buffer.begin(), buffer.begin() + plaintextLen), multiBlockPT);
+
+	std::copy(multiBlockPT.begin(), multiBlockPT.end(), buffer.begin());
+	ciphertextLen = encryptAESECB(buffer.data(), multiBlockPT.size(), key.data(), key.size(), buffer.data());
+	plaintextLen = decryptAESECB(buffer.data(), ciphertextLen, key.data(), key.size(), buffer.data());
+	EXPECT_EQ(std::string(buffer.begin(), buffer.begin() + plaintextLen), multiBlockPT);
+}
+
+TEST(AES_Binary, blockAlignedMessage) {
+	// A block aligned message gains a full block of padding
+	std::vector<uint8_t> msg(32, 0x61);
+	std::vector<uint8_t> key = hexStringToBytesVec(key128);
+
+	std::vector<uint8_t> ciphertext = encryptAESECB(msg, key);
+	EXPECT_EQ(ciphertext.size(), 48);
+	EXPECT_EQ(decryptAESECB(ciphertext, key), msg);
+}
+
+TEST(AES_Binary, invalidInput) {
+	std::vector<uint8_t> key = hexStringToBytesVec(key128);
+	std::vector<uint8_t> iv = hexStringToBytesVec(nonce);
+
+	EXPECT_THROW(encryptAESECB(toBytes(plaintext), std::vector<uint8_t>(15)), std::invalid_argument);
+	EXPECT_THROW(decryptAESECB(std::vector<uint8_t>(17), key), std::invalid_argument);
+	EXPECT_THROW(encryptAESCBC(toBytes(plaintext), std::vector<uint8_t>(8), key), std::invalid_argument);
+
+	// Flipping the IV turns the single 0x01 padding byte into 0x00
+	std::vector<uint8_t> ciphertext = encryptAESCBC(toBytes(plaintext), iv, key);
+	iv[15] ^= 0x01;
+	EXPECT_THROW(decryptAESCBC(ciphertext, iv, key), std::runtime_error);
+}
+
+TEST(AES_Binary, cbcLargeMessage) {
+	// Large enough to be split into several ranges for the parallel decryption path
+	std::string msg = generateRandomData(5) + "tail";
+	std::vector<uint8_t> key = hexStringToBytesVec(key192);
+	std::vector<uint8_t> iv = hexStringToBytesVec(nonce);
+
+	std::vector<uint8_t> ciphertext = encryptAESCBC(toBytes(msg), iv, key);
+	EXPECT_EQ(decryptAESCBC(ciphertext, iv, key), toBytes(msg));
+	EXPECT_EQ(decryptAESCBC(toHex(ciphertext.data(), ciphertext.size()), nonce, key192), msg);
+}
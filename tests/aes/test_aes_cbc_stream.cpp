@@ -0,0 +1,129 @@
+/*
+ * Copyright 2023-2024 The Gestalt Project Authors. All Rights Reserved.
+ *
+ * Licensed under the MIT License. See the file LICENSE for the full text.
+ */
+
+/*
+ * test_aes_cbc_stream.cpp
+ *
+ * This file contains the unit tests for the streaming AES-CBC encryptor and decryptor.
+ */
+
+#include "gtest/gtest.h"
+
+#include <algorithm>
+
+#include <gestalt/aes.h>
+#include "utils.h"
+
+/*
+ * Feeds data to a stream in pieces of the given sizes, cycling through them, and returns the output.
+ */
+template <typename Stream>
+static std::vector<uint8_t> runStream(Stream& stream, const std::vector<uint8_t>& data, const std::vector<size_t>& pieces) {
+	std::vector<uint8_t> out(data.size() + 2 * AES_BLOCK_SIZE);
+	size_t offset = 0;
+	size_t written = 0;
+	for (size_t i = 0; offset < data.size(); i++) {
+		size_t length = std::min(pieces[i % pieces.size()], data.size() - offset);
+		size_t produced = stream.update(data.data() + offset, length, out.data() + written);
+		EXPECT_EQ(produced % AES_BLOCK_SIZE, 0u);
+		EXPECT_LE(produced, length + AES_BLOCK_SIZE - 1);
+		offset += length;
+		written += produced;
+	}
+	written += stream.finalize(out.data() + written);
+	out.resize(written);
+	return out;
+}
+
+TEST(AES_CBC_Stream, matchesOneShot) {
+	std::vector<uint8_t> key = hexStringToBytesVec(generateRandomHexData(32));
+	std::vector<uint8_t> iv = hexStringToBytesVec(generateRandomHexData(16));
+	const std::vector<size_t> pieceSizes[] = { { 1 }, { 7, 16, 3 }, { 16 }, { 15, 17 }, { 33, 0, 100 }, { 4096 } };
+
+	for (size_t msgLen : { 0, 1, 15, 16, 17, 31, 32, 33, 1000, 4096, 10007 }) {
+		std::vector<uint8_t> msg = hexStringToBytesVec(generateRandomHexData(msgLen));
+		std::vector<uint8_t> expected = encryptAESCBC(msg, iv, key);
+
+		for (const std::vector<size_t>& pieces : pieceSizes) {
+			AESCBCEncryptor encryptor(key.data(), key.size(), iv.data());
+			std::vector<uint8_t> ciphertext = runStream(encryptor, msg, pieces);
+			EXPECT_EQ(ciphertext, expected) << "length " << msgLen;
+
+			AESCBCDecryptor decryptor(key.data(), key.size(), iv.data());
+			EXPECT_EQ(runStream(decryptor, ciphertext, pieces), msg) << "length " << msgLen;
+		}
+	}
+}
+
+TEST(AES_CBC_Stream, resetReusesKey) {
+	std::vector<uint8_t> key = hexStringToBytesVec(generateRandomHexData(16));
+	std::vector<uint8_t> iv1 = hexStringToBytesVec(generateRandomHexData(16));
+	std::vector<uint8_t> iv2 = hexStringToBytesVec(generateRandomHexData(16));
+	std::vector<uint8_t> msg = hexStringToBytesVec(generateRandomHexData(100));
+
+	AES cipher(key.data(), key.size());
+	AESCBCEncryptor encryptor(cipher, iv1.data());
+	runStream(encryptor, msg, { 10 });
+
+	// Data left over from an abandoned message does not leak into the next one
+	uint8_t scratch[AES_BLOCK_SIZE * 2];
+	encryptor.reset(iv1.data());
+	encryptor.update(msg.data(), 5, scratch);
+	encryptor.reset(iv2.data());
+	EXPECT_EQ(runStream(encryptor, msg, { 10 }), encryptAESCBC(msg, iv2, key));
+}
+
+TEST(AES_CBC_Stream, invalidInput) {
+	std::vector<uint8_t> key(16, 0x01);
+	std::vector<uint8_t> iv(16, 0x02);
+	std::vector<uint8_t> data(64);
+	std::vector<uint8_t> out(64 + AES_BLOCK_SIZE);
+
+	EXPECT_THROW(AESCBCEncryptor(key.data(), 20, iv.data()), std::invalid_argument);
+
+	// Ciphertext that is empty or not a multiple of the block size
+	AESCBCDecryptor decryptor(key.data(), key.size(), iv.data());
+	EXPECT_THROW(decryptor.finalize(out.data()), std::invalid_argument);
+	decryptor.reset(iv.data());
+	decryptor.update(data.data(), 33, out.data());
+	EXPECT_THROW(decryptor.finalize(out.data()), std::invalid_argument);
+
+	// A final block whose padding byte is zero
+	std::vector<uint8_t> ciphertext = encryptAESCBC(std::vector<uint8_t>(16, 0x00), iv, key);
+	ciphertext.resize(AES_BLOCK_SIZE);
+	decryptor.reset(iv.data());
+	decryptor.update(ciphertext.data(), ciphertext.size(), out.data());
+	EXPECT_THROW(decryptor.finalize(out.data()), std::runtime_error);
+
+	// No data after finalize
+	AESCBCEncryptor encryptor(key.data(), key.size(), iv.data());
+	encryptor.finalize(out.data());
+	EXPECT_THROW(encryptor.update(data.data(), 16, out.data()), std::runtime_error);
+	EXPECT_THROW(encryptor.finalize(out.data()), std::runtime_error);
+}
+
+TEST(AES_CBC_Stream, invalidPaddingEndsMessage) {
+	std::vector<uint8_t> key = hexStringToBytesVec(generateRandomHexData(16));
+	std::vector<uint8_t> iv = hexStringToBytesVec(generateRandomHexData(16));
+	std::vector<uint8_t> msg = hexStringToBytesVec(generateRandomHexData(40));
+	std::vector<uint8_t> out(64);
+
+	// The first block of an encrypted all-zero block decrypts to a padding byte of zero
+	std::vector<uint8_t> ciphertext = encryptAESCBC(std::vector<uint8_t>(16, 0x00), iv, key);
+	ciphertext.resize(AES_BLOCK_SIZE);
+
+	AESCBCDecryptor decryptor(key.data(), key.size(), iv.data());
+	decryptor.update(ciphertext.data(), ciphertext.size(), out.data());
+	EXPECT_THROW(decryptor.finalize(out.data()), std::runtime_error);
+
+	// A second attempt must not decrypt the block again under a chaining value that has moved on
+	EXPECT_THROW(decryptor.finalize(out.data()), std::runtime_error);
+	EXPECT_THROW(decryptor.update(ciphertext.data(), ciphertext.size(), out.data()), std::runtime_error);
+
+	// After reset the decryptor works normally
+	decryptor.reset(iv.data());
+	EXPECT_EQ(runStream(decryptor, encryptAESCBC(msg, iv, key), { 7 }), msg);
+}
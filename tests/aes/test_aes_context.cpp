@@ -0,0 +1,109 @@
+/*
+ * Copyright 2023-2024 The Gestalt Project Authors. All Rights Reserved.
+ *
+ * Licensed under the MIT License. See the file LICENSE for the full text.
+ */
+
+/*
+ * test_aes_context.cpp
+ *
+ * This file contains the unit tests for the reusable keyed AES context.
+ */
+
+#include "gtest/gtest.h"
+
+#include <type_traits>
+
+#include <gestalt/aes.h>
+#include "utils.h"
+#include "test_utils.h"
+#include "vectors/vectors_aes.h"
+
+// The schedules are held inline, so a context is copied without any allocation
+static_assert(std::is_trivially_copyable<AES>::value, "AES context must not own heap memory");
+
+class AES_Context : public ::testing::TestWithParam<AESBackend> {};
+
+TEST_P(AES_Context, matchesFreeFunctions) {
+	AESBackend backend = GetParam();
+	if (!isAESBackendSupported(backend)) {
+		GTEST_SKIP() << "Backend not supported on this CPU";
+	}
+
+	const std::string keys[] = { key128, key192, key256 };
+	std::vector<uint8_t> msg = toBytes(multiBlockPT);
+	std::vector<uint8_t> iv = hexStringToBytesVec(nonce);
+
+	for (const std::string& hexKey : keys) {
+		std::vector<uint8_t> key = hexStringToBytesVec(hexKey);
+		const AES cipher(key.data(), key.size(), backend);
+		std::vector<uint8_t> out(aesPaddedLength(msg.size()));
+
+		size_t outLen = cipher.encryptECB(msg.data(), msg.size(), out.data());
+		EXPECT_EQ(std::vector<uint8_t>(out.begin(), out.begin() + outLen), encryptAESECB(msg, key));
+		EXPECT_EQ(cipher.decryptECB(out.data(), outLen, out.data()), msg.size());
+		EXPECT_EQ(std::vector<uint8_t>(out.begin(), out.begin() + msg.size()), msg);
+
+		outLen = cipher.encryptCBC(msg.data(), msg.size(), iv.data(), out.data());
+		EXPECT_EQ(std::vector<uint8_t>(out.begin(), out.begin() + outLen), encryptAESCBC(msg, iv, key));
+		EXPECT_EQ(cipher.decryptCBC(out.data(), outLen, iv.data(), out.data()), msg.size());
+		EXPECT_EQ(std::vector<uint8_t>(out.begin(), out.begin() + msg.size()), msg);
+
+		cipher.encryptCTR(msg.data(), msg.size(), iv.data(), out.data());
+		EXPECT_EQ(std::vector<uint8_t>(out.begin(), out.begin() + msg.size()), encryptAESCTR(msg, iv, key));
+		cipher.decryptCTR(out.data(), msg.size(), iv.data(), out.data());
+		EXPECT_EQ(std::vector<uint8_t>(out.begin(), out.begin() + msg.size()), msg);
+
+		uint8_t tag[16];
+		cipher.encryptGCM(msg.data(), msg.size(), nullptr, 0, iv.data(), 12, out.data(), tag);
+		std::vector<uint8_t> sealed(out.begin(), out.begin() + msg.size());
+		sealed.insert(sealed.end(), tag, tag + 16);
+		EXPECT_EQ(sealed, encryptAESGCM(msg, std::vector<uint8_t>(iv.begin(), iv.begin() + 12), key));
+		cipher.decryptGCM(out.data(), msg.size(), nullptr, 0, iv.data(), 12, tag, 16, out.data());
+		EXPECT_EQ(std::vector<uint8_t>(out.begin(), out.begin() + msg.size()), msg);
+	}
+}
+
+INSTANTIATE_TEST_SUITE_P(
+	Backends, AES_Context, ::testing::Values(AESBackend::Reference, AESBackend::TTable, AESBackend::AESNI, AESBackend::Bitsliced)
+);
+
+TEST(AES_ContextReuse, manyMessagesOneKey) {
+	std::vector<uint8_t> key = hexStringToBytesVec(key256);
+	std::vector<uint8_t> iv = hexStringToBytesVec(nonce);
+	const AES cipher(key.data(), key.size());
+
+	for (size_t length = 0; length < 100; length++) {
+		std::vector<uint8_t> msg(length, static_cast<uint8_t>(length));
+		std::vector<uint8_t> out(aesPaddedLength(length));
+
+		size_t outLen = cipher.encryptCBC(msg.data(), length, iv.data(), out.data());
+		EXPECT_EQ(std::vector<uint8_t>(out.begin(), out.begin() + outLen), encryptAESCBC(msg, iv, key));
+		EXPECT_EQ(cipher.decryptCBC(out.data(), outLen, iv.data(), out.data()), length);
+		EXPECT_EQ(std::vector<uint8_t>(out.begin(), out.begin() + length), msg);
+	}
+}
+
+TEST(AES_ContextReuse, copyOutlivesOriginal) {
+	std::vector<uint8_t> key = hexStringToBytesVec(key128);
+	std::vector<uint8_t> msg = toBytes(multiBlockPT);
+	std::vector<uint8_t> out(aesPaddedLength(msg.size()));
+
+	AES* original = new AES(key.data(), key.size());
+	AES copy = *original;
+	delete original;
+
+	size_t outLen = copy.encryptECB(msg.data(), msg.size(), out.data());
+	EXPECT_EQ(std::vector<uint8_t>(out.begin(), out.begin() + outLen), encryptAESECB(msg, key));
+}
+
+TEST(AES_ContextReuse, invalidInput) {
+	std::vector<uint8_t> key = hexStringToBytesVec(key128);
+	const AES cipher(key.data(), key.size());
+	uint8_t buffer[32] = { 0 };
+
+	EXPECT_THROW(AES("zz0102030405060708090a0b0c0d0e0f"), std::invalid_argument);
+	EXPECT_THROW(AES(key.data(), 15), std::invalid_argument);
+	EXPECT_THROW(cipher.decryptECB(buffer, 17, buffer), std::invalid_argument);
+	EXPECT_THROW(cipher.decryptGCM(buffer, 16, nullptr, 0, buffer, 12, buffer + 16, 16, buffer), std::runtime_error);
+}
@@ -0,0 +1,156 @@
+/*
+ * Copyright 2023-2024 The Gestalt Project Authors. All Rights Reserved.
+ *
+ * Licensed under the MIT License. See the file LICENSE for the full text.
+ */
+
+/*
+ * test_aes_ctr.cpp
+ *
+ * This file contains the unit tests for the AES CTR mode.
+ */
+
+#include "gtest/gtest.h"
+
+#include <gestalt/aes.h>
+#include "aes/aesCore.h"
+#include "utils.h"
+
+struct AESCTRVector {
+	std::string name;
+	std::string key;
+	std::string counter;
+	std::string plaintext;
+	std::string ciphertext;
+};
+
+// NIST SP 800-38A, Appendix F.5
+const std::string CTR_COUNTER = "f0f1f2f3f4f5f6f7f8f9fafbfcfdfeff";
+const std::string CTR_PLAINTEXT =
+	"6bc1bee22e409f96e93d7e117393172aae2d8a571e03ac9c9eb76fac45af8e51"
+	"30c81c46a35ce411e5fbc1191a0a52eff69f2445df4f9b17ad2b417be66c3710";
+
+const AESCTRVector AES_CTR_VECTORS[] = {
+	{
+		"CTR-AES128",
+		"2b7e151628aed2a6abf7158809cf4f3c",
+		CTR_COUNTER,
+		CTR_PLAINTEXT,
+		"874d6191b620e3261bef6864990db6ce9806f66b7970fdff8617187bb9fffdff"
+		"5ae4df3edbd5d35e5b4f09020db03eab1e031dda2fbe03d1792170a0f3009cee"
+	},
+	{
+		"CTR-AES192",
+		"8e73b0f7da0e6452c810f32b809079e562f8ead2522c6b7b",
+		CTR_COUNTER,
+		CTR_PLAINTEXT,
+		"1abc932417521ca24f2b0459fe7e6e0b090339ec0aa6faefd5ccc2c6f4ce8e94"
+		"1e36b26bd1ebc670d1bd1d665620abf74f78a7f6d29809585a97daec58c6b050"
+	},
+	{
+		"CTR-AES256",
+		"603deb1015ca71be2b73aef0857d77811f352c073b6108d72d9810a30914dff4",
+		CTR_COUNTER,
+		CTR_PLAINTEXT,
+		"601ec313775789a5b7a7f504bbf3d228f443e3ca4d62b59aca84e990cacaf5c5"
+		"2b0930daa23de94ce87017ba2d84988ddfc9c58db67aada613c2dd08457941a6"
+	}
+};
+
+TEST(AES_CTR, KAT) {
+	for (const AESCTRVector& vector : AES_CTR_VECTORS) {
+		SCOPED_TRACE(vector.name);
+		std::vector<uint8_t> key = hexStringToBytesVec(vector.key);
+		std::vector<uint8_t> counter = hexStringToBytesVec(vector.counter);
+
+		std::vector<uint8_t> ciphertext = encryptAESCTR(hexStringToBytesVec(vector.plaintext), counter, key);
+		EXPECT_EQ(toHex(ciphertext.data(), ciphertext.size()), vector.ciphertext);
+
+		std::vector<uint8_t> plaintext = decryptAESCTR(ciphertext, counter, key);
+		EXPECT_EQ(toHex(plaintext.data(), plaintext.size()), vector.plaintext);
+	}
+}
+
+TEST(AES_CTR, partialBlock) {
+	// CTR needs no padding, a truncated message produces a truncated ciphertext
+	const AESCTRVector& vector = AES_CTR_VECTORS[0];
+	std::vector<uint8_t> plaintext = hexStringToBytesVec(vector.plaintext);
+	plaintext.resize(37);
+
+	std::vector<uint8_t> ciphertext = encryptAESCTR(plaintext, hexStringToBytesVec(vector.counter), hexStringToBytesVec(vector.key));
+	EXPECT_EQ(toHex(ciphertext.data(), ciphertext.size()), vector.ciphertext.substr(0, 2 * 37));
+}
+
+TEST(AES_CTR, inPlace) {
+	const AESCTRVector& vector = AES_CTR_VECTORS[2];
+	std::vector<uint8_t> key = hexStringToBytesVec(vector.key);
+	std::vector<uint8_t> counter = hexStringToBytesVec(vector.counter);
+	std::vector<uint8_t> buffer = hexStringToBytesVec(vector.plaintext);
+
+	encryptAESCTR(buffer.data(), buffer.size(), counter.data(), key.data(), key.size(), buffer.data());
+	EXPECT_EQ(toHex(buffer.data(), buffer.size()), vector.ciphertext);
+
+	decryptAESCTR(buffer.data(), buffer.size(), counter.data(), key.data(), key.size(), buffer.data());
+	EXPECT_EQ(toHex(buffer.data(), buffer.size()), vector.plaintext);
+}
+
+TEST(AES_CTR, seek) {
+	std::vector<uint8_t> key = hexStringToBytesVec(generateRandomHexData(16));
+	std::vector<uint8_t> counter = hexStringToBytesVec(generateRandomHexData(16));
+	std::vector<uint8_t> plaintext = hexStringToBytesVec(generateRandomHexData(1000));
+	std::vector<uint8_t> ciphertext = encryptAESCTR(plaintext, counter, key);
+
+	// Decrypting any slice directly must match the same bytes of the full decryption
+	const size_t offsets[] = { 0, 1, 15, 16, 17, 131, 999 };
+	for (size_t offset : offsets) {
+		SCOPED_TRACE(offset);
+		size_t length = ciphertext.size() - offset < 200 ? ciphertext.size() - offset : 200;
+		std::vector<uint8_t> slice(length);
+
+		decryptAESCTR(ciphertext.data() + offset, length, counter.data(), key.data(), key.size(), slice.data(), offset);
+		EXPECT_TRUE(std::equal(slice.begin(), slice.end(), plaintext.begin() + offset));
+	}
+}
+
+TEST(AES_CTR, counterCarry) {
+	// The counter is a 128-bit integer, so incrementing the low 64 bits must carry into the high half
+	std::vector<uint8_t> key = hexStringToBytesVec(generateRandomHexData(16));
+	std::vector<uint8_t> counter = hexStringToBytesVec("0000000000000001fffffffffffffffe");
+	std::vector<uint8_t> plaintext(4 * AES_BLOCK_SIZE, 0);
+
+	std::vector<uint8_t> keystream = hexStringToBytesVec(
+		"0000000000000001fffffffffffffffe"
+		"0000000000000001ffffffffffffffff"
+		"00000000000000020000000000000000"
+		"00000000000000020000000000000001"
+	);
+	AES cipher(key.data(), key.size(), AESBackend::Reference);
+	for (size_t i = 0; i < 4; i++) {
+		cipher.encryptBlock(keystream.data() + i * AES_BLOCK_SIZE);
+	}
+
+	EXPECT_EQ(encryptAESCTR(plaintext, counter, key), keystream);
+}
+
+TEST(AES_CTR, largeMessage) {
+	// Large enough to be split into several ranges for the parallel path
+	std::string msg = generateRandomData(5) + "tail";
+	std::vector<uint8_t> plaintext(msg.begin(), msg.end());
+	std::vector<uint8_t> key = hexStringToBytesVec(generateRandomHexData(32));
+	std::vector<uint8_t> counter = hexStringToBytesVec(generateRandomHexData(16));
+
+	std::vector<uint8_t> ciphertext = encryptAESCTR(plaintext, counter, key);
+
+	// A single sequential pass over the keystream must produce the same ciphertext
+	std::vector<uint8_t> expected(plaintext.size());
+	AES cipher(key.data(), key.size());
+	cipher.applyCTR(plaintext.data(), expected.data(), plaintext.size(), counter.data());
+	EXPECT_EQ(ciphertext, expected);
+
+	EXPECT_EQ(decryptAESCTR(ciphertext, counter, key), plaintext);
+}
+
+TEST(AES_CTR, invalidCounter) {
+	std::vector<uint8_t> key = hexStringToBytesVec(generateRandomHexData(16));
+	EXPECT_THROW(encryptAESCTR(std::vector<uint8_t>(16), std::vector<uint8_t>(12), key), std::invalid_argument);
+}
@@ -0,0 +1,309 @@
+/*
+ * Copyright 2023-2024 The Gestalt Project Authors. All Rights Reserved.
+ *
+ * Licensed under the MIT License. See the file LICENSE for the full text.
+ */
+
+/*
+ * test_aes_gcm.cpp
+ *
+ * This file contains the unit tests for AES-GCM and its GHASH engines.
+ */
+
+#include <cstring>
+
+#include "gtest/gtest.h"
+
+#include <gestalt/aes.h>
+#include "aes/aesGCM.h"
+#include "utils.h"
+
+struct AESGCMVector {
+	std::string name;
+	std::string key;
+	std::string iv;
+	std::string plaintext;
+	std::string aad;
+	std::string ciphertext;
+	std::string tag;
+};
+
+const std::string GCM_PLAINTEXT =
+	"d9313225f88406e5a55909c5aff5269a86a7a9531534f7da2e4c303d8a318a72"
+	"1c3c0c95956809532fcf0e2449a6b525b16aedf5aa0de657ba637b391aafd255";
+const std::string GCM_PLAINTEXT_60 = GCM_PLAINTEXT.substr(0, 120);
+const std::string GCM_AAD = "feedfacedeadbeeffeedfacedeadbeefabaddad2";
+
+// "The Galois/Counter Mode of Operation (GCM)", McGrew and Viega, Appendix B
+const AESGCMVector AES_GCM_VECTORS[] = {
+	{
+		"TestCase1",
+		"00000000000000000000000000000000",
+		"000000000000000000000000",
+		"",
+		"",
+		"",
+		"58e2fccefa7e3061367f1d57a4e7455a"
+	},
+	{
+		"TestCase2",
+		"00000000000000000000000000000000",
+		"000000000000000000000000",
+		"00000000000000000000000000000000",
+		"",
+		"0388dace60b6a392f328c2b971b2fe78",
+		"ab6e47d42cec13bdf53a67b21257bddf"
+	},
+	{
+		"TestCase3",
+		"feffe9928665731c6d6a8f9467308308",
+		"cafebabefacedbaddecaf888",
+		GCM_PLAINTEXT,
+		"",
+		"42831ec2217774244b7221b784d0d49ce3aa212f2c02a4e035c17e2329aca12e"
+		"21d514b25466931c7d8f6a5aac84aa051ba30b396a0aac973d58e091473f5985",
+		"4d5c2af327cd64a62cf35abd2ba6fab4"
+	},
+	{
+		"TestCase4",
+		"feffe9928665731c6d6a8f9467308308",
+		"cafebabefacedbaddecaf888",
+		GCM_PLAINTEXT_60,
+		GCM_AAD,
+		"42831ec2217774244b7221b784d0d49ce3aa212f2c02a4e035c17e2329aca12e"
+		"21d514b25466931c7d8f6a5aac84aa051ba30b396a0aac973d58e091",
+		"5bc94fbc3221a5db94fae95ae7121a47"
+	},
+	{
+		"TestCase5",
+		"feffe9928665731c6d6a8f9467308308",
+		"cafebabefacedbad",
+		GCM_PLAINTEXT_60,
+		GCM_AAD,
+		"61353b4c2806934a777ff51fa22a4755699b2a714fcdc6f83766e5f97b6c7423"
+		"73806900e49f24b22b097544d4896b424989b5e1ebac0f07c23f4598",
+		"3612d2e79e3b0785561be14aaca2fccb"
+	},
+	{
+		"TestCase6",
+		"feffe9928665731c6d6a8f9467308308",
+		"9313225df88406e555909c5aff5269aa6a7a9538534f7da1e4c303d2a318a728"
+		"c3c0c95156809539fcf0e2429a6b525416aedbf5a0de6a57a637b39b",
+		GCM_PLAINTEXT_60,
+		GCM_AAD,
+		"8ce24998625615b603a033aca13fb894be9112a5c3a211a8ba262a3cca7e2ca7"
+		"01e4a9a4fba43c90ccdcb281d48c7c6fd62875d2aca417034c34aee5",
+		"619cc5aefffe0bfa462af43c1699d050"
+	},
+	{
+		"TestCase14",
+		"0000000000000000000000000000000000000000000000000000000000000000",
+		"000000000000000000000000",
+		"00000000000000000000000000000000",
+		"",
+		"cea7403d4d606b6e074ec5d3baf39d18",
+		"d0d1c8a799996bf0265b98b5d48ab919"
+	},
+	{
+		"TestCase16",
+		"feffe9928665731c6d6a8f9467308308feffe9928665731c6d6a8f9467308308",
+		"cafebabefacedbaddecaf888",
+		GCM_PLAINTEXT_60,
+		GCM_AAD,
+		"522dc1f099567d07f47f37a32a84427d643a8cdcbfe5c0c97598a2bd2555d1aa"
+		"8cb08e48590dbb3da7b08b1056828838c5f61e6393ba7a0abcc9f662",
+		"76fc6ece0f4e1768cddf8853bb2d551b"
+	}
+};
+
+class GCM_Functions : public testing::TestWithParam<GHASHBackend> {
+protected:
+	void SetUp() override {
+		if (!isGHASHBackendSupported(GetParam()))
+			GTEST_SKIP();
+	}
+
+	void setCounter(GCM& gcm, const std::string& counter) { hexStringToBytes(counter, gcm.counter); }
+	void applyCTR(GCM& gcm, unsigned char* data, size_t numBlocks) { gcm.applyCTR(data, data, numBlocks); }
+};
+
+std::string GHASHBackendNameGenerator(const testing::TestParamInfo<GHASHBackend>& info) {
+	return info.param == GHASHBackend::CLMUL ? "CLMUL" : "Table";
+}
+
+INSTANTIATE_TEST_SUITE_P(All, GCM_Functions, testing::Values(GHASHBackend::Table, GHASHBackend::CLMUL), GHASHBackendNameGenerator);
+
+TEST_P(GCM_Functions, KAT) {
+	for (const AESGCMVector& vector : AES_GCM_VECTORS) {
+		SCOPED_TRACE(vector.name);
+		std::vector<uint8_t> key = hexStringToBytesVec(vector.key);
+		std::vector<uint8_t> iv = hexStringToBytesVec(vector.iv);
+		std::vector<uint8_t> aad = hexStringToBytesVec(vector.aad);
+		std::vector<uint8_t> data = hexStringToBytesVec(vector.plaintext);
+		unsigned char tag[GCM_TAG_SIZE];
+
+		GCM gcm(key.data(), key.size(), AESBackend::Auto, GetParam());
+		gcm.start(iv.data(), iv.size());
+		gcm.updateAAD(aad.data(), aad.size());
+		gcm.encryptUpdate(data.data(), data.data(), data.size());
+		gcm.finish(tag);
+		EXPECT_EQ(toHex(data.data(), data.size()), vector.ciphertext);
+		EXPECT_EQ(toHex(tag, GCM_TAG_SIZE), vector.tag);
+
+		gcm.start(iv.data(), iv.size());
+		gcm.updateAAD(aad.data(), aad.size());
+		gcm.decryptUpdate(data.data(), data.data(), data.size());
+		EXPECT_TRUE(gcm.verify(tag));
+		EXPECT_EQ(toHex(data.data(), data.size()), vector.plaintext);
+	}
+}
+
+TEST_P(GCM_Functions, streamingMatchesOneShot) {
+	std::vector<uint8_t> key = hexStringToBytesVec(generateRandomHexData(16));
+	std::vector<uint8_t> iv = hexStringToBytesVec(generateRandomHexData(12));
+	std::vector<uint8_t> aad = hexStringToBytesVec(generateRandomHexData(77));
+	std::vector<uint8_t> plaintext = hexStringToBytesVec(generateRandomHexData(1500));
+
+	std::vector<uint8_t> expected(plaintext.size());
+	unsigned char expectedTag[GCM_TAG_SIZE];
+	encryptAESGCM(
+		plaintext.data(), plaintext.size(), aad.data(), aad.size(), iv.data(), iv.size(), key.data(), key.size(),
+		expected.data(), expectedTag
+	);
+
+	// Uneven update sizes cross block boundaries in every position
+	const size_t chunks[] = { 1, 15, 16, 17, 3, 600, 33, 0, 5 };
+	GCM gcm(key.data(), key.size(), AESBackend::Auto, GetParam());
+	gcm.start(iv.data(), iv.size());
+	gcm.updateAAD(aad.data(), 10);
+	gcm.updateAAD(aad.data() + 10, aad.size() - 10);
+
+	std::vector<uint8_t> ciphertext(plaintext.size());
+	size_t position = 0;
+	for (size_t i = 0; position < plaintext.size(); i++) {
+		size_t chunk = chunks[i % (sizeof(chunks) / sizeof(chunks[0]))];
+		chunk = chunk < plaintext.size() - position ? chunk : plaintext.size() - position;
+		gcm.encryptUpdate(plaintext.data() + position, ciphertext.data() + position, chunk);
+		position += chunk;
+	}
+	unsigned char tag[GCM_TAG_SIZE];
+	gcm.finish(tag);
+
+	EXPECT_EQ(ciphertext, expected);
+	EXPECT_EQ(0, std::memcmp(tag, expectedTag, GCM_TAG_SIZE));
+}
+
+TEST_P(GCM_Functions, counterWrapsLow32Bits) {
+	// GCM increments only the last 32 bits of the counter block
+	std::vector<uint8_t> key = hexStringToBytesVec(generateRandomHexData(16));
+	GCM gcm(key.data(), key.size(), AESBackend::Auto, GetParam());
+	setCounter(gcm, "0102030405060708090a0b0cfffffffe");
+
+	unsigned char data[3 * AES_BLOCK_SIZE] = { 0 };
+	applyCTR(gcm, data, 3);
+
+	std::vector<uint8_t> expected = hexStringToBytesVec(
+		"0102030405060708090a0b0cffffffff"
+		"0102030405060708090a0b0c00000000"
+		"0102030405060708090a0b0c00000001"
+	);
+	AES cipher(key.data(), key.size());
+	cipher.encryptBlocks(expected.data(), 3);
+	EXPECT_EQ(0, std::memcmp(data, expected.data(), sizeof(data)));
+}
+
+TEST(AES_GCM, backendsAgree) {
+	if (!isGHASHBackendSupported(GHASHBackend::CLMUL))
+		GTEST_SKIP();
+
+	unsigned char h[16];
+	hexStringToBytes(generateRandomHexData(16), h);
+	std::vector<uint8_t> data = hexStringToBytesVec(generateRandomHexData(23 * 16));
+
+	GHASH table(h, GHASHBackend::Table);
+	GHASH clmul(h, GHASHBackend::CLMUL);
+	table.update(data.data(), 23);
+	clmul.update(data.data(), 23);
+
+	unsigned char tableDigest[16];
+	unsigned char clmulDigest[16];
+	table.digest(tableDigest);
+	clmul.digest(clmulDigest);
+	EXPECT_EQ(0, std::memcmp(tableDigest, clmulDigest, 16));
+}
+
+TEST(AES_GCM, vectorRoundTrip) {
+	std::vector<uint8_t> key = hexStringToBytesVec(generateRandomHexData(32));
+	std::vector<uint8_t> iv = hexStringToBytesVec(generateRandomHexData(12));
+	std::vector<uint8_t> aad = hexStringToBytesVec("feedface");
+	std::vector<uint8_t> plaintext = hexStringToBytesVec(generateRandomHexData(100));
+
+	std::vector<uint8_t> sealed = encryptAESGCM(plaintext, iv, key, aad);
+	EXPECT_EQ(sealed.size(), plaintext.size() + GCM_TAG_SIZE);
+	EXPECT_EQ(decryptAESGCM(sealed, iv, key, aad), plaintext);
+}
+
+TEST(AES_GCM, tamperDetected) {
+	std::vector<uint8_t> key = hexStringToBytesVec(generateRandomHexData(16));
+	std::vector<uint8_t> iv = hexStringToBytesVec(generateRandomHexData(12));
+	std::vector<uint8_t> aad = hexStringToBytesVec("feedface");
+	std::vector<uint8_t> sealed = encryptAESGCM(hexStringToBytesVec(generateRandomHexData(40)), iv, key, aad);
+
+	std::vector<uint8_t> modified = sealed;
+	modified[3] ^= 0x01;
+	EXPECT_THROW(decryptAESGCM(modified, iv, key, aad), std::runtime_error);
+
+	modified = sealed;
+	modified.back() ^= 0x80;
+	EXPECT_THROW(decryptAESGCM(modified, iv, key, aad), std::runtime_error);
+
+	EXPECT_THROW(decryptAESGCM(sealed, iv, key, hexStringToBytesVec("feedfacf")), std::runtime_error);
+}
+
+TEST(AES_GCM, streamingClass) {
+	const AESGCMVector& vector = AES_GCM_VECTORS[3];
+	std::vector<uint8_t> key = hexStringToBytesVec(vector.key);
+	std::vector<uint8_t> iv = hexStringToBytesVec(vector.iv);
+	std::vector<uint8_t> aad = hexStringToBytesVec(vector.aad);
+	std::vector<uint8_t> data = hexStringToBytesVec(vector.plaintext);
+	unsigned char tag[GCM_TAG_SIZE];
+
+	// One key schedule, several messages
+	AESGCM gcm(key.data(), key.size());
+	for (int message = 0; message < 2; message++) {
+		std::vector<uint8_t> buffer = data;
+		gcm.start(iv.data(), iv.size());
+		gcm.updateAAD(aad.data(), aad.size());
+		gcm.encryptUpdate(buffer.data(), 7, buffer.data());
+		gcm.encryptUpdate(buffer.data() + 7, buffer.size() - 7, buffer.data() + 7);
+		gcm.finish(tag);
+		EXPECT_EQ(toHex(buffer.data(), buffer.size()), vector.ciphertext);
+		EXPECT_EQ(toHex(tag, GCM_TAG_SIZE), vector.tag);
+	}
+
+	// A truncated tag is the prefix of the full tag
+	unsigned char shortTag[12];
+	gcm.start(iv.data(), iv.size());
+	gcm.updateAAD(aad.data(), aad.size());
+	gcm.encryptUpdate(data.data(), data.size(), data.data());
+	gcm.finish(shortTag, sizeof(shortTag));
+	EXPECT_EQ(0, std::memcmp(shortTag, tag, sizeof(shortTag)));
+}
+
+TEST(AES_GCM, invalidUsage) {
+	std::vector<uint8_t> key = hexStringToBytesVec(generateRandomHexData(16));
+	std::vector<uint8_t> iv = hexStringToBytesVec(generateRandomHexData(12));
+	unsigned char buffer[16] = { 0 };
+	unsigned char tag[GCM_TAG_SIZE];
+
+	AESGCM gcm(key.data(), key.size());
+	EXPECT_THROW(gcm.encryptUpdate(buffer, sizeof(buffer), buffer), std::runtime_error);
+	EXPECT_THROW(gcm.start(iv.data(), 0), std::invalid_argument);
+
+	gcm.start(iv.data(), iv.size());
+	gcm.encryptUpdate(buffer, sizeof(buffer), buffer);
+	EXPECT_THROW(gcm.updateAAD(buffer, sizeof(buffer)), std::runtime_error);
+	EXPECT_THROW(gcm.finish(tag, 10), std::invalid_argument);
+
+	EXPECT_THROW(decryptAESGCM(std::vector<uint8_t>(15), iv, key), std::invalid_argument);
+}
@@ -0,0 +1,218 @@
+/*
+ * Copyright 2023-2024 The Gestalt Project Authors. All Rights Reserved.
+ *
+ * Licensed under the MIT License. See the file LICENSE for the full text.
+ */
+
+/*
+ * test_aes_key_wrap.cpp
+ *
+ * This file contains the unit tests for the AES key wrap modes KW and KWP.
+ */
+
+#include "gtest/gtest.h"
+
+#include <gestalt/aes.h>
+#include "utils.h"
+
+struct AESKeyWrapVector {
+	std::string name;
+	std::string kek;
+	std::string key;
+	std::string wrapped;
+	bool padded;
+};
+
+// RFC 3394, Section 4 and RFC 5649, Section 6
+const AESKeyWrapVector AES_KEY_WRAP_VECTORS[] = {
+	{
+		"RFC3394_4_1",
+		"000102030405060708090a0b0c0d0e0f",
+		"00112233445566778899aabbccddeeff",
+		"1fa68b0a8112b447aef34bd8fb5a7b829d3e862371d2cfe5",
+		false
+	},
+	{
+		"RFC3394_4_5",
+		"000102030405060708090a0b0c0d0e0f101112131415161718191a1b1c1d1e1f",
+		"00112233445566778899aabbccddeeff0001020304050607",
+		"a8f9bc1612c68b3ff6e6f4fbe30e71e4769c8b80a32cb8958cd5d17d6b254da1",
+		false
+	},
+	{
+		"RFC3394_4_6",
+		"000102030405060708090a0b0c0d0e0f101112131415161718191a1b1c1d1e1f",
+		"00112233445566778899aabbccddeeff000102030405060708090a0b0c0d0e0f",
+		"28c9f404c4b810f4cbccb35cfb87f8263f5786e2d80ed326cbc7f0e71a99f43bfb988b9b7a02dd21",
+		false
+	},
+	{
+		"RFC5649_6_1",
+		"5840df6e29b02af1ab493b705bf16ea1ae8338f4dcc176a8",
+		"c37b7e6492584340bed12207808941155068f738",
+		"138bdeaa9b8fa7fc61f97742e72248ee5ae6ae5360d1ae6a5f54f373fa543b6a",
+		true
+	},
+	{
+		"RFC5649_6_2",
+		"5840df6e29b02af1ab493b705bf16ea1ae8338f4dcc176a8",
+		"466f7250617369",
+		"afbeb0f07dfbf5419200f2ccb50bb24f",
+		true
+	}
+};
+
+class AES_KeyWrap : public ::testing::TestWithParam<AESBackend> {};
+
+TEST_P(AES_KeyWrap, KAT) {
+	AESBackend backend = GetParam();
+	if (!isAESBackendSupported(backend)) {
+		GTEST_SKIP() << "Backend not supported on this CPU";
+	}
+
+	for (const AESKeyWrapVector& vector : AES_KEY_WRAP_VECTORS) {
+		SCOPED_TRACE(vector.name);
+		std::vector<uint8_t> kekBytes = hexStringToBytesVec(vector.kek);
+		std::vector<uint8_t> key = hexStringToBytesVec(vector.key);
+		std::vector<uint8_t> wrapped(aesKeyWrapPaddedLength(key.size()));
+		AES kek(kekBytes.data(), kekBytes.size(), backend);
+
+		size_t wrappedLen = vector.padded ? kek.wrapKeyPadded(key.data(), key.size(), wrapped.data())
+		                                  : kek.wrapKey(key.data(), key.size(), wrapped.data());
+		EXPECT_EQ(toHex(wrapped.data(), wrappedLen), vector.wrapped);
+
+		// In place
+		size_t keyLen = vector.padded ? kek.unwrapKeyPadded(wrapped.data(), wrappedLen, wrapped.data())
+		                              : kek.unwrapKey(wrapped.data(), wrappedLen, wrapped.data());
+		EXPECT_EQ(toHex(wrapped.data(), keyLen), vector.key);
+	}
+}
+
+INSTANTIATE_TEST_SUITE_P(
+	Backends, AES_KeyWrap,
+	::testing::Values(AESBackend::Reference, AESBackend::TTable, AESBackend::AESNI, AESBackend::Bitsliced)
+);
+
+TEST(AES_KeyWrapBatch, matchesSingleCalls) {
+	std::vector<uint8_t> kekBytes = hexStringToBytesVec(generateRandomHexData(32));
+	AES kek(kekBytes.data(), kekBytes.size());
+
+	// Mixed lengths split the lockstep groups, and more than one full group of each length
+	const size_t keyLengths[] = { 32, 32, 32, 16, 16, 32, 32, 32, 32, 32, 32, 32, 32, 32, 24, 1, 7, 9, 32 };
+	const size_t count = sizeof(keyLengths) / sizeof(keyLengths[0]);
+
+	for (bool padded : { false, true }) {
+		std::vector<std::vector<uint8_t>> keys;
+		std::vector<std::vector<uint8_t>> wrapped;
+		std::vector<std::vector<uint8_t>> outputs;
+		std::vector<AESKeyWrapItem> items;
+
+		for (size_t i = 0; i < count; i++) {
+			if (!padded && keyLengths[i] % 8 != 0) {
+				continue;
+			}
+			keys.push_back(hexStringToBytesVec(generateRandomHexData(keyLengths[i])));
+			std::vector<uint8_t> buffer(aesKeyWrapPaddedLength(keyLengths[i]));
+			size_t length = padded ? kek.wrapKeyPadded(keys.back().data(), keys.back().size(), buffer.data())
+			                       : kek.wrapKey(keys.back().data(), keys.back().size(), buffer.data());
+			buffer.resize(length);
+			wrapped.push_back(buffer);
+			outputs.push_back(std::vector<uint8_t>(length - 8));
+		}
+		for (size_t i = 0; i < keys.size(); i++) {
+			items.push_back({ wrapped[i].data(), wrapped[i].size(), outputs[i].data(), 0, AESBatchStatus::Ok });
+		}
+
+		size_t succeeded = padded ? unwrapAESKeyPaddedBatch(kek, items.data(), items.size())
+		                          : unwrapAESKeyBatch(kek, items.data(), items.size());
+		EXPECT_EQ(succeeded, keys.size());
+		for (size_t i = 0; i < keys.size(); i++) {
+			EXPECT_EQ(items[i].status, AESBatchStatus::Ok);
+			EXPECT_EQ(std::vector<uint8_t>(outputs[i].begin(), outputs[i].begin() + items[i].outLen), keys[i]);
+		}
+	}
+}
+
+TEST(AES_KeyWrapBatch, interleavedLengths) {
+	std::vector<uint8_t> kekBytes = hexStringToBytesVec(generateRandomHexData(32));
+	AES kek(kekBytes.data(), kekBytes.size());
+
+	// A key store alternating 24- and 40-byte wraps, with an invalid item in between
+	const size_t count = 21;
+	std::vector<std::vector<uint8_t>> keys(count);
+	std::vector<std::vector<uint8_t>> wrapped(count);
+	std::vector<std::vector<uint8_t>> outputs(count);
+	std::vector<AESKeyWrapItem> items(count);
+	for (size_t i = 0; i < count; i++) {
+		keys[i] = hexStringToBytesVec(generateRandomHexData(i % 2 == 0 ? 16 : 32));
+		wrapped[i].resize(keys[i].size() + 8);
+		kek.wrapKey(keys[i].data(), keys[i].size(), wrapped[i].data());
+		if (i == 9) {
+			wrapped[i].resize(20);
+		}
+		outputs[i].resize(wrapped[i].size());
+		items[i] = { wrapped[i].data(), wrapped[i].size(), outputs[i].data(), 0, AESBatchStatus::Ok };
+	}
+
+	EXPECT_EQ(unwrapAESKeyBatch(kek, items.data(), count), count - 1);
+	for (size_t i = 0; i < count; i++) {
+		if (i == 9) {
+			EXPECT_EQ(items[i].status, AESBatchStatus::InvalidLength);
+			continue;
+		}
+		EXPECT_EQ(items[i].status, AESBatchStatus::Ok) << i;
+		EXPECT_EQ(std::vector<uint8_t>(outputs[i].begin(), outputs[i].begin() + items[i].outLen), keys[i]) << i;
+	}
+}
+
+TEST(AES_KeyWrapBatch, perItemStatus) {
+	std::vector<uint8_t> kekBytes = hexStringToBytesVec(generateRandomHexData(16));
+	AES kek(kekBytes.data(), kekBytes.size());
+	std::vector<uint8_t> key(32, 0x42);
+
+	std::vector<uint8_t> good(40), tampered(40), wrongKek(40), shortLen(16);
+	kek.wrapKey(key.data(), key.size(), good.data());
+	kek.wrapKey(key.data(), key.size(), tampered.data());
+	tampered[30] ^= 0x01;
+	std::vector<uint8_t> otherKek(16, 0x07);
+	wrapAESKey(key.data(), key.size(), otherKek.data(), otherKek.size(), wrongKek.data());
+
+	std::vector<uint8_t> out[4] = { std::vector<uint8_t>(32), std::vector<uint8_t>(32), std::vector<uint8_t>(8), std::vector<uint8_t>(32) };
+	AESKeyWrapItem items[] = {
+		{ good.data(), good.size(), out[0].data(), 0, AESBatchStatus::Ok },
+		{ tampered.data(), tampered.size(), out[1].data(), 0, AESBatchStatus::Ok },
+		{ shortLen.data(), shortLen.size(), out[2].data(), 0, AESBatchStatus::Ok },
+		{ wrongKek.data(), wrongKek.size(), out[3].data(), 0, AESBatchStatus::Ok }
+	};
+
+	EXPECT_EQ(unwrapAESKeyBatch(kek, items, 4), 1u);
+	EXPECT_EQ(items[0].status, AESBatchStatus::Ok);
+	EXPECT_EQ(out[0], key);
+	EXPECT_EQ(items[1].status, AESBatchStatus::IntegrityCheckFailed);
+	EXPECT_EQ(items[2].status, AESBatchStatus::InvalidLength);
+	EXPECT_EQ(items[3].status, AESBatchStatus::IntegrityCheckFailed);
+
+	// Failed unwraps leave no key material behind
+	EXPECT_EQ(items[1].outLen, 0u);
+	EXPECT_EQ(out[1], std::vector<uint8_t>(32, 0x00));
+	EXPECT_EQ(unwrapAESKeyBatch(kek, items, 0), 0u);
+}
+
+TEST(AES_KeyWrap, invalidInput) {
+	std::vector<uint8_t> kek(16, 0x01);
+	std::vector<uint8_t> key(40, 0x02);
+	std::vector<uint8_t> out(64);
+
+	EXPECT_THROW(wrapAESKey(key.data(), 8, kek.data(), kek.size(), out.data()), std::invalid_argument);
+	EXPECT_THROW(wrapAESKey(key.data(), 20, kek.data(), kek.size(), out.data()), std::invalid_argument);
+	EXPECT_THROW(wrapAESKeyPadded(key.data(), 0, kek.data(), kek.size(), out.data()), std::invalid_argument);
+	EXPECT_THROW(unwrapAESKey(key.data(), 16, kek.data(), kek.size(), out.data()), std::invalid_argument);
+	EXPECT_THROW(unwrapAESKeyPadded(key.data(), 20, kek.data(), kek.size(), out.data()), std::invalid_argument);
+	EXPECT_THROW(wrapAESKey(key.data(), 16, kek.data(), 15, out.data()), std::invalid_argument);
+
+	// A KW wrapped key is not a valid KWP wrapped key and the reverse
+	size_t wrappedLen = wrapAESKey(key.data(), 16, kek.data(), kek.size(), out.data());
+	EXPECT_THROW(unwrapAESKeyPadded(out.data(), wrappedLen, kek.data(), kek.size(), out.data()), std::runtime_error);
+	wrappedLen = wrapAESKeyPadded(key.data(), 16, kek.data(), kek.size(), out.data());
+	EXPECT_THROW(unwrapAESKey(out.data(), wrappedLen, kek.data(), kek.size(), out.data()), std::runtime_error);
+}
@@ -0,0 +1,156 @@
+/*
+ * Copyright 2023-2024 The Gestalt Project Authors. All Rights Reserved.
+ *
+ * Licensed under the MIT License. See the file LICENSE for the full text.
+ */
+
+/*
+ * test_aes_mac.cpp
+ *
+ * This file contains the unit tests for AES-CMAC and GMAC.
+ */
+
+#include "gtest/gtest.h"
+
+#include <algorithm>
+
+#include <gestalt/aes.h>
+#include "utils.h"
+
+struct AESCMACVector {
+	std::string name;
+	std::string key;
+	size_t msgLen;
+	std::string tag;
+};
+
+const std::string CMAC_MESSAGE =
+	"6bc1bee22e409f96e93d7e117393172aae2d8a571e03ac9c9eb76fac45af8e51"
+	"30c81c46a35ce411e5fbc1191a0a52eff69f2445df4f9b17ad2b417be66c3710";
+
+const std::string CMAC_KEY_128 = "2b7e151628aed2a6abf7158809cf4f3c";
+const std::string CMAC_KEY_192 = "8e73b0f7da0e6452c810f32b809079e562f8ead2522c6b7b";
+const std::string CMAC_KEY_256 = "603deb1015ca71be2b73aef0857d77811f352c073b6108d72d9810a30914dff4";
+
+// NIST SP 800-38B, Appendix D (the AES-128 examples are also RFC 4493, Section 4)
+const AESCMACVector AES_CMAC_VECTORS[] = {
+	{ "Example1", CMAC_KEY_128, 0, "bb1d6929e95937287fa37d129b756746" },
+	{ "Example2", CMAC_KEY_128, 16, "070a16b46b4d4144f79bdd9dd04a287c" },
+	{ "Example3", CMAC_KEY_128, 40, "dfa66747de9ae63030ca32611497c827" },
+	{ "Example4", CMAC_KEY_128, 64, "51f0bebf7e3b9d92fc49741779363cfe" },
+	{ "Example5", CMAC_KEY_192, 0, "d17ddf46adaacde531cac483de7a9367" },
+	{ "Example6", CMAC_KEY_192, 16, "9e99a7bf31e710900662f65e617c5184" },
+	{ "Example7", CMAC_KEY_192, 40, "8a1de5be2eb31aad089a82e6ee908b0e" },
+	{ "Example8", CMAC_KEY_192, 64, "a1d5df0eed790f794d77589659f39a11" },
+	{ "Example9", CMAC_KEY_256, 0, "028962f61b7bf89efc6b551f4667d983" },
+	{ "Example10", CMAC_KEY_256, 16, "28a7023f452e8f82bd4bf28d8c37c35c" },
+	{ "Example11", CMAC_KEY_256, 40, "aaf3d8f1de5640c232f5b169b9c911e6" },
+	{ "Example12", CMAC_KEY_256, 64, "e1992190549f6ed5696a2c056c315410" }
+};
+
+class AES_CMAC : public ::testing::TestWithParam<AESBackend> {};
+
+TEST_P(AES_CMAC, KAT) {
+	AESBackend backend = GetParam();
+	if (!isAESBackendSupported(backend)) {
+		GTEST_SKIP() << "Backend not supported on this CPU";
+	}
+
+	std::vector<uint8_t> msg = hexStringToBytesVec(CMAC_MESSAGE);
+	for (const AESCMACVector& vector : AES_CMAC_VECTORS) {
+		SCOPED_TRACE(vector.name);
+		std::vector<uint8_t> key = hexStringToBytesVec(vector.key);
+		std::vector<uint8_t> expected = hexStringToBytesVec(vector.tag);
+		uint8_t tag[16];
+
+		AESCMAC cmac(key.data(), key.size(), backend);
+		cmac.update(msg.data(), vector.msgLen);
+		cmac.finish(tag);
+		EXPECT_EQ(toHex(tag, 16), vector.tag);
+
+		// One byte at a time, on the same instance
+		for (size_t i = 0; i < vector.msgLen; i++) {
+			cmac.update(msg.data() + i, 1);
+		}
+		EXPECT_TRUE(cmac.verify(expected.data()));
+
+		EXPECT_TRUE(verifyCMACAES(msg.data(), vector.msgLen, key.data(), key.size(), expected.data()));
+	}
+}
+
+INSTANTIATE_TEST_SUITE_P(
+	Backends, AES_CMAC,
+	::testing::Values(AESBackend::Reference, AESBackend::TTable, AESBackend::AESNI, AESBackend::Bitsliced)
+);
+
+TEST(AES_MAC, cmacStreamingMatchesOneShot) {
+	std::vector<uint8_t> key = hexStringToBytesVec(generateRandomHexData(32));
+	std::vector<uint8_t> msg = hexStringToBytesVec(generateRandomHexData(5000));
+	AES cipher(key.data(), key.size());
+	AESCMAC cmac(cipher);
+
+	for (size_t msgLen : { 1, 15, 16, 17, 255, 256, 257, 5000 }) {
+		uint8_t expected[16];
+		cmacAES(msg.data(), msgLen, key.data(), key.size(), expected);
+
+		for (size_t piece : { 3, 16, 100, 1000 }) {
+			for (size_t offset = 0; offset < msgLen; offset += piece) {
+				cmac.update(msg.data() + offset, std::min(piece, msgLen - offset));
+			}
+			uint8_t tag[16];
+			cmac.finish(tag);
+			EXPECT_EQ(toHex(tag, 16), toHex(expected, 16)) << "length " << msgLen << ", piece " << piece;
+		}
+	}
+}
+
+TEST(AES_MAC, cmacRejectsTampering) {
+	std::vector<uint8_t> key = hexStringToBytesVec(CMAC_KEY_128);
+	std::vector<uint8_t> msg = hexStringToBytesVec(CMAC_MESSAGE);
+	uint8_t tag[12];
+	cmacAES(msg.data(), msg.size(), key.data(), key.size(), tag, sizeof(tag));
+	EXPECT_EQ(toHex(tag, sizeof(tag)), "51f0bebf7e3b9d92fc497417");
+
+	msg[20] ^= 0x01;
+	EXPECT_FALSE(verifyCMACAES(msg.data(), msg.size(), key.data(), key.size(), tag, sizeof(tag)));
+	msg[20] ^= 0x01;
+	tag[11] ^= 0x80;
+	EXPECT_FALSE(verifyCMACAES(msg.data(), msg.size(), key.data(), key.size(), tag, sizeof(tag)));
+
+	EXPECT_THROW(cmacAES(msg.data(), msg.size(), key.data(), key.size(), tag, 4), std::invalid_argument);
+	EXPECT_THROW(cmacAES(msg.data(), msg.size(), key.data(), 10, tag), std::invalid_argument);
+}
+
+TEST(AES_MAC, gmacKAT) {
+	// McGrew and Viega, GCM test case 1: no plaintext and no AAD
+	std::vector<uint8_t> key(16, 0x00);
+	std::vector<uint8_t> iv(12, 0x00);
+	uint8_t tag[16];
+	gmacAES(nullptr, 0, iv.data(), iv.size(), key.data(), key.size(), tag);
+	EXPECT_EQ(toHex(tag, 16), "58e2fccefa7e3061367f1d57a4e7455a");
+}
+
+TEST(AES_MAC, gmacMatchesGCMWithoutPlaintext) {
+	std::vector<uint8_t> key = hexStringToBytesVec(generateRandomHexData(16));
+	std::vector<uint8_t> iv = hexStringToBytesVec(generateRandomHexData(12));
+	std::vector<uint8_t> msg = hexStringToBytesVec(generateRandomHexData(1000));
+
+	// GCM with an empty plaintext outputs only the tag
+	std::vector<uint8_t> expected = encryptAESGCM(std::vector<uint8_t>(), iv, key, msg);
+
+	uint8_t tag[16];
+	gmacAES(msg.data(), msg.size(), iv.data(), iv.size(), key.data(), key.size(), tag);
+	EXPECT_EQ(toHex(tag, 16), toHex(expected.data(), expected.size()));
+
+	AES cipher(key.data(), key.size());
+	AESGMAC gmac(cipher);
+	for (int message = 0; message < 2; message++) {
+		gmac.start(iv.data(), iv.size());
+		gmac.update(msg.data(), 333);
+		gmac.update(msg.data() + 333, msg.size() - 333);
+		EXPECT_TRUE(gmac.verify(expected.data()));
+	}
+
+	msg[999] ^= 0x01;
+	EXPECT_FALSE(verifyGMACAES(msg.data(), msg.size(), iv.data(), iv.size(), key.data(), key.size(), expected.data()));
+}
@@ -0,0 +1,174 @@
+/*
+ * Copyright 2023-2024 The Gestalt Project Authors. All Rights Reserved.
+ *
+ * Licensed under the MIT License. See the file LICENSE for the full text.
+ */
+
+/*
+ * test_aes_xts.cpp
+ *
+ * This file contains the unit tests for the XTS-AES mode.
+ */
+
+#include "gtest/gtest.h"
+
+#include <gestalt/aes.h>
+#include "utils.h"
+
+struct AESXTSVector {
+	std::string name;
+	std::string key; // Data key followed by tweak key
+	uint64_t dataUnit;
+	std::string plaintext;
+	std::string ciphertext;
+};
+
+static std::string sequentialBytes(size_t length) {
+	std::string hex;
+	for (size_t i = 0; i < length; i++) {
+		unsigned char byte = static_cast<unsigned char>(i);
+		hex += toHex(&byte, 1);
+	}
+	return hex;
+}
+
+const std::string XTS_STEALING_KEY = "fffefdfcfbfaf9f8f7f6f5f4f3f2f1f0bfbebdbcbbbab9b8b7b6b5b4b3b2b1b0";
+
+// IEEE 1619, Annex B
+const AESXTSVector AES_XTS_VECTORS[] = {
+	{
+		"Vector1",
+		"0000000000000000000000000000000000000000000000000000000000000000",
+		0,
+		"0000000000000000000000000000000000000000000000000000000000000000",
+		"917cf69ebd68b2ec9b9fe9a3eadda692cd43d2f59598ed858c02c2652fbf922e"
+	},
+	{
+		"Vector2",
+		"1111111111111111111111111111111122222222222222222222222222222222",
+		0x3333333333,
+		"4444444444444444444444444444444444444444444444444444444444444444",
+		"c454185e6a16936e39334038acef838bfb186fff7480adc4289382ecd6d394f0"
+	},
+	{
+		"Vector3",
+		"fffefdfcfbfaf9f8f7f6f5f4f3f2f1f022222222222222222222222222222222",
+		0x3333333333,
+		"4444444444444444444444444444444444444444444444444444444444444444",
+		"af85336b597afc1a900b2eb21ec949d292df4c047e0b21532186a5971a227a89"
+	},
+	{
+		"Vector10",
+		"2718281828459045235360287471352662497757247093699959574966967627"
+		"3141592653589793238462643383279502884197169399375105820974944592",
+		0xff,
+		sequentialBytes(512),
+		"1c3b3a102f770386e4836c99e370cf9bea00803f5e482357a4ae12d414a3e63b5d31e276f8fe4a8d66b317f9ac683f44680a86ac35adfc3345befecb4bb188fd"
+		"5776926c49a3095eb108fd1098baec70aaa66999a72a82f27d848b21d4a741b0c5cd4d5fff9dac89aeba122961d03a757123e9870f8acf1000020887891429ca"
+		"2a3e7a7d7df7b10355165c8b9a6d0a7de8b062c4500dc4cd120c0f7418dae3d0b5781c34803fa75421c790dfe1de1834f280d7667b327f6c8cd7557e12ac3a0f"
+		"93ec05c52e0493ef31a12d3d9260f79a289d6a379bc70c50841473d1a8cc81ec583e9645e07b8d9670655ba5bbcfecc6dc3966380ad8fecb17b6ba02469a020a"
+		"84e18e8f84252070c13e9f1f289be54fbc481457778f616015e1327a02b140f1505eb309326d68378f8374595c849d84f4c333ec4423885143cb47bd71c5edae"
+		"9be69a2ffeceb1bec9de244fbe15992b11b77c040f12bd8f6a975a44a0f90c29a9abc3d4d893927284c58754cce294529f8614dcd2aba991925fedc4ae74ffac"
+		"6e333b93eb4aff0479da9a410e4450e0dd7ae4c6e2910900575da401fc07059f645e8b7e9bfdef33943054ff84011493c27b3429eaedb4ed5376441a77ed4385"
+		"1ad77f16f541dfd269d50d6a5f14fb0aab1cbb4c1550be97f7ab4066193c4caa773dad38014bd2092fa755c824bb5e54c4f36ffda9fcea70b9c6e693e148c151"
+	},
+	// Ciphertext stealing
+	{ "Vector15", XTS_STEALING_KEY, 0x123456789a, sequentialBytes(17), "6c1625db4671522d3d7599601de7ca09ed" },
+	{ "Vector16", XTS_STEALING_KEY, 0x123456789a, sequentialBytes(18), "d069444b7a7e0cab09e24447d24deb1fedbf" },
+	{ "Vector17", XTS_STEALING_KEY, 0x123456789a, sequentialBytes(19), "e5df1351c0544ba1350b3363cd8ef4beedbf9d" },
+	{ "Vector18", XTS_STEALING_KEY, 0x123456789a, sequentialBytes(20), "9d84c813f719aa2c7be3f66171c7c5c2edbf9dac" }
+};
+
+TEST(AES_XTS, KAT) {
+	for (const AESXTSVector& vector : AES_XTS_VECTORS) {
+		SCOPED_TRACE(vector.name);
+		std::vector<uint8_t> key = hexStringToBytesVec(vector.key);
+		std::vector<uint8_t> data = hexStringToBytesVec(vector.plaintext);
+		AESXTS xts(key.data(), key.size());
+
+		xts.encryptDataUnit(data.data(), data.size(), vector.dataUnit, data.data());
+		EXPECT_EQ(toHex(data.data(), data.size()), vector.ciphertext);
+
+		xts.decryptDataUnit(data.data(), data.size(), vector.dataUnit, data.data());
+		EXPECT_EQ(toHex(data.data(), data.size()), vector.plaintext);
+	}
+}
+
+TEST(AES_XTS, stealingRoundTrip) {
+	std::vector<uint8_t> key = hexStringToBytesVec(XTS_STEALING_KEY);
+	AESXTS xts(key.data(), key.size());
+
+	for (size_t length = AES_BLOCK_SIZE; length < 12 * AES_BLOCK_SIZE; length++) {
+		std::vector<uint8_t> plaintext = hexStringToBytesVec(sequentialBytes(length));
+		std::vector<uint8_t> ciphertext(length);
+		std::vector<uint8_t> decrypted(length);
+
+		xts.encryptDataUnit(plaintext.data(), length, 7, ciphertext.data());
+		xts.decryptDataUnit(ciphertext.data(), length, 7, decrypted.data());
+		EXPECT_EQ(decrypted, plaintext) << "length " << length;
+	}
+}
+
+TEST(AES_XTS, dataUnitsAreIndependent) {
+	const size_t sectorSize = 4096;
+	const size_t numSectors = 16;
+	std::vector<uint8_t> key = hexStringToBytesVec(generateRandomHexData(64));
+	std::vector<uint8_t> image = hexStringToBytesVec(generateRandomHexData(sectorSize * numSectors));
+	std::vector<uint8_t> encrypted(image.size());
+
+	encryptAESXTS(image.data(), image.size(), key.data(), key.size(), sectorSize, 100, encrypted.data());
+
+	// Each sector matches a single data unit call with its own number
+	AESXTS xts(key.data(), key.size());
+	for (size_t sector = 0; sector < numSectors; sector++) {
+		std::vector<uint8_t> unit(sectorSize);
+		xts.encryptDataUnit(image.data() + sector * sectorSize, sectorSize, 100 + sector, unit.data());
+		EXPECT_TRUE(std::equal(unit.begin(), unit.end(), encrypted.begin() + sector * sectorSize)) << "sector " << sector;
+	}
+
+	// Rewriting one sector leaves the others untouched
+	std::vector<uint8_t> updated = encrypted;
+	std::vector<uint8_t> page(sectorSize, 0xab);
+	xts.encryptDataUnit(page.data(), sectorSize, 105, updated.data() + 5 * sectorSize);
+
+	decryptAESXTS(updated.data(), updated.size(), key.data(), key.size(), sectorSize, 100, updated.data());
+	for (size_t sector = 0; sector < numSectors; sector++) {
+		const uint8_t* expected = sector == 5 ? page.data() : image.data() + sector * sectorSize;
+		EXPECT_TRUE(std::equal(expected, expected + sectorSize, updated.begin() + sector * sectorSize)) << "sector " << sector;
+	}
+}
+
+TEST(AES_XTS, largeImage) {
+	// Enough sectors to be split between threads
+	const size_t sectorSize = 512;
+	std::vector<uint8_t> key = hexStringToBytesVec(generateRandomHexData(32));
+	std::vector<uint8_t> image(5 * 1024 * 1024);
+	for (size_t i = 0; i < image.size(); i++) {
+		image[i] = static_cast<uint8_t>(i * 7);
+	}
+	std::vector<uint8_t> data = image;
+
+	encryptAESXTS(data.data(), data.size(), key.data(), key.size(), sectorSize, 0, data.data());
+
+	AESXTS xts(key.data(), key.size());
+	std::vector<uint8_t> lastSector(sectorSize);
+	size_t lastIndex = image.size() / sectorSize - 1;
+	xts.decryptDataUnit(data.data() + lastIndex * sectorSize, sectorSize, lastIndex, lastSector.data());
+	EXPECT_TRUE(std::equal(lastSector.begin(), lastSector.end(), image.begin() + lastIndex * sectorSize));
+
+	decryptAESXTS(data.data(), data.size(), key.data(), key.size(), sectorSize, 0, data.data());
+	EXPECT_EQ(data, image);
+}
+
+TEST(AES_XTS, invalidInput) {
+	std::vector<uint8_t> key(64, 0x01);
+	std::vector<uint8_t> data(64);
+
+	EXPECT_THROW(AESXTS(key.data(), 48), std::invalid_argument);
+	EXPECT_THROW(AESXTS(key.data(), 16), std::invalid_argument);
+
+	AESXTS xts(key.data(), 32);
+	EXPECT_THROW(xts.encryptDataUnit(data.data(), 15, 0, data.data()), std::invalid_argument);
+	EXPECT_THROW(xts.encryptDataUnits(data.data(), 64, 8, 0, data.data()), std::invalid_argument);
+	EXPECT_THROW(xts.decryptDataUnits(data.data(), 60, 32, 0, data.data()), std::invalid_argument);
+}
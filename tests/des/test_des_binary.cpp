@@ -0,0 +1,114 @@
+/*
+ * Copyright 2023-2024 The Gestalt Project Authors. All Rights Reserved.
+ *
+ * Licensed under the MIT License. See the file LICENSE for the full text.
+ */
+
+/*
+ * test_des_binary.cpp
+ *
+ * This file contains the unit tests for the raw byte DES & 3DES interface.
+ */
+
+#include "gtest/gtest.h"
+
+#include <gestalt/des.h>
+#include "utils.h"
+#include "test_utils.h"
+#include "vectors/vectors_des.h"
+
+TEST(DES_Binary, ecbMatchesHex) {
+    std::vector<uint8_t> ciphertext = encryptDESECB(toBytes(multiBlockPT), hexStringToBytesVec(key));
+    EXPECT_EQ(toHex(ciphertext.data(), ciphertext.size()), encryptDESECB(multiBlockPT, key));
+    EXPECT_EQ(decryptDESECB(ciphertext, hexStringToBytesVec(key)), toBytes(multiBlockPT));
+
+    ciphertext = encrypt3DESECB(
+        toBytes(multiBlockPT), hexStringToBytesVec(key), hexStringToBytesVec(key2), hexStringToBytesVec(key3)
+    );
+    EXPECT_EQ(toHex(ciphertext.data(), ciphertext.size()), encrypt3DESECB(multiBlockPT, key, key2, key3));
+    EXPECT_EQ(
+        decrypt3DESECB(ciphertext, hexStringToBytesVec(key), hexStringToBytesVec(key2), hexStringToBytesVec(key3)),
+        toBytes(multiBlockPT)
+    );
+}
+
+TEST(DES_Binary, cbcMatchesHex) {
+    std::vector<uint8_t> iv = hexStringToBytesVec(nonce);
+
+    std::vector<uint8_t> ciphertext = encryptDESCBC(toBytes(multiBlockPT), iv, hexStringToBytesVec(key));
+    EXPECT_EQ(toHex(ciphertext.data(), ciphertext.size()), encryptDESCBC(multiBlockPT, nonce, key));
+    EXPECT_EQ(decryptDESCBC(ciphertext, iv, hexStringToBytesVec(key)), toBytes(multiBlockPT));
+
+    ciphertext = encrypt3DESCBC(
+        toBytes(multiBlockPT), iv, hexStringToBytesVec(key), hexStringToBytesVec(key2), hexStringToBytesVec(key3)
+    );
+    EXPECT_EQ(toHex(ciphertext.data(), ciphertext.size()), encrypt3DESCBC(multiBlockPT, nonce, key, key2, key3));
+    EXPECT_EQ(
+        decrypt3DESCBC(ciphertext, iv, hexStringToBytesVec(key), hexStringToBytesVec(key2), hexStringToBytesVec(key3)),
+        toBytes(multiBlockPT)
+    );
+}
+
+TEST(DES_Binary, knownAnswer) {
+    std::vector<uint8_t> ciphertext = encrypt3DESCBC(
+        toBytes(plaintext), hexStringToBytesVec(nonce), hexStringToBytesVec(key), hexStringToBytesVec(key2),
+        hexStringToBytesVec(key3)
+    );
+    EXPECT_EQ(ciphertext, hexStringToBytesVec("ee6edc51099b7783bf57f381d620957c"));
+}
+
+TEST(DES_Binary, inPlace) {
+    std::vector<uint8_t> k1 = hexStringToBytesVec(key);
+    std::vector<uint8_t> k2 = hexStringToBytesVec(key2);
+    std::vector<uint8_t> iv = hexStringToBytesVec(nonce);
+
+    // Long enough for whole bitsliced groups and a partial one
+    std::string msg;
+    while (msg.size() < 5000) {
+        msg += multiBlockPT;
+    }
+    std::vector<uint8_t> expected = encrypt3DESCBC(toBytes(msg), iv, k1, k2, k1);
+
+    std::vector<uint8_t> buffer(desPaddedLength(msg.size()));
+    std::copy(msg.begin(), msg.end(), buffer.begin());
+
+    size_t ciphertextLen = encrypt3DESCBC(buffer.data(), msg.size(), iv.data(), k1.data(), k2.data(), k1.data(), buffer.data());
+    EXPECT_EQ(ciphertextLen, buffer.size());
+    EXPECT_EQ(buffer, expected);
+
+    size_t plaintextLen = decrypt3DESCBC(buffer.data(), ciphertextLen, iv.data(), k1.data(), k2.data(), k1.data(), buffer.data());
+    EXPECT_EQ(std::string(buffer.begin(), buffer.begin() + plaintextLen), msg);
+
+    std::copy(msg.begin(), msg.end(), buffer.begin());
+    ciphertextLen = encryptDESECB(buffer.data(), msg.size(), k1.data(), buffer.data());
+    plaintextLen = decryptDESECB(buffer.data(), ciphertextLen, k1.data(), buffer.data());
+    EXPECT_EQ(std::string(buffer.begin(), buffer.begin() + plaintextLen), msg);
+}
+
+TEST(DES_Binary, blockAlignedMessage) {
+    // A block aligned message gains a full block of padding
+    std::vector<uint8_t> msg(16, 0x61);
+    std::vector<uint8_t> ciphertext = encryptDESECB(msg, hexStringToBytesVec(key));
+    EXPECT_EQ(ciphertext.size(), 24);
+    EXPECT_EQ(decryptDESECB(ciphertext, hexStringToBytesVec(key)), msg);
+}
+
+TEST(DES_Binary, invalidInput) {
+    std::vector<uint8_t> k1 = hexStringToBytesVec(key);
+    std::vector<uint8_t> k2 = hexStringToBytesVec(key2);
+    std::vector<uint8_t> iv = hexStringToBytesVec(nonce);
+    std::vector<uint8_t> msg = toBytes(plaintext);
+
+    EXPECT_THROW(encryptDESECB(msg, std::vector<uint8_t>(7)), std::invalid_argument);
+    EXPECT_THROW(encryptDESCBC(msg, std::vector<uint8_t>(16), k1), std::invalid_argument);
+    EXPECT_THROW(encrypt3DESECB(msg, k1, k1, k2), std::invalid_argument);
+    EXPECT_THROW(encrypt3DESECB(msg, k1, k2, k2), std::invalid_argument);
+    EXPECT_THROW(decryptDESECB(std::vector<uint8_t>(12), k1), std::invalid_argument);
+    EXPECT_THROW(decryptDESCBC(std::vector<uint8_t>(), iv, k1), std::runtime_error);
+
+    // A final block that decrypts to a zero padding byte
+    std::vector<uint8_t> zeroPadded(8, 0);
+    std::vector<uint8_t> ciphertext = encryptDESECB(zeroPadded, k1);
+    ciphertext.resize(8);
+    EXPECT_THROW(decryptDESECB(ciphertext, k1), std::runtime_error);
+}
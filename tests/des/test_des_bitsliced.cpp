@@ -0,0 +1,99 @@
+/*
+ * Copyright 2023-2024 The Gestalt Project Authors. All Rights Reserved.
+ *
+ * Licensed under the MIT License. See the file LICENSE for the full text.
+ */
+
+/*
+ * test_des_bitsliced.cpp
+ *
+ * This file contains the unit tests for the bitsliced DES engine. Every result is checked against the
+ * table driven DES, including block counts that leave partial groups.
+ */
+
+#include "gtest/gtest.h"
+#include <vector>
+
+#include "des/desCore.h"
+#include "des/desBitsliced.h"
+
+static std::vector<uint64_t> testBlocks(size_t numBlocks) {
+    std::vector<uint64_t> blocks(numBlocks);
+    uint64_t state = 0x0123456789ABCDEFULL;
+    for (uint64_t& block : blocks) {
+        state = state * 6364136223846793005ULL + 1442695040888963407ULL;
+        block = state;
+    }
+    return blocks;
+}
+
+TEST(DES_Bitsliced, knownAnswer) {
+    DESBitsliced des(0x752878397493CB70ULL);
+    uint64_t block = 0x1122334455667788;
+
+    des.encryptBlocks(&block, 1);
+    EXPECT_EQ(block, 0xB5219EE81AA7499D);
+    des.decryptBlocks(&block, 1);
+    EXPECT_EQ(block, 0x1122334455667788);
+}
+
+TEST(DES_Bitsliced, matchesTableDES) {
+    DES des("133457799BBCDFF1");
+    DESBitsliced bitsliced(des);
+
+    for (size_t numBlocks : { 1, 63, 64, 65, 300, 1000 }) {
+        std::vector<uint64_t> blocks = testBlocks(numBlocks);
+        std::vector<uint64_t> expected = blocks;
+        for (uint64_t& block : expected) {
+            block = des.encryptBlock(block);
+        }
+
+        bitsliced.encryptBlocks(blocks.data(), blocks.size());
+        EXPECT_EQ(blocks, expected) << numBlocks << " blocks";
+
+        bitsliced.decryptBlocks(blocks.data(), blocks.size());
+        EXPECT_EQ(blocks, testBlocks(numBlocks)) << numBlocks << " blocks";
+    }
+}
+
+TEST(DES_Bitsliced, tripleDESMatchesTableDES) {
+    DES des1("133457799BBCDFF1");
+    DES des2("0E329232EA6D0D73");
+    DES des3("752878397493CB70");
+    DESBitsliced bitsliced1(des1);
+    DESBitsliced bitsliced2(des2);
+    DESBitsliced bitsliced3(des3);
+
+    for (size_t numBlocks : { 1, 64, 300, 1000 }) {
+        std::vector<uint64_t> blocks = testBlocks(numBlocks);
+        std::vector<uint64_t> expected = blocks;
+        for (uint64_t& block : expected) {
+            block = des3.encryptBlock(des2.decryptBlock(des1.encryptBlock(block)));
+        }
+
+        DESBitsliced::encryptBlocksEDE(bitsliced1, bitsliced2, bitsliced3, blocks.data(), blocks.size());
+        EXPECT_EQ(blocks, expected) << numBlocks << " blocks";
+
+        DESBitsliced::decryptBlocksEDE(bitsliced1, bitsliced2, bitsliced3, blocks.data(), blocks.size());
+        EXPECT_EQ(blocks, testBlocks(numBlocks)) << numBlocks << " blocks";
+    }
+}
+
+TEST(DES_Bitsliced, widePassMatchesTableDES) {
+    if (!desBitslicedAVX2Supported()) {
+        GTEST_SKIP() << "AVX2 is not supported by this CPU";
+    }
+    DES des("0E329232EA6D0D73");
+    DESBitsliced bitsliced(des);
+
+    // One full 256-block pass followed by a 64-block pass and a partial group
+    size_t numBlocks = DES_BITSLICED_AVX2_BLOCKS + DES_BITSLICED_BLOCKS + 5;
+    std::vector<uint64_t> blocks = testBlocks(numBlocks);
+    std::vector<uint64_t> expected = blocks;
+    for (uint64_t& block : expected) {
+        block = des.encryptBlock(block);
+    }
+
+    bitsliced.encryptBlocks(blocks.data(), blocks.size());
+    EXPECT_EQ(blocks, expected);
+}
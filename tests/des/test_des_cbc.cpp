@@ -13,8 +13,12 @@
 #include "gtest/gtest.h"
 
 #include <gestalt/des.h>
+#include "utils.h"
+#include "parallel/parallel.h"
 #include "vectors/vectors_des.h"
 
+const bool skipLargeMessage = true; // This test can take a bit, so set to false if you'd like to test.
+
 TEST(DES_CBC, encrypt) {
     std::string ciphertext = encryptDESCBC(plaintext, nonce, key);
     std::string expected = "95a32bce039b97b209e35f005da93c0c";
@@ -39,4 +43,27 @@ TEST(DES_CBC, multiBlock) {
 
 	std::string descryptedPlaintext = decryptDESCBC(ciphertext, nonce, key);
 	EXPECT_EQ(descryptedPlaintext, multiBlockPT); 
-}
\ No newline at end of file
+}
+
+TEST(DES_CBC, largeMessage) {
+    if (skipLargeMessage) GTEST_SKIP();
+
+    // Large enough to be split into several ranges for the parallel decryption path
+    std::string msg = generateRandomData(4) + "tail";
+    std::string ciphertext = encryptDESCBC(msg, nonce, key);
+    EXPECT_EQ(decryptDESCBC(ciphertext, nonce, key), msg);
+}
+
+TEST(DES_CBC, parallelRanges) {
+    // Just over two ranges' worth of blocks, decrypted with at least two ranges even on a single core
+    setParallelThreadCount(4);
+    std::string msg = generateRandomData(2) + "tail";
+    EXPECT_GT(splitBlockRange(msg.size() / 8 + 1, 8).size(), 1u);
+
+    std::string ciphertext = encryptDESCBC(msg, nonce, key);
+    std::string tripleCiphertext = encrypt3DESCBC(msg, nonce, key, key2, key3);
+    EXPECT_EQ(decryptDESCBC(ciphertext, nonce, key), msg);
+    EXPECT_EQ(decrypt3DESCBC(tripleCiphertext, nonce, key, key2, key3), msg);
+
+    setParallelThreadCount(0);
+}
@@ -34,9 +34,18 @@ public:
     std::string sbox(uint64_t in) { return printIntToBinary(des.sboxSubstitution(in)); };
     std::string permutation(uint32_t in) { return printIntToBinary(des.permute(in, P, 32, P_SIZE)); };
     std::string f(uint32_t in) { return printIntToBinary(des.f(in, 0)); };
+    uint32_t f(uint32_t in, size_t round) { return des.f(in, round); };
+    uint32_t referenceF(uint32_t in, size_t round) {
+        uint64_t expanded = des.permute(static_cast<uint64_t>(in), E, 32, E_SIZE) & 0x0000FFFFFFFFFFFF;
+        return des.permute(des.sboxSubstitution(expanded ^ des.roundKeys[round]), P, 32, P_SIZE);
+    };
     std::string finalPermutation(uint64_t in) { 
         return printIntToBinary(des.permute(in, FP, DES_BLOCK_SIZE, FP_SIZE));
     };
+    bool permutationsMatchTables(uint64_t in) {
+        return DES::initialPermutation(in) == des.permute(in, IP, DES_BLOCK_SIZE, IP_SIZE) &&
+               DES::finalPermutation(in) == des.permute(in, FP, DES_BLOCK_SIZE, FP_SIZE);
+    };
 };
 
 // Thanks to https://www.nayuki.io/page/des-cipher-internals-in-excel for DES test vector with internal steps
@@ -67,6 +76,15 @@ TEST(DES_Functions, keyExpansion) {
     }
 }
 
+TEST(DES_Functions, binaryKeyMatchesHexKey) {
+    DES fromHex("752878397493CB70");
+    DES fromBinary(static_cast<uint64_t>(0x752878397493CB70));
+
+    EXPECT_EQ(fromBinary.encryptBlock(0x1122334455667788), fromHex.encryptBlock(0x1122334455667788));
+    EXPECT_EQ(fromBinary.encryptBlock(0x1122334455667788), 0xB5219EE81AA7499D);
+    EXPECT_THROW(DES("752878397493CB7G"), std::invalid_argument);
+}
+
 TEST(DES_Functions, encryptBlock) {
     DES tester("752878397493CB70");
     uint64_t plaintext = 0x1122334455667788;
@@ -130,6 +148,28 @@ TEST(DES_Functions, f) {
     EXPECT_EQ(output, expected);
 }
 
+TEST(DES_Functions, deltaSwapPermutations) {
+    DES_Functions tester("752878397493CB70");
+    uint64_t input = 0x1122334455667788;
+
+    for (int i = 0; i < 1024; i++) {
+        input = input * 6364136223846793005ULL + 1442695040888963407ULL;
+        EXPECT_TRUE(tester.permutationsMatchTables(input));
+    }
+}
+
+TEST(DES_Functions, fMatchesSeparateSteps) {
+    DES_Functions tester("752878397493CB70");
+    uint32_t input = 0x80668066;
+
+    for (size_t round = 0; round < DES_NUM_OF_ROUNDS; round++) {
+        for (int i = 0; i < 256; i++) {
+            input = input * 1664525 + 1013904223;
+            EXPECT_EQ(tester.f(input, round), tester.referenceF(input, round));
+        }
+    }
+}
+
 TEST(DES_Functions, finalPermutation) {
     DES_Functions tester("752878397493CB70");
     uint64_t input = 0x4895A5E3AD2BDC34;
@@ -139,6 +179,38 @@ TEST(DES_Functions, finalPermutation) {
     EXPECT_EQ(output, expected);
 }
 
+TEST(DES_Functions, tripleDESMatchesChainedDES) {
+    DES des1("133457799BBCDFF1");
+    DES des2("0E329232EA6D0D73");
+    DES des3("752878397493CB70");
+    TripleDES tdes(des1, des2, des3);
+
+    uint64_t block = 0x0123456789ABCDEF;
+    for (int i = 0; i < 100; i++) {
+        uint64_t expected = des3.encryptBlock(des2.decryptBlock(des1.encryptBlock(block)));
+        uint64_t ciphertext = tdes.encryptBlock(block);
+        EXPECT_EQ(ciphertext, expected);
+        EXPECT_EQ(tdes.decryptBlock(ciphertext), block);
+        block = ciphertext;
+    }
+}
+
+TEST(DES_Functions, tripleDESKeyingOptions) {
+    DES des1(0x133457799BBCDFF1ULL);
+    DES des2(0x0E329232EA6D0D73ULL);
+    uint64_t block = 0x1122334455667788;
+
+    // Two-key 3DES reuses K1 as K3
+    TripleDES twoKey(0x133457799BBCDFF1ULL, 0x0E329232EA6D0D73ULL);
+    EXPECT_EQ(twoKey.encryptBlock(block), TripleDES(des1, des2, des1).encryptBlock(block));
+    EXPECT_EQ(twoKey.encryptBlock(block), des1.encryptBlock(des2.decryptBlock(des1.encryptBlock(block))));
+
+    // With all keys equal, 3DES reduces to single DES
+    TripleDES oneKey(des1, des1, des1);
+    EXPECT_EQ(oneKey.encryptBlock(block), des1.encryptBlock(block));
+    EXPECT_EQ(oneKey.decryptBlock(block), des1.decryptBlock(block));
+}
+
 TEST(DES_Errors, singleKeyInvalidSize) {
     std::string smallKey = "abc";
     EXPECT_THROW(encryptDESECB(plaintext, smallKey), std::invalid_argument);
@@ -153,4 +225,4 @@ TEST(TDES_Errors, invalidKeyArrangement) {
     EXPECT_THROW(encrypt3DESECB(plaintext, key, key, key3), std::invalid_argument);
     EXPECT_THROW(encrypt3DESECB(plaintext, key, key2, key2), std::invalid_argument);
     EXPECT_THROW(encrypt3DESECB(plaintext, key, key, key), std::invalid_argument);
-}
\ No newline at end of file
+}
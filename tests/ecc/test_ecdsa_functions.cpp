@@ -16,6 +16,7 @@
 #include "gtest/gtest.h"
 
 #include <gestalt/ecdsa.h>
+#include "utils.h"
 #include "vectors/vectors_ecdsa.h"
 
 TEST(ECDSA, keyGen) {
@@ -42,6 +43,9 @@ protected:
     void prepareMessage(const std::string& messageHash, mpz_t& result) { 
         ecdsa.prepareMessage(messageHash, result);
     };
+    void prepareDigest(const uint8_t* digest, size_t length, mpz_t& result) {
+        ecdsa.prepareDigest(digest, length, result);
+    };
     bool isInvalidSignature(Signature S) { return ecdsa.isInvalidSignature(S); };
     void setKeyPair(const std::string& givenKey) { ecdsa.setKeyPair(givenKey); };
     Signature generateSignature(const mpz_t& e, mpz_t& k) { return ecdsa.generateSignature(e, k); };
@@ -67,6 +71,27 @@ TEST_F(ECDSA_Test, PrepareMessage) {
     EXPECT_TRUE(mpz_cmp(result.n, expected.n) == 0);
 }
 
+TEST_F(ECDSA_Test, PrepareDigestMatchesHex) {
+    // The default curve is secp256k1, so digests of up to 32 bytes are used whole
+    const std::string hexDigests[] = {
+        "0fff",
+        "4c24c2225c70900f85f97d6ff7936f1dca59e8283f1a1a8872c981b98a0ee53a",
+        "ddaf35a193617abacc417349ae20413112e6fa4e89a97ea20a9eeee64b55d39a"
+        "2192992a274fc1a836ba3c23a3feebbd454d4423643ce80e2a9ac94fa54ca49f"
+    };
+
+    for (const std::string& hexDigest : hexDigests) {
+        std::vector<unsigned char> digest = hexStringToBytesVec(hexDigest);
+        BigInt fromHex;
+        BigInt fromBytes;
+
+        prepareMessage(hexDigest, fromHex.n);
+        prepareDigest(digest.data(), digest.size(), fromBytes.n);
+
+        EXPECT_TRUE(mpz_cmp(fromHex.n, fromBytes.n) == 0) << hexDigest;
+    }
+}
+
 TEST_F(ECDSA_Test, IsValidSignature)  {
     Signature validSig("0xF3AC8061B514795B8843E3D6629527ED2AFD6B1F6A555A7ACABB5E6F79C8C2AC", 
                        "0x8BF77819CA05A6B2786C76262BF7371CEF97B218E96F175A3CCDDA2ACC058903");
@@ -27,5 +27,5 @@ TEST(RSA_Padding, mgf1) {
         "a89312fc044238fed47cebc38a76bdface9a0a39de99223890e74ce10378bc515a212b97b8a6d743cb766fc8d3d66a51546e447ba6a887"
         "0278f0262727ca041fa1aa9f7b5d1cb58a05e29076bd0b22d18674f7f308232fe86164eb275553fef2ff2b766d5ab57cd64d5946e19c93"
         "b7ab920acb9d6b246b51d9cd04b1e14e10375971b453c3a64db9d7e58c64f92bdeaba673";
-    EXPECT_EQ(output, expected);
+    EXPECT_EQ(bytesToHex(output), expected);
 }
\ No newline at end of file
@@ -58,6 +58,26 @@ TEST(SHA1, hashKatSHA1) {
     EXPECT_EQ(emptyStringDigest, expectedEmptyStringKAT);
 }
 
+// Every padding case: room for the length in the last block, no room, and whole blocks only
+TEST(SHA1, digestSHA1MatchesHex) {
+    const std::pair<size_t, std::string> vectors[] = {
+        { 0, "da39a3ee5e6b4b0d3255bfef95601890afd80709" },
+        { 55, "c1c8bbdc22796e28c0e15163d20899b65621d65a" },
+        { 56, "c2db330f6083854c99d4b5bfb6e8f29f201be699" },
+        { 64, "0098ba824b5c16427bd7a1122a5a442a25ec644d" }
+    };
+
+    for (const auto& vector : vectors) {
+        std::string msg(vector.first, 'a');
+        uint8_t digest[SHA1::DIGEST_SIZE];
+
+        digestSHA1(msg.data(), msg.size(), digest);
+
+        EXPECT_EQ(toHex(digest, SHA1::DIGEST_SIZE), vector.second) << vector.first << " bytes";
+        EXPECT_EQ(hashSHA1(msg), vector.second) << vector.first << " bytes";
+    }
+}
+
 // Large Known Answer Test(KAT) for SHA1 from:
 // [1] - https://www.di-mgt.com.au/sha_testvectors.html
 TEST(SHA1, hashLargeKatSHA1) {
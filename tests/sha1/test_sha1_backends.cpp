@@ -0,0 +1,63 @@
+/*
+ * Copyright 2023-2024 The Gestalt Project Authors. All Rights Reserved.
+ *
+ * Licensed under the MIT License. See the file LICENSE for the full text.
+ */
+
+/*
+ * test_sha1_backends.cpp
+ *
+ * This file contains the unit tests that run the SHA-1 compression backends against each other.
+ */
+
+#include <cstring>
+#include <random>
+#include <vector>
+
+#include "gtest/gtest.h"
+
+#include "sha1/sha1Core.h"
+
+static const uint32_t SHA1_IV[5] = { 0x67452301, 0xefcdab89, 0x98badcfe, 0x10325476, 0xc3d2e1f0 };
+
+static std::vector<uint8_t> randomBlocks(size_t numBlocks) {
+    std::mt19937 generator(0x53484131);
+    std::vector<uint8_t> data(numBlocks * 64);
+    for (auto& byte : data) {
+        byte = static_cast<uint8_t>(generator());
+    }
+    return data;
+}
+
+TEST(SHA1_Backends, NIMatchesScalar) {
+    if (!sha1NISupported())
+        GTEST_SKIP();
+
+    for (size_t numBlocks : {1, 2, 7, 64}) {
+        std::vector<uint8_t> data = randomBlocks(numBlocks);
+
+        uint32_t expected[5];
+        uint32_t actual[5];
+        std::memcpy(expected, SHA1_IV, sizeof(expected));
+        std::memcpy(actual, SHA1_IV, sizeof(actual));
+
+        sha1CompressScalar(expected, data.data(), numBlocks);
+        sha1CompressNI(actual, data.data(), numBlocks);
+
+        EXPECT_EQ(0, std::memcmp(expected, actual, sizeof(expected))) << numBlocks << " blocks";
+    }
+}
+
+TEST(SHA1_Backends, DispatchMatchesScalar) {
+    std::vector<uint8_t> data = randomBlocks(5);
+
+    uint32_t expected[5];
+    uint32_t actual[5];
+    std::memcpy(expected, SHA1_IV, sizeof(expected));
+    std::memcpy(actual, SHA1_IV, sizeof(actual));
+
+    sha1CompressScalar(expected, data.data(), 5);
+    sha1Compress(actual, data.data(), 5);
+
+    EXPECT_EQ(0, std::memcmp(expected, actual, sizeof(expected)));
+}
@@ -11,84 +11,99 @@
  */
 
 #include "gtest/gtest.h"
+#include <cstring>
 #include <string>
+#include <vector>
 
 #include <gestalt/sha1.h>
 #include "sha1/sha1Core.h"
 #include "utils.h"
 
-class SHA1_Test : public ::testing::Test {
-private:
+static const uint32_t SHA1_INITIAL_STATE[5] = { 0x67452301, 0xefcdab89, 0x98badcfe, 0x10325476, 0xc3d2e1f0 };
 
-    static const unsigned int BLOCK_SIZE = 80;
-    SHA1 SHA1Object;
-public:
+/*
+ * Compresses a padded message given in hex from the initial state.
+ */
+static void compressPadded(const std::string& paddedHex, uint32_t state[5]) {
+    std::vector<unsigned char> blocks = hexStringToBytesVec(paddedHex);
+    memcpy(state, SHA1_INITIAL_STATE, sizeof(SHA1_INITIAL_STATE));
+    sha1CompressScalar(state, blocks.data(), blocks.size() / SHA1_BLOCK_SIZE);
+}
 
-    void testSHA1FillBlock(std::string in, uint32_t computedW[BLOCK_SIZE]) {
-        SHA1Object.applySha1Padding(in);
-        this->SHA1Object.fillBlock(in, computedW);
-    }
-    void testSHA1Padding(std::string& in){
-        this->SHA1Object.applySha1Padding(in);
+/*
+ * Checks that the context pads the message into exactly the given blocks: compressing them by hand
+ * must give the digest of the context.
+ */
+static void expectPadding(const std::string& in, const std::string& expectedPaddedHex) {
+    uint32_t state[5];
+    compressPadded(expectedPaddedHex, state);
+
+    uint8_t expected[SHA1::DIGEST_SIZE];
+    for (size_t i = 0; i < SHA1::DIGEST_SIZE; i++) {
+        expected[i] = static_cast<uint8_t>(state[i / 4] >> (24 - 8 * (i % 4)));
     }
-};
-
-// Unit test for fillBlock function.
-TEST_F(SHA1_Test, fillBlock) {
-    std::string in = "abc";
-    uint32_t expectedW[80] = {
-        0x61626380, 0x00000000, 0x00000000, 0x00000000, 0x00000000, 0x00000000, 0x00000000, 0x00000000, 
-        0x00000000, 0x00000000, 0x00000000, 0x00000000, 0x00000000, 0x00000000, 0x00000000, 0x00000018, 
-        0xc2c4c700, 0x00000000, 0x00000030, 0x85898e01, 0x00000000, 0x00000060, 0x0b131c03, 0x00000030, 
-        0x85898ec1, 0x16263806, 0x00000000, 0x00000180, 0x2c4c700c, 0x000000f0, 0x93afb507, 0x5898e048, 
-        0x8e9a9202, 0x00000600, 0xb131c0f0, 0x16263bc6, 0x4ebed41e, 0x626380a1, 0x16263806, 0x000018c0, 
-        0xd2e138c4, 0x00000f00, 0x3afb5079, 0x898e04e5, 0xe2ba3c2b, 0x000060c0, 0x053a37cd, 0x74458547, 
-        0xda9415ed, 0x26380a16, 0x626383a1, 0x4ebf54de, 0x3835b44b, 0x0000f600, 0x1e84c7a3, 0x98e04d98, 
-        0x651d16a0, 0x62658ca1, 0x458544d6, 0x44584cb7, 0x7ba06619, 0x6380aea2, 0x0ae55269, 0x627b49a1, 
-        0x7cd45c9d, 0x000f0000, 0xfb50753a, 0xec6765e8, 0xba3c2be2, 0x0060c000, 0x3a37cd05, 0x458546f4, 
-        0xb8599dd6, 0x380a1a26, 0x01e02203, 0xe7cc3456, 0xe6e60b69, 0x00f60a00, 0x5795ef4f, 0x822e0879 };
-
-    uint32_t computedW[80]; // Array to store computed values
-    testSHA1FillBlock(in, computedW);
-
-    bool arraysEqual = true;
-    for (int i = 0; i < 80; i++) {
-        if (computedW[i] != expectedW[i]) {
-            std::cout << "Computed W: " << computedW[i] << " At: " << i << std::endl;
-            std::cout << "Expected W: " << expectedW[i] << " At: " << i << std::endl;
-            arraysEqual = false;
-        }
+
+    SHA1 context;
+    uint8_t digest[SHA1::DIGEST_SIZE];
+    context.update(in);
+    context.final(digest);
+
+    EXPECT_EQ(toHex(digest, SHA1::DIGEST_SIZE), toHex(expected, SHA1::DIGEST_SIZE)) << "message: " << in;
+}
+
+// Intermediate hash values for the two block message from https://nvlpubs.nist.gov/nistpubs/Legacy/FIPS/fipspub180-1.pdf
+TEST(SHA1_Functions, compressBlocks) {
+    // See pg.15 for the padded message and Appendix B for the hash values after each block.
+    const std::string paddedKAT =
+        "6162636462636465636465666465666765666768666768696768696a68696a6b"
+        "696a6b6c6a6b6c6d6b6c6d6e6c6d6e6f6d6e6f706e6f70718000000000000000"
+        "0000000000000000000000000000000000000000000000000000000000000000"
+        "00000000000000000000000000000000000000000000000000000000000001c0";
+    const uint32_t expectedFirstBlock[5] = { 0xf4286818, 0xc37b27ae, 0x0408f581, 0x84677148, 0x4a566572 };
+    const uint32_t expectedSecondBlock[5] = { 0x84983e44, 0x1c3bd26e, 0xbaae4aa1, 0xf95129e5, 0xe54670f1 };
+
+    std::vector<unsigned char> blocks = hexStringToBytesVec(paddedKAT);
+    uint32_t state[5];
+    memcpy(state, SHA1_INITIAL_STATE, sizeof(state));
+
+    sha1CompressScalar(state, blocks.data(), 1);
+    for (int i = 0; i < 5; i++) {
+        EXPECT_EQ(state[i], expectedFirstBlock[i]) << "H" << i << " after block 1";
     }
 
+    sha1CompressScalar(state, blocks.data() + SHA1_BLOCK_SIZE, 1);
+    for (int i = 0; i < 5; i++) {
+        EXPECT_EQ(state[i], expectedSecondBlock[i]) << "H" << i << " after block 2";
+    }
 
-    EXPECT_EQ(arraysEqual, 1);
+    // Both blocks in one call give the same result
+    compressPadded(paddedKAT, state);
+    for (int i = 0; i < 5; i++) {
+        EXPECT_EQ(state[i], expectedSecondBlock[i]) << "H" << i;
+    }
 }
 
 // Known Answer Test(KAT) for SHA1 Padding from https://nvlpubs.nist.gov/nistpubs/Legacy/FIPS/fipspub180-1.pdf
-TEST_F(SHA1_Test, paddingKatSHA1) { 
+TEST(SHA1_Functions, paddingKatSHA1) { 
     // See pg.12 for test vector.
-    std::string shortKAT = "abc";
+    const std::string shortKAT = "abc";
     const std::string expectedShortKAT = 
         "6162638000000000000000000000000000000000000000000000000000000000"
         "0000000000000000000000000000000000000000000000000000000000000018";
 
-    testSHA1Padding(shortKAT);
-    
-    EXPECT_EQ(convertToHex(shortKAT), expectedShortKAT);
+    expectPadding(shortKAT, expectedShortKAT);
 
     // See pg.15 for test vector.
-    std::string longKAT = "abcdbcdecdefdefgefghfghighijhijkijkljklmklmnlmnomnopnopq";
+    const std::string longKAT = "abcdbcdecdefdefgefghfghighijhijkijkljklmklmnlmnomnopnopq";
     const std::string expectedLongKAT = 
         "6162636462636465636465666465666765666768666768696768696a68696a6b"
         "696a6b6c6a6b6c6d6b6c6d6e6c6d6e6f6d6e6f706e6f70718000000000000000"
         "0000000000000000000000000000000000000000000000000000000000000000"
         "00000000000000000000000000000000000000000000000000000000000001c0";
 
-    testSHA1Padding(longKAT);
-
-    EXPECT_EQ(convertToHex(longKAT), expectedLongKAT);
+    expectPadding(longKAT, expectedLongKAT);
 
-    std::string longLongKAT = 
+    const std::string longLongKAT = 
         "abcdefghbcdefghicdefghijdefghijkefghijklfghijklmghijklmn"
         "hijklmnoijklmnopjklmnopqklmnopqrlmnopqrsmnopqrstnopqrstu";
     const std::string expectedLongLongKAT = 
@@ -97,16 +112,12 @@ TEST_F(SHA1_Test, paddingKatSHA1) {
         "696a6b6c6d6e6f706a6b6c6d6e6f70716b6c6d6e6f7071726c6d6e6f70717273"
         "6d6e6f70717273746e6f70717273747580000000000000000000000000000380";
 
-    testSHA1Padding(longLongKAT);
+    expectPadding(longLongKAT, expectedLongLongKAT);
 
-    EXPECT_EQ(convertToHex(longLongKAT), expectedLongLongKAT);
-
-    std::string emptyStringKAT = "";
+    const std::string emptyStringKAT = "";
     const std::string expectedEmptyStringKAT = 
         "8000000000000000000000000000000000000000000000000000000000000000"
         "0000000000000000000000000000000000000000000000000000000000000000";
 
-    testSHA1Padding(emptyStringKAT);
-
-    EXPECT_EQ(convertToHex(emptyStringKAT), expectedEmptyStringKAT);
+    expectPadding(emptyStringKAT, expectedEmptyStringKAT);
 }
\ No newline at end of file
@@ -0,0 +1,82 @@
+/*
+ * Copyright 2023-2024 The Gestalt Project Authors. All Rights Reserved.
+ *
+ * Licensed under the MIT License. See the file LICENSE for the full text.
+ */
+
+/*
+ * test_sha1_stream.cpp
+ *
+ * This file contains the unit tests for the streaming SHA1 context.
+ */
+
+#include "gtest/gtest.h"
+#include <string>
+
+#include <gestalt/sha1.h>
+#include <gestalt/hmac_sha1.h>
+#include "utils.h"
+#include "test_utils.h"
+
+TEST(SHA1_Stream, piecesMatchOneShot) {
+    std::string msg;
+    for (size_t i = 0; i < 300; i++) {
+        msg += static_cast<char>(i * 7 + 3);
+    }
+
+    // Every length around the one and two block padding boundaries, in varied piece sizes
+    for (size_t length = 0; length <= 300; length++) {
+        std::string prefix = msg.substr(0, length);
+        std::string expected = hashSHA1(prefix);
+        for (size_t pieceSize : { 1, 3, 63, 64, 65, 127, 128, 129, 1000 }) {
+            EXPECT_EQ(hashInPieces<SHA1>(prefix, pieceSize), expected) << length << " bytes in pieces of " << pieceSize;
+        }
+    }
+}
+
+TEST(SHA1_Stream, knownAnswer) {
+    SHA1 sha1;
+    sha1.update("ab", 2);
+    sha1.update(std::string("c"));
+    EXPECT_EQ(finalHex(sha1), "a9993e364706816aba3e25717850c26c9cd0d89d");
+
+    // 56 bytes: the length no longer fits into the first block
+    sha1.update(std::string("abcdbcdecdefdefgefghfghighijhijkijkljklmklmnlmnomnopnopq"));
+    EXPECT_EQ(finalHex(sha1), "84983e441c3bd26ebaae4aa1f95129e5e54670f1");
+}
+
+TEST(SHA1_Stream, millionCharacters) {
+    // The large vector of the one-shot tests, streamed in constant memory
+    std::string piece(1000, 'a');
+    SHA1 sha1;
+    for (int i = 0; i < 1000; i++) {
+        sha1.update(piece);
+    }
+
+    EXPECT_EQ(finalHex(sha1), "34aa973cd4c4daa4f61eeb2bdbad27316534016f");
+}
+
+TEST(SHA1_Stream, reuseAfterFinalAndReset) {
+    SHA1 sha;
+    EXPECT_EQ(sha.digestLength(), 20);
+
+    sha.update("abc", 3);
+    std::string first = finalHex(sha);
+    sha.update("abc", 3);
+    EXPECT_EQ(finalHex(sha), first);
+
+    sha.update("discarded", 9);
+    sha.reset();
+    sha.update("abc", 3);
+    EXPECT_EQ(finalHex(sha), hashSHA1("abc"));
+    EXPECT_EQ(sha.hash("abc"), first);
+}
+
+TEST(SHA1_Stream, declaredNextToHMAC) {
+    // The context shares its name with the HMAC hash selector, which must not hide it
+    SHA1 sha;
+    sha.update(std::string("what do ya want for nothing?"));
+
+    EXPECT_EQ(finalHex(sha), hashSHA1("what do ya want for nothing?"));
+    EXPECT_EQ(hmacSHA1("Jefe", "what do ya want for nothing?"), "effcdf6ae5eb2fa2d27416d5f184df9c259a7c79");
+}
@@ -0,0 +1,146 @@
+/*
+ * Copyright 2023-2024 The Gestalt Project Authors. All Rights Reserved.
+ *
+ * Licensed under the MIT License. See the file LICENSE for the full text.
+ */
+
+/*
+ * test_sha2_backends.cpp
+ *
+ * This file contains the unit tests that run the SHA-2 compression backends, single and multi-buffer,
+ * against each other.
+ */
+
+#include <cstring>
+#include <random>
+#include <vector>
+
+#include "gtest/gtest.h"
+
+#include "sha2/sha2Core.h"
+
+static const uint32_t SHA256_IV[8] = {
+    0x6a09e667, 0xbb67ae85, 0x3c6ef372, 0xa54ff53a, 0x510e527f, 0x9b05688c, 0x1f83d9ab, 0x5be0cd19
+};
+
+static const uint64_t SHA512_IV[8] = {
+    0x6a09e667f3bcc908, 0xbb67ae8584caa73b, 0x3c6ef372fe94f82b, 0xa54ff53a5f1d36f1,
+    0x510e527fade682d1, 0x9b05688c2b3e6c1f, 0x1f83d9abfb41bd6b, 0x5be0cd19137e2179
+};
+
+static std::vector<uint8_t> randomBlocks(size_t numBlocks, size_t blockSize = SHA256_BLOCK_SIZE) {
+    std::mt19937 generator(static_cast<uint32_t>(0x5348414e + numBlocks));
+    std::vector<uint8_t> data(numBlocks * blockSize);
+    for (auto& byte : data) {
+        byte = static_cast<uint8_t>(generator());
+    }
+    return data;
+}
+
+TEST(SHA256_Backends, NIMatchesScalar) {
+    if (!sha256NISupported())
+        GTEST_SKIP();
+
+    for (size_t numBlocks : {1, 2, 7, 64}) {
+        std::vector<uint8_t> data = randomBlocks(numBlocks);
+
+        uint32_t expected[8];
+        uint32_t actual[8];
+        std::memcpy(expected, SHA256_IV, sizeof(expected));
+        std::memcpy(actual, SHA256_IV, sizeof(actual));
+
+        sha256CompressScalar(expected, data.data(), numBlocks);
+        sha256CompressNI(actual, data.data(), numBlocks);
+
+        EXPECT_EQ(0, std::memcmp(expected, actual, sizeof(expected))) << numBlocks << " blocks";
+    }
+}
+
+TEST(SHA256_Backends, DispatchMatchesScalar) {
+    std::vector<uint8_t> data = randomBlocks(5);
+
+    uint32_t expected[8];
+    uint32_t actual[8];
+    std::memcpy(expected, SHA256_IV, sizeof(expected));
+    std::memcpy(actual, SHA256_IV, sizeof(actual));
+
+    sha256CompressScalar(expected, data.data(), 5);
+    sha256Compress(actual, data.data(), 5);
+
+    EXPECT_EQ(0, std::memcmp(expected, actual, sizeof(expected)));
+}
+
+class SHA2_LaneBackends : public testing::TestWithParam<SHA2LaneBackend> {
+protected:
+    void SetUp() override {
+        if (!isSHA2LaneBackendSupported(GetParam()))
+            GTEST_SKIP();
+    }
+};
+
+std::string SHA2LaneBackendNameGenerator(const testing::TestParamInfo<SHA2LaneBackend>& info) {
+    switch (info.param) {
+    case SHA2LaneBackend::SSE41: return "SSE41";
+    case SHA2LaneBackend::AVX2: return "AVX2";
+    case SHA2LaneBackend::AVX512: return "AVX512";
+    default: return "Scalar";
+    }
+}
+
+/*
+ * Compresses different data from a different starting state in every lane, for a full and a partly
+ * filled vector, and checks each lane against the single message code.
+ */
+template <typename Word>
+static void expectLanesMatchScalar(
+    size_t laneCount, const Word iv[8], size_t blockSize,
+    void (*compressLanes)(SHA2LaneBackend, Word* const*, const uint8_t* const*, size_t, size_t),
+    void (*compressScalar)(Word*, const uint8_t*, size_t), SHA2LaneBackend backend
+) {
+    const size_t numBlocks = 3;
+
+    for (size_t numLanes : {laneCount, laneCount - 1}) {
+        if (numLanes == 0)
+            continue;
+
+        std::vector<std::vector<uint8_t>> data(numLanes);
+        std::vector<std::vector<Word>> expected(numLanes, std::vector<Word>(iv, iv + 8));
+        std::vector<std::vector<Word>> actual(numLanes, std::vector<Word>(iv, iv + 8));
+        Word* states[SHA2_MAX_LANES];
+        const uint8_t* blocks[SHA2_MAX_LANES];
+
+        for (size_t lane = 0; lane < numLanes; lane++) {
+            data[lane] = randomBlocks(numBlocks + lane, blockSize);
+            expected[lane][0] += static_cast<Word>(lane);
+            actual[lane][0] += static_cast<Word>(lane);
+            compressScalar(expected[lane].data(), data[lane].data(), numBlocks);
+            states[lane] = actual[lane].data();
+            blocks[lane] = data[lane].data();
+        }
+
+        compressLanes(backend, states, blocks, numLanes, numBlocks);
+
+        for (size_t lane = 0; lane < numLanes; lane++) {
+            EXPECT_EQ(expected[lane], actual[lane]) << numLanes << " lanes, lane " << lane;
+        }
+    }
+}
+
+TEST_P(SHA2_LaneBackends, SHA256MatchesScalar) {
+    expectLanesMatchScalar<uint32_t>(
+        sha256LaneCount(GetParam()), SHA256_IV, SHA256_BLOCK_SIZE, sha256CompressLanes, sha256CompressScalar, GetParam()
+    );
+}
+
+TEST_P(SHA2_LaneBackends, SHA512MatchesScalar) {
+    expectLanesMatchScalar<uint64_t>(
+        sha512LaneCount(GetParam()), SHA512_IV, SHA512_BLOCK_SIZE, sha512CompressLanes, sha512Compress, GetParam()
+    );
+}
+
+INSTANTIATE_TEST_SUITE_P(
+    All,
+    SHA2_LaneBackends,
+    testing::Values(SHA2LaneBackend::Scalar, SHA2LaneBackend::SSE41, SHA2LaneBackend::AVX2, SHA2LaneBackend::AVX512),
+    SHA2LaneBackendNameGenerator
+);
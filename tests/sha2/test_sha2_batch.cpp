@@ -0,0 +1,105 @@
+/*
+ * Copyright 2023-2024 The Gestalt Project Authors. All Rights Reserved.
+ *
+ * Licensed under the MIT License. See the file LICENSE for the full text.
+ */
+
+/*
+ * test_sha2_batch.cpp
+ *
+ * This file contains the unit tests for the multi-buffer SHA2 batch functions.
+ */
+
+#include "gtest/gtest.h"
+#include <stdexcept>
+#include <string>
+#include <vector>
+
+#include <gestalt/sha2.h>
+#include "utils.h"
+
+/*
+ * Hashes messages of every length from 0 to a few blocks, in an order that mixes long and short
+ * ones, and checks each digest against the streaming context.
+ */
+template <typename Context>
+static void expectBatchMatchesContext(void (*hashBatch)(const SHA2BatchItem*, size_t)) {
+    const size_t numMessages = 300;
+    std::vector<std::string> messages(numMessages);
+    for (size_t i = 0; i < numMessages; i++) {
+        size_t length = (i * 37) % numMessages;
+        for (size_t j = 0; j < length; j++) {
+            messages[i].push_back(static_cast<char>('a' + (i + j) % 26));
+        }
+    }
+
+    std::vector<uint8_t> digests(numMessages * Context::DIGEST_SIZE);
+    std::vector<SHA2BatchItem> items(numMessages);
+    for (size_t i = 0; i < numMessages; i++) {
+        items[i].in = reinterpret_cast<const uint8_t*>(messages[i].data());
+        items[i].inLen = messages[i].size();
+        items[i].digest = digests.data() + i * Context::DIGEST_SIZE;
+    }
+
+    hashBatch(items.data(), items.size());
+
+    for (size_t i = 0; i < numMessages; i++) {
+        Context context;
+        uint8_t expected[Context::DIGEST_SIZE];
+        context.update(messages[i]);
+        context.final(expected);
+        EXPECT_EQ(toHex(expected, Context::DIGEST_SIZE), toHex(items[i].digest, Context::DIGEST_SIZE))
+            << "message of " << messages[i].size() << " bytes";
+    }
+}
+
+TEST(SHA2_Batch, SHA224) {
+    expectBatchMatchesContext<SHA224>(hashSHA224Batch);
+}
+
+TEST(SHA2_Batch, SHA256) {
+    expectBatchMatchesContext<SHA256>(hashSHA256Batch);
+}
+
+TEST(SHA2_Batch, SHA384) {
+    expectBatchMatchesContext<SHA384>(hashSHA384Batch);
+}
+
+TEST(SHA2_Batch, SHA512) {
+    expectBatchMatchesContext<SHA512>(hashSHA512Batch);
+}
+
+TEST(SHA2_Batch, SHA512_224) {
+    expectBatchMatchesContext<SHA512_224>(hashSHA512_224Batch);
+}
+
+TEST(SHA2_Batch, SHA512_256) {
+    expectBatchMatchesContext<SHA512_256>(hashSHA512_256Batch);
+}
+
+TEST(SHA2_Batch, singleEmptyMessage) {
+    uint8_t digest[SHA256::DIGEST_SIZE];
+    SHA2BatchItem item = { nullptr, 0, digest };
+
+    hashSHA256Batch(&item, 1);
+
+    EXPECT_EQ("e3b0c44298fc1c149afbf4c8996fb92427ae41e4649b934ca495991b7852b855", toHex(digest, sizeof(digest)));
+}
+
+TEST(SHA2_Batch, emptyBatch) {
+    EXPECT_NO_THROW(hashSHA512Batch(nullptr, 0));
+}
+
+TEST(SHA2_Batch, tooLongMessageThrows) {
+    uint8_t digest[SHA256::DIGEST_SIZE] = {};
+    SHA2BatchItem items[2] = {
+        { reinterpret_cast<const uint8_t*>("abc"), 3, digest },
+        { nullptr, static_cast<size_t>(1) << 61, digest }
+    };
+
+    if (sizeof(size_t) < 8)
+        GTEST_SKIP();
+
+    EXPECT_THROW(hashSHA256Batch(items, 2), std::invalid_argument);
+    EXPECT_EQ(std::string(2 * sizeof(digest), '0'), toHex(digest, sizeof(digest)));
+}
@@ -0,0 +1,131 @@
+/*
+ * Copyright 2023-2024 The Gestalt Project Authors. All Rights Reserved.
+ *
+ * Licensed under the MIT License. See the file LICENSE for the full text.
+ */
+
+/*
+ * test_sha2_stream.cpp
+ *
+ * This file contains the unit tests for the streaming SHA2 contexts.
+ */
+
+#include "gtest/gtest.h"
+#include <string>
+
+#include <gestalt/sha2.h>
+#include <gestalt/hmac_sha2.h>
+#include "utils.h"
+#include "test_utils.h"
+
+template <typename Context>
+static void expectPiecesMatchOneShot(std::string (*hashOneShot)(const std::string&)) {
+    std::string msg;
+    for (size_t i = 0; i < 600; i++) {
+        msg += static_cast<char>(i * 7 + 3);
+    }
+
+    // Every length around the one and two block padding boundaries, in varied piece sizes
+    for (size_t length = 0; length <= 300; length++) {
+        std::string prefix = msg.substr(0, length);
+        std::string expected = hashOneShot(prefix);
+        for (size_t pieceSize : { 1, 3, 63, 64, 65, 127, 128, 129, 1000 }) {
+            EXPECT_EQ(hashInPieces<Context>(prefix, pieceSize), expected) << length << " bytes in pieces of " << pieceSize;
+        }
+    }
+}
+
+TEST(SHA2_Stream, piecesMatchOneShot) {
+    expectPiecesMatchOneShot<SHA224>(hashSHA224);
+    expectPiecesMatchOneShot<SHA256>(hashSHA256);
+    expectPiecesMatchOneShot<SHA384>(hashSHA384);
+    expectPiecesMatchOneShot<SHA512>(hashSHA512);
+    expectPiecesMatchOneShot<SHA512_224>(hashSHA512_224);
+    expectPiecesMatchOneShot<SHA512_256>(hashSHA512_256);
+}
+
+TEST(SHA2_Stream, knownAnswer) {
+    SHA256 sha256;
+    sha256.update("ab", 2);
+    sha256.update(std::string("c"));
+    EXPECT_EQ(finalHex(sha256), "ba7816bf8f01cfea414140de5dae2223b00361a396177a9cb410ff61f20015ad");
+
+    SHA512_224 sha512_224;
+    sha512_224.update("abc", 3);
+    EXPECT_EQ(finalHex(sha512_224), "4634270f707b6a54daae7530460842e20e37ed265ceee9a43e8924aa");
+}
+
+TEST(SHA2_Stream, millionCharacters) {
+    // The large vectors of the one-shot tests, streamed in constant memory
+    std::string piece(1000, 'a');
+    SHA224 sha224;
+    SHA256 sha256;
+    SHA384 sha384;
+    SHA512 sha512;
+    for (int i = 0; i < 1000; i++) {
+        sha224.update(piece);
+        sha256.update(piece);
+        sha384.update(piece);
+        sha512.update(piece);
+    }
+
+    EXPECT_EQ(finalHex(sha224), "20794655980c91d8bbb4c1ea97618a4bf03f42581948b2ee4ee7ad67");
+    EXPECT_EQ(finalHex(sha256), "cdc76e5c9914fb9281a1c7e284d73e67f1809a48a497200e046d39ccc7112cd0");
+    EXPECT_EQ(
+        finalHex(sha384),
+        "9d0e1809716474cb086e834e310a4a1ced149e9c00f248527972cec5704c2a5b07b8b3dc38ecc4ebae97ddd87f3d8985"
+    );
+    EXPECT_EQ(
+        finalHex(sha512),
+        "e718483d0ce769644e2e42c7bc15b4638e1f98b13b2044285632a803afa973eb"
+        "de0ff244877ea60a4cb0432ce577c31beb009c5c2c49aa2e4eadb217ad8cc09b"
+    );
+}
+
+TEST(SHA2_Stream, reuseAfterFinalAndReset) {
+    SHA384 sha;
+    EXPECT_EQ(sha.digestLength(), 48);
+
+    sha.update("abc", 3);
+    std::string first = finalHex(sha);
+    sha.update("abc", 3);
+    EXPECT_EQ(finalHex(sha), first);
+
+    sha.update("discarded", 9);
+    sha.reset();
+    sha.update("abc", 3);
+    EXPECT_EQ(finalHex(sha), hashSHA384("abc"));
+}
+
+TEST(SHA2_Digest, rawMatchesHex) {
+    const std::string msg = "abcdbcdecdefdefgefghfghighijhijkijkljklmklmnlmnomnopnopq";
+    uint8_t digest[SHA512::DIGEST_SIZE];
+
+    digestSHA224(msg.data(), msg.size(), digest);
+    EXPECT_EQ(toHex(digest, SHA224::DIGEST_SIZE), hashSHA224(msg));
+    digestSHA256(msg.data(), msg.size(), digest);
+    EXPECT_EQ(toHex(digest, SHA256::DIGEST_SIZE), hashSHA256(msg));
+    digestSHA384(msg.data(), msg.size(), digest);
+    EXPECT_EQ(toHex(digest, SHA384::DIGEST_SIZE), hashSHA384(msg));
+    digestSHA512(msg.data(), msg.size(), digest);
+    EXPECT_EQ(toHex(digest, SHA512::DIGEST_SIZE), hashSHA512(msg));
+    digestSHA512_224(msg.data(), msg.size(), digest);
+    EXPECT_EQ(toHex(digest, SHA512_224::DIGEST_SIZE), hashSHA512_224(msg));
+    digestSHA512_256(msg.data(), msg.size(), digest);
+    EXPECT_EQ(toHex(digest, SHA512_256::DIGEST_SIZE), hashSHA512_256(msg));
+}
+
+TEST(SHA2_Stream, declaredNextToHMAC) {
+    // The contexts share their names with the HMAC hash selectors, which must not hide them
+    SHA256 sha256;
+    SHA512 sha512;
+    sha256.update(std::string("what do ya want for nothing?"));
+    sha512.update(std::string("what do ya want for nothing?"));
+
+    EXPECT_EQ(finalHex(sha256), hashSHA256("what do ya want for nothing?"));
+    EXPECT_EQ(finalHex(sha512), hashSHA512("what do ya want for nothing?"));
+    EXPECT_EQ(
+        hmacSHA256("Jefe", "what do ya want for nothing?"),
+        "5bdcc146bf60754e6a042426089575c75a003f089d2739839dec58b964ec3843"
+    );
+}
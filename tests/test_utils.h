@@ -0,0 +1,49 @@
+/*
+ * Copyright 2023-2024 The Gestalt Project Authors. All Rights Reserved.
+ *
+ * Licensed under the MIT License. See the file LICENSE for the full text.
+ */
+
+/*
+ * test_utils.h
+ *
+ * This file contains the helper functions shared by the unit tests.
+ */
+
+#pragma once
+
+#include <cstdint>
+#include <string>
+#include <vector>
+
+#include "utils.h"
+
+/*
+ * Copies the characters of a string into a byte vector.
+ */
+inline std::vector<uint8_t> toBytes(const std::string& str) {
+    return std::vector<uint8_t>(str.begin(), str.end());
+}
+
+/*
+ * Finishes a streaming hash context and returns the digest in hex.
+ */
+template <typename Context>
+std::string finalHex(Context& context) {
+    uint8_t digest[Context::DIGEST_SIZE];
+    context.final(digest);
+    return toHex(digest, Context::DIGEST_SIZE);
+}
+
+/*
+ * Feeds a message to a fresh streaming hash context in pieces of the given size and returns
+ * the digest in hex.
+ */
+template <typename Context>
+std::string hashInPieces(const std::string& msg, size_t pieceSize) {
+    Context context;
+    for (size_t i = 0; i < msg.size(); i += pieceSize) {
+        context.update(msg.data() + i, msg.size() - i < pieceSize ? msg.size() - i : pieceSize);
+    }
+    return finalHex(context);
+}
@@ -0,0 +1,106 @@
+/*
+ * Copyright 2023-2024 The Gestalt Project Authors. All Rights Reserved.
+ *
+ * Licensed under the MIT License. See the file LICENSE for the full text.
+ */
+
+/*
+ * cpu_features.cpp
+ *
+ * This file contains the implementation of the runtime CPU feature detection declared in cpu_features.h.
+ *
+ * References:
+ * - Intel 64 and IA-32 Architectures Software Developer's Manual, Volume 2A, "CPUID"
+ */
+
+#include "cpu_features.h"
+
+#if defined(GESTALT_X86)
+#if defined(_MSC_VER)
+#include <intrin.h>
+#else
+#include <cpuid.h>
+#endif
+#endif
+
+#if defined(GESTALT_X86)
+/*
+ * Executes CPUID for the given leaf and subleaf.
+ *
+ * @param leaf The CPUID function number (EAX).
+ * @param subleaf The CPUID sub-function number (ECX).
+ * @param regs Output registers in the order EAX, EBX, ECX, EDX.
+ */
+static void cpuid(unsigned int leaf, unsigned int subleaf, unsigned int regs[4]) {
+#if defined(_MSC_VER)
+    int info[4];
+    __cpuidex(info, static_cast<int>(leaf), static_cast<int>(subleaf));
+    for (int i = 0; i < 4; i++) {
+        regs[i] = static_cast<unsigned int>(info[i]);
+    }
+#else
+    __cpuid_count(leaf, subleaf, regs[0], regs[1], regs[2], regs[3]);
+#endif
+}
+
+/*
+ * Reads extended control register 0, which tells which register sets the OS saves on a context switch.
+ * Only valid when CPUID reports OSXSAVE.
+ */
+static unsigned long long readXCR0() {
+#if defined(_MSC_VER)
+    return _xgetbv(0);
+#else
+    unsigned int eax = 0;
+    unsigned int edx = 0;
+    __asm__ volatile("xgetbv" : "=a"(eax), "=d"(edx) : "c"(0));
+    return (static_cast<unsigned long long>(edx) << 32) | eax;
+#endif
+}
+#endif
+
+static CPUFeatures detectCPUFeatures() {
+    CPUFeatures features;
+
+#if defined(GESTALT_X86)
+    unsigned int regs[4] = { 0, 0, 0, 0 };
+    cpuid(0, 0, regs);
+    const unsigned int maxLeaf = regs[0];
+
+    if (maxLeaf >= 1) {
+        cpuid(1, 0, regs);
+        features.sse2  = (regs[3] & (1u << 26)) != 0;
+        features.ssse3 = (regs[2] & (1u << 9)) != 0;
+        features.sse41 = (regs[2] & (1u << 19)) != 0;
+        features.aesni = (regs[2] & (1u << 25)) != 0;
+        features.pclmul = (regs[2] & (1u << 1)) != 0;
+    }
+
+    // AVX2 code also needs the OS to preserve the XMM and YMM state (XCR0 bits 1 and 2)
+    // and AVX-512 code the opmask and ZMM state as well (XCR0 bits 5 to 7)
+    bool osSavesYMM = false;
+    bool osSavesZMM = false;
+    if (maxLeaf >= 1 && (regs[2] & (1u << 27)) != 0) {
+        const unsigned long long xcr0 = readXCR0();
+        osSavesYMM = (xcr0 & 0x6) == 0x6;
+        osSavesZMM = (xcr0 & 0xe6) == 0xe6;
+    }
+    if (maxLeaf >= 7) {
+        cpuid(7, 0, regs);
+        features.avx2 = osSavesYMM && (regs[1] & (1u << 5)) != 0;
+        features.avx512f = osSavesZMM && (regs[1] & (1u << 16)) != 0;
+        features.sha = (regs[1] & (1u << 29)) != 0;
+    }
+#endif
+
+    return features;
+}
+
+/*
+ * Returns the instruction set extensions supported by the executing CPU.
+ * Detection runs once on first use; later calls return the cached result.
+ */
+const CPUFeatures& getCPUFeatures() {
+    static const CPUFeatures features = detectCPUFeatures();
+    return features;
+}
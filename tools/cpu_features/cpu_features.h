@@ -0,0 +1,34 @@
+/*
+ * Copyright 2023-2024 The Gestalt Project Authors. All Rights Reserved.
+ *
+ * Licensed under the MIT License. See the file LICENSE for the full text.
+ */
+
+/*
+ * cpu_features.h
+ *
+ * This file provides runtime detection of the optional instruction set extensions that Gestalt
+ * can use for hardware accelerated backends. The features are queried once with CPUID and cached,
+ * so callers can cheaply decide which implementation to dispatch to.
+ *
+ * On non-x86 platforms every feature reports as unavailable and the portable code paths are used.
+ */
+
+#pragma once
+
+#if defined(__x86_64__) || defined(_M_X64) || defined(__i386__) || defined(_M_IX86)
+#define GESTALT_X86 1
+#endif
+
+struct CPUFeatures {
+    bool sse2 = false;
+    bool ssse3 = false;
+    bool sse41 = false;
+    bool aesni = false;
+    bool pclmul = false;
+    bool avx2 = false;    // Also requires the OS to save the YMM registers
+    bool avx512f = false; // Also requires the OS to save the opmask and ZMM registers
+    bool sha = false;     // SHA-1 and SHA-256 extensions
+};
+
+const CPUFeatures& getCPUFeatures();
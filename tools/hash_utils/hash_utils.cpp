@@ -13,6 +13,9 @@
  * The `hash` function returns a callable function object that can be used to hash 
  * strings with the selected hash algorithm. It supports multiple hash algorithms 
  * through the `HashAlgorithm` enum and internally uses pre-defined hash functions.
+ *
+ * `hash` returns the digest in hex. `digestFunction` and `hashBytes` give the raw digest instead, for
+ * the padding schemes and signatures that go on to use it as bytes.
  * 
  */
 
@@ -37,4 +40,40 @@ std::function<std::string(const std::string&)> hash(HashAlgorithm hashAlg) {
         default:
             throw std::invalid_argument("Unsupported hash function");
     }
+}
+
+/*
+ * Returns the raw digest function of a hash algorithm. It writes static_cast<size_t>(hashAlg) bytes.
+ *
+ * @throws std::invalid_argument for HashAlgorithm::None, which has no digest.
+ */
+DigestFunction digestFunction(HashAlgorithm hashAlg) {
+    switch (hashAlg) {
+        case HashAlgorithm::SHA1:
+            return digestSHA1;
+        case HashAlgorithm::SHA224:
+            return digestSHA224;
+        case HashAlgorithm::SHA256:
+            return digestSHA256;
+        case HashAlgorithm::SHA384:
+            return digestSHA384;
+        case HashAlgorithm::SHA512:
+            return digestSHA512;
+        default:
+            throw std::invalid_argument("Unsupported hash function");
+    }
+}
+
+/*
+ * Hashes a message and returns the raw digest. Like hash, HashAlgorithm::None returns the input
+ * unchanged.
+ */
+std::string hashBytes(HashAlgorithm hashAlg, const std::string& in) {
+    if (hashAlg == HashAlgorithm::None) {
+        return in;
+    }
+
+    uint8_t digest[static_cast<size_t>(HashAlgorithm::SHA512)];
+    digestFunction(hashAlg)(in.data(), in.size(), digest);
+    return std::string(reinterpret_cast<const char*>(digest), static_cast<size_t>(hashAlg));
 }
\ No newline at end of file
@@ -13,6 +13,9 @@
  * The `hash` function returns a callable function object that can be used to hash 
  * strings with the selected hash algorithm. It supports multiple hash algorithms 
  * through the `HashAlgorithm` enum and internally uses pre-defined hash functions.
+ *
+ * `hash` returns the digest in hex. `digestFunction` and `hashBytes` give the raw digest instead, for
+ * the padding schemes and signatures that go on to use it as bytes.
  * 
  */
 
@@ -21,6 +24,8 @@
 #include <iostream>
 #include <string>
 #include <functional>
+#include <cstdint>
+#include <cstddef>
 
 enum class HashAlgorithm : unsigned int{
     None = 0,
@@ -31,4 +36,8 @@ enum class HashAlgorithm : unsigned int{
     SHA512 = 64 // 64-Bytes
 };
 
-std::function<std::string(const std::string&)> hash(HashAlgorithm hashAlg);
\ No newline at end of file
+typedef void (*DigestFunction)(const void* in, size_t inLen, uint8_t* digest);
+
+std::function<std::string(const std::string&)> hash(HashAlgorithm hashAlg);
+DigestFunction digestFunction(HashAlgorithm hashAlg);
+std::string hashBytes(HashAlgorithm hashAlg, const std::string& in);
\ No newline at end of file
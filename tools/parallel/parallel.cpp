@@ -0,0 +1,106 @@
+/*
+ * Copyright 2023-2024 The Gestalt Project Authors. All Rights Reserved.
+ *
+ * Licensed under the MIT License. See the file LICENSE for the full text.
+ */
+
+/*
+ * parallel.cpp
+ *
+ * This file contains the implementation of the threading helpers declared in parallel.h.
+ */
+
+#include <atomic>
+#include <exception>
+#include <thread>
+
+#include "parallel.h"
+
+static std::atomic<size_t> threadCountOverride(0);
+
+/*
+ * Returns the number of threads bulk operations may use, at least one.
+ */
+size_t getParallelThreadCount() {
+    static const size_t hardwareThreads = std::thread::hardware_concurrency() > 0 ? std::thread::hardware_concurrency() : 1;
+    size_t threadCount = threadCountOverride.load();
+    return threadCount > 0 ? threadCount : hardwareThreads;
+}
+
+/*
+ * Sets the number of threads bulk operations may use, e.g. to keep a library call on one thread or to
+ * exercise the split paths on a machine with few cores.
+ *
+ * @param threadCount The number of threads, or 0 to use one per hardware thread.
+ */
+void setParallelThreadCount(size_t threadCount) {
+    threadCountOverride.store(threadCount);
+}
+
+/*
+ * Splits numBlocks blocks into contiguous ranges of roughly equal size, one per thread. Every range
+ * holds at least PARALLEL_MIN_BYTES_PER_THREAD bytes, so small inputs produce a single range.
+ *
+ * @param numBlocks The number of blocks to split.
+ * @param blockSize The size of one block in bytes.
+ * @return The ranges in ascending order, covering every block exactly once.
+ */
+std::vector<BlockRange> splitBlockRange(size_t numBlocks, size_t blockSize) {
+    size_t minBlocks = PARALLEL_MIN_BYTES_PER_THREAD / blockSize;
+    size_t numRanges = numBlocks / (minBlocks > 0 ? minBlocks : 1);
+    if (numRanges > getParallelThreadCount()) {
+        numRanges = getParallelThreadCount();
+    }
+    if (numRanges == 0) {
+        numRanges = 1;
+    }
+
+    std::vector<BlockRange> ranges(numRanges);
+    size_t first = 0;
+    for (size_t i = 0; i < numRanges; i++) {
+        size_t count = numBlocks / numRanges + (i < numBlocks % numRanges ? 1 : 0);
+        ranges[i].first = first;
+        ranges[i].count = count;
+        first += count;
+    }
+    return ranges;
+}
+
+/*
+ * Runs body(0) .. body(count - 1) concurrently, index 0 on the calling thread and every other index
+ * on a thread of its own, and waits for all of them. An exception thrown by any body is rethrown
+ * once all threads have finished.
+ *
+ * @param count The number of invocations.
+ * @param body The work to run for each index.
+ */
+void parallelFor(size_t count, const std::function<void(size_t)>& body) {
+    if (count == 0) {
+        return;
+    }
+
+    std::vector<std::exception_ptr> errors(count);
+    auto run = [&](size_t index) {
+        try {
+            body(index);
+        } catch (...) {
+            errors[index] = std::current_exception();
+        }
+    };
+
+    std::vector<std::thread> threads;
+    threads.reserve(count - 1);
+    for (size_t i = 1; i < count; i++) {
+        threads.emplace_back(run, i);
+    }
+    run(0);
+    for (std::thread& thread : threads) {
+        thread.join();
+    }
+
+    for (const std::exception_ptr& error : errors) {
+        if (error) {
+            std::rethrow_exception(error);
+        }
+    }
+}
@@ -0,0 +1,33 @@
+/*
+ * Copyright 2023-2024 The Gestalt Project Authors. All Rights Reserved.
+ *
+ * Licensed under the MIT License. See the file LICENSE for the full text.
+ */
+
+/*
+ * parallel.h
+ *
+ * This file provides the helpers used to split bulk cipher work across threads. A buffer of
+ * independent blocks is divided into contiguous ranges, one per hardware thread, and each range is
+ * processed on its own thread. Small buffers stay on the calling thread, since starting a thread costs
+ * more than processing a few hundred kilobytes.
+ */
+
+#pragma once
+
+#include <cstddef>
+#include <functional>
+#include <vector>
+
+// Minimum amount of work given to each thread
+const size_t PARALLEL_MIN_BYTES_PER_THREAD = 1 << 20;
+
+struct BlockRange {
+    size_t first;
+    size_t count;
+};
+
+size_t getParallelThreadCount();
+void setParallelThreadCount(size_t threadCount);
+std::vector<BlockRange> splitBlockRange(size_t numBlocks, size_t blockSize);
+void parallelFor(size_t count, const std::function<void(size_t)>& body);
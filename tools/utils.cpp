@@ -321,12 +321,24 @@ std::string printIntToBinary(uint32_t in) {
 }
 
 std::string toHex(const unsigned char* data, size_t length) {
-    std::stringstream ss;
-    ss << std::hex << std::setfill('0');
+    static const char digits[] = "0123456789abcdef";
+
+    std::string hex(2 * length, '0');
     for (size_t i = 0; i < length; ++i) {
-        ss << std::setw(2) << static_cast<int>(data[i]);
+        hex[2 * i] = digits[data[i] >> 4];
+        hex[2 * i + 1] = digits[data[i] & 0x0f];
     }
-    return ss.str();
+    return hex;
+}
+
+/*
+ * Returns the value of a hexadecimal digit, or -1 if c is not one.
+ */
+int hexDigitValue(char c) {
+    if (c >= '0' && c <= '9') return c - '0';
+    if (c >= 'a' && c <= 'f') return c - 'a' + 10;
+    if (c >= 'A' && c <= 'F') return c - 'A' + 10;
+    return -1;
 }
 
 std::string fromHex(const std::string& hex) {
@@ -334,12 +346,15 @@ std::string fromHex(const std::string& hex) {
         throw std::invalid_argument("Hex string must have an even length");
     }
 
-    std::string binary;
-    binary.reserve(hex.length() / 2);
-    
+    std::string binary(hex.length() / 2, '\0');
+
     for (size_t i = 0; i < hex.length(); i += 2) {
-        unsigned char byte = static_cast<unsigned char>(std::stoi(hex.substr(i, 2), nullptr, 16));
-        binary.push_back(byte);
+        int high = hexDigitValue(hex[i]);
+        int low = hexDigitValue(hex[i + 1]);
+        if (high < 0 || low < 0) {
+            throw std::invalid_argument("Hex string contains a non-hex character");
+        }
+        binary[i / 2] = static_cast<char>((high << 4) | low);
     }
 
     return binary;
@@ -48,5 +48,6 @@ void xorBlock(unsigned char* a, const std::string& b, size_t blockIndex);
 std::string printIntToBinary(uint64_t in);
 std::string printIntToBinary(uint32_t in);
 std::string toHex(const unsigned char* data, size_t length);
+int hexDigitValue(char c);
 std::string fromHex(const std::string& hex);
 unsigned int xorHexStrings(const std::string& hexStr1, const std::string& hexStr2);
\ No newline at end of file